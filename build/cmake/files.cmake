@@ -561,6 +561,7 @@ set(BASE_CMN_HDR
     wx/hashset.h
     wx/iconloc.h
     wx/init.h
+    wx/internedstring.h
     wx/intl.h
     wx/iosfwrap.h
     wx/ioswrap.h
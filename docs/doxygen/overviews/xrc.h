@@ -260,6 +260,7 @@ switches and options:
 @li -h (\--help): Show a help message.
 @li -v (\--verbose): Show verbose logging information.
 @li -c (\--cpp-code): Write C++ source rather than a XRS file.
+@li -b (\--binary): Write compiled XRB file rather than a XRS file.
 @li -e (\--extra-cpp-code): If used together with -c, generates C++ header file
     containing class definitions for the windows defined by the XRC file (see
     special subsection).
@@ -278,6 +279,7 @@ For example:
 $ wxrc resource.xrc
 $ wxrc resource.xrc -o resource.xrs
 $ wxrc resource.xrc -v -c -o resource.cpp
+$ wxrc resource.xrc -b -o resource.xrb
 @endcode
 
 @note XRS file is essentially a renamed ZIP archive which means that you can
@@ -292,6 +294,16 @@ thing to do:
 wxFileSystem::AddHandler(new wxArchiveFSHandler);
 @endcode
 
+@note XRB files contain the already parsed resources in a compact binary form
+and can be passed to wxXmlResource::Load() directly, just as the XRC files.
+Loading them is faster than loading XRC files, as the XML doesn't need to be
+parsed and the individual resources are only decoded when they are used for
+the first time. The relative paths of the files referenced by the resources
+are interpreted relatively to the location of the XRB file. Notice that the
+format of these files is private to wxWidgets and may change between its
+versions, so they must be regenerated using @c wxrc from the same version of
+wxWidgets as used by the application.
+
 
 @section overview_xrc_embeddedresource Using Embedded Resources
 
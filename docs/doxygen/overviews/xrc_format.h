@@ -1050,6 +1050,9 @@ Example:
 @hdr3col{property, type, description}
 @row3col{imagelist, @ref overview_xrcformat_type_imagelist,
      Image list to use for the images (default: none, built implicitly).}
+@row3col{deferred, @ref overview_xrcformat_type_bool,
+     Create the pages contents on demand, see @ref xrc_wxnotebook
+     "wxNotebook" (default: 0). @since 3.3.2}
 @endTable
 
 Additionally, a choicebook can have one or more child objects of the @c
@@ -1082,6 +1085,10 @@ Each @c choicebookpage has exactly one non-toplevel window as its child.
      Label to use for the collapsible section (default: empty).}
 @row3col{collapsed, @ref overview_xrcformat_type_bool,
      Should the pane be collapsed initially (default: 0)?}
+@row3col{deferred, @ref overview_xrcformat_type_bool,
+     If the pane is initially collapsed, create its contents only when it is
+     expanded for the first time, see wxXmlResource::CreateDeferredContents()
+     (default: 0). @since 3.3.2}
 @endTable
 
 wxCollapsiblePane may contain single optional child object of the @c panewindow
@@ -1467,6 +1474,9 @@ Example:
 @hdr3col{property, type, description}
 @row3col{imagelist, @ref overview_xrcformat_type_imagelist,
      Image list to use for the images (default: none, built implicitly).}
+@row3col{deferred, @ref overview_xrcformat_type_bool,
+     Create the pages contents on demand, see @ref xrc_wxnotebook
+     "wxNotebook" (default: 0). @since 3.3.2}
 @endTable
 
 Additionally, a listbook can have one or more child objects of the @c
@@ -1706,6 +1716,9 @@ class.
 @hdr3col{property, type, description}
 @row3col{imagelist, @ref overview_xrcformat_type_imagelist,
      Image list to use for the images (default: none, built implicitly).}
+@row3col{deferred, @ref overview_xrcformat_type_bool,
+     Create the contents of the pages only when they are shown for the
+     first time (default: 0). @since 3.3.2}
 @endTable
 
 A notebook can have one or more child objects of the @c notebookpage
@@ -1730,6 +1743,15 @@ pseudo-class.
 
 Each @c notebookpage has exactly one non-toplevel window as its child.
 
+If @c deferred is used, the window of each page is still created immediately,
+but its children are only created when the page is shown for the first time,
+except for the first and the selected pages, whose contents is created
+immediately. This can make creating a dialog with many complex pages much
+faster, but notice that the controls on the other pages can't be accessed
+before the page is shown, unless wxXmlResource::CreateDeferredContents() is
+called, and that their size is not taken into account when computing the
+notebook size, so it may need to be specified explicitly.
+
 Example:
 @code
 <object class="wxNotebook">
@@ -2237,6 +2259,9 @@ have the following properties:
 As with all the other book page elements, each @c simplebookpage must have
 exactly one non-toplevel window as its child.
 
+wxSimplebook also supports @c deferred boolean property with the same meaning
+as for @ref xrc_wxnotebook "wxNotebook" since wxWidgets 3.3.2.
+
 @since 3.0.2
 
 
@@ -2571,6 +2596,9 @@ Example:
 @hdr3col{property, type, description}
 @row3col{imagelist, @ref overview_xrcformat_type_imagelist,
      Image list to use for the images (default: none, built implicitly).}
+@row3col{deferred, @ref overview_xrcformat_type_bool,
+     Create the pages contents on demand, see @ref xrc_wxnotebook
+     "wxNotebook" (default: 0). @since 3.3.2}
 @endTable
 
 A toolbook can have one or more child objects of the @c toolbookpage
@@ -2612,6 +2640,9 @@ Each @c toolbookpage has exactly one non-toplevel window as its child.
 @hdr3col{property, type, description}
 @row3col{imagelist, @ref overview_xrcformat_type_imagelist,
      Image list to use for the images (default: none, built implicitly).}
+@row3col{deferred, @ref overview_xrcformat_type_bool,
+     Create the pages contents on demand, see @ref xrc_wxnotebook
+     "wxNotebook" (default: 0). @since 3.3.2}
 @endTable
 
 A treebook can have one or more child objects of the @c treebookpage
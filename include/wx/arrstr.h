@@ -60,6 +60,34 @@ inline int wxCMPFUNC_CONV wxNaturalStringSortDescending(const wxString& s1, cons
     return wxCmpNatural(s2, s1);
 }
 
+// Flags for wxGetStringSortKey() and wxArrayString::SortByKey().
+enum
+{
+    // Compare strings in the same way as wxString::Cmp() does.
+    wxSTRING_SORT_DEFAULT   = 0x0000,
+
+    // Compare strings case-insensitively, as wxString::CmpNoCase() does.
+    wxSTRING_SORT_NOCASE    = 0x0001,
+
+    // Use the current locale collation order, as wxStrcoll() does.
+    wxSTRING_SORT_LOCALE    = 0x0002,
+
+    // Use natural sort order, as wxCmpNaturalGeneric() does.
+    wxSTRING_SORT_NATURAL   = 0x0004,
+
+    // These flags are only used by wxArrayString::SortByKey() and are
+    // ignored by wxGetStringSortKey().
+    wxSTRING_SORT_REVERSE   = 0x0100,
+    wxSTRING_SORT_PARALLEL  = 0x0200
+};
+
+// Return the binary key which can be compared with other keys returned by
+// this function using the same flags (using std::string comparison operators
+// or memcmp()) to get the same result as comparing the strings themselves.
+WXDLLIMPEXP_BASE
+std::string wxGetStringSortKey(const wxString& str,
+                               int flags = wxSTRING_SORT_DEFAULT);
+
 
 #if wxUSE_STD_CONTAINERS
 
@@ -89,6 +117,9 @@ public:
     void Sort(CompareFunction function);
     void Sort(CMPFUNCwxString function) { wxBaseArray<wxString>::Sort(function); }
 
+    // Sort using the keys returned by wxGetStringSortKey().
+    void SortByKey(int flags = wxSTRING_SORT_DEFAULT);
+
     size_t Add(const wxString& string, size_t copies = 1)
     {
         wxBaseArray<wxString>::Add(string, copies);
@@ -269,6 +300,9 @@ public:
     // sort array elements using specified comparison function
   void Sort(CompareFunction compareFunction);
   void Sort(CompareFunction2 compareFunction);
+    // sort array elements using the keys returned by wxGetStringSortKey(),
+    // which is much faster than using a comparison function for big arrays
+  void SortByKey(int flags = wxSTRING_SORT_DEFAULT);
 
   // comparison
     // compare two arrays case sensitively
@@ -1559,6 +1559,71 @@ private:
 
 using wxDateTimeArray = wxBaseArray<wxDateTime>;
 
+// ----------------------------------------------------------------------------
+// wxDateTimeFormatter: a format string analysed once and then used for
+// formatting or parsing many dates, typically in a loop.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxDateTimeFormatter
+{
+public:
+    enum
+    {
+        // Use the default (localized) weekday and month names.
+        Flag_Default = 0,
+
+        // Always use English weekday and month names for "%a", "%A", "%b"
+        // and "%B", as required by RFC 822 and similar formats.
+        Flag_EnglishNames = 1
+    };
+
+    explicit wxDateTimeFormatter(const wxString& format,
+                                 int flags = Flag_Default);
+
+    const wxString& GetFormat() const { return m_format; }
+
+    // Return the date formatted as wxDateTime::Format() would do it, except
+    // for the names when Flag_EnglishNames is used.
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    // Parse the date, storing the result in the provided pointer which must
+    // be non-null. If end is non-null, it's filled with the iterator pointing
+    // after the parsed part of the string, otherwise the whole string must be
+    // parsed for this function to succeed.
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               wxString::const_iterator* end = nullptr) const;
+
+private:
+    // One element of the compiled format.
+    struct Element
+    {
+        // Format specifier character handled by this class itself, 0 for a
+        // literal text or '%' for a specifier which we don't handle and which
+        // is passed to wxDateTime::Format() as is.
+        wxChar spec;
+
+        // Literal text or the full format specification (i.e. including the
+        // leading "%") for the elements which we don't handle ourselves.
+        wxString text;
+    };
+
+    // Try to parse the date without using wxDateTime::ParseFormat(), return
+    // false if it's not possible.
+    bool DoParseFast(const wxString& date,
+                     wxDateTime* dt,
+                     wxString::const_iterator* end) const;
+
+    const wxString m_format;
+    const int m_flags;
+
+    std::vector<Element> m_elements;
+
+    // True if DoParseFast() can be used for this format at all.
+    bool m_canParseFast;
+};
+
 // ----------------------------------------------------------------------------
 // wxDateTimeHolidayAuthority: an object of this class will decide whether a
 // given date is a holiday and is used by all functions working with "work
@@ -38,6 +38,11 @@ public:
     // called when there is exception on descriptor
     virtual void OnExceptionWaiting() = 0;
 
+    // return true if OnReadWaiting() and OnWriteWaiting() always read or
+    // write everything possible, i.e. until getting EAGAIN, allowing to use
+    // edge-triggered notifications for this handler where supported
+    virtual bool DrainsFully() const { return false; }
+
     // virtual dtor for the base class
     virtual ~wxEventLoopSourceHandler() = default;
 };
@@ -19,6 +19,8 @@
 #include "wx/window.h"
 #include "wx/brush.h"
 
+#include <vector>
+
 
 class WXDLLIMPEXP_FWD_HTML wxHtmlWindowInterface;
 class WXDLLIMPEXP_FWD_HTML wxHtmlLinkInfo;
@@ -450,6 +452,7 @@ class WXDLLIMPEXP_HTML wxHtmlWordCell : public wxHtmlCell
 {
 public:
     wxHtmlWordCell(const wxString& word, const wxDC& dc);
+    wxHtmlWordCell(const wxString& word, int width, int height, int descent);
     void Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
               wxHtmlRenderingInfo& info) override;
     virtual wxCursor GetMouseCursor(wxHtmlWindowInterface *window) const override;
@@ -633,6 +636,40 @@ protected:
 private:
     void InitParent(wxHtmlContainerCell *parent);
 
+    // Build the index of the children positions, called at the end of
+    // Layout(), or reset it.
+    void BuildChildrenIndex();
+    void ClearChildrenIndex();
+
+    // Get the range of m_childrenIndex elements which may intersect the band
+    // between y1 and y2 (inclusive) in this cell coordinates.
+    void GetChildrenInBand(int y1, int y2, size_t *first, size_t *last) const;
+
+    // Implementation of FindCellByPos() used when the index is available.
+    wxHtmlCell *FindCellByPosIndexed(wxCoord x, wxCoord y, unsigned flags) const;
+
+    // Index of the children allowing to quickly find the ones in the given
+    // vertical band, used for drawing and hit testing if it's not empty. It's
+    // only built for the containers with many children as just iterating over
+    // them is fast enough otherwise.
+    struct ChildIndexEntry
+    {
+        wxHtmlCell *cell;
+
+        // Maximal bottom coordinate of this and all preceding children and
+        // minimal top coordinate of this and all following children: both are
+        // monotonic and so can be used for binary search, even if the children
+        // are not sorted by their positions, as happens with floating cells.
+        int maxBottom,
+            minTop;
+    };
+    std::vector<ChildIndexEntry> m_childrenIndex;
+
+    // Indices of the children which are not words: unlike the words, these
+    // cells may change the DC state in their DrawInvisible() and so must
+    // still be processed even when they're outside of the area being drawn.
+    std::vector<size_t> m_nonWordChildren;
+
     wxDECLARE_ABSTRACT_CLASS(wxHtmlContainerCell);
     wxDECLARE_NO_COPY_CLASS(wxHtmlContainerCell);
 };
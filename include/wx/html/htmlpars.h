@@ -69,6 +69,11 @@ public:
     // 4. call DoneParser();
     wxObject* Parse(const wxString& source);
 
+    // Does the same thing as Parse() but appends the source to the one
+    // returned by GetSource() instead of replacing it. Notice that the
+    // returned product only corresponds to the given fragment.
+    wxObject* ParseFragment(const wxString& fragment);
+
     // Sets the source. This must be called before running Parse() method.
     virtual void InitParser(const wxString& source);
     // This must be called after Parse().
@@ -267,6 +267,11 @@ public:
     // Append to current page
     bool AppendToPage(const wxString& source);
 
+    // Append a block to current page without parsing the existing contents
+    // again: this is much faster, but the block is always started on a new
+    // line and can't use unclosed tags of the existing page
+    bool AppendBlockToPage(const wxString& source);
+
     // Load HTML page from given location. Location can be either
     // a) /usr/wxGTK2/docs/html/wx.htm
     // b) http://www.somewhere.uk/document.htm
@@ -468,6 +473,9 @@ public:
     // implementation of SetPage()
     bool DoSetPage(const wxString& source);
 
+    // pass the source through all the registered processors
+    wxString ApplyProcessors(const wxString& source) const;
+
 protected:
     // This is pointer to the first cell in parsed data.  (Note: the first cell
     // is usually top one = all other cells are sub-cells of this one)
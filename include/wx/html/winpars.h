@@ -18,6 +18,8 @@
 #include "wx/html/htmlcell.h"
 #include "wx/encconv.h"
 
+#include <unordered_map>
+
 class WXDLLIMPEXP_FWD_HTML wxHtmlWindow;
 class WXDLLIMPEXP_FWD_HTML wxHtmlWindowInterface;
 class WXDLLIMPEXP_FWD_HTML wxHtmlWinParser;
@@ -160,8 +162,7 @@ protected:
 
 private:
     void AddWord(wxHtmlWordCell *word);
-    void AddWord(const wxString& word)
-        { AddWord(new wxHtmlWordCell(word, *(GetDC()))); }
+    void AddWord(const wxString& word);
     void AddPreBlock(const wxString& text);
 
     bool m_tmpLastWasSpace;
@@ -211,6 +212,24 @@ private:
     wxString m_FontFaceFixed, m_FontFaceNormal;
             // html font sizes and faces of fixed and proportional fonts
 
+    // extents of the words already measured using the fonts from
+    // m_FontsTable, which are kept for as long as the fonts themselves, i.e.
+    // are reused when parsing the next page too
+    struct WordExtent
+    {
+        int width, height, descent;
+    };
+    using WordExtents = std::unordered_map<wxString, WordExtent>;
+    std::unordered_map<const wxFont*, WordExtents> m_wordExtents;
+
+    // the font from m_FontsTable selected into m_DC by CreateCurrentFont()
+    const wxFont* m_currentFont;
+
+    // parameters of the DC used for measuring the words in m_wordExtents,
+    // the cache is discarded when a DC with different parameters is used
+    wxSize m_extentsPPI;
+    double m_extentsScaleX, m_extentsScaleY, m_extentsContentScale;
+
     // current whitespace handling mode
     WhitespaceMode m_whitespaceMode;
 
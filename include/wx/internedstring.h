@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/internedstring.h
+// Purpose:     wxInternedString class declaration
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_INTERNEDSTRING_H_
+#define _WX_INTERNEDSTRING_H_
+
+#include "wx/string.h"
+
+// ----------------------------------------------------------------------------
+// wxInternedString: handle to a unique, immutable string stored in a global
+// table, also known as "atom" or "symbol".
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxInternedString
+{
+public:
+    // Default ctor creates an object corresponding to the empty string.
+    wxInternedString() : m_entry(GetEmptyEntry()) { }
+
+    // Find the given string in the global table, adding it there if it's not
+    // present yet.
+    explicit wxInternedString(const wxString& str) : m_entry(Intern(str)) { }
+
+    // Default copy ctor and assignment operator are fine, they only copy the
+    // pointer to the table entry.
+
+    const wxString& GetString() const { return m_entry->first; }
+    operator const wxString&() const { return GetString(); }
+
+    bool empty() const { return GetString().empty(); }
+
+    // Return the hash of the string, computed only once, when the string was
+    // added to the table.
+    size_t GetHash() const { return m_entry->second; }
+
+    // Comparison only needs to compare the pointers, as there can be only a
+    // single entry for the given string.
+    bool operator==(const wxInternedString& other) const
+        { return m_entry == other.m_entry; }
+    bool operator!=(const wxInternedString& other) const
+        { return m_entry != other.m_entry; }
+
+    // Comparison with the normal strings compares the string contents.
+    bool operator==(const wxString& str) const { return GetString() == str; }
+    bool operator!=(const wxString& str) const { return GetString() != str; }
+
+    // Return the number of distinct strings in the global table.
+    static size_t GetCount();
+
+private:
+    // Entry of the global table containing the string and its hash. The
+    // entries are never destroyed, so pointers to them remain valid for the
+    // entire program lifetime.
+    typedef std::pair<const wxString, size_t> Entry;
+
+    static const Entry* Intern(const wxString& str);
+    static const Entry* GetEmptyEntry();
+
+    const Entry* m_entry;
+};
+
+inline bool operator==(const wxString& str, const wxInternedString& interned)
+    { return interned == str; }
+inline bool operator!=(const wxString& str, const wxInternedString& interned)
+    { return interned != str; }
+
+// Allow using wxInternedString as key in std::unordered_map without
+// recomputing the hash of the string.
+namespace std
+{
+    template<>
+    struct hash<wxInternedString>
+    {
+        size_t operator()(const wxInternedString& s) const
+        {
+            return s.GetHash();
+        }
+    };
+} // namespace std
+
+#endif // _WX_INTERNEDSTRING_H_
@@ -28,6 +28,7 @@ public:
     virtual void OnReadWaiting() override { m_handler->OnReadWaiting(); }
     virtual void OnWriteWaiting() override { m_handler->OnWriteWaiting(); }
     virtual void OnExceptionWaiting() override { m_handler->OnExceptionWaiting(); }
+    virtual bool DrainsFully() const override { return m_handler->DrainsFully(); }
 
 protected:
     wxEventLoopSourceHandler* const m_handler;
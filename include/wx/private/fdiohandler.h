@@ -32,6 +32,12 @@ public:
     // wxSocketImplUnix currently
     virtual bool IsOk() const { return true; }
 
+    // should return true if OnReadWaiting() and OnWriteWaiting() always
+    // consume all the available input or fill all the available output space,
+    // i.e. read or write until getting EAGAIN, which allows the dispatchers
+    // supporting it to use edge-triggered notifications for this handler
+    virtual bool DrainsFully() const { return false; }
+
 
     // get/set the mask of events for which we're currently registered for:
     // it's a combination of wxFDIO_{INPUT,OUTPUT,EXCEPTION}
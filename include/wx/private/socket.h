@@ -166,6 +166,13 @@ private:
     static wxSocketManager *ms_manager;
 };
 
+// Buffer used with the scatter/gather IO functions.
+struct wxSocketIOBuffer
+{
+    void *data;
+    size_t size;
+};
+
 /*
     Base class for all socket implementations providing functionality common to
     BSD and Winsock sockets.
@@ -182,6 +189,7 @@ public:
     // creating the socket
     void SetTimeout(unsigned long millisec);
     void SetReusable() { m_reusable = true; }
+    void SetReusePort() { m_reusePort = true; }
     void SetBroadcast() { m_broadcast = true; }
     void DontDoBind() { m_dobind = false; }
     void SetInitialSocketBuffers(int recv, int send)
@@ -252,6 +260,17 @@ public:
     int Read(void *buffer, int size);
     int Write(const void *buffer, int size);
 
+    // scatter/gather IO: read or write data from or to several buffers at
+    // once (for UDP sockets, only the first buffer is used at once, to
+    // preserve the datagram boundaries)
+    //
+    // return the total number of bytes read/written or -1 on error, notice
+    // that it may be less than the total size of all buffers even if it's not
+    // 0 and that all buffers are not necessarily used at once (although they
+    // are when the platform supports it)
+    int ReadV(const wxSocketIOBuffer *bufs, int count);
+    int WriteV(const wxSocketIOBuffer *bufs, int count);
+
     // basically a wrapper for select(): returns the condition of the socket,
     // blocking for not longer than timeout if it is specified (otherwise just
     // poll without blocking at all)
@@ -273,6 +292,11 @@ public:
     // no pending connections as our sockets are non-blocking)
     wxSocketImpl *Accept(wxSocketBase& wxsocket);
 
+    // same as Accept() but doesn't reenable the notifications about the new
+    // connections, ReenableEvents(wxSOCKET_INPUT_FLAG) must be called after
+    // calling this function as many times as needed
+    wxSocketImpl *DoAccept(wxSocketBase& wxsocket);
+
 
     // notifications
     // -------------
@@ -307,6 +331,7 @@ public:
     bool m_stream;
     bool m_establishing;
     bool m_reusable;
+    bool m_reusePort;
     bool m_broadcast;
     bool m_dobind;
 
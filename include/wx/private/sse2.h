@@ -0,0 +1,25 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/sse2.h
+// Purpose:     Check whether SSE2 intrinsics can be used
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_SSE2_H_
+#define _WX_PRIVATE_SSE2_H_
+
+// Define wxHAS_SSE2 and include the header declaring the SSE2 intrinsics if
+// they can be used unconditionally.
+//
+// SSE2 is part of the base x86-64 instruction set and is also available when
+// the compiler is explicitly told that it can use it for 32-bit x86 code, so
+// in these cases the code using it doesn't need to check for its availability
+// at run-time. We don't use SSE2 in the other builds at all, as run-time CPU
+// detection would cost more than it saves for the short loops using it.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define wxHAS_SSE2
+    #include <emmintrin.h>
+#endif
+
+#endif // _WX_PRIVATE_SSE2_H_
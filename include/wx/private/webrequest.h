@@ -11,11 +11,13 @@
 #define _WX_PRIVATE_WEBREQUEST_H_
 
 #include "wx/ffile.h"
+#include "wx/thread.h"
 
 #include "wx/private/refcountermt.h"
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 class WXDLLIMPEXP_FWD_BASE wxURI;
 
@@ -74,6 +76,10 @@ public:
 
     wxWebRequest::Storage GetStorage() const { return m_storage; }
 
+    void SetDataSink(wxWebRequestSink* sink) { m_dataSink = sink; }
+
+    wxWebRequestSink* GetDataSink() const { return m_dataSink; }
+
     // This method is called to execute the request in a synchronous way.
     virtual Result Execute() = 0;
 
@@ -88,6 +94,14 @@ public:
     // cancelled.
     void Cancel();
 
+    // This method is called to resume receiving the data after the sink
+    // returned wxWebRequestSink::Action_Pause.
+    //
+    // The default implementation passes the data accumulated by the response
+    // since then to the sink, but the backends should override it to really
+    // pause the transfer if possible.
+    virtual void Resume();
+
     virtual void SetTimeouts(long connectionTimeoutMs, long dataTimeoutMs) = 0;
 
     virtual wxWebResponseImplPtr GetResponse() const = 0;
@@ -127,6 +141,7 @@ public:
 protected:
     wxString m_method;
     wxWebRequest::Storage m_storage = wxWebRequest::Storage_Memory;
+    wxWebRequestSink* m_dataSink = nullptr;
     wxWebRequestHeaderMap m_headers;
     wxFileOffset m_dataSize = 0;
     std::unique_ptr<wxInputStream> m_dataStream;
@@ -252,6 +267,10 @@ public:
 
     void ReportDataReceived(size_t sizeReceived);
 
+    // Pass the data accumulated by ReportDataReceived() while the sink was
+    // paused to it.
+    void ResumeSink();
+
 protected:
     wxWebRequestImpl& m_request;
 
@@ -263,15 +282,51 @@ protected:
     // if the total amount of data to be downloaded is known in advance.
     void PreAllocBuffer(size_t sizeNeeded);
 
+    enum class DataResult
+    {
+        Consumed,   // All data was processed.
+        Paused,     // Nothing was processed, pass the same data again later.
+        Failed      // Storing data failed, the request should be aborted.
+    };
+
+    // This function can be used instead of GetDataBuffer() and
+    // ReportDataReceived() by the backends which receive the data into their
+    // own buffer, as it avoids copying it when possible.
+    DataResult HandleData(const void* data, size_t size);
+
 private:
-    // Called by wxWebRequestImpl only.
+    // Called by wxWebRequestImpl and wxWebRequestSync only.
     friend class wxWebRequestImpl;
+    friend class wxWebRequestSync;
     void Finalize();
 
+    // Pass the contents of m_readBuffer to the sink.
+    void FlushToSink();
+
+    // Used to return our buffer to the session for reusing it: notice that
+    // this also ensures that the session outlives us.
+    wxWebSessionImplPtr m_sessionImpl;
+
     wxMemoryBuffer m_readBuffer;
     mutable wxFFile m_file;
     mutable std::unique_ptr<wxInputStream> m_stream;
 
+    // With the backends receiving the data in a worker thread, the members
+    // below and m_readBuffer, when using a sink, are accessed from both it and
+    // the main thread calling Resume(), so this critical section protects them.
+    wxCriticalSection m_sinkCS;
+
+    // True if the sink returned Action_Pause and Resume() wasn't called yet.
+    bool m_sinkPaused = false;
+
+    // True between GetDataBuffer() and ReportDataReceived() calls, when the
+    // backend is writing to m_readBuffer and it must not be modified.
+    bool m_sinkAppending = false;
+
+    // True if m_readBuffer was obtained from the session and must be given
+    // back to it when we're destroyed.
+    bool m_reuseBuffer;
+
     wxDECLARE_NO_COPY_CLASS(wxWebResponseImpl);
 };
 
@@ -344,6 +399,19 @@ public:
 
     virtual bool EnablePersistentStorage(bool WXUNUSED(enable)) { return false; }
 
+    virtual bool SetMaxConnectionsPerHost(int WXUNUSED(maxConnections))
+        { return false; }
+
+    virtual wxWebSessionStats GetStats() const { return wxWebSessionStats(); }
+
+    // Return a buffer for storing the response data in memory, reusing one
+    // of the buffers released by the previous responses if possible.
+    wxMemoryBuffer GetResponseBuffer();
+
+    // Give the buffer which is not used any more to the session, to allow
+    // reusing it for another response.
+    void ReleaseResponseBuffer(wxMemoryBuffer& buffer);
+
 protected:
     explicit wxWebSessionImpl(Mode mode);
 
@@ -360,6 +428,11 @@ private:
     wxString m_tempDir;
     wxWebProxy m_proxy{wxWebProxy::Default()};
 
+    // Buffers released by the responses, protected by the critical section
+    // as responses can be destroyed in any thread.
+    std::vector<wxMemoryBuffer> m_freeBuffers;
+    wxCriticalSection m_freeBuffersCS;
+
 
     wxDECLARE_NO_COPY_CLASS(wxWebSessionImpl);
 };
@@ -46,7 +46,8 @@ private:
 class wxWebRequestCURL : public wxWebRequestImpl
 {
 public:
-    // Ctor for async requests: creates a new libcurl handle and owns it.
+    // Ctor for async requests: gets a libcurl handle from the session and
+    // returns it to it when destroyed.
     wxWebRequestCURL(wxWebSession& session,
                      wxWebSessionCURL& sessionImpl,
                      wxEvtHandler* handler,
@@ -64,6 +65,8 @@ public:
 
     void Start() override;
 
+    void Resume() override;
+
     void SetTimeouts(long connectionTimeoutMs, long dataTimeoutMs) override;
 
     wxWebResponseImplPtr GetResponse() const override
@@ -171,12 +174,32 @@ public:
 
     wxVersionInfo GetLibraryVersionInfo() const override;
 
+    wxWebSessionStats GetStats() const override { return m_stats; }
+
+    // Update the statistics after successfully completing a transfer using
+    // the given handle.
+    void UpdateStats(CURL* handle);
+
     static bool CurlRuntimeAtLeastVersion(unsigned int, unsigned int,
                                           unsigned int);
 
 protected:
+    // Return a handle configured with the options common to all requests:
+    // either a new one, if the argument is null, or the provided one, which
+    // must have been reset by the caller.
+    //
+    // May return null if creating a new handle failed.
+    CURL* PrepareHandle(CURL* handle);
+
+    wxWebSessionStats m_stats;
+
     static int ms_activeSessions;
     static unsigned int ms_runtimeVersion;
+
+    // Share handle used by all sessions for caching DNS lookups and TLS
+    // sessions, may be null if creating it failed.
+    static CURLSH* ms_share;
+    static wxCriticalSection* ms_shareLocks;
 };
 
 // Sync session implementation uses libcurl "easy" API.
@@ -207,6 +230,11 @@ public:
 
     CURL* GetHandle() const { return m_handle; }
 
+    // There is only a single connection used by this session at any time,
+    // so any limit is trivially respected.
+    bool SetMaxConnectionsPerHost(int WXUNUSED(maxConnections)) override
+        { return true; }
+
 private:
     CURL* m_handle = nullptr;
 
@@ -241,6 +269,16 @@ public:
         return (wxWebSessionHandle)m_handle;
     }
 
+    bool SetMaxConnectionsPerHost(int maxConnections) override;
+
+    // Return a handle to use for a new request, reusing a previously released
+    // one if possible.
+    CURL* AcquireHandle();
+
+    // Give the handle which is not used by the request any more back to the
+    // session.
+    void ReleaseHandle(CURL* handle);
+
     bool StartRequest(wxWebRequestCURL& request);
 
     void CancelRequest(wxWebRequestCURL* request);
@@ -271,6 +309,12 @@ private:
     wxTimer m_timeoutTimer;
     CURLM* m_handle = nullptr;
 
+    // Handles of the previously finished requests kept for reusing them.
+    std::vector<CURL*> m_freeHandles;
+
+    // Maximal number of connections to the same host or 0 if unlimited.
+    long m_maxConnectionsPerHost = 0;
+
     wxDECLARE_NO_COPY_CLASS(wxWebSessionCURL);
 };
 
@@ -12,6 +12,7 @@
 #define _WX_PROCESSH__
 
 #include "wx/event.h"
+#include "wx/buffer.h"
 
 #if wxUSE_STREAMS
     #include "wx/stream.h"
@@ -73,6 +74,33 @@ public:
     void Redirect() { m_redirect = true; }
     bool IsRedirected() const { return m_redirect; }
 
+    // call this before passing the object to wxExecute() to get the output
+    // of the redirected process in wxEVT_PROCESS_OUTPUT events instead of
+    // having to read it from the streams returned by GetInputStream() and
+    // GetErrorStream(), which are not available in this case
+    //
+    // currently only implemented for asynchronous execution under Unix
+    void EnableOutputEvents(bool enable = true) { m_outputEvents = enable; }
+    bool AreOutputEventsEnabled() const { return m_outputEvents; }
+
+    // call this before passing the object to wxExecute() to redirect the
+    // launched process stdout and, if errFile is non-empty, stderr, to the
+    // given files, which are created or truncated if they already exist
+    //
+    // errFile may be the same as outFile to redirect both streams to the
+    // same file
+    //
+    // currently only implemented under Unix
+    void RedirectToFiles(const wxString& outFile,
+                         const wxString& errFile = wxString())
+    {
+        m_outputFile = outFile;
+        m_errorFile = errFile;
+    }
+
+    const wxString& GetOutputFile() const { return m_outputFile; }
+    const wxString& GetErrorFile() const { return m_errorFile; }
+
     // detach from the parent - should be called by the parent if it's deleted
     // before the process it started terminates
     void Detach();
@@ -124,6 +152,10 @@ public:
     // needs to be public since it needs to be used from wxExecute() global func
     void SetPid(long pid) { m_pid = pid; }
 
+    // generate wxEVT_PROCESS_OUTPUT event with the given data read from the
+    // child stdout or stderr
+    void SendOutputEvent(bool isError, const wxMemoryBuffer& data);
+
 protected:
     void Init(wxEvtHandler *parent, int id, int flags);
 
@@ -142,6 +174,10 @@ protected:
 #endif // wxUSE_STREAMS
 
     bool m_redirect;
+    bool m_outputEvents;
+
+    wxString m_outputFile,
+             m_errorFile;
 
     wxDECLARE_DYNAMIC_CLASS(wxProcess);
     wxDECLARE_NO_COPY_CLASS(wxProcess);
@@ -190,4 +226,62 @@ typedef void (wxEvtHandler::*wxProcessEventFunction)(wxProcessEvent&);
 #define EVT_END_PROCESS(id, func) \
    wx__DECLARE_EVT1(wxEVT_END_PROCESS, id, wxProcessEventHandler(func))
 
+// ----------------------------------------------------------------------------
+// wxProcessOutputEvent: generated when new output of the child is available
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_FWD_BASE wxProcessOutputEvent;
+
+wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_BASE, wxEVT_PROCESS_OUTPUT, wxProcessOutputEvent );
+
+class WXDLLIMPEXP_BASE wxProcessOutputEvent : public wxEvent
+{
+public:
+    wxProcessOutputEvent(int nId = 0,
+                         int pid = 0,
+                         bool isError = false,
+                         const wxMemoryBuffer& data = wxMemoryBuffer())
+        : wxEvent(nId, wxEVT_PROCESS_OUTPUT),
+          m_pid(pid),
+          m_isError(isError),
+          m_data(data)
+    {
+    }
+
+    // PID of the process which produced the output
+    int GetPid() const { return m_pid; }
+
+    // true if the output comes from the child stderr and not stdout
+    bool IsError() const { return m_isError; }
+
+    // the data itself: notice that it doesn't need to be copied, as
+    // wxMemoryBuffer is reference-counted
+    const wxMemoryBuffer& GetBuffer() const { return m_data; }
+    const void* GetData() const { return m_data.GetData(); }
+    size_t GetDataLen() const { return m_data.GetDataLen(); }
+
+    // convenient accessor interpreting the data as text in the given encoding
+    wxString GetText(const wxMBConv& conv = wxConvUTF8) const
+    {
+        return wxString(static_cast<const char*>(GetData()), conv, GetDataLen());
+    }
+
+    wxNODISCARD virtual wxEvent *Clone() const override { return new wxProcessOutputEvent(*this); }
+
+private:
+    int m_pid;
+    bool m_isError;
+    wxMemoryBuffer m_data;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_ASSIGN_DEF_COPY(wxProcessOutputEvent);
+};
+
+typedef void (wxEvtHandler::*wxProcessOutputEventFunction)(wxProcessOutputEvent&);
+
+#define wxProcessOutputEventHandler(func) \
+    wxEVENT_HANDLER_CAST(wxProcessOutputEventFunction, func)
+
+#define EVT_PROCESS_OUTPUT(id, func) \
+   wx__DECLARE_EVT1(wxEVT_PROCESS_OUTPUT, id, wxProcessOutputEventHandler(func))
+
 #endif // _WX_PROCESSH__
@@ -70,6 +70,8 @@
 #include "wx/dataobj.h"
 #endif
 
+#include <vector>
+
 // Compatibility
 //#define wxRichTextAttr wxTextAttr
 #define wxTextAttrEx wxTextAttr
@@ -159,6 +161,11 @@ class WXDLLIMPEXP_FWD_BASE wxDataOutputStream;
 // the rect passed to Layout.
 #define wxRICHTEXT_LAYOUT_SPECIFIED_RECT 0x10
 
+// Used together with wxRICHTEXT_LAYOUT_SPECIFIED_RECT: only estimate
+// the size of the paragraphs below the rect which haven't been laid
+// out yet instead of laying them out.
+#define wxRICHTEXT_LAYOUT_ESTIMATE  0x20
+
 /**
     Flags to pass to Draw
  */
@@ -3198,6 +3205,12 @@ public:
     */
     bool RemoveChild(wxRichTextObject* child, bool deleteChild = false) ;
 
+    /**
+        Replaces the specified child with another object, optionally deleting
+        the old child.
+    */
+    bool ReplaceChild(wxRichTextObject* oldChild, wxRichTextObject* newChild, bool deleteOldChild = false);
+
     /**
         Deletes all the children.
     */
@@ -3214,6 +3227,11 @@ public:
     virtual void Move(const wxPoint& pt) override;
 
 protected:
+    // Called after adding, removing or replacing children using the functions
+    // of this class. Code modifying m_children of wxRichTextParagraphLayoutBox,
+    // which keeps an index of its children, directly must call it too.
+    virtual void OnChildrenChanged() { }
+
     wxRichTextObjectList    m_children;
 };
 
@@ -3398,6 +3416,16 @@ public:
     */
     virtual wxRichTextLine* GetLineAtYPosition(int y) const;
 
+    /**
+        Returns the first paragraph which hasn't been laid out yet, i.e. has no
+        lines, and is not above the given y pixel position, or @NULL if there
+        are none.
+
+        Such paragraphs only have an estimated size after laying out the
+        buffer using @c wxRICHTEXT_LAYOUT_ESTIMATE flag.
+    */
+    wxRichTextParagraph* GetFirstEstimatedParagraph(int y = 0) const;
+
     /**
         Returns the paragraph at the given character or caret position.
     */
@@ -3809,6 +3837,33 @@ public:
     bool GetFloatingObjects(wxRichTextObjectList& objects) const;
 
 protected:
+    virtual void OnChildrenChanged() override
+    {
+        m_childrenIndex.clear();
+        m_childrenIndexValid = false;
+    }
+
+    // Returns the children in a vector, allowing to use binary search to find
+    // them by position, rebuilding it if the children have changed.
+    const std::vector<wxRichTextObject*>& GetChildrenIndex() const;
+
+    // Finds the index of the child containing the given position using binary
+    // search or sets n to the number of children if there is none. Returns
+    // false if this can't be done because the ranges are not up to date.
+    bool FindChildAtPosition(long pos, size_t* n) const;
+
+    // Returns the last line of the last paragraph or null if there are none.
+    wxRichTextLine* GetLastLine() const;
+
+    // Returns the index of the first child whose range may change when
+    // modifying the content at the given position, or 0 if it can't be found.
+    // Must be called before modifying the content.
+    size_t GetFirstChildToUpdate(long pos) const;
+
+    // Updates the ranges of the children starting from the given index, the
+    // ranges of the preceding children must be already up to date.
+    void UpdateRangesFrom(size_t n);
+
     wxRichTextCtrl* m_ctrl;
     wxRichTextAttr  m_defaultAttributes;
 
@@ -3820,6 +3875,12 @@ protected:
 
     // The floating layout state
     wxRichTextFloatCollector* m_floatCollector;
+
+    // The cached children, see GetChildrenIndex().
+    mutable std::vector<wxRichTextObject*> m_childrenIndex;
+    mutable bool m_childrenIndexValid;
+
+    friend class wxRichTextAction;
 };
 
 /**
@@ -5298,6 +5359,31 @@ public:
     */
     virtual wxRichTextCommand* GetBatchedCommand() const { return m_batchedCommand; }
 
+    /**
+        Sets the maximum amount of memory, in bytes, used by the undo history.
+        When it is exceeded, the oldest commands are discarded. The default
+        value of 0 means that the memory used is not limited.
+    */
+    void SetUndoMemoryLimit(size_t limit) { m_undoMemoryLimit = limit; LimitUndoMemory(); }
+
+    /**
+        Returns the maximum amount of memory used by the undo history.
+    */
+    size_t GetUndoMemoryLimit() const { return m_undoMemoryLimit; }
+
+    /**
+        Sets whether the consecutive characters typed by the user are merged
+        into a single command, undone at once, until the start of the next word.
+        This is off by default.
+    */
+    void SetMergeTypingUndo(bool merge) { m_mergeTypingUndo = merge; }
+
+    /**
+        Returns @true if the consecutive characters typed by the user are
+        merged into a single command.
+    */
+    bool GetMergeTypingUndo() const { return m_mergeTypingUndo; }
+
     /**
         Begin suppressing undo/redo commands. The way undo is suppressed may be implemented
         differently by each command. If not dealt with by a command implementation, then
@@ -5853,6 +5939,12 @@ public:
 
 protected:
 
+    /// Discards the oldest commands if the undo history uses too much memory
+    void LimitUndoMemory();
+
+    /// Merges the command with the current one if both insert typed text
+    bool MergeTypingCommand(wxRichTextCommand* cmd);
+
     /// Command processor
     wxCommandProcessor*     m_commandProcessor;
 
@@ -5874,6 +5966,12 @@ protected:
     /// Whether to suppress undo
     int                     m_suppressUndo;
 
+    /// Maximum memory used by the undo history, 0 if unlimited
+    size_t                  m_undoMemoryLimit;
+
+    /// Whether to merge the consecutive typed characters
+    bool                    m_mergeTypingUndo;
+
     /// Style sheet, if any
     wxRichTextStyleSheet*   m_styleSheet;
 
@@ -6379,6 +6477,12 @@ public:
     */
     wxList& GetActions() { return m_actions; }
 
+    /**
+        Returns the approximate amount of memory, in bytes, used by the actions
+        of this command.
+    */
+    size_t GetMemoryUsage() const;
+
     /**
         Indicate whether the control should be frozen when performing Do/Undo
     */
@@ -6438,6 +6542,36 @@ public:
     */
     void ApplyParagraphs(const wxRichTextParagraphLayoutBox& fragment);
 
+    /**
+        Makes this wxRICHTEXT_CHANGE_STYLE action apply the given style to its
+        range when it is done, instead of replacing the paragraphs with the new
+        fragment. Only the attributes of the objects in the range, which are
+        going to be changed, are stored for undoing the action, instead of the
+        copies of the whole paragraphs.
+
+        The range of the action must be set before calling this function.
+    */
+    void SetStyleChange(const wxRichTextAttr& style, int flags);
+
+    /**
+        Returns @true if SetStyleChange() was called for this action.
+    */
+    bool HasStyleChange() const { return m_hasStyleChange; }
+
+    /**
+        Appends the text inserted by the given wxRICHTEXT_INSERT action, which
+        must immediately follow the text inserted by this one, to this action.
+
+        Returns @false, without changing anything, if the actions can't be
+        merged, e.g. because they don't insert plain text within a paragraph.
+    */
+    bool MergeInsertion(const wxRichTextAction& action);
+
+    /**
+        Returns the approximate amount of memory, in bytes, used by this action.
+    */
+    size_t GetMemoryUsage() const;
+
     /**
         Returns the new fragments.
     */
@@ -6553,6 +6687,18 @@ public:
     bool GetIgnoreFirstTime() const { return m_ignoreThis; }
 
 protected:
+    // Restores the attributes stored by SetStyleChange().
+    void RestoreOldStyles();
+
+    // The attributes of a paragraph, or of a run of objects inside it, before
+    // the style change.
+    struct OldStyle
+    {
+        wxRichTextRange range;
+        wxRichTextAttr attr;
+        bool isPara;
+    };
+
     // Action name
     wxString                        m_name;
 
@@ -6597,6 +6743,16 @@ protected:
 
     // The command identifier
     wxRichTextCommandId             m_cmdId;
+
+    // True if m_attributes must be applied with m_styleFlags to m_range
+    bool                            m_hasStyleChange;
+    int                             m_styleFlags;
+
+    // The attributes changed by the style change
+    std::vector<OldStyle>           m_oldStyles;
+
+    // Cached result of GetMemoryUsage(), 0 if not computed yet
+    mutable size_t                  m_memoryUsage;
 };
 
 /*!
@@ -78,6 +78,10 @@ class WXDLLIMPEXP_FWD_RICHTEXT wxRichTextStyleDefinition;
 #define wxRICHTEXT_DEFAULT_DELAYED_LAYOUT_THRESHOLD 20000
 // Milliseconds before layout occurs after resize
 #define wxRICHTEXT_DEFAULT_LAYOUT_INTERVAL 50
+
+// Height of the part of the buffer laid out in idle time during the
+// incremental layout, in multiples of the window height
+#define wxRICHTEXT_INCREMENTAL_LAYOUT_PAGES 4
 // Milliseconds before delayed image processing occurs
 #define wxRICHTEXT_DEFAULT_DELAYED_IMAGE_PROCESSING_INTERVAL 200
 
@@ -345,6 +349,10 @@ public:
     /**
         Sets the size of the buffer beyond which layout is delayed during resizing.
         This optimizes sizing for large buffers. The default is 20000.
+
+        When the entire buffer exceeding this size needs to be laid out, e.g.
+        after loading a file, only its visible part is laid out immediately and
+        the rest of it is laid out incrementally in idle time.
     */
     void SetDelayedLayoutThreshold(long threshold) { m_delayedLayoutThreshold = threshold; }
 
@@ -384,9 +392,17 @@ public:
     */
     void SetFullLayoutSavedPosition(long p) { m_fullLayoutSavedPosition = p; }
 
+    /**
+        Returns true if some parts of the buffer haven't been laid out yet and
+        only have estimated size.
+
+        wxEVT_RICHTEXT_LAYOUT_COMPLETE event is sent when they are laid out.
+    */
+    bool GetIncrementalLayoutRequired() const { return m_incrementalLayoutRequired; }
+
     /**
         Forces any pending layout due to delayed, partial layout when the control
-        was resized.
+        was resized or due to incremental layout of a large buffer.
     */
     void ForceDelayedLayout();
 
@@ -2315,6 +2331,15 @@ protected:
 
     virtual void DoThaw() override;
 
+    // Returns the layout flags to use and possibly changes the rect to lay out
+    // only its visible part, starting incremental layout if necessary.
+    int PrepareLayout(wxRect& rect, bool onlyVisibleRect);
+
+    // Lays out the next part of the buffer during incremental layout and
+    // returns true, or sends wxEVT_RICHTEXT_LAYOUT_COMPLETE and returns false
+    // if everything has been laid out.
+    bool ContinueIncrementalLayout(int height);
+
 
 // Data members
 protected:
@@ -2383,6 +2408,9 @@ protected:
     wxLongLong              m_fullLayoutTime;
     long                    m_fullLayoutSavedPosition;
 
+    /// Are some paragraphs still to be laid out in idle?
+    bool                    m_incrementalLayoutRequired;
+
     /// Threshold for doing delayed layout
     long                    m_delayedLayoutThreshold;
 
@@ -2520,6 +2548,9 @@ protected:
     @event{EVT_RICHTEXT_FOCUS_OBJECT_CHANGED(id, func)}
         Process a @c wxEVT_RICHTEXT_FOCUS_OBJECT_CHANGED event, generated when the
         current focus object has changed.
+    @event{EVT_RICHTEXT_LAYOUT_COMPLETE(id, func)}
+        Process a @c wxEVT_RICHTEXT_LAYOUT_COMPLETE event, generated when the
+        incremental layout of a large buffer has finished.
     @endEventTable
 
     @library{wxrichtext}
@@ -2683,6 +2714,7 @@ wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_RICHTEXT, wxEVT_RICHTEXT_PROPERTIES_CHANGE
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_RICHTEXT, wxEVT_RICHTEXT_SELECTION_CHANGED, wxRichTextEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_RICHTEXT, wxEVT_RICHTEXT_BUFFER_RESET, wxRichTextEvent );
 wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_RICHTEXT, wxEVT_RICHTEXT_FOCUS_OBJECT_CHANGED, wxRichTextEvent );
+wxDECLARE_EXPORTED_EVENT( WXDLLIMPEXP_RICHTEXT, wxEVT_RICHTEXT_LAYOUT_COMPLETE, wxRichTextEvent );
 
 typedef void (wxEvtHandler::*wxRichTextEventFunction)(wxRichTextEvent&);
 
@@ -2710,6 +2742,7 @@ typedef void (wxEvtHandler::*wxRichTextEventFunction)(wxRichTextEvent&);
 #define EVT_RICHTEXT_SELECTION_CHANGED(id, fn) wxDECLARE_EVENT_TABLE_ENTRY( wxEVT_RICHTEXT_SELECTION_CHANGED, id, -1, wxRichTextEventHandler( fn ), nullptr ),
 #define EVT_RICHTEXT_BUFFER_RESET(id, fn) wxDECLARE_EVENT_TABLE_ENTRY( wxEVT_RICHTEXT_BUFFER_RESET, id, -1, wxRichTextEventHandler( fn ), nullptr ),
 #define EVT_RICHTEXT_FOCUS_OBJECT_CHANGED(id, fn) wxDECLARE_EVENT_TABLE_ENTRY( wxEVT_RICHTEXT_FOCUS_OBJECT_CHANGED, id, -1, wxRichTextEventHandler( fn ), nullptr ),
+#define EVT_RICHTEXT_LAYOUT_COMPLETE(id, fn) wxDECLARE_EVENT_TABLE_ENTRY( wxEVT_RICHTEXT_LAYOUT_COMPLETE, id, -1, wxRichTextEventHandler( fn ), nullptr ),
 
 // old wxEVT_COMMAND_* constants
 #define wxEVT_COMMAND_RICHTEXT_LEFT_CLICK             wxEVT_RICHTEXT_LEFT_CLICK
@@ -17,6 +17,9 @@
 #include "wx/richtext/richtextbuffer.h"
 #include "wx/richtext/richtextstyles.h"
 
+#include <unordered_map>
+#include <vector>
+
 #if wxUSE_RICHTEXT && wxUSE_XML
 
 /*!
@@ -121,6 +124,10 @@ public:
     /// Create a string containing style attributes, plus further object 'attributes' (shown, id)
     static wxString AddAttributes(wxRichTextObject* obj, bool isPara = false);
 
+    /// Same as AddAttributes(), but reuses the string created for the previous
+    /// objects with the same attributes since the last call to Clear()
+    wxString GetAttributesString(wxRichTextObject* obj, bool isPara = false);
+
     virtual bool ExportStyleDefinition(wxOutputStream& stream, wxRichTextStyleDefinition* def, int level);
 
     virtual bool WriteProperties(wxOutputStream& stream, const wxRichTextProperties& properties, int level);
@@ -153,6 +160,18 @@ public:
     wxMBConv*   m_convMem;
     wxMBConv*   m_convFile;
     bool        m_deleteConvFile;
+
+    // Strings returned by GetAttributesString() indexed by the hash of the
+    // attributes, with the most recently used one cached separately as
+    // consecutive objects often have the same attributes.
+    struct AttributesCacheEntry
+    {
+        wxRichTextAttr  attr;
+        bool            isPara;
+        wxString        str;
+    };
+    std::unordered_multimap<size_t, AttributesCacheEntry> m_attributesCache;
+    const AttributesCacheEntry* m_lastAttributes;
 #endif
 
     wxString    m_fileEncoding;
@@ -170,6 +189,7 @@ public:
 
 class WXDLLIMPEXP_FWD_XML wxXmlNode;
 class WXDLLIMPEXP_FWD_XML wxXmlDocument;
+class WXDLLIMPEXP_FWD_XML wxXmlReader;
 
 class WXDLLIMPEXP_RICHTEXT wxRichTextXMLHandler: public wxRichTextFileHandler
 {
@@ -226,6 +246,10 @@ protected:
 #if wxUSE_STREAMS
     virtual bool DoLoadFile(wxRichTextBuffer *buffer, wxInputStream& stream) override;
     virtual bool DoSaveFile(wxRichTextBuffer *buffer, wxOutputStream& stream) override;
+
+    /// Import an object from the element at the current reader position,
+    /// reading its children one by one
+    bool ImportXML(wxRichTextBuffer* buffer, wxRichTextObject* obj, wxXmlReader& reader);
 #endif
 
     wxRichTextXMLHelper m_helper;
@@ -77,6 +77,14 @@ public:
     // for now.
     void Compress(bool on);
 
+    // When batching is enabled, the data sent by Execute(), Poke() and
+    // Advise() is buffered and sent later, together with the data of the
+    // other calls made before returning to the event loop, or when Flush()
+    // is called.
+    void EnableBatching(bool enable = true);
+
+    // Send all the buffered data immediately.
+    bool Flush();
 
 protected:
     virtual bool DoExecute(const void *data, size_t size, wxIPCFormat format) override;
@@ -104,6 +112,15 @@ private:
     // common part of both ctors
     void Init();
 
+    // called after adding a message to the output buffer
+    void OnMessageQueued();
+
+    // called after reading the reply to a synchronous request
+    void OnReplyReceived();
+
+    // true if EnableBatching() was called
+    bool m_batching;
+
     friend class wxTCPServer;
     friend class wxTCPClient;
     friend class wxTCPEventHandler;
@@ -22,7 +22,10 @@
 #include "wx/sckaddr.h"
 #include "wx/list.h"
 
+#include <vector>
+
 class wxSocketImpl;
+struct wxSocketIOBuffer;
 
 // ------------------------------------------------------------------------
 // Types and constants
@@ -89,7 +92,8 @@ enum
     wxSOCKET_BLOCK          = 0x0010,
     wxSOCKET_REUSEADDR      = 0x0020,
     wxSOCKET_BROADCAST      = 0x0040,
-    wxSOCKET_NOBIND         = 0x0080
+    wxSOCKET_NOBIND         = 0x0080,
+    wxSOCKET_REUSEPORT      = 0x0100
 };
 
 typedef int wxSocketFlags;
@@ -243,6 +247,12 @@ private:
     wxUint32 DoRead(void* buffer, wxUint32 nbytes);
     wxUint32 DoWrite(const void *buffer, wxUint32 nbytes);
 
+    // scatter/gather versions of the functions above: read or write the data
+    // of all the given buffers, using as few system calls as possible, and
+    // update the buffers to only contain the part which wasn't transferred
+    wxUint32 DoReadV(wxSocketIOBuffer *bufs, int count);
+    wxUint32 DoWriteV(wxSocketIOBuffer *bufs, int count);
+
     // wait until the given flags are set for this socket or the given timeout
     // (or m_timeout) expires
     //
@@ -342,6 +352,12 @@ public:
     wxSocketBase* Accept(bool wait = true);
     bool AcceptWith(wxSocketBase& socket, bool wait = true);
 
+    // accept all the pending connections, up to the given maximal number of
+    // them, without blocking and append them to the provided vector, return
+    // the number of the accepted connections
+    size_t AcceptAll(std::vector<wxSocketBase*>& sockets,
+                     size_t maxCount = static_cast<size_t>(-1));
+
     bool WaitForAccept(long seconds = -1, long milliseconds = 0);
 
     wxDECLARE_CLASS(wxSocketServer);
@@ -498,12 +498,13 @@ private:
           size_t pos,           // the cached index in this string
                  impl,          // the corresponding position in its m_impl
                  len;           // cached length or npos if unknown
+          bool ascii;           // true if the string is known to be ASCII
 
           // reset cached index to 0
           void ResetPos() { pos = impl = 0; }
 
           // reset position and length
-          void Reset() { ResetPos(); len = npos; }
+          void Reset() { ResetPos(); len = npos; ascii = false; }
       };
 
       // cache the indices mapping for the last few string used
@@ -642,6 +643,11 @@ private:
 
       Cache::Element * const cache = GetCacheElement();
 
+      // indices and byte offsets are the same for ASCII-only strings, which
+      // are very common, so avoid iterating over them completely
+      if ( cache->ascii )
+          return pos;
+
       // cached position can't be 0 so if it is, it means that this entry was
       // used for length caching only so far, i.e. it doesn't count as a hit
       // from our point of view
@@ -690,7 +696,10 @@ private:
   {
       Cache::Element * const cache = FindCacheElement();
       if ( cache )
+      {
           cache->len = npos;
+          cache->ascii = false;
+      }
   }
 
   void SetCachedLength(size_t len)
@@ -699,12 +708,20 @@ private:
       // present in the cache before, this seems to do no harm and the
       // potential for avoiding length recomputation for long strings looks
       // interesting
-      GetCacheElement()->len = len;
+      Cache::Element * const cache = GetCacheElement();
+      cache->len = len;
+
+      // notice that this is called before modifying m_impl, so we can't
+      // determine whether the string is ASCII here
+      cache->ascii = false;
   }
 
   void UpdateCachedLength(ptrdiff_t delta)
   {
       Cache::Element * const cache = FindCacheElement();
+      if ( cache )
+          cache->ascii = false;
+
       if ( cache && cache->len != npos )
       {
           wxSTRING_CACHE_ASSERT( (ptrdiff_t)cache->len + delta >= 0 );
@@ -1431,6 +1448,10 @@ public:
           // here as it's probably 0 anyhow -- you usually call length() before
           // starting to index the string
           cache->len = end() - begin();
+
+          // if the length in characters is the same as in bytes, all of
+          // them must be ASCII, remember it to speed up PosToImpl()
+          cache->ascii = cache->len == m_impl.length();
       }
       else
       {
@@ -15,6 +15,8 @@
 #include "wx/string.h"
 #include "wx/arrstr.h"
 
+#include <iterator>
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -33,6 +35,51 @@ enum wxStringTokenizerMode
     wxTOKEN_STRTOK          // behave exactly like strtok(3)
 };
 
+// ----------------------------------------------------------------------------
+// wxStringTokenDelimiters: set of delimiters used by the tokenizers below
+// ----------------------------------------------------------------------------
+
+// This is a helper class used by wxStringTokenizer and wxStringViewTokenizer
+// to quickly check whether a character is one of the delimiters, don't use it
+// directly.
+class WXDLLIMPEXP_BASE wxStringTokenDelimiters
+{
+public:
+    wxStringTokenDelimiters() { Set(wxString()); }
+    explicit wxStringTokenDelimiters(const wxString& delims) { Set(delims); }
+
+    void Set(const wxString& delims);
+
+    bool Contains(wxUniChar ch) const
+    {
+        const wxUint32 c = ch.GetValue();
+        if ( c < 128 )
+            return (m_ascii[c >> 5] >> (c & 31)) & 1;
+
+        return !m_nonASCII.empty() && m_nonASCII.find(ch) != wxString::npos;
+    }
+
+    // Find the first delimiter or the first non-delimiter in the given range
+    // of the string internal representation, return end if none was found.
+    const wxStringCharType*
+    FindFirstOf(const wxStringCharType* from, const wxStringCharType* end) const;
+    const wxStringCharType*
+    FindFirstNotOf(const wxStringCharType* from, const wxStringCharType* end) const;
+
+private:
+    // Bit mask of the ASCII delimiters.
+    wxUint32 m_ascii[4];
+
+    // The first few distinct ASCII delimiters and their total number, used
+    // for the optimized search when there are only a few of them.
+    enum { MAX_FAST = 4 };
+    wxStringCharType m_fast[MAX_FAST];
+    unsigned m_countASCII;
+
+    // Non-ASCII delimiters, if any (there are usually none).
+    wxString m_nonASCII;
+};
+
 // ----------------------------------------------------------------------------
 // wxStringTokenizer: replaces infamous strtok() and has some other features
 // ----------------------------------------------------------------------------
@@ -130,6 +177,7 @@ protected:
     wxString::const_iterator m_stringEnd;
     wxWCharBuffer m_delims;         // all possible delimiters
     size_t m_delimsLen;
+    wxStringTokenDelimiters m_delimsSet;
 
     wxString::const_iterator m_pos; // the current position in m_string
 
@@ -138,6 +186,172 @@ protected:
     wxChar   m_lastDelim;           // delimiter after last token or '\0'
 };
 
+// ----------------------------------------------------------------------------
+// wxStringTokenView: a token returned by wxStringViewTokenizer
+// ----------------------------------------------------------------------------
+
+// This is a non-owning reference to a part of the string being tokenized, so
+// it is only valid as long as this string is neither modified nor destroyed.
+class wxStringTokenView
+{
+public:
+    wxStringTokenView() : m_begin(nullptr), m_end(nullptr) { }
+    wxStringTokenView(const wxStringCharType* begin, const wxStringCharType* end)
+        : m_begin(begin), m_end(end) { }
+
+    // Access to the internal representation of the token: notice that in
+    // UTF-8 build size() returns the number of bytes and not characters.
+    const wxStringCharType* data() const { return m_begin; }
+    size_t size() const { return m_end - m_begin; }
+    bool empty() const { return m_begin == m_end; }
+
+    // Return the number of characters in the token.
+    size_t length() const
+    {
+#if wxUSE_UNICODE_UTF8
+        size_t len = 0;
+        for ( const char* p = m_begin; p != m_end; ++p )
+        {
+            // Don't count continuation bytes.
+            if ( (*p & 0xc0) != 0x80 )
+                len++;
+        }
+        return len;
+#else
+        return size();
+#endif
+    }
+
+    // Create a new string containing this token.
+    wxString ToString() const
+    {
+#if wxUSE_UNICODE_UTF8
+        return wxString::FromUTF8Unchecked(m_begin, size());
+#else
+        return wxString(m_begin, size());
+#endif
+    }
+
+    // Compare the token with the given string without creating a new string.
+    bool IsSameAs(const wxString& str) const
+    {
+        const wxStringCharType* const s = str.wx_str();
+#if wxUSE_UNICODE_UTF8
+        const size_t len = str.utf8_length();
+#else
+        const size_t len = str.length();
+#endif
+        return len == size() &&
+                std::char_traits<wxStringCharType>::compare(s, m_begin, len) == 0;
+    }
+
+    bool operator==(const wxString& str) const { return IsSameAs(str); }
+    bool operator!=(const wxString& str) const { return !IsSameAs(str); }
+
+#ifdef __cpp_lib_string_view
+    std::basic_string_view<wxStringCharType> ToStdView() const
+    {
+        return std::basic_string_view<wxStringCharType>(m_begin, size());
+    }
+#endif // __cpp_lib_string_view
+
+private:
+    const wxStringCharType* m_begin;
+    const wxStringCharType* m_end;
+};
+
+// ----------------------------------------------------------------------------
+// wxStringViewTokenizer: tokenizer returning views into the original string
+// ----------------------------------------------------------------------------
+
+// Unlike wxStringTokenizer, this class doesn't copy the string being
+// tokenized nor allocate memory for the tokens, but the string must remain
+// unchanged for as long as the tokenizer and the tokens returned by it are
+// used.
+class WXDLLIMPEXP_BASE wxStringViewTokenizer
+{
+public:
+    wxStringViewTokenizer(const wxString& str,
+                          const wxString& delims = wxDEFAULT_DELIMITERS,
+                          wxStringTokenizerMode mode = wxTOKEN_DEFAULT);
+
+    // Disallow tokenizing temporary strings, as the tokens would dangle.
+    wxStringViewTokenizer(wxString&& str,
+                          const wxString& delims = wxDEFAULT_DELIMITERS,
+                          wxStringTokenizerMode mode = wxTOKEN_DEFAULT) = delete;
+
+    // Same as the functions of wxStringTokenizer with the same names.
+    bool HasMoreTokens() const;
+    wxStringTokenView GetNextToken();
+    wxChar GetLastDelimiter() const { return m_lastDelim; }
+    wxStringTokenizerMode GetMode() const { return m_mode; }
+
+    // Support for range-based for loops: note that iterating over the tokens
+    // consumes them, just as calling GetNextToken() does.
+    class const_iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef wxStringTokenView value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const wxStringTokenView* pointer;
+        typedef const wxStringTokenView& reference;
+
+        const_iterator() : m_tokenizer(nullptr) { }
+
+        reference operator*() const { return m_token; }
+        pointer operator->() const { return &m_token; }
+
+        const_iterator& operator++() { Advance(); return *this; }
+
+        bool operator==(const const_iterator& other) const
+            { return m_tokenizer == other.m_tokenizer; }
+        bool operator!=(const const_iterator& other) const
+            { return m_tokenizer != other.m_tokenizer; }
+
+    private:
+        explicit const_iterator(wxStringViewTokenizer* tokenizer)
+            : m_tokenizer(tokenizer)
+        {
+            Advance();
+        }
+
+        void Advance()
+        {
+            if ( m_tokenizer->HasMoreTokens() )
+                m_token = m_tokenizer->GetNextToken();
+            else
+                m_tokenizer = nullptr;
+        }
+
+        wxStringViewTokenizer* m_tokenizer;
+        wxStringTokenView m_token;
+
+        friend class wxStringViewTokenizer;
+    };
+
+    const_iterator begin() { return const_iterator(this); }
+    const_iterator end() { return const_iterator(); }
+
+private:
+    const wxStringCharType* const m_begin;
+    const wxStringCharType* const m_end;
+    const wxStringCharType* m_pos;
+
+    // Cached position of the first non-delimiter character at or after
+    // m_pos, only valid if it is not before m_pos.
+    mutable const wxStringCharType* m_nextNonDelim;
+
+    wxStringTokenDelimiters m_delims;
+    wxStringTokenizerMode m_mode;
+    wxChar m_lastDelim;
+
+    // True if the last returned token was followed by a delimiter.
+    bool m_afterDelim;
+
+    wxDECLARE_NO_COPY_CLASS(wxStringViewTokenizer);
+};
+
 // ----------------------------------------------------------------------------
 // convenience function which returns all tokens at once
 // ----------------------------------------------------------------------------
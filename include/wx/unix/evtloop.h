@@ -19,6 +19,7 @@
 class wxEventLoopSource;
 class wxFDIODispatcher;
 class wxWakeUpPipeMT;
+class wxTimerFD;
 
 class WXDLLIMPEXP_BASE wxConsoleEventLoop
 #ifdef __WXOSX__
@@ -39,6 +40,16 @@ public:
     virtual void WakeUp() override;
     virtual bool IsOk() const override { return m_dispatcher != nullptr; }
 
+#if wxUSE_TIMER
+    // Set the maximal delay which may be added to the timers expiration in
+    // order to notify the timers expiring at close times together, with a
+    // single wake up, instead of waking up for each of them. The timers are
+    // never notified before their expiration. The default slack is 0.
+    //
+    // This affects all timers used with the console event loops.
+    static void SetTimerSlack(int milliseconds);
+#endif // wxUSE_TIMER
+
 protected:
     virtual void OnNextIteration() override;
     virtual void DoYieldFor(long eventsToProcess) override;
@@ -54,6 +65,10 @@ private:
     // either wxSelectDispatcher or wxEpollDispatcher
     wxFDIODispatcher *m_dispatcher;
 
+    // used for waking up when the next timer expires, if supported, may be
+    // null
+    wxTimerFD *m_timerFD;
+
     wxDECLARE_NO_COPY_CLASS(wxConsoleEventLoop);
 };
 
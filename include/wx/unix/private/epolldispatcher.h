@@ -16,11 +16,40 @@
 
 #include "wx/private/fdiodispatcher.h"
 
-struct epoll_event;
+#include <sys/epoll.h>
+
+#include <vector>
 
 class WXDLLIMPEXP_BASE wxEpollDispatcher : public wxFDIODispatcher
 {
 public:
+    // statistics about the dispatcher activity, mostly useful for profiling
+    struct Stats
+    {
+        // number of calls to Dispatch()
+        wxUint64 dispatches = 0;
+
+        // number of epoll_wait() calls done by Dispatch()
+        wxUint64 polls = 0;
+
+        // number of epoll_wait() calls which filled the entire buffer
+        wxUint64 fullPolls = 0;
+
+        // total number of events passed to the handlers
+        wxUint64 events = 0;
+
+        // number of events ignored because their descriptor was unregistered
+        // or its handler didn't want them any more
+        wxUint64 staleEvents = 0;
+
+        // number of events processed by the last and the busiest Dispatch()
+        unsigned lastBatch = 0,
+                 maxBatch = 0;
+
+        // current size of the events buffer
+        unsigned bufferSize = 0;
+    };
+
     // create a new instance of this class, can return nullptr if
     // epoll() is not supported on this system
     //
@@ -36,16 +65,53 @@ public:
     virtual bool HasPending() const override;
     virtual int Dispatch(int timeout = TIMEOUT_INFINITE) override;
 
+    // get the statistics accumulated since the creation of this object or
+    // the last call to ResetStats()
+    const Stats& GetStats() const;
+    void ResetStats();
+
 private:
     // ctor is private, use Create()
     wxEpollDispatcher(int epollDescriptor);
 
-    // common part of HasPending() and Dispatch(): calls epoll_wait() with the
-    // given timeout
-    int DoPoll(epoll_event *events, int numEvents, int timeout) const;
+    // calls epoll_wait() with the given timeout to fill m_events and returns
+    // the number of events in it
+    int DoPoll(int timeout) const;
+
+    // update the size to use for m_events after polling returned the given
+    // number of events
+    void AdaptBufferSize(int numEvents) const;
+
+    // remember the handler and the events for the given descriptor
+    void SetEntry(int fd, wxFDIOHandler* handler, uint32_t events);
 
 
     int m_epollDescriptor;
+
+    // the handlers and the epoll mask they're registered for, indexed by the
+    // descriptor: we store descriptors and not handler pointers in
+    // epoll_event, so that we can safely ignore the events for the
+    // descriptors unregistered before they could be dispatched
+    struct Entry
+    {
+        wxFDIOHandler* handler;
+        uint32_t events;
+    };
+
+    std::vector<Entry> m_entries;
+
+    // the buffer for epoll_wait(), its size grows when it becomes full and
+    // shrinks again when it remains mostly unused for some time
+    mutable std::vector<epoll_event> m_events;
+    mutable unsigned m_underusedPolls;
+
+    mutable Stats m_stats;
+
+    // the event retrieved by HasPending(), which must be dispatched by the
+    // next call to Dispatch() as it wouldn't be returned by epoll_wait() again
+    // for the descriptors using edge-triggered mode
+    mutable epoll_event m_pendingEvent;
+    mutable bool m_hasPendingEvent;
 };
 
 #endif // wxUSE_EPOLL_DISPATCHER
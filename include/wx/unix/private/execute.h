@@ -18,9 +18,11 @@
     #include "wx/private/streamtempinput.h"
 #endif
 
+#include <memory>
 #include <unordered_map>
 
 class wxEventLoopBase;
+class wxExecuteOutputEventsHandler;
 
 // Information associated with a running child process.
 class wxExecuteData
@@ -42,6 +44,8 @@ public:
 #endif // wxUSE_STREAMS
     }
 
+    ~wxExecuteData();
+
     // This must be called in the parent process as soon as fork() returns to
     // update us with the effective child PID. It also ensures that we handle
     // SIGCHLD to be able to detect when this PID exits, so wxTheApp must be
@@ -82,6 +86,11 @@ public:
     // the corresponding FDs, -1 if not redirected
     int m_fdOut,
         m_fdErr;
+
+    // the handlers generating wxEVT_PROCESS_OUTPUT events for the child
+    // stdout and stderr if wxProcess::EnableOutputEvents() was used
+    std::unique_ptr<wxExecuteOutputEventsHandler> m_outEvents,
+                                                  m_errEvents;
 #endif // wxUSE_STREAMS
 
 
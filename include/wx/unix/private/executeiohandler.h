@@ -133,4 +133,64 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxExecuteEventLoopSourceHandler);
 };
 
+// This handler is used by wxExecute() for the asynchronously launched
+// processes using wxProcess::EnableOutputEvents(): it reads all the data
+// available in the pipe connected to the child stdout or stderr as soon as it
+// appears, without blocking, and generates wxEVT_PROCESS_OUTPUT events for it.
+//
+// If it could be registered with the event loop, i.e. IsOk() returns true, it
+// takes ownership of the FD, which must be non-blocking, and closes it once
+// EOF is reached or when it is destroyed.
+class wxExecuteOutputEventsHandler : public wxEventLoopSourceHandler
+{
+public:
+    wxExecuteOutputEventsHandler(wxProcess& process, int fd, bool isError);
+
+    virtual ~wxExecuteOutputEventsHandler();
+
+    // Return false if we couldn't register with the event loop and so won't
+    // be able to do anything.
+    bool IsOk() const { return m_source != nullptr; }
+
+    // Read all the data remaining in the pipe, without blocking, and generate
+    // the events for it. This is used when the child terminates.
+    void ReadAll();
+
+    virtual void OnReadWaiting() override;
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+private:
+    // Read the data available in the pipe, but not much more than the given
+    // size, and generate an event for it.
+    //
+    // Returns false if no more data can be read right now (or ever).
+    bool ReadAvailable(size_t maxSize);
+
+    // Stop monitoring the FD and close it.
+    void Close();
+
+
+    wxProcess& m_process;
+    int m_fd;
+    const bool m_isError;
+
+    wxEventLoopSource* m_source;
+
+    // The size of the next read, it grows when the child produces a lot of
+    // output to read it using fewer system calls.
+    size_t m_readSize;
+
+    // The buffer used for reading small amounts of data, which are then
+    // copied into the buffer of exactly the right size.
+    wxCharBuffer m_readBuf;
+
+    // Pointer to the flag set to true when this object is destroyed, used to
+    // detect if it happened while generating an event. If events are
+    // generated recursively, it points to the flag of the innermost call.
+    bool* m_destroyed;
+
+    wxDECLARE_NO_COPY_CLASS(wxExecuteOutputEventsHandler);
+};
+
 #endif // _WX_UNIX_PRIVATE_EXECUTEIOHANDLER_H_
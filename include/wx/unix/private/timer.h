@@ -14,7 +14,7 @@
 
 #include "wx/private/timer.h"
 
-#include <list>
+#include <vector>
 
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
@@ -47,6 +47,11 @@ public:
 
 private:
     bool m_isRunning;
+
+    // index of this timer in wxTimerScheduler heap, only valid if it's running
+    size_t m_heapIndex;
+
+    friend class wxTimerScheduler;
 };
 
 // ----------------------------------------------------------------------------
@@ -55,10 +60,21 @@ private:
 
 struct wxTimerSchedule
 {
-    wxTimerSchedule(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+    wxTimerSchedule(wxUnixTimerImpl *timer,
+                    wxUsecClock_t expiration,
+                    wxUint64 seq)
         : m_timer(timer),
-          m_expiration(expiration)
+          m_expiration(expiration),
+          m_seq(seq)
+    {
+    }
+
+    // timers are ordered by their expiration time and, for the timers
+    // expiring at the same time, in the order in which they were scheduled
+    bool operator<(const wxTimerSchedule& other) const
     {
+        return m_expiration < other.m_expiration ||
+                (m_expiration == other.m_expiration && m_seq < other.m_seq);
     }
 
     // the timer itself (we don't own this pointer)
@@ -66,10 +82,10 @@ struct wxTimerSchedule
 
     // the time of its next expiration, in usec
     wxUsecClock_t m_expiration;
-};
 
-// the linked list of all active timers, we keep it sorted by expiration time
-using wxTimerList = std::list<wxTimerSchedule>;
+    // sequence number used to preserve the scheduling order
+    wxUint64 m_seq;
+};
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -97,16 +113,33 @@ public:
         }
     }
 
-    // adds timer which should expire at the given absolute time to the list
+    // adds timer which should expire at the given absolute time
     void AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration);
 
+    // changes the expiration time of an already added timer, this is more
+    // efficient than removing and adding it again
+    void UpdateTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration);
+
     // remove timer from the list, called automatically from timer dtor
     void RemoveTimer(wxUnixTimerImpl *timer);
 
+    // set the maximal delay, in usec, which can be added to the timers
+    // expiration times to allow processing the timers expiring at close
+    // times during a single wake up, 0 by default
+    void SetSlack(wxUsecClock_t slack) { m_slack = slack; }
+    wxUsecClock_t GetSlack() const { return m_slack; }
+
 
     // the functions below are used by the event loop implementation to monitor
     // and notify timers:
 
+    // if this function returns true, the absolute time at which the event
+    // loop should wake up to notify the next timer is returned in the provided
+    // parameter, taking the slack into account
+    //
+    // it returns false if there are no timers
+    bool GetNextWakeUp(wxUsecClock_t *when) const;
+
     // if this function returns true, the time remaining until the next time
     // expiration is returned in the provided parameter (always positive or 0)
     //
@@ -123,12 +156,32 @@ private:
     wxTimerScheduler() = default;
     ~wxTimerScheduler() = default;
 
-    // add the given timer schedule to the list in the right place
+    // add the given timer schedule to the heap in the right place
     void DoAddTimer(const wxTimerSchedule& s);
 
+    // remove the element at the given position from the heap
+    void DoRemoveAt(size_t n);
+
+    // store the schedule at the given position in the heap, updating the
+    // timer index
+    void DoPlace(size_t n, const wxTimerSchedule& s);
+
+    // restore the heap property after the element at the given position
+    // became smaller or larger respectively
+    void SiftUp(size_t n);
+    void SiftDown(size_t n);
+
+
+    // 4-ary min-heap of all currently active timers ordered by expiration:
+    // it provides O(log n) addition and removal of the timers, while being
+    // more cache friendly than a binary heap
+    std::vector<wxTimerSchedule> m_timers;
+
+    // next sequence number to use
+    wxUint64 m_seq = 0;
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // see SetSlack()
+    wxUsecClock_t m_slack = 0;
 
     static wxTimerScheduler *ms_instance;
 };
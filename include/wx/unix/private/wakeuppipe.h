@@ -48,6 +48,9 @@ public:
     virtual void OnWriteWaiting() override { }
     virtual void OnExceptionWaiting() override { }
 
+    // OnReadWaiting() always empties the pipe.
+    virtual bool DrainsFully() const override { return true; }
+
 private:
     wxPipe m_pipe;
 
@@ -88,6 +88,26 @@ private:
     wxWebAuthChallengeImplPtr m_impl;
 };
 
+// Interface for consuming the response data as soon as it is received.
+class wxWebRequestSink
+{
+public:
+    enum Action
+    {
+        Action_Continue,
+        Action_Pause
+    };
+
+    // Called with the data received from the server, which is only valid
+    // during this call.
+    //
+    // Return Action_Pause to indicate that the data was not consumed and
+    // should be passed again after wxWebRequest::Resume() is called.
+    virtual Action OnData(const void* data, size_t size) = 0;
+
+    virtual ~wxWebRequestSink() = default;
+};
+
 class WXDLLIMPEXP_NET wxWebResponse
 {
 public:
@@ -217,6 +237,8 @@ public:
 
     void SetStorage(Storage storage);
 
+    void SetDataSink(wxWebRequestSink* sink);
+
     void SetTimeouts(long connectionTimeoutMs, long dataTimeoutMs);
 
     Storage GetStorage() const;
@@ -274,6 +296,8 @@ public:
 
     void Cancel();
 
+    void Resume();
+
     wxWebAuthChallenge GetAuthChallenge() const;
 
     int GetId() const;
@@ -354,6 +378,21 @@ private:
     wxString m_url;
 };
 
+// Statistics about the connections used by the session.
+struct wxWebSessionStats
+{
+    // Number of the requests which were completed.
+    wxUint64 requests = 0;
+
+    // Number of the connections opened and of the requests which reused an
+    // already existing connection.
+    wxUint64 connectionsCreated = 0;
+    wxUint64 connectionsReused = 0;
+
+    // Number of the requests which reused the backend-specific request handle.
+    wxUint64 handlesReused = 0;
+};
+
 extern WXDLLIMPEXP_DATA_NET(const char) wxWebSessionBackendWinHTTP[];
 extern WXDLLIMPEXP_DATA_NET(const char) wxWebSessionBackendURLSession[];
 extern WXDLLIMPEXP_DATA_NET(const char) wxWebSessionBackendCURL[];
@@ -391,6 +430,10 @@ public:
 
     bool EnablePersistentStorage(bool enable = true);
 
+    bool SetMaxConnectionsPerHost(int maxConnections);
+
+    wxWebSessionStats GetStats() const;
+
     wxWebSessionHandle GetNativeHandle() const;
 
 private:
@@ -38,6 +38,9 @@ class WXDLLIMPEXP_FWD_XML wxXmlIOHandler;
 class WXDLLIMPEXP_FWD_BASE wxInputStream;
 class WXDLLIMPEXP_FWD_BASE wxOutputStream;
 
+class wxXmlCompactNode;
+class wxXmlReaderImpl;
+
 // Represents XML node type.
 enum wxXmlNodeType
 {
@@ -96,7 +99,7 @@ class WXDLLIMPEXP_XML wxXmlNode
 public:
     wxXmlNode()
         : m_attrs(nullptr), m_parent(nullptr), m_children(nullptr), m_next(nullptr),
-          m_lineNo(-1), m_noConversion(false)
+          m_lineNo(-1), m_noConversion(false), m_compactStrings(false)
     {
     }
 
@@ -127,8 +130,10 @@ public:
 
     // access methods:
     wxXmlNodeType GetType() const { return m_type; }
-    const wxString& GetName() const { return m_name; }
-    const wxString& GetContent() const { return m_content; }
+    const wxString& GetName() const
+        { return m_compactStrings ? DoGetCompactName() : m_name; }
+    const wxString& GetContent() const
+        { return m_compactStrings ? DoGetCompactContent() : m_content; }
 
     bool IsWhitespaceOnly() const;
     int GetDepth(const wxXmlNode *grandparent = nullptr) const;
@@ -153,8 +158,10 @@ public:
     int GetLineNumber() const { return m_lineNo; }
 
     void SetType(wxXmlNodeType type) { m_type = type; }
-    void SetName(const wxString& name) { m_name = name; }
-    void SetContent(const wxString& con) { m_content = con; }
+    void SetName(const wxString& name)
+        { if ( m_compactStrings ) DoDetachCompactStrings(); m_name = name; }
+    void SetContent(const wxString& con)
+        { if ( m_compactStrings ) DoDetachCompactStrings(); m_content = con; }
 
     void SetParent(wxXmlNode *parent) { m_parent = parent; }
     void SetNext(wxXmlNode *next) { m_next = next; }
@@ -176,8 +183,18 @@ private:
     int m_lineNo; // line number in original file, or -1
     bool m_noConversion; // don't do encoding conversion - node is plain text
 
+    // Only true for the nodes of the documents loaded using wxXMLDOC_COMPACT
+    // which store their name and content outside of m_name and m_content.
+    bool m_compactStrings;
+
     void DoFree();
     void DoCopy(const wxXmlNode& node);
+
+    const wxString& DoGetCompactName() const;
+    const wxString& DoGetCompactContent() const;
+    void DoDetachCompactStrings();
+
+    friend class wxXmlCompactNode;
 };
 
 
@@ -219,7 +236,12 @@ private:
 enum wxXmlDocumentLoadFlag
 {
     wxXMLDOC_NONE = 0,
-    wxXMLDOC_KEEP_WHITESPACE_NODES = 1
+    wxXMLDOC_KEEP_WHITESPACE_NODES = 1,
+
+    // allocate all nodes and attributes of the document from a memory arena
+    // instead of the heap, share the strings used as node names and keep the
+    // node text as UTF-8 until it's accessed
+    wxXMLDOC_COMPACT = 2
 };
 
 // Create an instance of this and pass it to wxXmlDocument::Load()
@@ -329,6 +351,81 @@ private:
     wxDECLARE_CLASS(wxXmlDocument);
 };
 
+// Kinds of items returned by wxXmlReader::Next().
+enum wxXmlReaderItem
+{
+    wxXML_READER_EOF,
+    wxXML_READER_ERROR,
+    wxXML_READER_START_ELEMENT,
+    wxXML_READER_END_ELEMENT,
+    wxXML_READER_TEXT,
+    wxXML_READER_CDATA,
+    wxXML_READER_COMMENT,
+    wxXML_READER_PI
+};
+
+// This class allows to read XML documents sequentially, without loading them
+// into memory entirely.
+
+class WXDLLIMPEXP_XML wxXmlReader
+{
+public:
+    // The stream must remain valid while this object is used. The flags are
+    // the same as for wxXmlDocument::Load(), but only
+    // wxXMLDOC_KEEP_WHITESPACE_NODES is used.
+    explicit wxXmlReader(wxInputStream& stream,
+                         int flags = wxXMLDOC_NONE,
+                         size_t bufSize = 16384);
+    ~wxXmlReader();
+
+    // Advance to the next item and return its kind.
+    wxXmlReaderItem Next();
+
+    // Return the kind of the current item.
+    wxXmlReaderItem GetItem() const;
+
+    // Element name for the element items, target for wxXML_READER_PI.
+    const wxString& GetName() const;
+
+    // Text, comment, CDATA or PI contents.
+    const wxString& GetText() const;
+
+    // Number of elements containing the current item, including the current
+    // one for the element items.
+    int GetDepth() const;
+
+    int GetLineNumber() const;
+
+    // Attributes of the current wxXML_READER_START_ELEMENT item.
+    size_t GetAttributeCount() const;
+    wxString GetAttributeName(size_t n) const;
+    wxString GetAttributeValue(size_t n) const;
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxString()) const;
+    bool HasAttribute(const wxString& attrName) const;
+
+    // Build the DOM for the element starting at the current item, which must
+    // be wxXML_READER_START_ELEMENT, and all its children. The reader is
+    // positioned on the corresponding wxXML_READER_END_ELEMENT after the
+    // call. The caller is responsible for deleting the returned node, which
+    // is null in case of error.
+    wxXmlNode *ReadSubtree();
+
+    // Skip the element starting at the current item and all its children,
+    // return false in case of error.
+    bool SkipSubtree();
+
+    // Return the information about the error if Next() returned
+    // wxXML_READER_ERROR.
+    const wxXmlParseError& GetError() const;
+
+private:
+    wxXmlReaderImpl* const m_impl;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlReader);
+};
+
 #endif // wxUSE_XML
 
 #endif // _WX_XML_H_
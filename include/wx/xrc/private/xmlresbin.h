@@ -0,0 +1,313 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/xrc/private/xmlresbin.h
+// Purpose:     Format of the compiled binary XRC resources
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_XRC_PRIVATE_XMLRESBIN_H_
+#define _WX_XRC_PRIVATE_XMLRESBIN_H_
+
+#include "wx/ffile.h"
+#include "wx/log.h"
+#include "wx/xml/xml.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// This header is used by both wxXmlResource, which loads the compiled XRC
+// files, and wxrc, which creates them, and so must not depend on anything
+// except wxBase and wxXML.
+//
+// The compiled file consists of a header, the string table, the index of the
+// resources and the nodes, in this order. All integers are 32 bit unsigned
+// and stored in little endian byte order, the strings are stored in UTF-8
+// without the trailing NUL and are referenced by their index in the table.
+//
+// The header contains the magic signature followed by these fields:
+//
+//  - Format version.
+//  - Number of strings.
+//  - Number of top-level entries.
+//  - Number of nested named objects.
+//  - Size of the nodes data.
+//
+// The string table contains the offsets of all strings (and the offset of
+// the end of the last string) relative to the start of the strings data,
+// followed by the data itself.
+//
+// Each top-level entry corresponds to an element child of the root
+// <resource> element and contains its name, only for the objects, and class
+// (NO_STRING if not specified), its offset in the nodes data and the flags.
+//
+// Each nested entry contains the name of an object not at top-level and the
+// index of the top-level entry containing it.
+//
+// Finally, the nodes data starts with the root element, without children,
+// followed by all the top-level entries. Each node is stored as its type,
+// name, content, line number, number of attributes, attributes names and
+// values and the number of children, followed by the children themselves.
+namespace wxXRCBinary
+{
+
+// Signature at the start of the file.
+static const char MAGIC[] = "wxXRCbin";
+static const size_t MAGIC_LEN = 8;
+
+// Current version of the format: files with different version are rejected.
+static const wxUint32 VERSION = 1;
+
+// Number of fields in a top-level entry.
+static const size_t ENTRY_FIELDS = 4;
+
+// Number of fields in a nested entry.
+static const size_t NESTED_FIELDS = 2;
+
+// String index used for missing strings.
+static const wxUint32 NO_STRING = 0xffffffff;
+
+// Flags of the top-level entries.
+enum
+{
+    // The entry must be loaded immediately and not on demand, e.g. because
+    // it's not an object or because it uses the IDs ranges.
+    ENTRY_EAGER = 1
+};
+
+// Creates the compiled XRC files.
+class Writer
+{
+public:
+    Writer() = default;
+
+    // Add all resources from the given document.
+    void AddDocument(const wxXmlDocument& doc);
+
+    // Write the compiled file.
+    bool Save(const wxString& filename) const;
+
+private:
+    static bool IsObjectNode(const wxXmlNode* node)
+    {
+        return node->GetType() == wxXML_ELEMENT_NODE &&
+                (node->GetName() == wxS("object") ||
+                    node->GetName() == wxS("object_ref"));
+    }
+
+    static void AddInt(std::string& data, wxUint32 n);
+
+    // Return the index of the given string, adding it if necessary.
+    wxUint32 AddString(const wxString& s);
+
+    // Return the index of the attribute value or NO_STRING if there is none.
+    wxUint32 AddAttribute(const wxXmlNode* node, const wxString& name);
+
+    // Add the node and, if withChildren is true, all of its children to the
+    // nodes data.
+    void AddNode(const wxXmlNode* node, bool withChildren);
+
+    // Add the named objects under the given node to the index of the nested
+    // objects and return true if any of the nodes uses IDs ranges.
+    bool AddNested(const wxXmlNode* node, wxUint32 entry);
+
+    std::unordered_map<wxString, wxUint32> m_stringsIndex;
+    std::vector<wxUint32> m_stringsOffsets;
+    std::string m_strings;
+
+    std::string m_entries;
+    wxUint32 m_entriesCount = 0;
+
+    std::string m_nested;
+    wxUint32 m_nestedCount = 0;
+
+    std::string m_nodes;
+
+    wxString m_version;
+};
+
+/* static */ inline
+void Writer::AddInt(std::string& data, wxUint32 n)
+{
+    n = wxUINT32_SWAP_ON_BE(n);
+    data.append(reinterpret_cast<const char*>(&n), sizeof(n));
+}
+
+inline wxUint32 Writer::AddString(const wxString& s)
+{
+    const auto it = m_stringsIndex.find(s);
+    if ( it != m_stringsIndex.end() )
+        return it->second;
+
+    const wxUint32 n = m_stringsOffsets.size();
+    m_stringsIndex[s] = n;
+    m_stringsOffsets.push_back(m_strings.size());
+    m_strings += s.utf8_string();
+
+    return n;
+}
+
+inline wxUint32
+Writer::AddAttribute(const wxXmlNode* node, const wxString& name)
+{
+    wxString value;
+    if ( !node->GetAttribute(name, &value) )
+        return NO_STRING;
+
+    return AddString(value);
+}
+
+inline void Writer::AddNode(const wxXmlNode* node, bool withChildren)
+{
+    AddInt(m_nodes, node->GetType());
+    AddInt(m_nodes, AddString(node->GetName()));
+    AddInt(m_nodes, AddString(node->GetContent()));
+    AddInt(m_nodes, node->GetLineNumber());
+
+    wxUint32 count = 0;
+    const wxXmlAttribute* attr;
+    for ( attr = node->GetAttributes(); attr; attr = attr->GetNext() )
+        count++;
+
+    AddInt(m_nodes, count);
+    for ( attr = node->GetAttributes(); attr; attr = attr->GetNext() )
+    {
+        AddInt(m_nodes, AddString(attr->GetName()));
+        AddInt(m_nodes, AddString(attr->GetValue()));
+    }
+
+    // Comments and processing instructions are not used by XRC, so don't
+    // store them.
+    std::vector<const wxXmlNode*> children;
+    if ( withChildren )
+    {
+        for ( const wxXmlNode* child = node->GetChildren();
+              child;
+              child = child->GetNext() )
+        {
+            switch ( child->GetType() )
+            {
+                case wxXML_ELEMENT_NODE:
+                case wxXML_TEXT_NODE:
+                case wxXML_CDATA_SECTION_NODE:
+                    children.push_back(child);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    AddInt(m_nodes, children.size());
+    for ( const wxXmlNode* child : children )
+        AddNode(child, true);
+}
+
+inline bool Writer::AddNested(const wxXmlNode* node, wxUint32 entry)
+{
+    bool usesRanges = false;
+    for ( const wxXmlNode* child = node->GetChildren();
+          child;
+          child = child->GetNext() )
+    {
+        if ( child->GetType() != wxXML_ELEMENT_NODE )
+            continue;
+
+        wxString name;
+        if ( child->GetAttribute(wxS("name"), &name) )
+        {
+            if ( name.find('[') != wxString::npos )
+                usesRanges = true;
+
+            if ( IsObjectNode(child) )
+            {
+                AddInt(m_nested, AddString(name));
+                AddInt(m_nested, entry);
+                m_nestedCount++;
+            }
+        }
+
+        if ( AddNested(child, entry) )
+            usesRanges = true;
+    }
+
+    return usesRanges;
+}
+
+inline void Writer::AddDocument(const wxXmlDocument& doc)
+{
+    const wxXmlNode* const root = doc.GetRoot();
+
+    const wxString version = root->GetAttribute(wxS("version"));
+    if ( m_nodes.empty() )
+    {
+        // All the top-level resources are stored after the root node, so it
+        // doesn't have any children itself.
+        AddNode(root, false);
+
+        m_version = version;
+    }
+    else if ( version != m_version )
+    {
+        wxLogWarning("Resource files must have same version number.");
+    }
+
+    for ( const wxXmlNode* node = root->GetChildren();
+          node;
+          node = node->GetNext() )
+    {
+        if ( node->GetType() != wxXML_ELEMENT_NODE )
+            continue;
+
+        const wxUint32 entry = m_entriesCount++;
+
+        // Non-objects, e.g. <ids-range>, must be always loaded, as well as
+        // the objects using the IDs ranges, as they need to be processed when
+        // the file is loaded.
+        wxUint32 flags = 0;
+        if ( AddNested(node, entry) ||
+                !IsObjectNode(node) ||
+                    node->GetAttribute(wxS("name")).find('[') != wxString::npos )
+            flags |= ENTRY_EAGER;
+
+        // Only objects can be found by name, don't index anything else, e.g.
+        // the <ids-range> elements which have names too.
+        AddInt(m_entries, IsObjectNode(node) ? AddAttribute(node, wxS("name"))
+                                             : NO_STRING);
+        AddInt(m_entries, AddAttribute(node, wxS("class")));
+        AddInt(m_entries, m_nodes.size());
+        AddInt(m_entries, flags);
+
+        AddNode(node, true);
+    }
+}
+
+inline bool Writer::Save(const wxString& filename) const
+{
+    std::string data(MAGIC, MAGIC_LEN);
+    AddInt(data, VERSION);
+    AddInt(data, m_stringsOffsets.size());
+    AddInt(data, m_entriesCount);
+    AddInt(data, m_nestedCount);
+    AddInt(data, m_nodes.size());
+
+    for ( wxUint32 offset : m_stringsOffsets )
+        AddInt(data, offset);
+    AddInt(data, m_strings.size());
+    data += m_strings;
+
+    data += m_entries;
+    data += m_nested;
+    data += m_nodes;
+
+    wxFFile file(filename, "wb");
+    return file.IsOpened() &&
+            file.Write(data.data(), data.size()) == data.size() &&
+                file.Close();
+}
+
+} // namespace wxXRCBinary
+
+#endif // _WX_XRC_PRIVATE_XMLRESBIN_H_
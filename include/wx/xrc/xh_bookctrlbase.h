@@ -74,6 +74,10 @@ private:
     // True if we're used for parsing the contents of the book control node.
     bool m_isInside;
 
+    // True if the contents of the pages not shown initially should be only
+    // created when they're shown.
+    bool m_deferPages;
+
     wxDECLARE_NO_COPY_CLASS(wxBookCtrlXmlHandlerBase);
 };
 
@@ -25,6 +25,7 @@ public:
 
 private:
     bool m_isInside;
+    bool m_deferPane;
     wxCollapsiblePane *m_collpane;
 
     wxDECLARE_DYNAMIC_CLASS(wxCollapsiblePaneXmlHandler);
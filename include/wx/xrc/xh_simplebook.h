@@ -26,6 +26,7 @@ public:
 
 private:
     bool m_isInside;
+    bool m_deferPages;
     wxSimplebook *m_simplebook;
 
     wxDECLARE_DYNAMIC_CLASS(wxSimplebookXmlHandler);
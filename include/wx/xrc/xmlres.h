@@ -43,6 +43,7 @@ class WXDLLIMPEXP_FWD_XML wxXmlDocument;
 class WXDLLIMPEXP_FWD_XML wxXmlNode;
 class WXDLLIMPEXP_FWD_XRC wxXmlSubclassFactory;
 class wxXmlResourceModule;
+class wxXmlResourceBinary;
 class wxXmlResourceDataRecords;
 class wxXmlResourceInternal;
 
@@ -243,6 +244,12 @@ public:
     // Loads an icon resource from a file.
     wxIcon LoadIcon(const wxString& name);
 
+    // Creates the contents of the given window and all its children which
+    // was deferred, e.g. for the book control pages not shown yet if the
+    // "deferred" property is used for them. Returns true if anything was
+    // created.
+    bool CreateDeferredContents(wxWindow *window);
+
     // Attaches an unknown control to the given panel/window/dialog.
     // Unknown controls are used in conjunction with <object class="unknown">.
     bool AttachUnknownControl(const wxString& name, wxWindow *control,
@@ -392,6 +399,12 @@ protected:
 private:
     wxXmlResourceDataRecords& Data() const;
 
+    // Implementation of DoLoadFile() which can also return the data of the
+    // compiled resources file, allowing to create its nodes on demand later,
+    // instead of creating all of them immediately if binary is null.
+    wxXmlDocument *DoLoadFileOrBinary(const wxString& file,
+                                      wxXmlResourceBinary **binary);
+
     // the real implementation of CreateResFromNode(): this should be only
     // called if node is non-null
     wxObject *DoCreateResFromNode(wxXmlNode& node,
@@ -430,6 +443,7 @@ private:
     friend class wxXmlResourceModule;
     friend class wxIdRangeManager;
     friend class wxIdRange;
+    friend class wxXmlResourceDeferred;
 
     // singleton instance:
     static wxXmlResource *ms_instance;
@@ -669,6 +683,15 @@ public:
     wxObject *CreateResFromNode(wxXmlNode *node,
                                 wxObject *parent, wxObject *instance = nullptr) override;
 
+    // Creates a resource from a node, but defers the creation of its
+    // children until it is shown for the first time.
+    wxObject *CreateResFromNodeWithDeferredChildren(wxXmlNode *node,
+                                                    wxObject *parent) override;
+
+    // Creates a resource from a node as a child of the given window when
+    // the window is shown for the first time.
+    void CreateResFromNodeLater(wxXmlNode *node, wxWindow *parent) override;
+
     // helper
 #if wxUSE_FILESYSTEM
     wxFileSystem& GetCurFileSystem() override;
@@ -133,6 +133,9 @@ public:
                                          wxXmlNode *rootnode = nullptr) = 0;
     virtual wxObject *CreateResFromNode(wxXmlNode *node, wxObject *parent,
                                         wxObject *instance = nullptr) = 0;
+    virtual wxObject *CreateResFromNodeWithDeferredChildren(wxXmlNode *node,
+                                                            wxObject *parent) = 0;
+    virtual void CreateResFromNodeLater(wxXmlNode *node, wxWindow *parent) = 0;
 
 #if wxUSE_FILESYSTEM
     virtual wxFileSystem& GetCurFileSystem() = 0;
@@ -202,6 +205,11 @@ public:
     // a resource from it, false otherwise.
     virtual bool CanHandle(wxXmlNode *node) = 0;
 
+    // Returns the classes of all objects this handler can handle, as declared
+    // by AddHandledClass(), or an empty array if it didn't declare them and
+    // CanHandle() must be called for the objects of any class.
+    const wxArrayString& GetHandledClasses() const { return m_handledClasses; }
+
 
     void SetParentResource(wxXmlResource *res)
     {
@@ -220,6 +228,11 @@ public:
     // Add styles common to all wxWindow-derived classes.
     void AddWindowStyles();
 
+    // Declare that CanHandle() may return true for the objects of the given
+    // class. If this is called at all, it must be called for all the classes
+    // that can be handled, as CanHandle() won't be called for the others.
+    void AddHandledClass(const wxString& classname);
+
 protected:
     // Everything else is simply forwarded to wxXmlResourceHandlerImpl.
     void ReportError(wxXmlNode *context, const wxString& message)
@@ -440,6 +453,15 @@ protected:
     {
         return GetImpl()->CreateResFromNode(node, parent, instance);
     }
+    wxObject *CreateResFromNodeWithDeferredChildren(wxXmlNode *node,
+                                                    wxObject *parent)
+    {
+        return GetImpl()->CreateResFromNodeWithDeferredChildren(node, parent);
+    }
+    void CreateResFromNodeLater(wxXmlNode *node, wxWindow *parent)
+    {
+        GetImpl()->CreateResFromNodeLater(node, parent);
+    }
 
 #if wxUSE_FILESYSTEM
     wxFileSystem& GetCurFileSystem()
@@ -476,6 +498,9 @@ private:
 
     wxXmlResourceHandlerImplBase *m_impl;
 
+    // Classes of the objects that can be handled, may be empty if unknown.
+    wxArrayString m_handledClasses;
+
     wxDECLARE_ABSTRACT_CLASS(wxXmlResourceHandler);
 };
 
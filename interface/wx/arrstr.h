@@ -308,6 +308,33 @@ public:
     */
     void Sort(CompareFunction compareFunction);
 
+    /**
+        Sorts the array using the keys returned by wxGetStringSortKey().
+
+        This function computes the sort key for each string only once and then
+        sorts the array by comparing the keys, which is much faster than
+        calling Sort() with a comparison function for big arrays, especially
+        when using natural sort order as wxCmpNaturalGeneric() needs to split
+        both strings into parts every time it is called.
+
+        @param flags Combination of ::wxSTRING_SORT_DEFAULT,
+            ::wxSTRING_SORT_NOCASE, ::wxSTRING_SORT_LOCALE or
+            ::wxSTRING_SORT_NATURAL, selecting the sort order, and, optionally,
+            ::wxSTRING_SORT_REVERSE to sort in the reverse order and
+            ::wxSTRING_SORT_PARALLEL to use several threads for sorting big
+            arrays on multi-core systems.
+
+        Example of sorting file names in natural order:
+        @code
+        wxArrayString files;
+        wxDir::GetAllFiles(dir, &files);
+        files.SortByKey(wxSTRING_SORT_NATURAL);
+        @endcode
+
+        @since 3.3.2
+    */
+    void SortByKey(int flags = wxSTRING_SORT_DEFAULT);
+
     /**
         Compares 2 arrays respecting the case. Returns @true if the arrays have
         different number of elements or if the elements don't match pairwise.
@@ -614,3 +641,72 @@ wxString wxJoin(const wxArrayString& arr, const wxChar sep,
 
 ///@}
 
+
+/**
+    Flags used by wxGetStringSortKey() and wxArrayString::SortByKey().
+
+    @since 3.3.2
+ */
+enum
+{
+    /// Use the same order as wxString::Cmp().
+    wxSTRING_SORT_DEFAULT   = 0x0000,
+
+    /// Use the same order as wxString::CmpNoCase().
+    wxSTRING_SORT_NOCASE    = 0x0001,
+
+    /**
+        Use the same order as wxStrcoll(), i.e. the current locale collation
+        order.
+
+        If ::wxSTRING_SORT_NOCASE is specified too, the strings are converted
+        to lower case before collating them.
+     */
+    wxSTRING_SORT_LOCALE    = 0x0002,
+
+    /**
+        Use the same order as wxCmpNaturalGeneric().
+
+        Note that this order may differ from wxCmpNatural() under the
+        platforms where it uses the native comparison function.
+     */
+    wxSTRING_SORT_NATURAL   = 0x0004,
+
+    /// Sort in reverse order, only used by wxArrayString::SortByKey().
+    wxSTRING_SORT_REVERSE   = 0x0100,
+
+    /**
+        Use multiple threads for sorting big arrays.
+
+        This flag is only used by wxArrayString::SortByKey() and only has an
+        effect if ::wxUSE_THREADS is 1 and the system has more than one CPU.
+     */
+    wxSTRING_SORT_PARALLEL  = 0x0200
+};
+
+/**
+    Return the binary sort key for the given string.
+
+    The keys returned by this function for different strings and the same
+    @a flags can be compared using the standard std::string comparison
+    operators, or memcmp(), and the result is the same as comparing the
+    strings themselves in the order specified by @a flags. Note that the keys
+    are not human readable and can't be compared with the keys created using
+    different flags or, for ::wxSTRING_SORT_LOCALE and ::wxSTRING_SORT_NATURAL,
+    with the keys created when using a different locale.
+
+    Precomputing the keys is useful when the same strings need to be compared
+    many times, e.g. for sorting. wxArrayString::SortByKey() uses this
+    function to sort the array efficiently.
+
+    @param str The string to compute the key for.
+    @param flags One of ::wxSTRING_SORT_DEFAULT, ::wxSTRING_SORT_NOCASE,
+        ::wxSTRING_SORT_LOCALE (possibly combined with
+        ::wxSTRING_SORT_NOCASE) or ::wxSTRING_SORT_NATURAL.
+
+    @header{wx/arrstr.h}
+
+    @since 3.3.2
+ */
+std::string wxGetStringSortKey(const wxString& str,
+                               int flags = wxSTRING_SORT_DEFAULT);
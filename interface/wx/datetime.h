@@ -1674,6 +1674,114 @@ const wxDateTime wxDefaultDateTime;
 #define wxInvalidDateTime wxDefaultDateTime
 
 
+/**
+    @class wxDateTimeFormatter
+
+    Helper for formatting or parsing many dates using the same format.
+
+    Using this class is equivalent to calling wxDateTime::Format() or
+    wxDateTime::ParseFormat() with the format passed to its constructor, but
+    the format string is analysed only once, when the object is created,
+    instead of doing it on every call. Moreover, the most commonly used
+    numeric fields, i.e. @c "%Y", @c "%m", @c "%d", @c "%H", @c "%M", @c "%S",
+    @c "%l", as well as @c "%F", @c "%T" and @c "%z", are formatted and, if
+    the format contains the full date and uses only these fields, parsed
+    directly, which is significantly faster when formatting or parsing big
+    numbers of dates, e.g. ISO 8601 timestamps in a log file. Any other format
+    specifiers are handled by wxDateTime itself, so the results are always the
+    same as when using it directly.
+
+    Example of use:
+    @code
+        const wxDateTimeFormatter fmt("%Y-%m-%dT%H:%M:%S");
+        for ( const auto& line : lines )
+        {
+            wxDateTime dt;
+            if ( !fmt.Parse(line, &dt) )
+                ... handle invalid date ...
+        }
+    @endcode
+
+    For the RFC 822 format, i.e. @c "%a, %d %b %Y %H:%M:%S %z", the
+    ::Flag_EnglishNames flag should be used to always use the English names
+    of the week days and months, independently of the current locale. In this
+    case the names are also handled by this class directly.
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{data}
+
+    @see wxDateTime::Format(), wxDateTime::ParseFormat()
+*/
+class wxDateTimeFormatter
+{
+public:
+    enum
+    {
+        /// Use the same week day and month names as wxDateTime::Format().
+        Flag_Default = 0,
+
+        /**
+            Always use English week day and month names for @c "%a", @c "%A",
+            @c "%b" and @c "%B" when formatting and parsing.
+
+            Note that if the date can't be parsed using the English names,
+            Parse() still falls back to using wxDateTime::ParseFormat() which
+            uses the names in the current locale.
+         */
+        Flag_EnglishNames = 1
+    };
+
+    /**
+        Create the formatter for the given non-empty format.
+
+        @param format The format in the same syntax as used by
+            wxDateTime::Format() and wxDateTime::ParseFormat().
+        @param flags Either ::Flag_Default or ::Flag_EnglishNames.
+    */
+    explicit wxDateTimeFormatter(const wxString& format,
+                                 int flags = Flag_Default);
+
+    /**
+        Return the format passed to the constructor.
+    */
+    const wxString& GetFormat() const;
+
+    /**
+        Format the given date.
+
+        The result is the same as returned by wxDateTime::Format() for the
+        same format, unless ::Flag_EnglishNames was specified.
+
+        @param dt The date to format, must be valid.
+        @param tz The time zone to use for formatting the date.
+    */
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    /**
+        Parse the given string using the format of this object.
+
+        This function first tries to parse the string quickly, e.g. assuming
+        that all numeric fields have their full width, and falls back to
+        wxDateTime::ParseFormat() if this fails, so it accepts the same
+        strings as the latter.
+
+        @param date The string to parse.
+        @param dt Non-null pointer filled with the parsed date if the
+            function returns @true and not modified otherwise.
+        @param end If non-null, filled with the iterator pointing to the first
+            unparsed character in @a date. If it is @NULL, this function only
+            succeeds if the entire string is parsed.
+        @return @true if the date was parsed successfully.
+    */
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               wxString::const_iterator* end = nullptr) const;
+};
+
+
 /**
     @class wxDateTimeWorkDays
 
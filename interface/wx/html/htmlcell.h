@@ -784,7 +784,22 @@ public:
 class wxHtmlWordCell : public wxHtmlCell
 {
 public:
+    /**
+        Constructor measuring the word using the font currently selected
+        into the given DC.
+    */
     wxHtmlWordCell(const wxString& word, const wxDC& dc);
+
+    /**
+        Constructor using the already known extent of the word.
+
+        This is useful to avoid measuring the same word more than once, the
+        values must be the same as returned by wxDC::GetTextExtent() for this
+        word.
+
+        @since 3.3.2
+    */
+    wxHtmlWordCell(const wxString& word, int width, int height, int descent);
 };
 
 
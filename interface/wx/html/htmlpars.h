@@ -248,6 +248,20 @@ public:
     */
     wxObject* Parse(const wxString& source);
 
+    /**
+        Parses the given fragment of the document.
+
+        This method works exactly like Parse() and the returned product
+        corresponds to the given fragment only, as it is parsed independently
+        of any previously parsed source. However the fragment is appended to
+        the source returned by GetSource() instead of replacing it, which is
+        useful for adding the results of parsing the fragment to the existing
+        product.
+
+        @since 3.3.2
+    */
+    wxObject* ParseFragment(const wxString& fragment);
+
     /**
         Restores parser's state before last call to PushTagHandler().
     */
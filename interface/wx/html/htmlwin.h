@@ -191,9 +191,38 @@ public:
             HTML code fragment
 
         @return @false if an error occurred, @true otherwise.
+
+        @see AppendBlockToPage()
     */
     bool AppendToPage(const wxString& source);
 
+    /**
+        Appends HTML fragment as a new block at the end of the currently
+        displayed page and refreshes the window.
+
+        Unlike AppendToPage(), which parses the entire page again, this
+        function only parses the new fragment, which is much faster when
+        appending to a long page, e.g. when using wxHtmlWindow to show a log
+        to which new messages are continuously added. The cells of the
+        existing page are not laid out again either.
+
+        However the fragment is parsed independently of the existing page,
+        so, unlike with AppendToPage(), it always starts on a new line and is
+        not affected by any tags left open at the end of the page, e.g. it
+        uses the default font and colours even if the page changed them.
+
+        If there is no current page, this function is equivalent to
+        SetPage().
+
+        @param source
+            HTML code fragment
+
+        @return @false if an error occurred, @true otherwise.
+
+        @since 3.3.2
+    */
+    bool AppendBlockToPage(const wxString& source);
+
     /**
         Returns pointer to the top-level container.
 
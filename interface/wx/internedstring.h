@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/internedstring.h
+// Purpose:     interface of wxInternedString
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxInternedString
+
+    Handle to a unique immutable string stored in a global table.
+
+    This class, also known as "atom" or "symbol" in other libraries, is useful
+    for applications using many copies of the same strings, e.g. property,
+    attribute or configuration key names, as each distinct string is stored
+    only once, and, more importantly, comparing two wxInternedString objects
+    only needs to compare two pointers and their hash value is computed only
+    once, when the string is interned, which makes using them as keys in hash
+    maps much more efficient than using wxString.
+
+    Creating wxInternedString from a wxString requires looking it up in the
+    global table, which is protected by a critical section, so it is about as
+    expensive as a hash map lookup. Hence it is only advantageous to use this
+    class for the strings which are created once and then compared or looked
+    up many times.
+
+    The strings added to the table are never removed from it, so this class
+    should not be used with the strings coming from untrusted sources or
+    with a potentially unbounded number of distinct values.
+
+    Example:
+    @code
+        static const wxInternedString KEY_WIDTH("width");
+
+        std::unordered_map<wxInternedString, int> properties;
+        properties[KEY_WIDTH] = 100;
+
+        // Hashing and comparisons use the precomputed hash and the pointer.
+        int width = properties[KEY_WIDTH];
+    @endcode
+
+    This class is thread-safe and can be used from any thread.
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{data}
+
+    @see wxString
+*/
+class wxInternedString
+{
+public:
+    /**
+        Default constructor creates an object corresponding to the empty
+        string.
+    */
+    wxInternedString();
+
+    /**
+        Create an object corresponding to the given string.
+
+        The string is added to the global table if it's not present in it
+        yet.
+    */
+    explicit wxInternedString(const wxString& str);
+
+    /**
+        Return the string this object corresponds to.
+
+        The returned reference remains valid until the end of the program.
+    */
+    const wxString& GetString() const;
+
+    /// Implicit conversion to wxString, same as GetString().
+    operator const wxString&() const;
+
+    /// Return @true if this object corresponds to the empty string.
+    bool empty() const;
+
+    /**
+        Return the hash of the string.
+
+        The hash is computed only once, when the string is added to the
+        table, so this function is very fast. It is used by the
+        specialization of @c std::hash<> for this class.
+    */
+    size_t GetHash() const;
+
+    /**
+        Compare two interned strings.
+
+        This only needs to compare the pointers and so is very fast.
+    */
+    bool operator==(const wxInternedString& other) const;
+    bool operator!=(const wxInternedString& other) const;
+
+    /**
+        Compare with an ordinary string.
+
+        This compares the string contents.
+    */
+    bool operator==(const wxString& str) const;
+    bool operator!=(const wxString& str) const;
+
+    /**
+        Return the number of distinct strings in the global table.
+    */
+    static size_t GetCount();
+};
@@ -30,10 +30,18 @@
     and GetErrorStream() can then be used to retrieve the streams corresponding to the
     child process standard output, input and error output respectively.
 
+    Alternatively, EnableOutputEvents() can be used to get the child output in
+    wxProcessOutputEvent instead of having to poll the streams for it, or
+    RedirectToFiles() can be used to write the output directly into a file.
+
     @beginEventEmissionTable{wxProcessEvent}
     @event{EVT_END_PROCESS(id, func)}
         Process a @c wxEVT_END_PROCESS event, sent by wxProcess::OnTerminate upon
         the external process termination.
+    @event{EVT_PROCESS_OUTPUT(id, func)}
+        Process a @c wxEVT_PROCESS_OUTPUT event, sent when new output of the
+        child process is available if EnableOutputEvents() was called.
+        This event uses wxProcessOutputEvent class.
     @endEventTable
 
     @library{wxbase}
@@ -257,6 +265,76 @@ public:
     */
     void Redirect();
 
+    /**
+        Enables getting the child output in events.
+
+        If this function is called before passing the object to ::wxExecute()
+        together with Redirect(), the output of the child process is read as
+        soon as it becomes available and @c wxEVT_PROCESS_OUTPUT events are
+        generated for it. GetInputStream() and GetErrorStream() return @NULL
+        in this case.
+
+        This is much more efficient than polling the streams, especially for
+        the processes producing a lot of output, as all the available data is
+        read at once, and the data is not copied when the event is processed.
+
+        All the output events are guaranteed to be generated before the
+        @c wxEVT_END_PROCESS one.
+
+        This only works with asynchronous execution and is currently only
+        implemented under Unix, the streams are used as usual otherwise.
+
+        @since 3.3.2
+    */
+    void EnableOutputEvents(bool enable = true);
+
+    /**
+        Returns @true if EnableOutputEvents() had been called.
+
+        @since 3.3.2
+    */
+    bool AreOutputEventsEnabled() const;
+
+    /**
+        Redirects the child output to the given files.
+
+        The files are created, or truncated if they already exist, by
+        ::wxExecute() and the child output is written directly into them,
+        without passing through this process at all.
+
+        @param outFile The name of the file for the child standard output.
+        @param errFile The name of the file for the child standard error, if
+            empty, the standard error is not redirected to a file. It can be
+            the same as @a outFile to write both streams to the same file.
+
+        This function can be combined with Redirect(), in which case the
+        streams not redirected to the files are still available, e.g.
+        GetErrorStream() can be used if @a errFile is empty, while
+        GetInputStream() always returns @NULL.
+
+        Currently only implemented under Unix.
+
+        @since 3.3.2
+    */
+    void RedirectToFiles(const wxString& outFile,
+                         const wxString& errFile = wxString());
+
+    /**
+        Returns the name of the file passed to RedirectToFiles() for the
+        standard output.
+
+        @since 3.3.2
+    */
+    const wxString& GetOutputFile() const;
+
+    /**
+        Returns the name of the file passed to RedirectToFiles() for the
+        standard error.
+
+        @since 3.3.2
+    */
+    const wxString& GetErrorFile() const;
+
     /**
         Sets the priority of the process, between 0 (lowest) and 100 (highest).
         It can only be set before the process is created.
@@ -316,3 +394,77 @@ public:
 
 wxEventType wxEVT_END_PROCESS;
 
+/**
+    @class wxProcessOutputEvent
+
+    This event is sent to wxProcess, and so to the wxEvtHandler specified
+    when creating it, when new output of the child process is available if
+    wxProcess::EnableOutputEvents() was called.
+
+    @beginEventTable{wxProcessOutputEvent}
+    @event{EVT_PROCESS_OUTPUT(id, func)}
+        Process a @c wxEVT_PROCESS_OUTPUT event. @a id is the identifier of
+        the process object (the id passed to the wxProcess constructor).
+    @endEventTable
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{events}
+
+    @see wxProcess, @ref overview_events
+*/
+class wxProcessOutputEvent : public wxEvent
+{
+public:
+    /**
+        Constructor.
+
+        Takes a wxProcess id, a process id, the flag indicating whether the
+        data comes from stderr and the data itself.
+    */
+    wxProcessOutputEvent(int id = 0,
+                         int pid = 0,
+                         bool isError = false,
+                         const wxMemoryBuffer& data = wxMemoryBuffer());
+
+    /**
+        Returns the process id.
+    */
+    int GetPid() const;
+
+    /**
+        Returns @true if the data comes from the child standard error and
+        @false if it comes from its standard output.
+    */
+    bool IsError() const;
+
+    /**
+        Returns the buffer containing the data.
+
+        wxMemoryBuffer is reference-counted, so this buffer can be copied and
+        kept after the event is processed cheaply.
+    */
+    const wxMemoryBuffer& GetBuffer() const;
+
+    /**
+        Returns the pointer to the data.
+    */
+    const void* GetData() const;
+
+    /**
+        Returns the length of the data.
+    */
+    size_t GetDataLen() const;
+
+    /**
+        Returns the data as text in the given encoding.
+
+        Note that a multibyte character may be split between two events, so
+        the data of several events should be concatenated before converting
+        it if this may be a problem.
+    */
+    wxString GetText(const wxMBConv& conv = wxConvUTF8) const;
+};
+
+wxEventType wxEVT_PROCESS_OUTPUT;
@@ -106,6 +106,13 @@ enum
     - Much better performance in many common cases, by a factor of 10-100.
     - Consistent behaviour, including performance, on all platforms.
 
+    Since wxWidgets 3.3.2, the regular expressions are JIT-compiled if PCRE
+    JIT support is available, which makes matching them significantly faster.
+    The compiled expressions are also cached, so that creating several wxRegEx
+    objects using the same pattern and flags is cheap. Note that wxRegEx
+    objects themselves still must not be used from multiple threads
+    concurrently, but different objects using the same pattern can be.
+
     @library{wxbase}
     @category{data}
 
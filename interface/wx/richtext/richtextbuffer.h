@@ -39,6 +39,11 @@ enum wxRichTextFileType
 // the rect passed to Layout.
 #define wxRICHTEXT_LAYOUT_SPECIFIED_RECT 0x10
 
+// Used together with wxRICHTEXT_LAYOUT_SPECIFIED_RECT: only estimate
+// the size of the paragraphs below the rect which haven't been laid
+// out yet instead of laying them out.
+#define wxRICHTEXT_LAYOUT_ESTIMATE  0x20
+
 /**
     Flags to pass to Draw
  */
@@ -3037,6 +3042,16 @@ public:
     */
     bool RemoveChild(wxRichTextObject* child, bool deleteChild = false) ;
 
+    /**
+        Replaces the specified child with another object, optionally deleting
+        the old child.
+
+        Returns @false if @a oldChild is not a child of this object.
+
+        @since 3.3.2
+    */
+    bool ReplaceChild(wxRichTextObject* oldChild, wxRichTextObject* newChild, bool deleteOldChild = false);
+
     /**
         Deletes all the children.
     */
@@ -3053,6 +3068,18 @@ public:
     virtual void Move(const wxPoint& pt);
 
 protected:
+    /**
+        Called after adding, removing or replacing children using the
+        functions of this class.
+
+        The code modifying m_children directly must call this function too,
+        as wxRichTextParagraphLayoutBox overrides it to update the index of
+        its children used for finding them by position.
+
+        @since 3.3.2
+    */
+    virtual void OnChildrenChanged();
+
     wxRichTextObjectList    m_children;
 };
 
@@ -3235,6 +3262,18 @@ public:
     */
     virtual wxRichTextLine* GetLineAtYPosition(int y) const;
 
+    /**
+        Returns the first paragraph which hasn't been laid out yet, i.e. has no
+        lines, and is not above the given y pixel position, or @NULL if there
+        are none.
+
+        Such paragraphs only have an estimated size after laying out the
+        buffer using @c wxRICHTEXT_LAYOUT_ESTIMATE flag.
+
+        @since 3.3.2
+    */
+    wxRichTextParagraph* GetFirstEstimatedParagraph(int y = 0) const;
+
     /**
         Returns the paragraph at the given character or caret position.
     */
@@ -5087,6 +5126,54 @@ public:
     */
     virtual wxRichTextCommand* GetBatchedCommand() const { return m_batchedCommand; }
 
+    /**
+        Sets the maximum amount of memory, in bytes, used by the undo history.
+
+        When it is exceeded after a new command is stored, the oldest commands
+        are discarded, although the current command and the commands which can
+        be redone are always kept. The memory used
+        by the commands is estimated using wxRichTextCommand::GetMemoryUsage().
+
+        The default value of 0 means that the memory used is not limited.
+
+        @since 3.3.2
+    */
+    void SetUndoMemoryLimit(size_t limit);
+
+    /**
+        Returns the maximum amount of memory used by the undo history.
+
+        @see SetUndoMemoryLimit()
+
+        @since 3.3.2
+    */
+    size_t GetUndoMemoryLimit() const;
+
+    /**
+        Sets whether the consecutive characters typed by the user are merged
+        into a single command.
+
+        If this is enabled, typing a word creates a single command, undone at
+        once, instead of a command per character. A new command is started at
+        the start of each word, after a line break or when the text is typed
+        at a different position.
+
+        This is off by default.
+
+        @since 3.3.2
+    */
+    void SetMergeTypingUndo(bool merge);
+
+    /**
+        Returns @true if the consecutive characters typed by the user are
+        merged into a single command.
+
+        @see SetMergeTypingUndo()
+
+        @since 3.3.2
+    */
+    bool GetMergeTypingUndo() const;
+
     /**
         Begin suppressing undo/redo commands. The way undo is suppressed may be implemented
         differently by each command. If not dealt with by a command implementation, then
@@ -6170,6 +6257,14 @@ public:
     */
     wxList& GetActions() { return m_actions; }
 
+    /**
+        Returns the approximate amount of memory, in bytes, used by the actions
+        of this command.
+
+        @since 3.3.2
+    */
+    size_t GetMemoryUsage() const;
+
 protected:
 
     wxList  m_actions;
@@ -6222,6 +6317,49 @@ public:
     */
     void ApplyParagraphs(const wxRichTextParagraphLayoutBox& fragment);
 
+    /**
+        Makes this wxRICHTEXT_CHANGE_STYLE action apply the given style, with
+        the given wxRichTextParagraphLayoutBox::SetStyle() flags, to its range
+        when it is done, instead of replacing the paragraphs with the new
+        fragment.
+
+        Only the attributes of the paragraphs and the runs of objects changed
+        by the style are stored for undoing the action, instead of the copies
+        of all the affected paragraphs, which makes the undo history use much
+        less memory when changing the style of a big selection.
+
+        The range of the action must be set before calling this function,
+        which must be called before the action is done.
+
+        @since 3.3.2
+    */
+    void SetStyleChange(const wxRichTextAttr& style, int flags);
+
+    /**
+        Returns @true if SetStyleChange() was called for this action.
+
+        @since 3.3.2
+    */
+    bool HasStyleChange() const;
+
+    /**
+        Appends the text inserted by the given wxRICHTEXT_INSERT action, which
+        must immediately follow the text inserted by this one, to this action.
+
+        Returns @false, without changing anything, if the actions can't be
+        merged, e.g. because they don't insert plain text within a paragraph.
+
+        @since 3.3.2
+    */
+    bool MergeInsertion(const wxRichTextAction& action);
+
+    /**
+        Returns the approximate amount of memory, in bytes, used by this action.
+
+        @since 3.3.2
+    */
+    size_t GetMemoryUsage() const;
+
     /**
         Returns the new fragments.
     */
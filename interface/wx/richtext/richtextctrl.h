@@ -54,6 +54,10 @@
 #define wxRICHTEXT_DEFAULT_DELAYED_LAYOUT_THRESHOLD 20000
 // Milliseconds before layout occurs after resize
 #define wxRICHTEXT_DEFAULT_LAYOUT_INTERVAL 50
+
+// Height of the part of the buffer laid out in idle time during the
+// incremental layout, in multiples of the window height
+#define wxRICHTEXT_INCREMENTAL_LAYOUT_PAGES 4
 // Milliseconds before delayed image processing occurs
 #define wxRICHTEXT_DEFAULT_DELAYED_IMAGE_PROCESSING_INTERVAL 200
 
@@ -318,6 +322,13 @@ public:
     /**
         Sets the size of the buffer beyond which layout is delayed during resizing.
         This optimizes sizing for large buffers. The default is 20000.
+
+        When the entire buffer exceeding this size needs to be laid out, e.g.
+        after loading a file, only its visible part is laid out immediately and
+        the rest of it is laid out incrementally in idle time, using estimated
+        sizes for the scrollbars until then. @c wxEVT_RICHTEXT_LAYOUT_COMPLETE
+        is generated when this is done. Set the threshold to @c LONG_MAX to
+        always lay out the entire buffer immediately.
     */
     void SetDelayedLayoutThreshold(long threshold);
 
@@ -351,8 +362,20 @@ public:
     */
     void SetFullLayoutSavedPosition(long p);
 
+    /**
+        Returns @true if some parts of the buffer haven't been laid out yet and
+        only have estimated size.
+
+        @see SetDelayedLayoutThreshold()
+
+        @since 3.3.2
+    */
+    bool GetIncrementalLayoutRequired() const;
+
     // Force any pending layout due to large buffer
     /**
+        Forces any pending layout due to delayed, partial layout when the
+        control was resized or due to incremental layout of a large buffer.
     */
     void ForceDelayedLayout();
 
@@ -2271,6 +2294,9 @@ protected:
     wxLongLong              m_fullLayoutTime;
     long                    m_fullLayoutSavedPosition;
 
+    /// Are some paragraphs still to be laid out in idle?
+    bool                    m_incrementalLayoutRequired;
+
     /// Threshold for doing delayed layout
     long                    m_delayedLayoutThreshold;
 
@@ -2376,6 +2402,11 @@ protected:
     @event{EVT_RICHTEXT_FOCUS_OBJECT_CHANGED(id, func)}
         Process a @c wxEVT_RICHTEXT_FOCUS_OBJECT_CHANGED event, generated when the
         current focus object has changed.
+    @event{EVT_RICHTEXT_LAYOUT_COMPLETE(id, func)}
+        Process a @c wxEVT_RICHTEXT_LAYOUT_COMPLETE event, generated when the
+        incremental layout of a large buffer has finished, see
+        wxRichTextCtrl::SetDelayedLayoutThreshold(). This event is available
+        since wxWidgets 3.3.2.
     @endEventTable
 
     @library{wxrichtext}
@@ -2526,3 +2557,4 @@ wxEventType wxEVT_RICHTEXT_PROPERTIES_CHANGED;
 wxEventType wxEVT_RICHTEXT_SELECTION_CHANGED;
 wxEventType wxEVT_RICHTEXT_BUFFER_RESET;
 wxEventType wxEVT_RICHTEXT_FOCUS_OBJECT_CHANGED;
+wxEventType wxEVT_RICHTEXT_LAYOUT_COMPLETE;
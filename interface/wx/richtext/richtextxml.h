@@ -24,6 +24,11 @@
     - wxRICHTEXT_HANDLER_INCLUDE_STYLESHEET
       Include the style sheet in loading and saving operations.
 
+    Since wxWidgets 3.3.2, the document is read sequentially when loading it,
+    without creating the XML nodes for all of it at once: the nodes passed to
+    wxRichTextObject::ImportFromXML() only exist while the top-level object,
+    e.g. a paragraph, containing them is being imported.
+
 
     @library{wxrichtext}
     @category{richtext}
@@ -80,5 +85,16 @@ protected:
         Saves buffer context to the given stream.
     */
     virtual bool DoSaveFile(wxRichTextBuffer* buffer, wxOutputStream& stream);
+
+    /**
+        Imports an object from the element at the current position of the
+        reader, reading its child objects one by one.
+
+        The reader is positioned at the end of the element after the call.
+        Returns @false if an error occurred while reading.
+
+        @since 3.3.2
+    */
+    bool ImportXML(wxRichTextBuffer* buffer, wxRichTextObject* obj, wxXmlReader& reader);
 };
 
@@ -222,6 +222,24 @@ public:
     */
     virtual bool Disconnect();
 
+    /**
+        Enable or disable batching of the outgoing messages.
+
+        By default, the data sent by Execute(), Poke() and Advise() is written
+        to the socket immediately. When batching is enabled, it is buffered
+        instead and all the messages sent before returning to the event loop
+        are written at once, which is much more efficient when sending many
+        small messages, e.g. calling Advise() in a loop.
+
+        Notice that the buffered data is always sent before waiting for the
+        reply to Request(), StartAdvise() or StopAdvise(), so batching doesn't
+        affect the synchronous calls. Flush() can be used to send the buffered
+        data immediately, and disabling batching flushes it too.
+
+        @since 3.3.2
+    */
+    void EnableBatching(bool enable = true);
+
     ///@{
     /**
         Called by the client application to execute a command on the server.
@@ -238,6 +256,15 @@ public:
     bool Execute(const wxString data);
     ///@}
 
+    /**
+        Send all the data buffered because of EnableBatching() immediately.
+
+        Returns @true if successful.
+
+        @since 3.3.2
+    */
+    bool Flush();
+
     /**
         Message sent to the client application when the server notifies it of a
         change in the data associated with the given item.
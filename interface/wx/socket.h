@@ -258,6 +258,35 @@ public:
     */
     bool AcceptWith(wxSocketBase& socket, bool wait = true);
 
+    /**
+        Accept all pending connections at once.
+
+        This function accepts all the incoming connections which are already
+        waiting to be accepted, without ever blocking, and appends the sockets
+        corresponding to them to the provided vector. It is more efficient
+        than calling Accept() in a loop for a server which needs to handle
+        many connections arriving simultaneously, e.g. when called from the
+        @b wxSOCKET_CONNECTION event handler, as only a single event is
+        generated for all of them.
+
+        The returned sockets use the same flags as this one and must be
+        destroyed by the caller using wxSocketBase::Destroy().
+
+        @param sockets
+            Vector to which the new sockets are appended.
+        @param maxCount
+            Maximal number of connections to accept, by default all the
+            pending connections are accepted.
+
+        @return The number of accepted connections, which may be 0.
+
+        @see Accept(), WaitForAccept()
+
+        @since 3.3.2
+    */
+    size_t AcceptAll(std::vector<wxSocketBase*>& sockets,
+                     size_t maxCount = static_cast<size_t>(-1));
+
     /**
         Wait for an incoming connection.
 
@@ -672,6 +701,12 @@ enum wxSocketEventFlags
     @b wxSOCKET_REUSEADDR implies @b SO_REUSEPORT in addition to
     @b SO_REUSEADDR to be consistent with Windows.
 
+    The @b wxSOCKET_REUSEPORT flag controls the use of the @b SO_REUSEPORT
+    @b setsockopt() flag, where it is available. This flag allows several
+    server sockets, typically used by different threads or processes, to
+    listen on the same port, with the system distributing the incoming
+    connections between them.
+
     The @b wxSOCKET_BROADCAST flag controls the use of the @b SO_BROADCAST standard
     @b setsockopt() flag. This flag allows the socket to use the broadcast address,
     and is generally used in conjunction with @b wxSOCKET_NOBIND and
@@ -702,7 +737,8 @@ enum
     wxSOCKET_NOWAIT_READ = 64,    ///< Read as much data as possible and return immediately
     wxSOCKET_WAITALL_READ = 128,  ///< Wait for all required data to be read unless an error occurs.
     wxSOCKET_NOWAIT_WRITE = 256,   ///< Write as much data as possible and return immediately
-    wxSOCKET_WAITALL_WRITE = 512   ///< Wait for all required data to be written unless an error occurs.
+    wxSOCKET_WAITALL_WRITE = 512,  ///< Wait for all required data to be written unless an error occurs.
+    wxSOCKET_REUSEPORT = 1024      ///< Allows several sockets to listen on the same port (since 3.3.2).
 };
 
 
@@ -1131,6 +1167,12 @@ public:
         @flag{wxSOCKET_NOBIND}
             Stops the socket from being bound to a specific adapter (normally
             used in conjunction with @b wxSOCKET_BROADCAST).
+        @flag{wxSOCKET_REUSEPORT}
+            Allows several server sockets to listen on the same address and
+            port, which can be used to accept connections in several threads,
+            each using its own socket (wxServerSocket only, and only on the
+            platforms supporting @c SO_REUSEPORT option, it is ignored
+            elsewhere). This flag is available since wxWidgets 3.3.2.
         @endFlagTable
 
         For more information on socket events see @ref wxSocketFlags .
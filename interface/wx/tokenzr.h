@@ -90,7 +90,7 @@ enum wxStringTokenizerMode
     @library{wxbase}
     @category{data}
 
-    @see ::wxStringTokenize()
+    @see ::wxStringTokenize(), wxStringViewTokenizer
 */
 class wxStringTokenizer : public wxObject
 {
@@ -165,6 +165,161 @@ public:
 };
 
 
+/**
+    @class wxStringTokenView
+
+    A token returned by wxStringViewTokenizer.
+
+    Objects of this class don't contain the characters of the token but just
+    refer to the part of the string being tokenized, so they are cheap to
+    create and copy, but they may only be used as long as this string is not
+    modified nor destroyed.
+
+    Notice that the token is represented in terms of the internal
+    representation of wxString, i.e. the functions data() and size() operate
+    on the UTF-8 bytes and not on the characters when using UTF-8 build.
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{data}
+*/
+class wxStringTokenView
+{
+public:
+    /// Default constructor creates an empty token not referring to anything.
+    wxStringTokenView();
+
+    /// Pointer to the start of the token in the string internal buffer.
+    const wxStringCharType* data() const;
+
+    /// The size of the token in units of wxStringCharType.
+    size_t size() const;
+
+    /// Return @true if the token is empty.
+    bool empty() const;
+
+    /// Return the number of characters in the token.
+    size_t length() const;
+
+    /**
+        Create a new string containing this token.
+
+        Notice that, unlike all the other functions of this class, this one
+        allocates memory for the new string.
+    */
+    wxString ToString() const;
+
+    /**
+        Compare the token with the given string.
+
+        This is more efficient than comparing the string returned by
+        ToString() with it, as no new string needs to be created.
+    */
+    bool IsSameAs(const wxString& str) const;
+
+    ///@{
+    /// Comparison operators, same as IsSameAs().
+    bool operator==(const wxString& str) const;
+    bool operator!=(const wxString& str) const;
+    ///@}
+
+    /**
+        Return the token as a standard string view.
+
+        This function is only available if @c __cpp_lib_string_view is
+        defined, i.e. when using C++17 standard library.
+    */
+    std::basic_string_view<wxStringCharType> ToStdView() const;
+};
+
+/**
+    @class wxStringViewTokenizer
+
+    Tokenizer working in the same way as wxStringTokenizer but not copying the
+    string being tokenized and returning the tokens as wxStringTokenView
+    objects, which don't allocate any memory.
+
+    This makes this class much more efficient than wxStringTokenizer when
+    parsing long strings or strings with many tokens, but, because of this,
+    the string must remain alive and unchanged while this object or any of
+    the tokens returned by it are used. For this reason it is impossible to
+    create this object from a temporary string.
+
+    The tokens can be retrieved in a loop using HasMoreTokens() and
+    GetNextToken(), exactly as with wxStringTokenizer, or using range-based
+    for loop:
+
+    @code
+    const wxString str("first:second:third:fourth");
+    for ( const wxStringTokenView& token : wxStringViewTokenizer(str, ":") )
+    {
+        if ( token == "third" )
+            ...
+    }
+    @endcode
+
+    Searching for the delimiters is optimized for the common case of having
+    only a few ASCII delimiters, so this class may also be used for efficiently
+    parsing large amounts of text, such as CSV files. Notice that using
+    ::wxTOKEN_RET_EMPTY_ALL mode with a single delimiter character returns the
+    same tokens as ::wxSplit() without the escape character, but without
+    allocating memory for them.
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{data}
+
+    @see wxStringTokenizer
+*/
+class wxStringViewTokenizer
+{
+public:
+    /**
+        Constructor taking the string to tokenize, the delimiters and the
+        tokenizer mode.
+
+        The parameters have the same meaning as for
+        wxStringTokenizer::wxStringTokenizer(), however, unlike in that class,
+        the string is not copied and must outlive this object.
+    */
+    wxStringViewTokenizer(const wxString& str,
+                          const wxString& delims = wxDEFAULT_DELIMITERS,
+                          wxStringTokenizerMode mode = wxTOKEN_DEFAULT);
+
+    /// Returns @true if the tokenizer has further tokens.
+    bool HasMoreTokens() const;
+
+    /**
+        Returns the next token or an empty token if there are no more of them.
+    */
+    wxStringTokenView GetNextToken();
+
+    /// Same as wxStringTokenizer::GetLastDelimiter().
+    wxChar GetLastDelimiter() const;
+
+    /**
+        Returns the mode used by the tokenizer.
+
+        This is never ::wxTOKEN_DEFAULT, which is replaced by the actual mode
+        used in the constructor.
+    */
+    wxStringTokenizerMode GetMode() const;
+
+    ///@{
+    /**
+        Iterators allowing to use range-based for loop over the tokens.
+
+        Note that iterating over the tokens consumes them, just as calling
+        GetNextToken() does, so the tokens can be only iterated over once.
+    */
+    const_iterator begin();
+    const_iterator end();
+    ///@}
+};
+
+
 /** @addtogroup group_funcmacro_string */
 ///@{
 
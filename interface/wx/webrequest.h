@@ -5,6 +5,59 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    @class wxWebRequestSink
+
+    Interface for consuming the response data as soon as it's received.
+
+    Objects implementing this interface can be associated with a web request
+    using wxWebRequest::SetDataSink() or wxWebRequestSync::SetDataSink() to
+    process the response data without storing it, which avoids copying it
+    when possible.
+
+    @since 3.3.2
+
+    @library{wxnet}
+    @category{net}
+*/
+class wxWebRequestSink
+{
+public:
+    /**
+        Possible return values of OnData().
+    */
+    enum Action
+    {
+        /// The data was consumed, continue the transfer.
+        Action_Continue,
+
+        /**
+            The data was not consumed and should be passed again when
+            wxWebRequest::Resume() is called.
+
+            This can only be used with the asynchronous requests.
+        */
+        Action_Pause
+    };
+
+    /**
+        Called with the chunk of data received from the server.
+
+        For the synchronous requests, this function is called in the thread
+        executing the request. For the asynchronous ones, it is called in the
+        main thread when using libcurl backend, but may be called from a
+        worker thread with the other backends, so it must not use any GUI
+        functions.
+
+        @param data Pointer to the data, only valid during this call.
+        @param size Size of the data in bytes.
+    */
+    virtual Action OnData(const void* data, size_t size) = 0;
+
+    /// Trivial but virtual destructor.
+    virtual ~wxWebRequestSink();
+};
+
 /**
     @class wxWebRequest
 
@@ -305,6 +358,25 @@ public:
     */
     void Cancel();
 
+    /**
+        Resume passing the data to the sink after it paused it.
+
+        This function should be called after wxWebRequestSink::OnData()
+        returned wxWebRequestSink::Action_Pause, when the sink is ready to
+        accept more data. The data which couldn't be consumed before will be
+        passed to it again, possibly from inside this function itself.
+
+        With libcurl backend, pausing the sink also pauses the transfer, but
+        the other backends keep receiving the data while the sink is paused
+        and just accumulate it in memory. As these backends receive the data
+        in a worker thread, wxWebRequestSink::OnData() may be called either
+        from it or from the thread calling this function, but never from both
+        of them at the same time.
+
+        @since 3.3.2
+    */
+    void Resume();
+
     /**
         Returns a response object after a successful request.
 
@@ -434,9 +506,33 @@ public:
         With this storage method the data is only available during the
         @c wxEVT_WEBREQUEST_DATA event calls as soon as it's received from the
         server.
+
+        @see SetDataSink()
     */
     void SetStorage(Storage storage);
 
+    /**
+        Set the object receiving the response data as soon as it arrives.
+
+        When a sink is set, the response data is passed to its
+        wxWebRequestSink::OnData() function directly from the buffer it was
+        received into whenever possible and is not stored anywhere, i.e. the
+        storage specified by SetStorage() is not used and no
+        @c wxEVT_WEBREQUEST_DATA events are generated.
+
+        This is the most efficient way of processing large amounts of data.
+
+        The sink must remain valid until the request is completed, failed or
+        cancelled and this function can only be called before the request is
+        started.
+
+        @param sink The sink to use, may be @NULL to reset it. The request
+            does not take ownership of it.
+
+        @since 3.3.2
+    */
+    void SetDataSink(wxWebRequestSink* sink);
+
     /**
         Set the timeouts for the connection and total request time.
 
@@ -883,9 +979,33 @@ public:
         With this storage method the data is only available during the
         @c wxEVT_WEBREQUEST_DATA event calls as soon as it's received from the
         server.
+
+        @see SetDataSink()
     */
     void SetStorage(Storage storage);
 
+    /**
+        Set the object receiving the response data as soon as it arrives.
+
+        When a sink is set, the response data is passed to its
+        wxWebRequestSink::OnData() function directly from the buffer it was
+        received into whenever possible and is not stored anywhere, i.e. the
+        storage specified by SetStorage() is not used and no
+        @c wxEVT_WEBREQUEST_DATA events are generated.
+
+        This is the most efficient way of processing large amounts of data.
+
+        The sink must remain valid until the request is completed, failed or
+        cancelled and this function can only be called before the request is
+        started.
+
+        @param sink The sink to use, may be @NULL to reset it. The request
+            does not take ownership of it.
+
+        @since 3.3.2
+    */
+    void SetDataSink(wxWebRequestSink* sink);
+
     /**
         Flags for disabling security features.
 
@@ -1172,6 +1292,38 @@ public:
     wxString AsString() const;
 };
 
+/**
+    @struct wxWebSessionStats
+
+    Statistics about the requests made using wxWebSession or wxWebSessionSync.
+
+    Objects of this type are returned by wxWebSession::GetStats().
+
+    @since 3.3.2
+
+    @library{wxnet}
+    @category{net}
+*/
+struct wxWebSessionStats
+{
+    /// Number of the requests which were completed.
+    wxUint64 requests;
+
+    /// Number of the connections which were opened.
+    wxUint64 connectionsCreated;
+
+    /// Number of the requests which reused an already existing connection.
+    wxUint64 connectionsReused;
+
+    /**
+        Number of the requests which reused the native request handle.
+
+        Reusing the handles avoids the overhead of creating new ones and
+        allows to reuse the DNS and TLS sessions caches associated with them.
+     */
+    wxUint64 handlesReused;
+};
+
 /**
     @class wxWebProxy
 
@@ -1453,6 +1605,47 @@ public:
         @since 3.3.0
      */
     bool EnablePersistentStorage(bool enable);
+
+    /**
+        Limit the number of simultaneous connections to the same host.
+
+        By default, the number of connections is not limited and a new one is
+        opened whenever a request is started while all the existing
+        connections to the same host are busy. Using this function allows to
+        limit the number of connections, in which case the requests are queued
+        until one of the connections becomes available.
+
+        Note that the connections are reused by the subsequent requests to the
+        same host whenever possible and requests using HTTP/2 can share the
+        same connection, so a small limit is usually sufficient.
+
+        @param maxConnections The maximal number of connections, or 0 to
+            remove the limit.
+        @return @true if the backend supports limiting the number of
+            connections, @false otherwise.
+
+        @note This is only implemented in the libcurl backend.
+
+        @since 3.3.2
+     */
+    bool SetMaxConnectionsPerHost(int maxConnections);
+
+    /**
+        Return the statistics about the requests and connections used by this
+        session.
+
+        This can be used to check whether the connections are reused as
+        expected.
+
+        This function should be called from the same thread which uses the
+        session.
+
+        @note This is only implemented in the libcurl backend, the other ones
+            always return all zero statistics.
+
+        @since 3.3.2
+     */
+    wxWebSessionStats GetStats() const;
 };
 
 /**
@@ -1644,6 +1837,48 @@ public:
         @note This is only implemented in the macOS backend.
      */
     bool EnablePersistentStorage(bool enable);
+
+    /**
+        Limit the number of simultaneous connections to the same host.
+
+        By default, the number of connections is not limited and a new one is
+        opened whenever a request is started while all the existing
+        connections to the same host are busy. Using this function allows to
+        limit the number of connections, in which case the requests are queued
+        until one of the connections becomes available.
+
+        Note that the connections are reused by the subsequent requests to the
+        same host whenever possible and requests using HTTP/2 can share the
+        same connection, so a small limit is usually sufficient.
+
+        @param maxConnections The maximal number of connections, or 0 to
+            remove the limit.
+        @return @true if the backend supports limiting the number of
+            connections, @false otherwise.
+
+        @note This is only implemented in the libcurl backend. Synchronous
+            sessions only use a single connection at a time in any case.
+
+        @since 3.3.2
+     */
+    bool SetMaxConnectionsPerHost(int maxConnections);
+
+    /**
+        Return the statistics about the requests and connections used by this
+        session.
+
+        This can be used to check whether the connections are reused as
+        expected.
+
+        This function should be called from the same thread which uses the
+        session.
+
+        @note This is only implemented in the libcurl backend, the other ones
+            always return all zero statistics.
+
+        @since 3.3.2
+     */
+    wxWebSessionStats GetStats() const;
 };
 
 
@@ -553,7 +553,16 @@ public:
 enum wxXmlDocumentLoadFlag
 {
     wxXMLDOC_NONE,
-    wxXMLDOC_KEEP_WHITESPACE_NODES
+    wxXMLDOC_KEEP_WHITESPACE_NODES,
+
+    /**
+        Use compact in-memory representation of the document.
+
+        See wxXmlDocument::Load() for more details.
+
+        @since 3.3.2
+     */
+    wxXMLDOC_COMPACT
 };
 
 
@@ -841,6 +850,20 @@ public:
         less memory however makes impossible to recreate exactly the loaded text with a
         Save() call later. Read the initial description of this class for more info.
 
+        If @a flags contains wxXMLDOC_COMPACT, all nodes and attributes are
+        allocated from a memory arena owned by the document instead of being
+        allocated individually on the heap, the names of the nodes are stored
+        only once, no matter how many times they occur in the document, and
+        the contents of the nodes are kept in UTF-8 and only converted to
+        wxString when they are accessed for the first time. This makes
+        loading and destroying big documents much faster and requires less
+        memory. The document can still be accessed and modified as usual, and
+        the nodes detached from it remain valid even after it is destroyed,
+        but please notice that, unlike with the default representation, even
+        read-only access to the nodes of such document from multiple threads
+        requires synchronization. This flag is available since wxWidgets
+        3.3.2.
+
         Create an wxXmlParseError object and pass it to this function to get more
         information if an error occurred during XML parsing (this parameter is
         only available since wxWidgets 3.3.0).
@@ -939,3 +962,220 @@ public:
     */
     static wxVersionInfo GetLibraryVersionInfo();
 };
+
+
+/**
+    Kinds of the items returned by wxXmlReader::Next().
+
+    @since 3.3.2
+ */
+enum wxXmlReaderItem
+{
+    /// The end of the document was reached.
+    wxXML_READER_EOF,
+
+    /// An error occurred, use wxXmlReader::GetError() for more information.
+    wxXML_READER_ERROR,
+
+    /// Start of an element, its name and attributes are available.
+    wxXML_READER_START_ELEMENT,
+
+    /// End of an element, only its depth is available.
+    wxXML_READER_END_ELEMENT,
+
+    /// Text contents of an element.
+    wxXML_READER_TEXT,
+
+    /// Contents of a CDATA section.
+    wxXML_READER_CDATA,
+
+    /// A comment, its text is available.
+    wxXML_READER_COMMENT,
+
+    /// A processing instruction with the target as name and the data as text.
+    wxXML_READER_PI
+};
+
+/**
+    @class wxXmlReader
+
+    Streaming XML reader.
+
+    Unlike wxXmlDocument, this class doesn't build the tree representing the
+    entire document in memory but returns the items found in the input one by
+    one, which allows processing documents of any size using the amount of
+    memory proportional to their depth only. The input stream is read in
+    chunks of the size specified in the constructor as needed.
+
+    The typical use of this class is:
+    @code
+    wxFileInputStream stream("records.xml");
+    wxXmlReader reader(stream);
+    for ( ;; )
+    {
+        switch ( reader.Next() )
+        {
+            case wxXML_READER_START_ELEMENT:
+                if ( reader.GetName() == "record" )
+                {
+                    // Build the tree for just this element.
+                    std::unique_ptr<wxXmlNode> record(reader.ReadSubtree());
+                    if ( record )
+                        ProcessRecord(record.get());
+                }
+                break;
+
+            case wxXML_READER_ERROR:
+                wxLogError("Parsing error at line %d: %s",
+                           reader.GetError().line, reader.GetError().message);
+                return false;
+
+            case wxXML_READER_EOF:
+                return true;
+
+            default:
+                // Ignore the other items.
+                break;
+        }
+    }
+    @endcode
+
+    Notice that the adjacent text fragments are always merged together and,
+    unless wxXMLDOC_KEEP_WHITESPACE_NODES flag is used, the text consisting of
+    whitespace only is skipped, as in wxXmlDocument::Load().
+
+    @library{wxxml}
+    @category{xml}
+
+    @see wxXmlDocument
+
+    @since 3.3.2
+*/
+class wxXmlReader
+{
+public:
+    /**
+        Create the reader parsing the given stream.
+
+        The stream must remain valid for the lifetime of this object.
+
+        @param stream The stream to read the XML from.
+        @param flags Only wxXMLDOC_KEEP_WHITESPACE_NODES is currently used.
+        @param bufSize The size of the chunks in which the stream is read.
+     */
+    explicit wxXmlReader(wxInputStream& stream,
+                         int flags = wxXMLDOC_NONE,
+                         size_t bufSize = 16384);
+
+    /**
+        Advance to the next item and return its kind.
+
+        Once wxXML_READER_EOF or wxXML_READER_ERROR is returned, all
+        subsequent calls return it too.
+     */
+    wxXmlReaderItem Next();
+
+    /**
+        Return the kind of the current item.
+
+        This is the same value as returned by the last call to Next().
+     */
+    wxXmlReaderItem GetItem() const;
+
+    /**
+        Return the name of the current element or processing instruction
+        target.
+
+        Returns an empty string for the other items.
+     */
+    const wxString& GetName() const;
+
+    /**
+        Return the text of the current text, CDATA, comment or processing
+        instruction item.
+     */
+    const wxString& GetText() const;
+
+    /**
+        Return the depth of the current item.
+
+        The depth of the root element start and end is 1, the depth of its
+        children and text is 2 and so on. The items outside of the root
+        element, such as comments before it, have depth 0.
+     */
+    int GetDepth() const;
+
+    /**
+        Return the line number at which the current item starts.
+     */
+    int GetLineNumber() const;
+
+    /**
+        Return the number of the attributes of the current element.
+
+        Returns 0 if the current item is not an element start.
+     */
+    size_t GetAttributeCount() const;
+
+    /**
+        Return the name of the attribute with the given index.
+
+        @a n must be less than GetAttributeCount().
+     */
+    wxString GetAttributeName(size_t n) const;
+
+    /**
+        Return the value of the attribute with the given index.
+
+        @a n must be less than GetAttributeCount().
+     */
+    wxString GetAttributeValue(size_t n) const;
+
+    /**
+        Get the value of the attribute of the current element.
+
+        Returns @true and fills @a value, if it's non-null, if the attribute
+        exists or returns @false otherwise.
+     */
+    bool GetAttribute(const wxString& attrName, wxString *value) const;
+
+    /**
+        Return the value of the attribute of the current element or
+        @a defaultVal if it doesn't exist.
+     */
+    wxString GetAttribute(const wxString& attrName,
+                          const wxString& defaultVal = wxString()) const;
+
+    /**
+        Return @true if the current element has the given attribute.
+     */
+    bool HasAttribute(const wxString& attrName) const;
+
+    /**
+        Read the entire current element into a tree of wxXmlNode objects.
+
+        This function can only be called when the current item is
+        wxXML_READER_START_ELEMENT. It consumes all items up to and including
+        the end of this element, which becomes the current item.
+
+        The returned node is owned by the caller. Returns @NULL if an error
+        occurred or if the document ended before the end of the element.
+     */
+    wxXmlNode *ReadSubtree();
+
+    /**
+        Skip the entire current element.
+
+        Like ReadSubtree(), but doesn't build any nodes.
+
+        Returns @false if an error occurred or the document ended before the
+        end of the element.
+     */
+    bool SkipSubtree();
+
+    /**
+        Return information about the error, if Next() returned
+        wxXML_READER_ERROR.
+     */
+    const wxXmlParseError& GetError() const;
+};
@@ -101,6 +101,25 @@ public:
     void InsertHandler(wxXmlResourceHandler *handler);
 
 
+    /**
+        Creates the contents of the given window and its children whose
+        creation was deferred.
+
+        When the @c deferred property is used for a book control or
+        wxCollapsiblePane in XRC, the contents of the pages not shown initially
+        or of the collapsed pane is only created when they are shown for the
+        first time. This function can be used to create it immediately, e.g.
+        to allow accessing the controls using XRCCTRL() before this happens.
+
+        @param window The window, typically a dialog or a book control page,
+            whose deferred contents should be created. Must be non-null.
+        @return @true if anything was created, @false if there was nothing
+            deferred under this window.
+
+        @since 3.3.2
+    */
+    bool CreateDeferredContents(wxWindow* window);
+
     /**
         Attaches an unknown control to the given panel/window/dialog.
         Unknown controls are used in conjunction with \<object class="unknown"\>.
@@ -568,6 +587,16 @@ public:
     */
     virtual bool CanHandle(wxXmlNode* node) = 0;
 
+    /**
+        Returns the classes declared by AddHandledClass().
+
+        If the returned array is empty, CanHandle() is called for the objects
+        of any class.
+
+        @since 3.3.2
+    */
+    const wxArrayString& GetHandledClasses() const;
+
     /**
         Sets the parent resource.
     */
@@ -587,6 +616,23 @@ protected:
     */
     void AddWindowStyles();
 
+    /**
+        Declares that CanHandle() may return @true for the objects of the
+        given class.
+
+        Calling this function from the handler constructor allows wxXmlResource
+        to find the handler for an object without calling CanHandle() of all
+        the other handlers, which is much faster when many of them are used.
+
+        If it is called at all, it must be called for all classes which can be
+        handled by this handler, including the classes of any child objects
+        handled only in some context, as CanHandle() is not called for the
+        objects of the other classes any more.
+
+        @since 3.3.2
+    */
+    void AddHandledClass(const wxString& classname);
+
     /**
         Creates children.
     */
@@ -604,6 +650,33 @@ protected:
     wxObject* CreateResFromNode(wxXmlNode* node, wxObject* parent,
                                 wxObject* instance = nullptr);
 
+    /**
+        Creates a resource from a node, but defers creating its children.
+
+        This function creates the object itself immediately, but if it is a
+        window, the children created by its handler using CreateChildren() are
+        only created when the window is shown for the first time or when
+        wxXmlResource::CreateDeferredContents() is called.
+
+        This is used for implementing the @c deferred property of the book
+        controls.
+
+        @since 3.3.2
+    */
+    wxObject* CreateResFromNodeWithDeferredChildren(wxXmlNode* node,
+                                                    wxObject* parent);
+
+    /**
+        Creates a resource from a node as a child of the given window when it
+        is shown for the first time.
+
+        The object is created when @a parent is shown for the first time or
+        when wxXmlResource::CreateDeferredContents() is called for it.
+
+        @since 3.3.2
+    */
+    void CreateResFromNodeLater(wxXmlNode* node, wxWindow* parent);
+
     /**
         Creates an animation (see wxAnimation) from the filename specified in @a param.
 
@@ -17,13 +17,18 @@
 
 #include "wx/arrstr.h"
 #include "wx/scopedarray.h"
+#include "wx/thread.h"
 #include "wx/wxcrt.h"
 
 #include "wx/beforestd.h"
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include "wx/afterstd.h"
 
+// Sort the given strings using their keys, defined below.
+static void wxSortStringsByKey(wxString* strings, size_t count, int flags);
+
 // ============================================================================
 // ArrayString
 // ============================================================================
@@ -92,6 +97,11 @@ void wxArrayString::Sort(bool reverseOrder)
     }
 }
 
+void wxArrayString::SortByKey(int flags)
+{
+    wxSortStringsByKey(data(), size(), flags);
+}
+
 int wxSortedArrayString::Index(const wxString& str,
                                bool WXUNUSED_UNLESS_DEBUG(bCase),
                                bool WXUNUSED_UNLESS_DEBUG(bFromEnd)) const
@@ -501,6 +511,13 @@ void wxArrayString::Sort(bool reverseOrder)
         std::sort(m_pItems, m_pItems + m_nCount);
 }
 
+void wxArrayString::SortByKey(int flags)
+{
+    wxCHECK_RET( !m_autoSort, wxT("can't use this method with sorted arrays") );
+
+    wxSortStringsByKey(m_pItems, m_nCount, flags);
+}
+
 bool wxArrayString::operator==(const wxArrayString& a) const
 {
     if ( m_nCount != a.m_nCount )
@@ -582,15 +599,27 @@ wxString wxJoin(const wxArrayString& arr, const wxChar sep, const wxChar escape)
 
 wxArrayString wxSplit(const wxString& str, const wxChar sep, const wxChar escape)
 {
+    wxArrayString ret;
+
     if ( escape == wxT('\0') )
     {
-        // simple case: we don't need to honour the escape character
-        return wxStringTokenize(str, sep, wxTOKEN_RET_EMPTY_ALL);
+        // simple case: we don't need to honour the escape character, so we
+        // can just create the strings directly from the tokens
+        for ( const wxStringTokenView& token :
+                wxStringViewTokenizer(str, sep, wxTOKEN_RET_EMPTY_ALL) )
+        {
+            ret.push_back(token.ToString());
+        }
+
+        return ret;
     }
 
-    wxArrayString ret;
     wxString curr;
 
+    // Start of the part of the current token which still needs to be appended
+    // to curr: we append the whole runs of normal characters at once.
+    wxString::const_iterator run = str.begin();
+
     for ( wxString::const_iterator i = str.begin(),
                                  end = str.end();
           i != end;
@@ -604,36 +633,42 @@ wxArrayString wxSplit(const wxString& str, const wxChar sep, const wxChar escape
         // in this case).
         if ( ch == sep )
         {
+            curr.append(run, i);
             ret.push_back(curr);
             curr.clear();
+
+            run = i + 1;
         }
         else if ( ch == escape )
         {
-            ++i;
-            if ( i == end )
+            wxString::const_iterator next = i + 1;
+            if ( next == end )
             {
                 // Escape at the end of the string is not handled specially.
-                curr += ch;
                 break;
             }
 
             // Separator or the escape character itself may be escaped,
             // cancelling their special meaning, but escape character followed
             // by anything else is not handled specially.
-            if ( *i != sep && *i != escape )
-                curr += ch;
+            if ( *next == sep || *next == escape )
+            {
+                curr.append(run, i);
+                run = next;
+            }
 
-            curr += *i;
-        }
-        else // normal character
-        {
-            curr += ch;
+            // Skip the escaped character, it's part of the next run anyhow.
+            i = next;
         }
+        //else: normal character, just continue the current run
     }
 
     // add the last token, which we always have unless the string is empty
     if ( !str.empty() )
+    {
+        curr.append(run, str.end());
         ret.Add(curr);
+    }
 
     return ret;
 }
@@ -780,8 +815,285 @@ int CompareFragmentNatural(const wxStringFragment& lhs, const wxStringFragment&
     return 1;
 }
 
+// Append the value to the key using variable length encoding preserving the
+// order, i.e. such that comparing the keys using memcmp() compares the values
+// numerically. This is the same encoding as (original, allowing up to 31 bit
+// values) UTF-8 uses, so that ASCII characters take just a single byte.
+void AppendKeyValue(std::string& key, wxUint32 value)
+{
+    if ( value < 0x80 )
+    {
+        key += static_cast<char>(value);
+        return;
+    }
+
+    // Values which can't be represented are not supposed to occur, but just
+    // clamp them if they do.
+    if ( value > 0x7fffffff )
+        value = 0x7fffffff;
+
+    // Determine the number of continuation bytes needed.
+    int count;
+    if ( value < 0x800 )
+        count = 1;
+    else if ( value < 0x10000 )
+        count = 2;
+    else if ( value < 0x200000 )
+        count = 3;
+    else if ( value < 0x4000000 )
+        count = 4;
+    else
+        count = 5;
+
+    // The leading byte has count + 1 highest bits set followed by 0.
+    const unsigned lead = (0xff00 >> (count + 1)) & 0xff;
+    key += static_cast<char>(lead | (value >> (6*count)));
+    while ( count-- )
+        key += static_cast<char>(0x80 | ((value >> (6*count)) & 0x3f));
+}
+
+// Append the number as 64-bit big endian value.
+void AppendKeyNumber(std::string& key, wxUint64 value)
+{
+    for ( int shift = 56; shift >= 0; shift -= 8 )
+        key += static_cast<char>((value >> shift) & 0xff);
+}
+
+// Append the key for comparing strings characters, terminated by 0 value
+// which is less than the value of any character (even NUL).
+void AppendCharsKey(std::string& key, const wxString& str, bool noCase)
+{
+    for ( wxString::const_iterator it = str.begin(); it != str.end(); ++it )
+    {
+        const wxUniChar ch = noCase ? wxTolower(*it) : *it;
+        AppendKeyValue(key, ch.GetValue() + 1);
+    }
+
+    AppendKeyValue(key, 0);
+}
+
+// Append the key for comparing strings using wxStrcoll(), terminated by 0.
+void AppendCollationKey(std::string& key, const wxString& str)
+{
+#if defined(wxCRT_StrxfrmA) && defined(wxCRT_StrxfrmW)
+    // NB: as in wxStrcoll_String(), we have to use wc_str() even when using
+    //     UTF-8 internally.
+    const wxWCharBuffer wbuf(str.wc_str());
+
+    const size_t len = wxStrxfrm(nullptr, wbuf.data(), 0);
+    if ( len != static_cast<size_t>(-1) )
+    {
+        wxWCharBuffer xfrm(len);
+        wxStrxfrm(xfrm.data(), wbuf.data(), len + 1);
+
+        key.reserve(key.length() + len + 1);
+        for ( size_t n = 0; n < len; n++ )
+            AppendKeyValue(key, static_cast<wxUint32>(xfrm[n]));
+
+        AppendKeyValue(key, 0);
+        return;
+    }
+    //else: fall back to comparing the characters below
+#endif // wxCRT_Strxfrm[AW]
+
+    AppendCharsKey(key, str, false /* case-sensitive */);
+}
+
+// Append the key corresponding to wxCmpNaturalGeneric() order.
+void AppendNaturalKey(std::string& key, const wxString& str)
+{
+    wxString text(str);
+    for ( ;; )
+    {
+        // Note that the fragment types are ordered in the same way as
+        // CompareFragmentNatural() orders them.
+        const wxStringFragment fragment = GetFragment(text);
+        key += static_cast<char>(fragment.type);
+
+        switch ( fragment.type )
+        {
+            case wxStringFragment::Empty:
+                return;
+
+            case wxStringFragment::SpaceOrPunct:
+                AppendCollationKey(key, fragment.text);
+                break;
+
+            case wxStringFragment::Digit:
+                AppendKeyNumber(key, fragment.value);
+                break;
+
+            case wxStringFragment::LetterOrSymbol:
+                AppendCollationKey(key, fragment.text.Lower());
+                break;
+        }
+    }
+}
+
+struct wxStringSortItem
+{
+    std::string key;
+    size_t index;
+};
+
+#if wxUSE_THREADS
+
+// Simple thread used for sorting the strings in parallel.
+class wxStringSortThread : public wxThread
+{
+public:
+    explicit wxStringSortThread(const std::function<void()>& func)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_func(func)
+    {
+    }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        m_func();
+
+        return nullptr;
+    }
+
+private:
+    const std::function<void()> m_func;
+};
+
+// Don't bother with using threads for fewer strings than this per thread.
+const size_t MIN_STRINGS_PER_THREAD = 4096;
+
+#endif // wxUSE_THREADS
+
 } // unnamed namespace
 
+// ----------------------------------------------------------------------------
+// sort keys
+// ----------------------------------------------------------------------------
+
+std::string wxGetStringSortKey(const wxString& str, int flags)
+{
+    std::string key;
+
+    if ( flags & wxSTRING_SORT_NATURAL )
+    {
+        AppendNaturalKey(key, str);
+    }
+    else if ( flags & wxSTRING_SORT_LOCALE )
+    {
+        AppendCollationKey(key, flags & wxSTRING_SORT_NOCASE ? str.Lower()
+                                                             : str);
+    }
+    else
+    {
+        key.reserve(str.length() + 1);
+        AppendCharsKey(key, str, (flags & wxSTRING_SORT_NOCASE) != 0);
+    }
+
+    return key;
+}
+
+static void wxSortStringsByKey(wxString* strings, size_t count, int flags)
+{
+    if ( count < 2 )
+        return;
+
+    std::vector<wxStringSortItem> items(count);
+
+    const bool reverse = (flags & wxSTRING_SORT_REVERSE) != 0;
+    const auto compare = [reverse](const wxStringSortItem& item1,
+                                   const wxStringSortItem& item2)
+    {
+        return reverse ? item2.key < item1.key : item1.key < item2.key;
+    };
+
+    // Compute the keys for the items in the given range and sort them.
+    const auto sortRange = [&](size_t from, size_t to)
+    {
+        for ( size_t n = from; n < to; n++ )
+        {
+            items[n].key = wxGetStringSortKey(strings[n], flags);
+            items[n].index = n;
+        }
+
+        std::sort(items.begin() + from, items.begin() + to, compare);
+    };
+
+    size_t numChunks = 1;
+#if wxUSE_THREADS
+    if ( flags & wxSTRING_SORT_PARALLEL )
+    {
+        const int numCPUs = wxThread::GetCPUCount();
+        if ( numCPUs > 1 )
+        {
+            numChunks = wxMin(static_cast<size_t>(numCPUs),
+                              count / MIN_STRINGS_PER_THREAD);
+            if ( !numChunks )
+                numChunks = 1;
+        }
+    }
+#endif // wxUSE_THREADS
+
+    if ( numChunks == 1 )
+    {
+        sortRange(0, count);
+    }
+#if wxUSE_THREADS
+    else
+    {
+        std::vector<size_t> bounds(numChunks + 1);
+        for ( size_t n = 0; n <= numChunks; n++ )
+            bounds[n] = (count * n) / numChunks;
+
+        // Sort all chunks except the first one in the worker threads and the
+        // first one in this thread.
+        std::vector<std::unique_ptr<wxThread>> threads;
+        for ( size_t n = 1; n < numChunks; n++ )
+        {
+            const auto func = [&sortRange, &bounds, n]()
+            {
+                sortRange(bounds[n], bounds[n + 1]);
+            };
+
+            std::unique_ptr<wxThread> thread(new wxStringSortThread(func));
+            if ( thread->Run() != wxTHREAD_NO_ERROR )
+            {
+                // Just do it in this thread then.
+                func();
+                continue;
+            }
+
+            threads.push_back(std::move(thread));
+        }
+
+        sortRange(bounds[0], bounds[1]);
+
+        for ( const auto& thread : threads )
+            thread->Wait();
+
+        // And merge the sorted chunks together.
+        for ( size_t width = 1; width < numChunks; width *= 2 )
+        {
+            for ( size_t n = 0; n + width < numChunks; n += 2*width )
+            {
+                std::inplace_merge(items.begin() + bounds[n],
+                                   items.begin() + bounds[n + width],
+                                   items.begin() + bounds[wxMin(n + 2*width,
+                                                                numChunks)],
+                                   compare);
+            }
+        }
+    }
+#endif // wxUSE_THREADS
+
+    std::vector<wxString> sorted;
+    sorted.reserve(count);
+    for ( const auto& item : items )
+        sorted.push_back(std::move(strings[item.index]));
+
+    for ( size_t n = 0; n < count; n++ )
+        strings[n] = std::move(sorted[n]);
+}
 
 // ----------------------------------------------------------------------------
 // wxCmpNaturalGeneric
@@ -33,6 +33,7 @@
 
 #include "wx/apptrait.h"
 #include "wx/file.h"
+#include "wx/tokenzr.h"
 
 #include <stdlib.h>
 #include <ctype.h>
@@ -562,39 +563,25 @@ void wxSplitPath(wxArrayString& aParts, const wxString& path)
 {
   aParts.clear();
 
-  wxString strCurrent;
-  wxString::const_iterator pc = path.begin();
-  for ( ;; ) {
-    if ( pc == path.end() || *pc == wxCONFIG_PATH_SEPARATOR ) {
-      if ( strCurrent == wxT(".") ) {
-        // ignore
-      }
-      else if ( strCurrent == wxT("..") ) {
-        // go up one level
-        if ( aParts.size() == 0 )
-        {
-          wxLogWarning(_("'%s' has extra '..', ignored."), path);
-        }
-        else
-        {
-          aParts.erase(aParts.end() - 1);
-        }
-
-        strCurrent.Empty();
+  // extra '/' are ignored, so we don't need the empty tokens
+  for ( const wxStringTokenView& part :
+          wxStringViewTokenizer(path, wxCONFIG_PATH_SEPARATOR, wxTOKEN_STRTOK) ) {
+    if ( part == wxT(".") ) {
+      // ignore
+    }
+    else if ( part == wxT("..") ) {
+      // go up one level
+      if ( aParts.size() == 0 )
+      {
+        wxLogWarning(_("'%s' has extra '..', ignored."), path);
       }
-      else if ( !strCurrent.empty() ) {
-        aParts.push_back(strCurrent);
-        strCurrent.Empty();
+      else
+      {
+        aParts.erase(aParts.end() - 1);
       }
-      //else:
-        // could log an error here, but we prefer to ignore extra '/'
-
-      if ( pc == path.end() )
-        break;
     }
-    else
-      strCurrent += *pc;
-
-    ++pc;
+    else {
+      aParts.push_back(part.ToString());
+    }
   }
 }
@@ -2318,6 +2318,565 @@ bool wxDateTime::IsWorkDay(Country WXUNUSED(country)) const
     return !wxDateTimeHolidayAuthority::IsHoliday(*this);
 }
 
+// ============================================================================
+// wxDateTimeFormatter
+// ============================================================================
+
+namespace
+{
+
+// Append the number padded with zeroes to the given width, just as "%0Nd"
+// would do it, but without the overhead of using wxString::Format().
+void AppendZeroPadded(wxString& str, int n, int width)
+{
+    wxChar buf[16];
+    int pos = WXSIZEOF(buf);
+
+    if ( n < 0 )
+    {
+        // Fall back to the slow but general version for this rare case.
+        str += wxString::Format(wxS("%0*d"), width, n);
+        return;
+    }
+
+    do
+    {
+        buf[--pos] = wxT('0') + n % 10;
+        n /= 10;
+    }
+    while ( n );
+
+    while ( pos > static_cast<int>(WXSIZEOF(buf)) - width )
+        buf[--pos] = wxT('0');
+
+    str.append(buf + pos, WXSIZEOF(buf) - pos);
+}
+
+// Scan exactly the given number of ASCII digits.
+bool
+ScanFixedDigits(wxString::const_iterator& p,
+                const wxString::const_iterator& end,
+                int count,
+                int* number)
+{
+    int n = 0;
+    for ( ; count; --count, ++p )
+    {
+        if ( p == end || *p < wxT('0') || *p > wxT('9') )
+            return false;
+
+        n = 10*n + (*p - wxT('0'));
+    }
+
+    *number = n;
+
+    return true;
+}
+
+// Scan the English week day name and return it or -1.
+int
+ScanEnglishWeekDay(wxString::const_iterator& p,
+                   const wxString::const_iterator& end,
+                   wxDateTime::NameForm form)
+{
+    const wxString name = GetAlphaToken(p, end);
+    for ( int n = 0; n < 7; n++ )
+    {
+        const wxDateTime::WeekDay wd = static_cast<wxDateTime::WeekDay>(n);
+        if ( name.CmpNoCase(wxDateTime::GetEnglishWeekDayName(wd, form)) == 0 )
+            return n;
+    }
+
+    return -1;
+}
+
+// Scan the English month name and return its 1-based number or -1.
+int
+ScanEnglishMonth(wxString::const_iterator& p,
+                 const wxString::const_iterator& end,
+                 wxDateTime::NameForm form)
+{
+    const wxString name = GetAlphaToken(p, end);
+    for ( int n = 0; n < 12; n++ )
+    {
+        const wxDateTime::Month mon = static_cast<wxDateTime::Month>(n);
+        if ( name.CmpNoCase(wxDateTime::GetEnglishMonthName(mon, form)) == 0 )
+            return n + 1;
+    }
+
+    return -1;
+}
+
+} // anonymous namespace
+
+wxDateTimeFormatter::wxDateTimeFormatter(const wxString& format, int flags)
+    : m_format(format),
+      m_flags(flags)
+{
+    wxASSERT_MSG( !format.empty(), "format can't be empty" );
+
+    bool haveYear = false,
+         haveMon = false,
+         haveDay = false;
+
+    m_canParseFast = true;
+
+    Element literal;
+    literal.spec = 0;
+
+    for ( wxString::const_iterator p = format.begin(); p != format.end(); ++p )
+    {
+        if ( *p != wxT('%') )
+        {
+            literal.text += *p;
+            continue;
+        }
+
+        const wxString::const_iterator start = p;
+        if ( ++p == format.end() )
+        {
+            // Trailing "%" is not a valid format specification, but just
+            // treat it as a literal character, it is not our job to validate
+            // the format.
+            literal.text += wxT('%');
+            m_canParseFast = false;
+            break;
+        }
+
+        if ( *p == wxT('%') )
+        {
+            literal.text += wxT('%');
+            continue;
+        }
+
+        Element elem;
+        elem.spec = 0;
+
+        // Skip the flags and the width, if any: we don't handle them, so
+        // just pass them to wxDateTime::Format() as is.
+        while ( p + 1 != format.end() &&
+                    (*p == wxT('-') || *p == wxT('+') || *p == wxT('_') ||
+                     *p == wxT(' ') || wxIsdigit(*p)) )
+        {
+            ++p;
+        }
+
+        if ( p - start == 1 )
+        {
+            switch ( (*p).GetValue() )
+            {
+                case wxT('Y'):
+                    haveYear = true;
+                    elem.spec = *p;
+                    break;
+
+                case wxT('m'):
+                    haveMon = true;
+                    elem.spec = *p;
+                    break;
+
+                case wxT('d'):
+                    haveDay = true;
+                    elem.spec = *p;
+                    break;
+
+                case wxT('F'):
+                    haveYear = haveMon = haveDay = true;
+                    elem.spec = *p;
+                    break;
+
+                case wxT('H'):
+                case wxT('M'):
+                case wxT('S'):
+                case wxT('T'):
+                case wxT('l'):
+                case wxT('z'):
+                    elem.spec = *p;
+                    break;
+
+                case wxT('y'):
+                    // This one can be formatted but not parsed by us.
+                    elem.spec = *p;
+                    m_canParseFast = false;
+                    break;
+
+                case wxT('a'):
+                case wxT('A'):
+                case wxT('b'):
+                case wxT('B'):
+                    if ( m_flags & Flag_EnglishNames )
+                        elem.spec = *p;
+                    break;
+            }
+        }
+
+        if ( !elem.spec )
+        {
+            elem.spec = wxT('%');
+            elem.text.assign(start, p + 1);
+            m_canParseFast = false;
+        }
+
+        if ( !literal.text.empty() )
+        {
+            m_elements.push_back(literal);
+            literal.text.clear();
+        }
+
+        m_elements.push_back(elem);
+    }
+
+    if ( !literal.text.empty() )
+        m_elements.push_back(literal);
+
+    // We need to have the full date to avoid having to deal with the default
+    // values for the missing fields.
+    if ( !haveYear || !haveMon || !haveDay )
+        m_canParseFast = false;
+}
+
+wxString
+wxDateTimeFormatter::Format(const wxDateTime& dt,
+                            const wxDateTime::TimeZone& tz) const
+{
+    wxCHECK_MSG( dt.IsValid(), wxString(), "invalid wxDateTime" );
+
+    wxDateTime::Tm tm = dt.GetTm(tz);
+
+    wxString res;
+    res.reserve(m_format.length() + 16);
+
+    for ( const auto& elem : m_elements )
+    {
+        switch ( elem.spec )
+        {
+            case 0:
+                res += elem.text;
+                break;
+
+            case wxT('%'):
+                res += dt.Format(elem.text, tz);
+                break;
+
+            case wxT('Y'):
+                AppendZeroPadded(res, tm.year, 4);
+                break;
+
+            case wxT('m'):
+                AppendZeroPadded(res, tm.mon + 1, 2);
+                break;
+
+            case wxT('d'):
+                AppendZeroPadded(res, tm.mday, 2);
+                break;
+
+            case wxT('F'):
+                AppendZeroPadded(res, tm.year, 4);
+                res += wxT('-');
+                AppendZeroPadded(res, tm.mon + 1, 2);
+                res += wxT('-');
+                AppendZeroPadded(res, tm.mday, 2);
+                break;
+
+            case wxT('H'):
+                AppendZeroPadded(res, tm.hour, 2);
+                break;
+
+            case wxT('M'):
+                AppendZeroPadded(res, tm.min, 2);
+                break;
+
+            case wxT('S'):
+                AppendZeroPadded(res, tm.sec, 2);
+                break;
+
+            case wxT('T'):
+                AppendZeroPadded(res, tm.hour, 2);
+                res += wxT(':');
+                AppendZeroPadded(res, tm.min, 2);
+                res += wxT(':');
+                AppendZeroPadded(res, tm.sec, 2);
+                break;
+
+            case wxT('l'):
+                AppendZeroPadded(res, tm.msec, 3);
+                break;
+
+            case wxT('y'):
+                AppendZeroPadded(res, tm.year % 100, 2);
+                break;
+
+            case wxT('z'):
+                {
+                    // This must be consistent with wxDateTime::Format().
+                    int ofs = tz.GetOffset();
+                    if ( ofs == -wxGetTimeZone() && dt.IsDST() == 1 )
+                        ofs += wxDateTime::DST_OFFSET;
+
+                    if ( ofs < 0 )
+                    {
+                        res += wxT('-');
+                        ofs = -ofs;
+                    }
+                    else
+                    {
+                        res += wxT('+');
+                    }
+
+                    AppendZeroPadded(res, 100*(ofs/3600) + (ofs/60)%60, 4);
+                }
+                break;
+
+            case wxT('a'):
+            case wxT('A'):
+                res += wxDateTime::GetEnglishWeekDayName
+                       (
+                        tm.GetWeekDay(),
+                        elem.spec == wxT('a') ? wxDateTime::Name_Abbr
+                                              : wxDateTime::Name_Full
+                       );
+                break;
+
+            case wxT('b'):
+            case wxT('B'):
+                res += wxDateTime::GetEnglishMonthName
+                       (
+                        tm.mon,
+                        elem.spec == wxT('b') ? wxDateTime::Name_Abbr
+                                              : wxDateTime::Name_Full
+                       );
+                break;
+
+            default:
+                wxFAIL_MSG( "unexpected format element" );
+        }
+    }
+
+    return res;
+}
+
+bool
+wxDateTimeFormatter::DoParseFast(const wxString& date,
+                                 wxDateTime* dt,
+                                 wxString::const_iterator* end) const
+{
+    int year = 0,
+        mon = 0,
+        mday = 0,
+        hour = 0,
+        min = 0,
+        sec = 0,
+        msec = 0;
+
+    int wday = -1;
+
+    bool haveTimeZone = false;
+    long timeZone = 0;
+
+    wxString::const_iterator p = date.begin();
+    const wxString::const_iterator pEnd = date.end();
+
+    for ( const auto& elem : m_elements )
+    {
+        switch ( elem.spec )
+        {
+            case 0:
+                for ( const auto& ch : elem.text )
+                {
+                    if ( wxIsspace(ch) )
+                    {
+                        // As in ParseFormat(), white space in the format
+                        // matches any amount of it, including none, in the
+                        // input.
+                        while ( p != pEnd && wxIsspace(*p) )
+                            ++p;
+                    }
+                    else
+                    {
+                        if ( p == pEnd || *p != ch )
+                            return false;
+
+                        ++p;
+                    }
+                }
+                break;
+
+            case wxT('Y'):
+                if ( !ScanFixedDigits(p, pEnd, 4, &year) )
+                    return false;
+                break;
+
+            case wxT('m'):
+                if ( !ScanFixedDigits(p, pEnd, 2, &mon) )
+                    return false;
+                break;
+
+            case wxT('d'):
+                if ( !ScanFixedDigits(p, pEnd, 2, &mday) )
+                    return false;
+                break;
+
+            case wxT('F'):
+                if ( !ScanFixedDigits(p, pEnd, 4, &year) ||
+                        p == pEnd || *p++ != wxT('-') ||
+                        !ScanFixedDigits(p, pEnd, 2, &mon) ||
+                            p == pEnd || *p++ != wxT('-') ||
+                                !ScanFixedDigits(p, pEnd, 2, &mday) )
+                    return false;
+                break;
+
+            case wxT('H'):
+                if ( !ScanFixedDigits(p, pEnd, 2, &hour) )
+                    return false;
+                break;
+
+            case wxT('M'):
+                if ( !ScanFixedDigits(p, pEnd, 2, &min) )
+                    return false;
+                break;
+
+            case wxT('S'):
+                if ( !ScanFixedDigits(p, pEnd, 2, &sec) )
+                    return false;
+                break;
+
+            case wxT('T'):
+                if ( !ScanFixedDigits(p, pEnd, 2, &hour) ||
+                        p == pEnd || *p++ != wxT(':') ||
+                        !ScanFixedDigits(p, pEnd, 2, &min) ||
+                            p == pEnd || *p++ != wxT(':') ||
+                                !ScanFixedDigits(p, pEnd, 2, &sec) )
+                    return false;
+                break;
+
+            case wxT('l'):
+                if ( !ScanFixedDigits(p, pEnd, 3, &msec) )
+                    return false;
+                break;
+
+            case wxT('z'):
+                if ( p == pEnd )
+                    return false;
+
+                if ( *p == wxT('Z') )
+                {
+                    ++p;
+                }
+                else
+                {
+                    // Only handle the most common forms here, i.e. +HHMM
+                    // and +HH:MM, and leave the others to ParseFormat().
+                    const bool minus = *p == wxT('-');
+                    if ( !minus && *p != wxT('+') )
+                        return false;
+
+                    ++p;
+
+                    int tzHours, tzMinutes;
+                    if ( !ScanFixedDigits(p, pEnd, 2, &tzHours) )
+                        return false;
+
+                    if ( p != pEnd && *p == wxT(':') )
+                        ++p;
+
+                    if ( !ScanFixedDigits(p, pEnd, 2, &tzMinutes) )
+                        return false;
+
+                    if ( tzHours > 15 || tzMinutes > 59 )
+                        return false;
+
+                    timeZone = 3600*tzHours + 60*tzMinutes;
+                    if ( minus )
+                        timeZone = -timeZone;
+                }
+
+                haveTimeZone = true;
+                break;
+
+            case wxT('a'):
+            case wxT('A'):
+                wday = ScanEnglishWeekDay(p, pEnd,
+                                          elem.spec == wxT('a')
+                                            ? wxDateTime::Name_Abbr
+                                            : wxDateTime::Name_Full);
+                if ( wday == -1 )
+                    return false;
+                break;
+
+            case wxT('b'):
+            case wxT('B'):
+                mon = ScanEnglishMonth(p, pEnd,
+                                       elem.spec == wxT('b')
+                                        ? wxDateTime::Name_Abbr
+                                        : wxDateTime::Name_Full);
+                if ( mon == -1 )
+                    return false;
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    if ( !end && p != pEnd )
+        return false;
+
+    // Perform the same checks as ParseFormat() does, except that we also
+    // reject leap seconds and let ParseFormat() deal with them.
+    if ( mon < 1 || mon > 12 )
+        return false;
+
+    const wxDateTime::Month month = static_cast<wxDateTime::Month>(mon - 1);
+    if ( mday < 1 || mday > wxDateTime::GetNumberOfDays(month, year) )
+        return false;
+
+    if ( hour > 23 || min > 59 || sec > 59 )
+        return false;
+
+    wxDateTime dtParsed(static_cast<wxDateTime::wxDateTime_t>(mday), month, year,
+                        static_cast<wxDateTime::wxDateTime_t>(hour),
+                        static_cast<wxDateTime::wxDateTime_t>(min),
+                        static_cast<wxDateTime::wxDateTime_t>(sec),
+                        static_cast<wxDateTime::wxDateTime_t>(msec));
+    if ( haveTimeZone )
+        dtParsed.MakeFromTimezone(timeZone);
+
+    if ( wday != -1 && dtParsed.GetWeekDay() != wday )
+        return false;
+
+    *dt = dtParsed;
+    if ( end )
+        *end = p;
+
+    return true;
+}
+
+bool
+wxDateTimeFormatter::Parse(const wxString& date,
+                           wxDateTime* dt,
+                           wxString::const_iterator* end) const
+{
+    wxCHECK_MSG( dt, false, "date pointer must be specified" );
+
+    if ( m_canParseFast && DoParseFast(date, dt, end) )
+        return true;
+
+    // Fall back to the general, but slower, code.
+    wxDateTime dtParsed;
+    wxString::const_iterator endParse;
+    if ( !dtParsed.ParseFormat(date, m_format, &endParse) )
+        return false;
+
+    if ( end )
+        *end = endParse;
+    else if ( endParse != date.end() )
+        return false;
+
+    *dt = dtParsed;
+
+    return true;
+}
+
 // ============================================================================
 // wxDateSpan
 // ============================================================================
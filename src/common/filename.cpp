@@ -489,12 +489,9 @@ wxFileName::DoSetPath(const wxString& pathOrig, wxPathFormat format, int flags)
     //    was just "/" or "\\", m_dirs will be empty. We know from
     //    the m_relative field, if this means "nothing" or "root dir".
 
-    wxStringTokenizer tn( path, GetPathSeparators(format) );
-
-    while ( tn.HasMoreTokens() )
+    for ( const wxStringTokenView& token :
+            wxStringViewTokenizer(path, GetPathSeparators(format)) )
     {
-        wxString token = tn.GetNextToken();
-
         // Remove empty token under DOS and Unix, interpret them
         // as .. under Mac.
         if (token.empty())
@@ -505,7 +502,7 @@ wxFileName::DoSetPath(const wxString& pathOrig, wxPathFormat format, int flags)
         }
         else
         {
-           m_dirs.Add( token );
+           m_dirs.Add( token.ToString() );
         }
     }
 }
@@ -256,20 +256,29 @@ bool wxHTTP::ParseHeaders()
         if ( line.empty() )
             break;
 
-        wxString left_str = line.BeforeFirst(':');
-        if(!left_str.CmpNoCase("Set-Cookie"))
+        // Split the line into the header name and value only once.
+        wxString left_str, value;
+        const size_t posColon = line.find(':');
+        if ( posColon == wxString::npos )
         {
-            wxString cookieName = line.AfterFirst(':').Strip(wxString::both).BeforeFirst('=');
-            wxString cookieValue = line.AfterFirst(':').Strip(wxString::both).AfterFirst('=').BeforeFirst(';');
-            m_cookies[cookieName] = cookieValue;
-
-            // For compatibility
-            m_headers[left_str] = line.AfterFirst(':').Strip(wxString::both);
+            left_str = line;
         }
         else
         {
-            m_headers[left_str] = line.AfterFirst(':').Strip(wxString::both);
+            left_str.assign(line, 0, posColon);
+            value.assign(line, posColon + 1, wxString::npos);
+            value.Trim(false).Trim(true);
         }
+
+        if(!left_str.CmpNoCase("Set-Cookie"))
+        {
+            wxString cookieName = value.BeforeFirst('=');
+            wxString cookieValue = value.AfterFirst('=').BeforeFirst(';');
+            m_cookies[cookieName] = cookieValue;
+        }
+
+        // For compatibility, Set-Cookie is stored as a header too.
+        m_headers[left_str] = value;
     }
     return true;
 }
@@ -386,12 +395,12 @@ bool wxHTTP::BuildRequest(const wxString& path, const wxString& method)
         return true;
     }
 
-    wxStringTokenizer token(tmp_str,wxT(' '));
+    wxStringViewTokenizer token(tmp_str,wxT(' '));
     wxString tmp_str2;
     bool ret_value;
 
-    token.NextToken();
-    tmp_str2 = token.NextToken();
+    token.GetNextToken();
+    tmp_str2 = token.GetNextToken().ToString();
 
     m_http_response = wxAtoi(tmp_str2);
 
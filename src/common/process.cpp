@@ -27,9 +27,11 @@
 // ----------------------------------------------------------------------------
 
 wxDEFINE_EVENT( wxEVT_END_PROCESS, wxProcessEvent );
+wxDEFINE_EVENT( wxEVT_PROCESS_OUTPUT, wxProcessOutputEvent );
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxProcess, wxEvtHandler);
 wxIMPLEMENT_DYNAMIC_CLASS(wxProcessEvent, wxEvent);
+wxIMPLEMENT_DYNAMIC_CLASS(wxProcessOutputEvent, wxEvent);
 
 // ============================================================================
 // wxProcess implementation
@@ -48,6 +50,7 @@ void wxProcess::Init(wxEvtHandler *parent, int id, int flags)
     m_pid        = 0;
     m_priority   = wxPRIORITY_DEFAULT;
     m_redirect   = (flags & wxPROCESS_REDIRECT) != 0;
+    m_outputEvents = false;
 
 #if wxUSE_STREAMS
     m_inputStream  = nullptr;
@@ -97,6 +100,14 @@ void wxProcess::OnTerminate(int pid, int status)
     //      us!
 }
 
+void wxProcess::SendOutputEvent(bool isError, const wxMemoryBuffer& data)
+{
+    wxProcessOutputEvent event(m_id, m_pid, isError, data);
+    event.SetEventObject(this);
+
+    SafelyProcessEvent(event);
+}
+
 void wxProcess::Detach()
 {
     // we just detach from the next handler of the chain (i.e. our "parent" -- see ctor)
@@ -31,11 +31,18 @@
     #include "wx/crt.h"
 #endif //WX_PRECOMP
 
+#include "wx/thread.h"
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
 #endif
 
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 // WXREGEX_CONVERT_TO_MB    defined when the regex lib is using chars and
 //                          wxChar is wide, so conversion to UTF-8 must be done
 // wxRegChar                the character type used by the regular expression engine
@@ -100,13 +107,131 @@ enum
 
 typedef size_t regoff_t;
 
+// Compiled PCRE code which may be shared by several regex_t objects, possibly
+// used from different threads: this is fine because the code is never
+// modified after being compiled, and each regex_t has its own match data.
+class CompiledCode
+{
+public:
+    explicit CompiledCode(pcre2_code* code) : m_code(code) { }
+    ~CompiledCode() { pcre2_code_free(m_code); }
+
+    const pcre2_code* Get() const { return m_code; }
+
+private:
+    pcre2_code* const m_code;
+
+    wxDECLARE_NO_COPY_CLASS(CompiledCode);
+};
+
+using CompiledCodePtr = std::shared_ptr<const CompiledCode>;
+
+// Process-wide cache of the recently compiled patterns.
+//
+// Compiling a regex, and especially JIT-compiling it, is much more expensive
+// than matching it, and the same patterns are often used in many places, so
+// keep the most recently used ones around to avoid recompiling them.
+class CompiledCodeCache
+{
+public:
+    // Maximal number of patterns kept in the cache.
+    static constexpr size_t MAX_SIZE = 64;
+
+    static CompiledCodeCache& Get()
+    {
+        static CompiledCodeCache s_cache;
+        return s_cache;
+    }
+
+    // Return the cached code for the given pattern and options or null.
+    CompiledCodePtr Find(const wxRegChar* pattern, int options)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+
+        const auto it = m_map.find(Key(pattern, options));
+        if ( it == m_map.end() )
+            return CompiledCodePtr();
+
+        // Move the entry to the front of the list as it's the most recently
+        // used one now.
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+        return it->second->second;
+    }
+
+    void Add(const wxRegChar* pattern, int options, const CompiledCodePtr& code)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+
+        Key key(pattern, options);
+
+        // Another thread could have compiled the same pattern concurrently,
+        // don't add it twice in this case.
+        if ( m_map.find(key) != m_map.end() )
+            return;
+
+        if ( m_map.size() == MAX_SIZE )
+        {
+            m_map.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front(key, code);
+        m_map.emplace(std::move(key), m_entries.begin());
+    }
+
+private:
+    CompiledCodeCache() = default;
+
+    struct Key
+    {
+        Key(const wxRegChar* pattern_, int options_)
+            : pattern(pattern_), options(options_)
+        {
+        }
+
+        bool operator==(const Key& other) const
+        {
+            return options == other.options && pattern == other.pattern;
+        }
+
+        std::basic_string<wxRegChar> pattern;
+        int options;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<std::basic_string<wxRegChar>>()(key.pattern)
+                        ^ static_cast<size_t>(key.options);
+        }
+    };
+
+    // Entries in the most recently used first order.
+    using Entries = std::list<std::pair<Key, CompiledCodePtr>>;
+    Entries m_entries;
+
+    std::unordered_map<Key, Entries::iterator, KeyHash> m_map;
+
+#if wxUSE_THREADS
+    wxCriticalSection m_cs;
+#endif
+
+    wxDECLARE_NO_COPY_CLASS(CompiledCodeCache);
+};
+
 struct regex_t
 {
     // This is the only "public" field -- not that it really matters anyhow for
     // this private struct.
     size_t re_nsub;
 
-    pcre2_code* code;
+    CompiledCodePtr code;
     pcre2_match_data* match_data;
 
     int errorcode;
@@ -141,25 +266,43 @@ int wx_regcomp(regex_t* preg, const wxRegChar* pattern, int cflags)
     else
         options |= PCRE2_DOTALL;
 
-    preg->code = pcre2_compile
-                 (
-                    (PCRE2_SPTR)pattern,
-                    PCRE2_ZERO_TERMINATED,
-                    options,
-                    &preg->errorcode,
-                    &preg->erroroffset,
-                    nullptr                    // use default context
-                 );
+    CompiledCodeCache& cache = CompiledCodeCache::Get();
 
+    preg->code = cache.Find(pattern, options);
     if ( !preg->code )
     {
-        // Don't bother translating PCRE error to the most appropriate POSIX
-        // error code, there is no way to do it losslessly and the main thing
-        // that matters is the error message and not the error code anyhow.
-        return REG_BADPAT;
+        pcre2_code* const code = pcre2_compile
+                                 (
+                                    (PCRE2_SPTR)pattern,
+                                    PCRE2_ZERO_TERMINATED,
+                                    options,
+                                    &preg->errorcode,
+                                    &preg->erroroffset,
+                                    nullptr             // use default context
+                                 );
+
+        if ( !code )
+        {
+            // Don't bother translating PCRE error to the most appropriate
+            // POSIX error code, there is no way to do it losslessly and the
+            // main thing that matters is the error message and not the error
+            // code anyhow.
+            return REG_BADPAT;
+        }
+
+        // Use JIT if possible, this makes matching several times faster. If
+        // JIT is not available, either because PCRE was built without it or
+        // because it's not supported on this platform, this just fails and
+        // pcre2_match() falls back to the interpreter, so ignore the errors.
+        (void)pcre2_jit_compile(code, PCRE2_JIT_COMPLETE);
+
+        preg->code = std::make_shared<CompiledCode>(code);
+
+        cache.Add(pattern, options, preg->code);
     }
 
-    preg->match_data = pcre2_match_data_create_from_pattern(preg->code, nullptr);
+    preg->match_data = pcre2_match_data_create_from_pattern(preg->code->Get(),
+                                                            nullptr);
 
     return REG_NOERROR;
 }
@@ -177,16 +320,33 @@ wx_regexec(const regex_t* preg, const wxRegChar* string, size_t len,
     if ( eflags & REG_NOTEMPTY )
         options |= PCRE2_NOTEMPTY;
 
-    const int rc = pcre2_match
-                   (
-                        preg->code,
-                        (PCRE2_SPTR)string,
-                        len,
-                        0,                      // start offset
-                        options,
-                        preg->match_data,
-                        nullptr                    // use default context
-                   );
+    int rc = pcre2_match
+             (
+                preg->code->Get(),
+                (PCRE2_SPTR)string,
+                len,
+                0,                      // start offset
+                options,
+                preg->match_data,
+                nullptr                 // use default context
+             );
+
+    // The JIT-compiled code uses a small stack by default and may run out of
+    // it for the patterns requiring a lot of backtracking, which the
+    // interpreter, using the heap, can still match, so fall back to it then.
+    if ( rc == PCRE2_ERROR_JIT_STACKLIMIT )
+    {
+        rc = pcre2_match
+             (
+                preg->code->Get(),
+                (PCRE2_SPTR)string,
+                len,
+                0,
+                options | PCRE2_NO_JIT,
+                preg->match_data,
+                nullptr
+             );
+    }
 
     if ( rc == PCRE2_ERROR_NOMATCH )
         return REG_NOMATCH;
@@ -245,7 +405,7 @@ wx_regerror(int errcode, const regex_t* preg, wxRegErrorChar* errbuf, size_t err
 void wx_regfree(regex_t* preg)
 {
     pcre2_match_data_free(preg->match_data);
-    pcre2_code_free(preg->code);
+    preg->code.reset();
 }
 
 } // anonymous namespace
@@ -40,6 +40,9 @@
 #include <stdio.h>
 #include <errno.h>
 
+#include <unordered_set>
+#include <vector>
+
 #include "wx/socket.h"
 
 // --------------------------------------------------------------------------
@@ -120,9 +123,42 @@ public:
     void Client_OnRequest(wxSocketEvent& event);
     void Server_OnRequest(wxSocketEvent& event);
 
+    // flush the output of the given connection soon, but not immediately
+    void ScheduleFlush(wxTCPConnection *connection);
+
+    // handle the messages already received by the connection soon: this is
+    // needed if they had been read together with the reply to a synchronous
+    // request, as we won't get any socket events for them
+    void ScheduleInput(wxTCPConnection *connection);
+
+    // cancel anything scheduled by the functions above, must be called when
+    // the connection is destroyed
+    void Cancel(wxTCPConnection *connection);
+
 private:
     void HandleDisconnect(wxTCPConnection *connection);
 
+    // handle all the messages which were already received by the connection
+    void HandleMessages(wxTCPConnection *connection);
+
+    // handle a single incoming message
+    void HandleMessage(wxTCPConnection *connection);
+
+    // ensure that ProcessScheduled() is called soon
+    void DoSchedule();
+
+    // process the connections passed to ScheduleFlush() and ScheduleInput()
+    void ProcessScheduled();
+
+    // connections with the batched output which still needs to be flushed
+    std::unordered_set<wxTCPConnection *> m_connectionsToFlush;
+
+    // connections with the input which still needs to be processed
+    std::unordered_set<wxTCPConnection *> m_connectionsWithInput;
+
+    // true if ProcessScheduled() call is pending
+    bool m_scheduled = false;
+
     wxDECLARE_EVENT_TABLE();
     wxDECLARE_NO_COPY_CLASS(wxTCPEventHandler);
 };
@@ -151,6 +187,9 @@ public:
         return *ms_handler;
     }
 
+    // get the global wxTCPEventHandler if it exists, don't create it
+    static wxTCPEventHandler *GetHandlerIfExists() { return ms_handler; }
+
     // as ms_handler is initialized on demand, don't do anything in OnInit()
     virtual bool OnInit() override { return true; }
     virtual void OnExit() override { wxDELETE(ms_handler); }
@@ -170,29 +209,42 @@ wxTCPEventHandler *wxTCPEventHandlerModule::ms_handler = nullptr;
 // wxIPCSocketStreams
 // --------------------------------------------------------------------------
 
-#define USE_BUFFER
+namespace
+{
+
+// Size of the output buffer: it needs to be big enough to contain many small
+// messages when batching them.
+const size_t IPC_OUTPUT_BUFFER_SIZE = 64*1024;
+
+// Size of the input buffer, which is filled with all the data available on
+// the socket, possibly containing several messages, at once.
+const size_t IPC_INPUT_BUFFER_SIZE = 64*1024;
+
+// Data blocks of at least this size bypass the buffers and are written to, or
+// read from, the socket directly.
+const size_t IPC_DIRECT_IO_THRESHOLD = 16*1024;
+
+} // anonymous namespace
 
 // this class contains the various (related) streams used by wxTCPConnection
-// and also provides a way to read from the socket stream directly
+// and also provides a way to read from the socket directly
 //
 // for writing to the stream use the IPCOutput class below
 class wxIPCSocketStreams
 {
 public:
     // ctor initializes all the streams on top of the given socket
-    //
-    // note that we use a bigger than default buffer size which matches the
-    // typical Ethernet MTU (minus TCP header overhead)
     wxIPCSocketStreams(wxSocketBase& sock)
-        : m_socketStream(sock),
-#ifdef USE_BUFFER
-          m_bufferedOut(m_socketStream, 1448),
-#else
-          m_bufferedOut(m_socketStream),
-#endif
-          m_dataIn(m_socketStream),
-          m_dataOut(m_bufferedOut)
+        : m_sock(sock),
+          m_socketStream(sock),
+          m_bufferedOut(m_socketStream, IPC_OUTPUT_BUFFER_SIZE),
+          m_dataOut(m_bufferedOut),
+          m_inBuf(IPC_INPUT_BUFFER_SIZE)
     {
+        // We still want to write all the data at once, but we must be able
+        // to read just the data which is available on the socket to fill our
+        // input buffer without blocking until it becomes full.
+        m_sock.SetFlags(m_sock.GetFlags() & ~wxSOCKET_WAITALL_READ);
     }
 
     // expose the IO methods needed by IPC code (notice that writing is only
@@ -201,29 +253,48 @@ public:
     // flush output
     void Flush()
     {
-#ifdef USE_BUFFER
         m_bufferedOut.Sync();
-#endif
     }
 
-    // simple wrappers around the functions with the same name in
-    // wxDataInputStream
+    // return true if we have any already received data which hasn't been
+    // processed yet
+    bool HasInput() const { return m_inStart < m_inEnd; }
+
+    // simple functions reading the data in the same format as written by
+    // wxDataOutputStream
     wxUint8 Read8()
     {
-        Flush();
-        return m_dataIn.Read8();
+        wxUint8 i8 = 0;
+        ReadRaw(&i8, sizeof(i8));
+        return i8;
     }
 
     wxUint32 Read32()
     {
-        Flush();
-        return m_dataIn.Read32();
+        wxUint32 i32 = 0;
+        ReadRaw(&i32, sizeof(i32));
+        return wxUINT32_SWAP_ON_BE(i32);
     }
 
     wxString ReadString()
     {
-        Flush();
-        return m_dataIn.ReadString();
+        const size_t len = Read32();
+        if ( !len )
+            return wxString();
+
+        // avoid copying the string data if we already have all of it
+        if ( m_inEnd - m_inStart >= len )
+        {
+            const wxString str = wxString::FromUTF8(&m_inBuf[m_inStart], len);
+            m_inStart += len;
+            return str;
+        }
+
+        wxCharBuffer buf(len);
+        if ( !ReadRaw(buf.data(), len) )
+            return wxString();
+
+        return wxString::FromUTF8(buf.data(), len);
     }
 
     // read arbitrary (size-prepended) data
@@ -231,8 +302,6 @@ public:
     // connection parameter is needed to call its GetBufferAtLeast() method
     void *ReadData(wxConnectionBase *conn, size_t *size)
     {
-        Flush();
-
         wxCHECK_MSG( conn, nullptr, "null connection parameter" );
         wxCHECK_MSG( size, nullptr, "null size parameter" );
 
@@ -241,7 +310,8 @@ public:
         void * const data = conn->GetBufferAtLeast(*size);
         wxCHECK_MSG( data, nullptr, "IPC buffer allocation failed" );
 
-        m_socketStream.Read(data, *size);
+        if ( !ReadRaw(data, *size) )
+            return nullptr;
 
         return data;
     }
@@ -262,24 +332,89 @@ public:
     wxDataOutputStream& GetDataOut() { return m_dataOut; }
     wxOutputStream& GetUnformattedOut() { return m_bufferedOut; }
 
+    // write the data directly to the socket, after flushing the buffered
+    // data, which avoids copying it to the buffer in chunks
+    void WriteDirect(const void *data, size_t size)
+    {
+        Flush();
+        m_socketStream.Write(data, size);
+    }
+
 private:
+    // read exactly the given number of bytes, first from the buffer and then
+    // from the socket, blocking until they're all received
+    bool ReadRaw(void *data, size_t size)
+    {
+        char *p = static_cast<char *>(data);
+        while ( size )
+        {
+            if ( !HasInput() )
+            {
+                // make sure we don't block waiting for the reply to a request
+                // which is still sitting in our output buffer
+                Flush();
+
+                // read big blocks directly into the destination, there is no
+                // need to copy them via our buffer
+                if ( size >= IPC_DIRECT_IO_THRESHOLD )
+                {
+                    m_sock.Read(p, size);
+                    const size_t count = m_sock.LastCount();
+                    if ( !count || m_sock.Error() )
+                        return false;
+
+                    p += count;
+                    size -= count;
+                    continue;
+                }
+
+                if ( !FillBuffer() )
+                    return false;
+            }
+
+            const size_t count = wxMin(size, m_inEnd - m_inStart);
+            memcpy(p, &m_inBuf[m_inStart], count);
+            m_inStart += count;
+            p += count;
+            size -= count;
+        }
+
+        return true;
+    }
+
+    // read all the data available on the socket into our buffer, only
+    // blocking if there is none at all
+    bool FillBuffer()
+    {
+        m_inStart =
+        m_inEnd = 0;
+
+        m_sock.Read(&m_inBuf[0], m_inBuf.size());
+        m_inEnd = m_sock.LastCount();
+
+        return m_inEnd != 0;
+    }
+
+    wxSocketBase& m_sock;
+
     // this is the low-level underlying stream using the connection socket
     wxSocketStream m_socketStream;
 
     // the buffered stream is used to avoid writing all pieces of an IPC
     // request to the socket one by one but to instead do it all at once when
-    // we're done with it
-#ifdef USE_BUFFER
+    // we're done with it, or even to write several requests at once
     wxBufferedOutputStream m_bufferedOut;
-#else
-    wxOutputStream& m_bufferedOut;
-#endif
 
-    // finally the data streams are used to be able to write typed data into
-    // the above streams easily
-    wxDataInputStream  m_dataIn;
+    // finally the data stream is used to be able to write typed data into
+    // the above stream easily
     wxDataOutputStream m_dataOut;
 
+    // the buffer containing the data received from the socket and the range
+    // of the data not consumed yet
+    std::vector<char> m_inBuf;
+    size_t m_inStart = 0,
+           m_inEnd = 0;
+
     wxDECLARE_NO_COPY_CLASS(wxIPCSocketStreams);
 };
 
@@ -290,20 +425,26 @@ namespace
 // underlying socket stream
 //
 // this class is intentionally separated from wxIPCSocketStreams to ensure that
-// Flush() is always called
+// Flush() is always called, unless the output is explicitly batched
 class IPCOutput
 {
 public:
     // construct an object associated with the given streams (which must have
     // life time greater than ours as we keep a reference to it)
-    IPCOutput(wxIPCSocketStreams *streams)
-        : m_streams(*streams)
+    explicit IPCOutput(wxIPCSocketStreams *streams, bool flush = true)
+        : m_streams(*streams),
+          m_flush(flush)
     {
         wxASSERT_MSG( streams, "null streams pointer" );
     }
 
-    // dtor calls Flush() really sending the IPC data to the network
-    ~IPCOutput() { m_streams.Flush(); }
+    // dtor calls Flush() really sending the IPC data to the network, unless
+    // we're batching the output
+    ~IPCOutput()
+    {
+        if ( m_flush )
+            m_streams.Flush();
+    }
 
 
     // write a byte
@@ -330,12 +471,17 @@ public:
     void WriteData(const void *data, size_t size)
     {
         m_streams.GetDataOut().Write32(size);
-        m_streams.GetUnformattedOut().Write(data, size);
+
+        if ( size >= IPC_DIRECT_IO_THRESHOLD )
+            m_streams.WriteDirect(data, size);
+        else
+            m_streams.GetUnformattedOut().Write(data, size);
     }
 
 
 private:
     wxIPCSocketStreams& m_streams;
+    const bool m_flush;
 
     wxDECLARE_NO_COPY_CLASS(IPCOutput);
 };
@@ -405,6 +551,7 @@ wxConnectionBase *wxTCPClient::MakeConnection(const wxString& host,
                     client->SetClientData(connection);
                     client->SetNotify(wxSOCKET_INPUT_FLAG | wxSOCKET_LOST_FLAG);
                     client->Notify(true);
+                    connection->OnReplyReceived();
                     return connection;
                 }
                 else
@@ -544,12 +691,17 @@ void wxTCPConnection::Init()
 {
     m_sock = nullptr;
     m_streams = nullptr;
+    m_batching = false;
 }
 
 wxTCPConnection::~wxTCPConnection()
 {
     Disconnect();
 
+    if ( wxTCPEventHandler * const
+            handler = wxTCPEventHandlerModule::GetHandlerIfExists() )
+        handler->Cancel(this);
+
     if ( m_sock )
     {
         m_sock->SetClientData(nullptr);
@@ -564,6 +716,36 @@ void wxTCPConnection::Compress(bool WXUNUSED(on))
     // TODO
 }
 
+void wxTCPConnection::EnableBatching(bool enable)
+{
+    if ( !enable && m_batching )
+        Flush();
+
+    m_batching = enable;
+}
+
+bool wxTCPConnection::Flush()
+{
+    if ( !m_streams )
+        return false;
+
+    m_streams->Flush();
+
+    return !m_sock->Error();
+}
+
+void wxTCPConnection::OnMessageQueued()
+{
+    if ( m_batching )
+        wxTCPEventHandlerModule::GetHandler().ScheduleFlush(this);
+}
+
+void wxTCPConnection::OnReplyReceived()
+{
+    if ( m_streams->HasInput() )
+        wxTCPEventHandlerModule::GetHandler().ScheduleInput(this);
+}
+
 // Calls that CLIENT can make.
 bool wxTCPConnection::Disconnect()
 {
@@ -592,11 +774,15 @@ bool wxTCPConnection::DoExecute(const void *data,
         return false;
 
     // Prepare EXECUTE message
-    IPCOutput out(m_streams);
-    out.Write8(IPC_EXECUTE);
-    out.Write8(format);
+    {
+        IPCOutput out(m_streams, !m_batching);
+        out.Write8(IPC_EXECUTE);
+        out.Write8(format);
+
+        out.WriteData(data, size);
+    }
 
-    out.WriteData(data, size);
+    OnMessageQueued();
 
     return true;
 }
@@ -618,7 +804,11 @@ const void *wxTCPConnection::Request(const wxString& item,
     // with null pointer (this makes sense if it knows that it always works
     // with NUL-terminated strings)
     size_t sizeFallback;
-    return m_streams->ReadData(this, size ? size : &sizeFallback);
+    const void * const data = m_streams->ReadData(this, size ? size : &sizeFallback);
+
+    OnReplyReceived();
+
+    return data;
 }
 
 bool wxTCPConnection::DoPoke(const wxString& item,
@@ -629,9 +819,13 @@ bool wxTCPConnection::DoPoke(const wxString& item,
     if ( !m_sock->IsConnected() )
         return false;
 
-    IPCOutput out(m_streams);
-    out.Write(IPC_POKE, item, format);
-    out.WriteData(data, size);
+    {
+        IPCOutput out(m_streams, !m_batching);
+        out.Write(IPC_POKE, item, format);
+        out.WriteData(data, size);
+    }
+
+    OnMessageQueued();
 
     return true;
 }
@@ -645,6 +839,8 @@ bool wxTCPConnection::StartAdvise(const wxString& item)
 
     const int ret = m_streams->Read8();
 
+    OnReplyReceived();
+
     return ret == IPC_ADVISE_START;
 }
 
@@ -657,6 +853,8 @@ bool wxTCPConnection::StopAdvise (const wxString& item)
 
     const int ret = m_streams->Read8();
 
+    OnReplyReceived();
+
     return ret == IPC_ADVISE_STOP;
 }
 
@@ -669,9 +867,13 @@ bool wxTCPConnection::DoAdvise(const wxString& item,
     if ( !m_sock->IsConnected() )
         return false;
 
-    IPCOutput out(m_streams);
-    out.Write(IPC_ADVISE, item, format);
-    out.WriteData(data, size);
+    {
+        IPCOutput out(m_streams, !m_batching);
+        out.Write(IPC_ADVISE, item, format);
+        out.WriteData(data, size);
+    }
+
+    OnMessageQueued();
 
     return true;
 }
@@ -700,6 +902,63 @@ void wxTCPEventHandler::HandleDisconnect(wxTCPConnection *connection)
     connection->OnDisconnect();
 }
 
+void wxTCPEventHandler::ScheduleFlush(wxTCPConnection *connection)
+{
+    m_connectionsToFlush.insert(connection);
+    DoSchedule();
+}
+
+void wxTCPEventHandler::ScheduleInput(wxTCPConnection *connection)
+{
+    m_connectionsWithInput.insert(connection);
+    DoSchedule();
+}
+
+void wxTCPEventHandler::Cancel(wxTCPConnection *connection)
+{
+    m_connectionsToFlush.erase(connection);
+    m_connectionsWithInput.erase(connection);
+}
+
+void wxTCPEventHandler::DoSchedule()
+{
+    // all connections are processed at once, so only queue a single call
+    if ( m_scheduled )
+        return;
+
+    m_scheduled = true;
+    CallAfter(&wxTCPEventHandler::ProcessScheduled);
+}
+
+void wxTCPEventHandler::ProcessScheduled()
+{
+    m_scheduled = false;
+
+    // processing could result in destroying some connections, so don't
+    // iterate over the sets which could be modified by Cancel() but take the
+    // connections from them one by one
+    while ( !m_connectionsToFlush.empty() )
+    {
+        wxTCPConnection * const connection = *m_connectionsToFlush.begin();
+        m_connectionsToFlush.erase(m_connectionsToFlush.begin());
+
+        if ( connection->GetConnected() )
+            connection->Flush();
+    }
+
+    while ( !m_connectionsWithInput.empty() )
+    {
+        wxTCPConnection * const connection = *m_connectionsWithInput.begin();
+        m_connectionsWithInput.erase(m_connectionsWithInput.begin());
+
+        // the buffered messages may have been already handled since this
+        // connection was scheduled, and we must not block waiting for more
+        // of them from the socket here
+        if ( connection->GetConnected() && connection->m_streams->HasInput() )
+            HandleMessages(connection);
+    }
+}
+
 void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
 {
     wxSocketBase *sock = event.GetSocket();
@@ -720,6 +979,28 @@ void wxTCPEventHandler::Client_OnRequest(wxSocketEvent &event)
         return;
     }
 
+    HandleMessages(connection);
+}
+
+void wxTCPEventHandler::HandleMessages(wxTCPConnection *connection)
+{
+    // Handle all the messages we have already received, as the peer may have
+    // sent many of them at once, instead of waiting for another event for
+    // each of them.
+    wxSocketBase * const sock = connection->m_sock;
+    wxIPCSocketStreams * const streams = connection->m_streams;
+    do
+    {
+        HandleMessage(connection);
+
+        // Note that the connection may have been disconnected or even
+        // destroyed by the message handler, so check for this before
+        // accessing it (or its streams) again.
+    } while ( sock->GetClientData() == connection && streams->HasInput() );
+}
+
+void wxTCPEventHandler::HandleMessage(wxTCPConnection *connection)
+{
     // Receive message number.
     wxIPCSocketStreams * const streams = connection->m_streams;
 
@@ -907,6 +1188,7 @@ void wxTCPEventHandler::Server_OnRequest(wxSocketEvent &event)
                     sock->SetClientData(new_connection);
                     sock->SetNotify(wxSOCKET_INPUT_FLAG | wxSOCKET_LOST_FLAG);
                     sock->Notify(true);
+                    new_connection->OnReplyReceived();
                     return;
                 }
                 else
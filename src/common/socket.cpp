@@ -47,6 +47,13 @@
 
 #ifdef __UNIX__
     #include <errno.h>
+    #include <sys/uio.h>
+#endif
+
+// accept4() allows to create the accepted socket in non-blocking mode and
+// with close-on-exec flag set directly, without any extra system calls
+#if defined(__LINUX__) && defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+    #define wxHAS_ACCEPT4
 #endif
 
 // we use MSG_NOSIGNAL to avoid getting SIGPIPE when sending data to a remote
@@ -312,6 +319,7 @@ wxSocketImpl::wxSocketImpl(wxSocketBase& wxsocket)
 
     m_establishing    = false;
     m_reusable        = false;
+    m_reusePort       = false;
     m_broadcast       = false;
     m_dobind          = true;
     m_initialRecvBufferSize = -1;
@@ -351,6 +359,11 @@ void wxSocketImpl::PostCreation()
     if ( m_reusable )
         EnableSocketOption(SO_REUSEADDR);
 
+#ifdef SO_REUSEPORT
+    if ( m_reusePort )
+        EnableSocketOption(SO_REUSEPORT);
+#endif
+
     if ( m_broadcast )
     {
         wxASSERT_MSG( !m_stream, "broadcasting is for datagram sockets only" );
@@ -416,7 +429,11 @@ wxSocketError wxSocketImpl::CreateServer()
 
     if ( IsOk() )
     {
-        if ( listen(m_fd, 5) != 0 )
+        // use the maximal backlog size as with a small one the new connections
+        // are dropped by the system if several of them arrive before we can
+        // accept them, which results in long delays for the clients retrying
+        // to connect
+        if ( listen(m_fd, SOMAXCONN) != 0 )
             m_error = wxSOCKET_IOERR;
     }
 
@@ -519,14 +536,29 @@ wxSocketError wxSocketImpl::CreateUDP()
 
 wxSocketImpl *wxSocketImpl::Accept(wxSocketBase& wxsocket)
 {
-    wxSockAddressStorage from;
-    WX_SOCKLEN_T fromlen = sizeof(from);
-    const wxSOCKET_T fd = accept(m_fd, &from.addr, &fromlen);
+    wxSocketImpl * const sock = DoAccept(wxsocket);
 
     // accepting is similar to reading in the sense that it resets "ready for
     // read" flag on the socket
     ReenableEvents(wxSOCKET_INPUT_FLAG);
 
+    return sock;
+}
+
+wxSocketImpl *wxSocketImpl::DoAccept(wxSocketBase& wxsocket)
+{
+    wxSockAddressStorage from;
+    WX_SOCKLEN_T fromlen = sizeof(from);
+#ifdef wxHAS_ACCEPT4
+    // the socket is going to be made non-blocking by UpdateBlockingState()
+    // below anyhow (unless wxSOCKET_BLOCK is used), so do it immediately and
+    // also prevent it from being inherited by the child processes
+    const wxSOCKET_T fd = accept4(m_fd, &from.addr, &fromlen,
+                                  SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+    const wxSOCKET_T fd = accept(m_fd, &from.addr, &fromlen);
+#endif
+
     if ( fd == INVALID_SOCKET )
     {
         UpdateLastError();
@@ -766,6 +798,138 @@ int wxSocketImpl::Write(const void *buffer, int size)
     return ret;
 }
 
+#ifdef __UNIX__
+
+namespace
+{
+
+// maximal number of buffers which can be used with ReadV() and WriteV(),
+// this is much less than IOV_MAX but is enough for our needs
+const int MAX_IO_BUFFERS = 8;
+
+// fill the given msghdr with the buffers, return false if there are too many
+// of them
+bool InitMsgHdr(msghdr& msg, iovec *iov, const wxSocketIOBuffer *bufs, int count)
+{
+    wxCHECK_MSG( count > 0 && count <= MAX_IO_BUFFERS, false,
+                 "invalid number of buffers" );
+
+    for ( int n = 0; n < count; n++ )
+    {
+        iov[n].iov_base = bufs[n].data;
+        iov[n].iov_len = bufs[n].size;
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+
+    return true;
+}
+
+} // anonymous namespace
+
+int wxSocketImpl::ReadV(const wxSocketIOBuffer *bufs, int count)
+{
+    // datagram sockets must preserve the boundaries between buffers
+    if ( !m_stream )
+        return Read(bufs[0].data, static_cast<int>(bufs[0].size));
+
+    if ( m_fd == INVALID_SOCKET || m_server )
+    {
+        m_error = wxSOCKET_INVSOCK;
+        return -1;
+    }
+
+    msghdr msg;
+    iovec iov[MAX_IO_BUFFERS];
+    if ( !InitMsgHdr(msg, iov, bufs, count) )
+    {
+        m_error = wxSOCKET_INVOP;
+        return -1;
+    }
+
+    int ret;
+    DO_WHILE_EINTR( ret, recvmsg(m_fd, &msg, 0) );
+
+    if ( ret == SOCKET_ERROR )
+    {
+        UpdateLastError();
+        return ret;
+    }
+
+    m_error = wxSOCKET_NOERROR;
+
+    if ( !ret )
+    {
+        // the connection was closed by peer, see RecvStream()
+        m_establishing = false;
+        NotifyOnStateChange(wxSOCKET_LOST);
+
+        Shutdown();
+    }
+
+    return ret;
+}
+
+int wxSocketImpl::WriteV(const wxSocketIOBuffer *bufs, int count)
+{
+    if ( !m_stream )
+        return Write(bufs[0].data, static_cast<int>(bufs[0].size));
+
+    if ( m_fd == INVALID_SOCKET || m_server )
+    {
+        m_error = wxSOCKET_INVSOCK;
+        return -1;
+    }
+
+    msghdr msg;
+    iovec iov[MAX_IO_BUFFERS];
+    if ( !InitMsgHdr(msg, iov, bufs, count) )
+    {
+        m_error = wxSOCKET_INVOP;
+        return -1;
+    }
+
+#ifdef wxNEEDS_IGNORE_SIGPIPE
+    IgnoreSignal ignore(SIGPIPE);
+#endif
+
+    // notice that we use sendmsg() rather than writev() to be able to pass
+    // MSG_NOSIGNAL to it
+    int ret;
+    DO_WHILE_EINTR( ret, sendmsg(m_fd, &msg, wxSOCKET_MSG_NOSIGNAL) );
+
+    if ( ret == SOCKET_ERROR )
+        UpdateLastError();
+    else
+        m_error = wxSOCKET_NOERROR;
+
+    return ret;
+}
+
+#else // !__UNIX__
+
+// Winsock provides WSARecv() and WSASend() which could be used here, but for
+// now just transfer the first buffer: this is correct as the callers must
+// handle partial IO anyhow, just less efficient.
+
+int wxSocketImpl::ReadV(const wxSocketIOBuffer *bufs, int count)
+{
+    wxCHECK_MSG( count > 0, -1, "invalid number of buffers" );
+
+    return Read(bufs[0].data, static_cast<int>(bufs[0].size));
+}
+
+int wxSocketImpl::WriteV(const wxSocketIOBuffer *bufs, int count)
+{
+    wxCHECK_MSG( count > 0, -1, "invalid number of buffers" );
+
+    return Write(bufs[0].data, static_cast<int>(bufs[0].size));
+}
+
+#endif // __UNIX__/!__UNIX__
+
 // ==========================================================================
 // wxSocketBase
 // ==========================================================================
@@ -977,6 +1141,30 @@ void wxSocketBase::ShutdownOutput()
         m_impl->Shutdown();
 }
 
+namespace
+{
+
+// skip the given number of bytes in the buffers, advancing bufs past all the
+// buffers which were completely consumed
+void ConsumeIOBuffers(wxSocketIOBuffer*& bufs, int& count, size_t size)
+{
+    while ( count )
+    {
+        const size_t n = wxMin(size, bufs->size);
+        bufs->data = static_cast<char *>(bufs->data) + n;
+        bufs->size -= n;
+        size -= n;
+
+        if ( bufs->size )
+            break;
+
+        bufs++;
+        count--;
+    }
+}
+
+} // anonymous namespace
+
 wxSocketBase& wxSocketBase::Read(void* buffer, wxUint32 nbytes)
 {
     wxSocketReadGuard read(this);
@@ -1073,6 +1261,78 @@ wxUint32 wxSocketBase::DoRead(void* buffer_, wxUint32 nbytes)
     return total;
 }
 
+// This function works in the same way as DoRead(), please see the comments
+// there.
+wxUint32 wxSocketBase::DoReadV(wxSocketIOBuffer *bufs, int count)
+{
+    wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+
+    wxUint32 total = 0;
+
+    // Use the push back buffer first.
+    while ( count )
+    {
+        const wxUint32 size = static_cast<wxUint32>(bufs->size);
+        const wxUint32 ret = GetPushback(bufs->data, size, false);
+        if ( !ret )
+            break;
+
+        total += ret;
+        ConsumeIOBuffers(bufs, count, ret);
+    }
+
+    // Skip empty buffers, if any.
+    ConsumeIOBuffers(bufs, count, 0);
+
+    while ( count )
+    {
+        const int ret = !m_impl->m_stream || m_connected
+                            ? m_impl->ReadV(bufs, count)
+                            : 0;
+        if ( ret == -1 )
+        {
+            if ( m_impl->GetError() == wxSOCKET_WOULDBLOCK )
+            {
+                if ( m_flags & wxSOCKET_NOWAIT_READ )
+                {
+                    SetError(wxSOCKET_NOERROR);
+                    break;
+                }
+
+                if ( !DoWaitWithTimeout(wxSOCKET_INPUT_FLAG) )
+                {
+                    SetError(wxSOCKET_TIMEDOUT);
+                    break;
+                }
+
+                continue;
+            }
+            else // "real" error
+            {
+                SetError(wxSOCKET_IOERR);
+                break;
+            }
+        }
+        else if ( ret == 0 )
+        {
+            m_closed = true;
+
+            if ( (m_flags & wxSOCKET_WAITALL_READ) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        total += ret;
+
+        if ( !(m_flags & wxSOCKET_WAITALL_READ) )
+            break;
+
+        ConsumeIOBuffers(bufs, count, ret);
+    }
+
+    return total;
+}
+
 wxSocketBase& wxSocketBase::ReadMsg(void* buffer, wxUint32 nbytes)
 {
     struct
@@ -1109,12 +1369,38 @@ wxSocketBase& wxSocketBase::ReadMsg(void* buffer, wxUint32 nbytes)
             else
                 len2 = 0;
 
-            // Don't attempt to read if the msg was zero bytes long.
-            m_lcount_read = len ? DoRead(buffer, len) : 0;
-            m_lcount = m_lcount_read;
+            if ( !len2 )
+            {
+                // Read the data and the trailer at once, this avoids an
+                // extra system call.
+                wxSocketIOBuffer bufs[] =
+                {
+                    { buffer, len },
+                    { &msg, sizeof(msg) },
+                };
+
+                const wxUint32 total = DoReadV(bufs, WXSIZEOF(bufs));
+
+                m_lcount_read = wxMin(total, len);
+                m_lcount = m_lcount_read;
+
+                if ( total == len + sizeof(msg) )
+                {
+                    sig = (wxUint32)msg.sig[0];
+                    sig |= (wxUint32)(msg.sig[1] << 8);
+                    sig |= (wxUint32)(msg.sig[2] << 16);
+                    sig |= (wxUint32)(msg.sig[3] << 24);
 
-            if ( len2 )
+                    if ( sig == 0xdeadfeed )
+                        ok = true;
+                }
+            }
+            else // We need to discard the part which doesn't fit.
             {
+                // Don't attempt to read if the msg was zero bytes long.
+                m_lcount_read = len ? DoRead(buffer, len) : 0;
+                m_lcount = m_lcount_read;
+
                 char discard_buffer[MAX_DISCARD_SIZE];
                 long discard_len;
 
@@ -1128,17 +1414,17 @@ wxSocketBase& wxSocketBase::ReadMsg(void* buffer, wxUint32 nbytes)
                     len2 -= (wxUint32)discard_len;
                 }
                 while ((discard_len > 0) && len2);
-            }
 
-            if ( !len2 && DoRead(&msg, sizeof(msg)) == sizeof(msg) )
-            {
-                sig = (wxUint32)msg.sig[0];
-                sig |= (wxUint32)(msg.sig[1] << 8);
-                sig |= (wxUint32)(msg.sig[2] << 16);
-                sig |= (wxUint32)(msg.sig[3] << 24);
+                if ( !len2 && DoRead(&msg, sizeof(msg)) == sizeof(msg) )
+                {
+                    sig = (wxUint32)msg.sig[0];
+                    sig |= (wxUint32)(msg.sig[1] << 8);
+                    sig |= (wxUint32)(msg.sig[2] << 16);
+                    sig |= (wxUint32)(msg.sig[3] << 24);
 
-                if ( sig == 0xdeadfeed )
-                    ok = true;
+                    if ( sig == 0xdeadfeed )
+                        ok = true;
+                }
             }
         }
     }
@@ -1262,13 +1548,66 @@ wxUint32 wxSocketBase::DoWrite(const void *buffer_, wxUint32 nbytes)
     return total;
 }
 
+// This function works in the same way as DoWrite(), please see the comments
+// there.
+wxUint32 wxSocketBase::DoWriteV(wxSocketIOBuffer *bufs, int count)
+{
+    wxCHECK_MSG( m_impl, 0, "socket must be valid" );
+
+    // Skip empty buffers, if any.
+    ConsumeIOBuffers(bufs, count, 0);
+
+    wxUint32 total = 0;
+    while ( count )
+    {
+        if ( m_impl->m_stream && !m_connected )
+        {
+            if ( (m_flags & wxSOCKET_WAITALL_WRITE) || !total )
+                SetError(wxSOCKET_IOERR);
+            break;
+        }
+
+        const int ret = m_impl->WriteV(bufs, count);
+        if ( ret == -1 )
+        {
+            if ( m_impl->GetError() == wxSOCKET_WOULDBLOCK )
+            {
+                if ( m_flags & wxSOCKET_NOWAIT_WRITE )
+                    break;
+
+                if ( !DoWaitWithTimeout(wxSOCKET_OUTPUT_FLAG) )
+                {
+                    SetError(wxSOCKET_TIMEDOUT);
+                    break;
+                }
+
+                continue;
+            }
+            else // "real" error
+            {
+                SetError(wxSOCKET_IOERR);
+                break;
+            }
+        }
+
+        total += ret;
+
+        if ( !(m_flags & wxSOCKET_WAITALL_WRITE) )
+            break;
+
+        ConsumeIOBuffers(bufs, count, ret);
+    }
+
+    return total;
+}
+
 wxSocketBase& wxSocketBase::WriteMsg(const void *buffer, wxUint32 nbytes)
 {
     struct
     {
         unsigned char sig[4];
         unsigned char len[4];
-    } msg;
+    } msg, msgEnd;
 
     wxSocketWriteGuard write(this);
 
@@ -1284,28 +1623,33 @@ wxSocketBase& wxSocketBase::WriteMsg(const void *buffer, wxUint32 nbytes)
     msg.len[2] = (unsigned char) ((nbytes >> 16) & 0xff);
     msg.len[3] = (unsigned char) ((nbytes >> 24) & 0xff);
 
-    bool ok = false;
-    if ( DoWrite(&msg, sizeof(msg)) == sizeof(msg) )
-    {
-        m_lcount_write = DoWrite(buffer, nbytes);
-        m_lcount = m_lcount_write;
-        if ( m_lcount_write == nbytes )
-        {
-            msg.sig[0] = (unsigned char) 0xed;
-            msg.sig[1] = (unsigned char) 0xfe;
-            msg.sig[2] = (unsigned char) 0xad;
-            msg.sig[3] = (unsigned char) 0xde;
-            msg.len[0] =
-            msg.len[1] =
-            msg.len[2] =
-            msg.len[3] = (char) 0;
-
-            if ( DoWrite(&msg, sizeof(msg)) == sizeof(msg))
-                ok = true;
-        }
-    }
+    msgEnd.sig[0] = (unsigned char) 0xed;
+    msgEnd.sig[1] = (unsigned char) 0xfe;
+    msgEnd.sig[2] = (unsigned char) 0xad;
+    msgEnd.sig[3] = (unsigned char) 0xde;
+    msgEnd.len[0] =
+    msgEnd.len[1] =
+    msgEnd.len[2] =
+    msgEnd.len[3] = (char) 0;
+
+    // Write the header, the data and the trailer at once: this is not only
+    // more efficient than doing it in 3 system calls, but also avoids delays
+    // due to Nagle's algorithm holding back the data after the header.
+    wxSocketIOBuffer bufs[] =
+    {
+        { &msg, sizeof(msg) },
+        { const_cast<void *>(buffer), nbytes },
+        { &msgEnd, sizeof(msgEnd) },
+    };
+
+    const wxUint32 total = DoWriteV(bufs, WXSIZEOF(bufs));
+
+    // Only count the data itself, as we always did.
+    m_lcount_write = total > sizeof(msg) ? wxMin(total - sizeof(msg), nbytes)
+                                         : 0;
+    m_lcount = m_lcount_write;
 
-    if ( !ok )
+    if ( total != sizeof(msg) + nbytes + sizeof(msgEnd) )
         SetError(wxSOCKET_IOERR);
 
     return *this;
@@ -1906,6 +2250,9 @@ wxSocketServer::wxSocketServer(const wxSockAddress& addr,
     if (GetFlags() & wxSOCKET_REUSEADDR) {
         m_impl->SetReusable();
     }
+    if (GetFlags() & wxSOCKET_REUSEPORT) {
+        m_impl->SetReusePort();
+    }
     if (GetFlags() & wxSOCKET_BROADCAST) {
         m_impl->SetBroadcast();
     }
@@ -1943,24 +2290,41 @@ bool wxSocketServer::AcceptWith(wxSocketBase& sock, bool wait)
         return false;
     }
 
-    if ( wait )
+    // if our socket is non-blocking, try accepting the connection
+    // immediately, as it's likely to be already pending if we're called from
+    // the connection event handler, and only wait for it if it isn't
+    const bool blocking = (m_flags & wxSOCKET_BLOCK) != 0;
+    wxSocketImpl *impl = nullptr;
+    if ( !blocking )
+    {
+        impl = m_impl->Accept(sock);
+        if ( !impl &&
+                (!wait || m_impl->GetError() != wxSOCKET_WOULDBLOCK) )
+            return false;
+    }
+
+    if ( !impl )
     {
-        // wait until we get a connection
-        if ( !m_impl->SelectWithTimeout(wxSOCKET_INPUT_FLAG) )
+        if ( wait )
         {
-            SetError(wxSOCKET_TIMEDOUT);
+            // wait until we get a connection
+            if ( !m_impl->SelectWithTimeout(wxSOCKET_INPUT_FLAG) )
+            {
+                SetError(wxSOCKET_TIMEDOUT);
 
-            return false;
+                return false;
+            }
         }
-    }
 
-    sock.m_impl = m_impl->Accept(sock);
+        impl = m_impl->Accept(sock);
 
-    if ( !sock.m_impl )
-    {
-        return false;
+        if ( !impl )
+        {
+            return false;
+        }
     }
 
+    sock.m_impl = impl;
     sock.m_type = wxSOCKET_BASE;
     sock.m_connected = true;
 
@@ -1982,6 +2346,53 @@ wxSocketBase *wxSocketServer::Accept(bool wait)
     return sock;
 }
 
+size_t wxSocketServer::AcceptAll(std::vector<wxSocketBase*>& sockets,
+                                 size_t maxCount)
+{
+    if ( !m_impl || (m_impl->m_fd == INVALID_SOCKET) || !m_impl->IsServer() )
+    {
+        wxFAIL_MSG( "can only be called for a valid server socket" );
+
+        SetError(wxSOCKET_INVSOCK);
+
+        return 0;
+    }
+
+    size_t count = 0;
+    while ( count < maxCount )
+    {
+        // accept() would block if there are no pending connections on a
+        // blocking socket, so check for them first in this case
+        if ( (m_flags & wxSOCKET_BLOCK) && !m_impl->Select(wxSOCKET_INPUT_FLAG) )
+            break;
+
+        wxSocketBase* const sock = new wxSocketBase();
+        sock->SetFlags(m_flags);
+
+        sock->m_impl = m_impl->DoAccept(*sock);
+        if ( !sock->m_impl )
+        {
+            sock->Destroy();
+            break;
+        }
+
+        sock->m_type = wxSOCKET_BASE;
+        sock->m_connected = true;
+
+        sockets.push_back(sock);
+        count++;
+    }
+
+    // only reenable the events once, after accepting all the connections
+    m_impl->ReenableEvents(wxSOCKET_INPUT_FLAG);
+
+    // not having any more connections to accept is not an error here
+    if ( m_impl->GetError() == wxSOCKET_WOULDBLOCK )
+        SetError(wxSOCKET_NOERROR);
+
+    return count;
+}
+
 bool wxSocketServer::WaitForAccept(long seconds, long milliseconds)
 {
     return DoWait(seconds, milliseconds, wxSOCKET_CONNECTION_FLAG) == 1;
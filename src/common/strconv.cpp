@@ -41,6 +41,7 @@
 
 #include "wx/encconv.h"
 #include "wx/fontmap.h"
+#include "wx/private/sse2.h"
 #include "wx/private/unicode.h"
 
 #ifdef __DARWIN__
@@ -943,6 +944,147 @@ extern const unsigned char tableUtf8Lengths[256] = {
                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F5..FF
 };
 
+namespace
+{
+
+// Helpers for the fast paths used by the UTF-8 converters below: real world
+// text is mostly ASCII, so we handle runs of 7 bit characters in blocks and
+// only fall back to the byte by byte decoding for the non-ASCII ones.
+
+// Copy the initial ASCII part of the src buffer containing srcLen bytes to
+// dst, which must have space for dstLen characters, or just count its length
+// if dst is null.
+//
+// Returns the number of characters copied (or counted).
+size_t DecodeASCIIRun(wchar_t* dst, size_t dstLen, const char* src, size_t srcLen)
+{
+    const size_t maxLen = dst ? wxMin(srcLen, dstLen) : srcLen;
+
+    size_t n = 0;
+
+#ifdef wxHAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; n + 16 <= maxLen; n += 16 )
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(src + n));
+        if ( _mm_movemask_epi8(v) )
+            break;
+
+        if ( !dst )
+            continue;
+
+        const __m128i lo = _mm_unpacklo_epi8(v, zero);
+        const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+        __m128i* const out = (__m128i*)(dst + n);
+#if SIZEOF_WCHAR_T == 2
+        _mm_storeu_si128(out, lo);
+        _mm_storeu_si128(out + 1, hi);
+#else // 32 bit wchar_t
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+#endif // SIZEOF_WCHAR_T
+    }
+#else // !wxHAS_SSE2
+    // Check 8 bytes at once even without SIMD instructions.
+    for ( ; n + 8 <= maxLen; n += 8 )
+    {
+        wxUint64 word;
+        memcpy(&word, src + n, sizeof(word));
+        if ( word & wxULL(0x8080808080808080) )
+            break;
+
+        if ( dst )
+        {
+            for ( size_t i = 0; i < 8; i++ )
+                dst[n + i] = (unsigned char)src[n + i];
+        }
+    }
+#endif // wxHAS_SSE2/!wxHAS_SSE2
+
+    for ( ; n < maxLen; n++ )
+    {
+        const unsigned char c = src[n];
+        if ( c >= 0x80 )
+            break;
+
+        if ( dst )
+            dst[n] = c;
+    }
+
+    return n;
+}
+
+// Reverse of DecodeASCIIRun(): copy the initial part of src consisting only of
+// ASCII characters to dst (or just count it if dst is null).
+//
+// Stops at the first non-ASCII character, NUL or after srcLen characters
+// (which may be wxNO_LEN), whichever comes first.
+size_t EncodeASCIIRun(char* dst, size_t dstLen, const wchar_t* src, size_t srcLen)
+{
+    const size_t maxLen = dst ? wxMin(srcLen, dstLen) : srcLen;
+
+    size_t n = 0;
+
+#ifdef wxHAS_SSE2
+    // We need to check for NULs only when working with NUL-terminated input,
+    // but doing it unconditionally is simpler and almost free. Also note that
+    // we must not read past the NUL in this case, so only use the vectorized
+    // loop when the length is known.
+    if ( srcLen != wxNO_LEN )
+    {
+        const __m128i zero = _mm_setzero_si128();
+#if SIZEOF_WCHAR_T == 2
+        const __m128i nonASCII = _mm_set1_epi16((short)0xff80);
+        for ( ; n + 8 <= maxLen; n += 8 )
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(src + n));
+            if ( _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, nonASCII), zero)) != 0xffff ||
+                    _mm_movemask_epi8(_mm_cmpeq_epi16(v, zero)) )
+                break;
+
+            if ( dst )
+                _mm_storel_epi64((__m128i*)(dst + n), _mm_packus_epi16(v, v));
+        }
+#else // 32 bit wchar_t
+        const __m128i nonASCII = _mm_set1_epi32((int)0xffffff80);
+        for ( ; n + 8 <= maxLen; n += 8 )
+        {
+            const __m128i v1 = _mm_loadu_si128((const __m128i*)(src + n));
+            const __m128i v2 = _mm_loadu_si128((const __m128i*)(src + n + 4));
+            const __m128i any = _mm_and_si128(_mm_or_si128(v1, v2), nonASCII);
+            if ( _mm_movemask_epi8(_mm_cmpeq_epi32(any, zero)) != 0xffff ||
+                    _mm_movemask_epi8(_mm_cmpeq_epi32(v1, zero)) ||
+                        _mm_movemask_epi8(_mm_cmpeq_epi32(v2, zero)) )
+                break;
+
+            if ( dst )
+            {
+                const __m128i w = _mm_packs_epi32(v1, v2);
+                _mm_storel_epi64((__m128i*)(dst + n), _mm_packus_epi16(w, w));
+            }
+        }
+#endif // SIZEOF_WCHAR_T
+    }
+#endif // wxHAS_SSE2
+
+    for ( ; n < maxLen; n++ )
+    {
+        const wchar_t wc = src[n];
+        if ( !wc || (wxUint32)wc >= 0x80 )
+            break;
+
+        if ( dst )
+            dst[n] = (char)wc;
+    }
+
+    return n;
+}
+
+} // anonymous namespace
+
 size_t
 wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
                             const char *src, size_t srcLen) const
@@ -953,7 +1095,7 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
     if ( srcLen == wxNO_LEN )
         srcLen = strlen(src) + 1;
 
-    for ( const char *p = src; ; p++ )
+    for ( const char *p = src; ; )
     {
         if ( (srcLen == wxNO_LEN ? !*p : !srcLen) )
         {
@@ -975,6 +1117,25 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
             return written;
         }
 
+        // Convert all ASCII characters, if any, at once.
+        if ( srcLen != wxNO_LEN )
+        {
+            const size_t run = DecodeASCIIRun(out, dstLen, p, srcLen);
+            if ( run )
+            {
+                p += run;
+                srcLen -= run;
+                written += run;
+                if ( out )
+                {
+                    out += run;
+                    dstLen -= run;
+                }
+
+                continue;
+            }
+        }
+
         if ( out && !dstLen-- )
             break;
 
@@ -1036,6 +1197,8 @@ wxMBConvStrictUTF8::ToWChar(wchar_t *dst, size_t dstLen,
             }
         }
 
+        p++;
+
 #ifdef WC_UTF16
         // cast is ok because wchar_t == wxUint16 if WC_UTF16
         if ( encode_utf16(code, (wxUint16 *)out) == 2 )
@@ -1088,6 +1251,22 @@ wxMBConvStrictUTF8::FromWChar(char *dst, size_t dstLen,
             return written;
         }
 
+        // Handle the ASCII characters in bulk.
+        const size_t run = EncodeASCIIRun(out, dstLen, wp,
+                                          end ? end - wp : wxNO_LEN);
+        if ( run )
+        {
+            wp += run;
+            written += run;
+            if ( out )
+            {
+                out += run;
+                dstLen -= run;
+            }
+
+            continue;
+        }
+
         wxUint32 code;
 #ifdef WC_UTF16
         code = *wp++;
@@ -1191,6 +1370,31 @@ size_t wxMBConvUTF8::ToWChar(wchar_t *buf, size_t n,
     const bool isNulTerminated = srcLen == wxNO_LEN;
     while ((isNulTerminated ? *psz : srcLen--) && ((!buf) || (len < n)))
     {
+        // Convert the ASCII characters in bulk if we know where the input
+        // ends, but stop at the backslashes which need to be escaped in octal
+        // mode.
+        if ( !isNulTerminated )
+        {
+            size_t run = DecodeASCIIRun(buf, buf ? n - len : 0, psz, srcLen + 1);
+            if ( run && (m_options & MAP_INVALID_UTF8_TO_OCTAL) )
+            {
+                const char* const backslash = wxTmemchr(psz, '\\', run);
+                if ( backslash )
+                    run = backslash - psz;
+            }
+
+            if ( run )
+            {
+                psz += run;
+                srcLen -= run - 1;
+                len += run;
+                if ( buf )
+                    buf += run;
+
+                continue;
+            }
+        }
+
         const char *opsz = psz;
         unsigned char cc = *psz++, fc = cc;
         unsigned cnt;
@@ -1364,6 +1568,25 @@ size_t wxMBConvUTF8::FromWChar(char *buf, size_t n,
     const wchar_t* const end = srcLen == wxNO_LEN ? nullptr : psz + srcLen;
     while ((end ? psz < end : *psz) && ((!buf) || (len < n)))
     {
+        size_t run = EncodeASCIIRun(buf, buf ? n - len : 0, psz,
+                                    end ? end - psz : wxNO_LEN);
+        if ( run && (m_options & MAP_INVALID_UTF8_TO_OCTAL) )
+        {
+            const wchar_t* const backslash = wxTmemchr(psz, L'\\', run);
+            if ( backslash )
+                run = backslash - psz;
+        }
+
+        if ( run )
+        {
+            psz += run;
+            len += run;
+            if ( buf )
+                buf += run;
+
+            continue;
+        }
+
         wxUint32 cc;
 
 #ifdef WC_UTF16
@@ -29,10 +29,15 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "wx/hashmap.h"
+#include "wx/internedstring.h"
+#include "wx/thread.h"
 #include "wx/uilocale.h"
 #include "wx/vector.h"
 #include "wx/xlocale.h"
 
+#include <unordered_map>
+
 #ifdef __WINDOWS__
     #include "wx/msw/wrapwin.h"
 #endif // __WINDOWS__
@@ -1970,6 +1975,25 @@ int wxString::DoPrintfUtf8(const char *format, ...)
     later result in out of memory error and crashing, so we also have to impose
     some arbitrary limit on it.
 */
+
+// Assign the contents of the buffer filled by wxVsnprintf() to the string.
+static inline void AssignFormatted(wxString& str, const wchar_t* buf)
+{
+    str.assign(buf);
+}
+
+#if wxUSE_UNICODE_UTF8
+static inline void AssignFormatted(wxString& str, const char* buf)
+{
+    // As in wxUTF8StringBuffer, it isn't an error if vsnprintf() wrote
+    // something invalid into the buffer, just don't use it in this case.
+    if ( wxStringOperations::IsValidUtf8String(buf) )
+        str = wxString::FromUTF8Unchecked(buf);
+    else
+        str.clear();
+}
+#endif // wxUSE_UNICODE_UTF8
+
 #if wxUSE_UNICODE_UTF8
 template<typename BufferType>
 #else
@@ -1980,9 +2004,53 @@ template<typename BufferType>
 static int DoStringPrintfV(wxString& str,
                            const wxString& format, va_list argptr)
 {
-    size_t size = 1024;
+#if wxUSE_UNICODE_UTF8
+    typedef typename BufferType::CharType CharType;
+#else
+    typedef wxChar CharType;
+#endif
+
+    size_t size;
     PreserveErrno preserveErrno;
 
+    // Try formatting into a buffer on the stack first: this is enough for the
+    // vast majority of strings and avoids allocating a big buffer on the heap
+    // only to copy its contents to the string and free it immediately.
+    {
+        CharType bufStack[1024];
+
+        va_list argptrcopy;
+        wxVaCopy(argptrcopy, argptr);
+
+        errno = 0;
+        const int len = wxVsnprintf(bufStack, WXSIZEOF(bufStack), format, argptrcopy);
+        va_end(argptrcopy);
+
+        if ( len >= 0 && static_cast<size_t>(len) < WXSIZEOF(bufStack) )
+        {
+            AssignFormatted(str, bufStack);
+
+            return str.length();
+        }
+
+        if ( len >= 0 )
+        {
+            // We know exactly how much space we need, see below.
+            size = len + 1;
+        }
+        else if ( (errno == EILSEQ) || (errno == EINVAL) )
+        {
+            // Hard error, see the comments in the loop below.
+            str.clear();
+
+            return -1;
+        }
+        else // Buffer too small but we don't know what size is needed.
+        {
+            size = 2*WXSIZEOF(bufStack);
+        }
+    }
+
     for ( ;; )
     {
 #if wxUSE_UNICODE_UTF8
@@ -2253,3 +2321,71 @@ int wxString::Freq(wxUniChar ch) const
     return count;
 }
 
+
+// ----------------------------------------------------------------------------
+// wxInternedString
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The table of all interned strings mapping them to their hashes.
+struct wxInternedStringTable
+{
+    std::unordered_map<wxString, size_t, wxStringHash, wxStringEqual> map;
+
+#if wxUSE_THREADS
+    wxCriticalSection cs;
+#endif // wxUSE_THREADS
+};
+
+wxInternedStringTable& GetInternedStringTable()
+{
+    // This table is intentionally never destroyed, as wxInternedString
+    // objects may be used until the very end of the program, including in
+    // the dtors of other global objects.
+    static wxInternedStringTable* const s_table = new wxInternedStringTable;
+
+    return *s_table;
+}
+
+} // anonymous namespace
+
+/* static */
+const wxInternedString::Entry* wxInternedString::Intern(const wxString& str)
+{
+    wxInternedStringTable& table = GetInternedStringTable();
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(table.cs);
+#endif // wxUSE_THREADS
+
+    const auto it = table.map.find(str);
+    if ( it != table.map.end() )
+        return &*it;
+
+    // Note that pointers to the elements of unordered_map remain valid even
+    // if it is rehashed, so it's fine to return it.
+    const size_t hash = wxStringHash()(str);
+    return &*table.map.emplace(str, hash).first;
+}
+
+/* static */
+const wxInternedString::Entry* wxInternedString::GetEmptyEntry()
+{
+    static const Entry* const s_entry = Intern(wxString());
+
+    return s_entry;
+}
+
+/* static */
+size_t wxInternedString::GetCount()
+{
+    wxInternedStringTable& table = GetInternedStringTable();
+
+#if wxUSE_THREADS
+    wxCriticalSectionLocker lock(table.cs);
+#endif // wxUSE_THREADS
+
+    return table.map.size();
+}
@@ -30,6 +30,11 @@
 // Required for wxIs... functions
 #include <ctype.h>
 
+#include "wx/private/sse2.h"
+
+#include <algorithm>
+#include <type_traits>
+
 // ============================================================================
 // implementation
 // ============================================================================
@@ -38,35 +43,325 @@
 // helpers
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+// Return the value of the given code unit of the string representation.
+inline wxUint32 GetUnitValue(wxStringCharType ch)
+{
+    return static_cast<std::make_unsigned<wxStringCharType>::type>(ch);
+}
+
+inline bool IsInASCIIMask(const wxUint32* mask, wxUint32 c)
+{
+    return c < 128 && ((mask[c >> 5] >> (c & 31)) & 1);
+}
+
+#if wxUSE_UNICODE_UTF8
+// Return the length of the UTF-8 sequence starting at the given position,
+// taking care to never go beyond the end of the string.
+inline size_t GetUTF8SeqLength(const char* p, const char* end)
+{
+    const size_t len = wxStringOperations::GetUtf8CharLength(*p);
+    return wxMin(len, static_cast<size_t>(end - p));
+}
+#endif // wxUSE_UNICODE_UTF8
+
+// Return the number of code units in the string representation.
+inline size_t GetUnitsCount(const wxString& str)
+{
+#if wxUSE_UNICODE_UTF8
+    return str.utf8_length();
+#else
+    return str.length();
+#endif
+}
+
+// Check if the (non-ASCII) character starting at p is one of the characters
+// in the given string, return the length of this character in any case.
+inline bool
+IsNonASCIIOneOf(const wxString& chars,
+                const wxStringCharType* p,
+                const wxStringCharType* end,
+                size_t* len)
+{
+    const wxStringCharType* const start = chars.wx_str();
+    const wxStringCharType* const stop = start + GetUnitsCount(chars);
+
+#if wxUSE_UNICODE_UTF8
+    // As UTF-8 is self-synchronizing, any match of a complete sequence
+    // corresponds to a character in the string.
+    *len = GetUTF8SeqLength(p, end);
+    return std::search(start, stop, p, p + *len) != stop;
+#else
+    wxUnusedVar(end);
+
+    *len = 1;
+    return std::find(start, stop, *p) != stop;
+#endif
+}
+
+#ifdef wxHAS_SSE2
+
+// SSE2 operations on the vectors of string code units.
+template <size_t N> struct SSE2Units;
+
+template <> struct SSE2Units<1>
+{
+    static __m128i Splat(wxUint32 c) { return _mm_set1_epi8((char)c); }
+    static __m128i CmpEq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+};
+
+template <> struct SSE2Units<2>
+{
+    static __m128i Splat(wxUint32 c) { return _mm_set1_epi16((short)c); }
+    static __m128i CmpEq(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+};
+
+template <> struct SSE2Units<4>
+{
+    static __m128i Splat(wxUint32 c) { return _mm_set1_epi32((int)c); }
+    static __m128i CmpEq(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+};
+
+// Skip all the blocks not containing any of the 4 given code units and
+// return the start of the first block containing one of them or of the last
+// incomplete block, which must be checked by the caller.
+const wxStringCharType*
+SkipBlocksWithoutAnyOf4(const wxStringCharType* p,
+                        const wxStringCharType* end,
+                        const wxStringCharType* units)
+{
+    typedef SSE2Units<sizeof(wxStringCharType)> Ops;
+
+    const ptrdiff_t UNITS_PER_BLOCK = 16 / sizeof(wxStringCharType);
+
+    const __m128i d0 = Ops::Splat(GetUnitValue(units[0]));
+    const __m128i d1 = Ops::Splat(GetUnitValue(units[1]));
+    const __m128i d2 = Ops::Splat(GetUnitValue(units[2]));
+    const __m128i d3 = Ops::Splat(GetUnitValue(units[3]));
+
+    for ( ; end - p >= UNITS_PER_BLOCK; p += UNITS_PER_BLOCK )
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)p);
+        const __m128i m = _mm_or_si128
+                          (
+                            _mm_or_si128(Ops::CmpEq(v, d0), Ops::CmpEq(v, d1)),
+                            _mm_or_si128(Ops::CmpEq(v, d2), Ops::CmpEq(v, d3))
+                          );
+        if ( _mm_movemask_epi8(m) )
+            break;
+    }
+
+    return p;
+}
+
+#endif // wxHAS_SSE2
+
+// Return the mode to really use for the given delimiters.
+wxStringTokenizerMode
+GetActualMode(const wxString& delims, wxStringTokenizerMode mode)
+{
+    if ( mode != wxTOKEN_DEFAULT )
+        return mode;
+
+    // by default, we behave like strtok() if the delimiters are only
+    // whitespace characters and as wxTOKEN_RET_EMPTY otherwise (for
+    // whitespace delimiters, strtok() behaviour is better because we want
+    // to count consecutive spaces as one delimiter)
+    for ( wxString::const_iterator p = delims.begin(); p != delims.end(); ++p )
+    {
+        if ( !wxIsspace(*p) )
+        {
+            // not whitespace char in delims
+            return wxTOKEN_RET_EMPTY;
+        }
+    }
+
+    // only whitespaces
+    return wxTOKEN_STRTOK;
+}
+
+} // anonymous namespace
+
 static wxString::const_iterator
-find_first_of(const wxChar *delims, size_t len,
+find_first_of(const wxStringTokenDelimiters& delims,
+              const wxString& str,
               const wxString::const_iterator& from,
               const wxString::const_iterator& end)
 {
     wxASSERT_MSG( from <= end,  wxT("invalid index") );
 
+#if wxUSE_UNICODE_UTF8
+    wxUnusedVar(str);
+
     for ( wxString::const_iterator i = from; i != end; ++i )
     {
-        if ( wxTmemchr(delims, *i, len) )
+        if ( delims.Contains(*i) )
             return i;
     }
 
     return end;
+#else
+    // In wchar_t build the iterators directly correspond to the positions in
+    // the string buffer, so we can use the optimized search function.
+    const wxStringCharType* const buf = str.wx_str();
+    const wxString::const_iterator begin = str.begin();
+
+    return begin + (delims.FindFirstOf(buf + (from - begin),
+                                       buf + (end - begin)) - buf);
+#endif
 }
 
 static wxString::const_iterator
-find_first_not_of(const wxChar *delims, size_t len,
+find_first_not_of(const wxStringTokenDelimiters& delims,
+                  const wxString& str,
                   const wxString::const_iterator& from,
                   const wxString::const_iterator& end)
 {
     wxASSERT_MSG( from <= end,  wxT("invalid index") );
 
+#if wxUSE_UNICODE_UTF8
+    wxUnusedVar(str);
+
     for ( wxString::const_iterator i = from; i != end; ++i )
     {
-        if ( !wxTmemchr(delims, *i, len) )
+        if ( !delims.Contains(*i) )
             return i;
     }
 
+    return end;
+#else
+    const wxStringCharType* const buf = str.wx_str();
+    const wxString::const_iterator begin = str.begin();
+
+    return begin + (delims.FindFirstNotOf(buf + (from - begin),
+                                          buf + (end - begin)) - buf);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// wxStringTokenDelimiters
+// ----------------------------------------------------------------------------
+
+void wxStringTokenDelimiters::Set(const wxString& delims)
+{
+    memset(m_ascii, 0, sizeof(m_ascii));
+    m_countASCII = 0;
+    m_nonASCII.clear();
+
+    for ( wxString::const_iterator i = delims.begin(); i != delims.end(); ++i )
+    {
+        const wxUniChar ch = *i;
+        if ( !ch.IsAscii() )
+        {
+            m_nonASCII += ch;
+            continue;
+        }
+
+        // Ignore the duplicate delimiters.
+        if ( Contains(ch) )
+            continue;
+
+        const wxUint32 c = ch.GetValue();
+        m_ascii[c >> 5] |= 1u << (c & 31);
+
+        if ( m_countASCII < MAX_FAST )
+            m_fast[m_countASCII] = static_cast<wxStringCharType>(c);
+
+        m_countASCII++;
+    }
+
+    // Fill the unused fast delimiters slots with the copies of the first
+    // delimiter to allow always checking for all of them in FindFirstOf().
+    for ( unsigned n = m_countASCII; n < MAX_FAST; n++ )
+        m_fast[n] = m_countASCII ? m_fast[0] : wxStringCharType(0);
+}
+
+const wxStringCharType*
+wxStringTokenDelimiters::FindFirstOf(const wxStringCharType* from,
+                                     const wxStringCharType* end) const
+{
+    wxASSERT_MSG( from <= end, wxT("invalid range") );
+
+    if ( m_nonASCII.empty() )
+    {
+        switch ( m_countASCII )
+        {
+            case 0:
+                return end;
+
+            case 1:
+                // Using the standard function is the fastest way to find a
+                // single character as it's typically heavily optimized.
+                from = std::char_traits<wxStringCharType>::find(from,
+                                                                end - from,
+                                                                m_fast[0]);
+                return from ? from : end;
+        }
+
+#ifdef wxHAS_SSE2
+        if ( m_countASCII <= MAX_FAST )
+            from = SkipBlocksWithoutAnyOf4(from, end, m_fast);
+#endif // wxHAS_SSE2
+
+        for ( const wxStringCharType* p = from; p != end; ++p )
+        {
+            if ( IsInASCIIMask(m_ascii, GetUnitValue(*p)) )
+                return p;
+        }
+
+        return end;
+    }
+
+    // General case of (also) having non-ASCII delimiters.
+    for ( const wxStringCharType* p = from; p != end; )
+    {
+        const wxUint32 c = GetUnitValue(*p);
+        if ( c < 128 )
+        {
+            if ( IsInASCIIMask(m_ascii, c) )
+                return p;
+
+            ++p;
+            continue;
+        }
+
+        size_t len;
+        if ( IsNonASCIIOneOf(m_nonASCII, p, end, &len) )
+            return p;
+
+        p += len;
+    }
+
+    return end;
+}
+
+const wxStringCharType*
+wxStringTokenDelimiters::FindFirstNotOf(const wxStringCharType* from,
+                                        const wxStringCharType* end) const
+{
+    wxASSERT_MSG( from <= end, wxT("invalid range") );
+
+    for ( const wxStringCharType* p = from; p != end; )
+    {
+        const wxUint32 c = GetUnitValue(*p);
+        if ( c < 128 )
+        {
+            if ( !IsInASCIIMask(m_ascii, c) )
+                return p;
+
+            ++p;
+            continue;
+        }
+
+        size_t len;
+        if ( m_nonASCII.empty() || !IsNonASCIIOneOf(m_nonASCII, p, end, &len) )
+            return p;
+
+        p += len;
+    }
+
     return end;
 }
 
@@ -101,35 +396,11 @@ void wxStringTokenizer::SetString(const wxString& str,
                                   const wxString& delims,
                                   wxStringTokenizerMode mode)
 {
-    if ( mode == wxTOKEN_DEFAULT )
-    {
-        // by default, we behave like strtok() if the delimiters are only
-        // whitespace characters and as wxTOKEN_RET_EMPTY otherwise (for
-        // whitespace delimiters, strtok() behaviour is better because we want
-        // to count consecutive spaces as one delimiter)
-        wxString::const_iterator p;
-        for ( p = delims.begin(); p != delims.end(); ++p )
-        {
-            if ( !wxIsspace(*p) )
-                break;
-        }
-
-        if ( p != delims.end() )
-        {
-            // not whitespace char in delims
-            mode = wxTOKEN_RET_EMPTY;
-        }
-        else
-        {
-            // only whitespaces
-            mode = wxTOKEN_STRTOK;
-        }
-    }
-
     m_delims = delims.wc_str();
     m_delimsLen = delims.length();
+    m_delimsSet.Set(delims);
 
-    m_mode = mode;
+    m_mode = GetActualMode(delims, mode);
 
     Reinit(str);
 }
@@ -152,6 +423,7 @@ void wxStringTokenizer::DoCopyFrom(const wxStringTokenizer& src)
     m_pos = m_string.begin() + (src.m_pos - src.m_string.begin());
     m_delims = src.m_delims;
     m_delimsLen = src.m_delimsLen;
+    m_delimsSet = src.m_delimsSet;
     m_mode = src.m_mode;
     m_lastDelim = src.m_lastDelim;
     m_hasMoreTokens = src.m_hasMoreTokens;
@@ -184,7 +456,7 @@ bool wxStringTokenizer::DoHasMoreTokens() const
 {
     wxCHECK_MSG( IsOk(), false, wxT("you should call SetString() first") );
 
-    if ( find_first_not_of(m_delims, m_delimsLen, m_pos, m_stringEnd)
+    if ( find_first_not_of(m_delimsSet, m_string, m_pos, m_stringEnd)
          != m_stringEnd )
     {
         // there are non delimiter characters left, so we do have more tokens
@@ -261,7 +533,7 @@ wxString wxStringTokenizer::GetNextToken()
 
         // find the end of this token
         wxString::const_iterator pos =
-            find_first_of(m_delims, m_delimsLen, m_pos, m_stringEnd);
+            find_first_of(m_delimsSet, m_string, m_pos, m_stringEnd);
 
         // and the start of the next one
         if ( pos == m_stringEnd )
@@ -297,6 +569,111 @@ wxString wxStringTokenizer::GetNextToken()
     return token;
 }
 
+// ----------------------------------------------------------------------------
+// wxStringViewTokenizer
+// ----------------------------------------------------------------------------
+
+wxStringViewTokenizer::wxStringViewTokenizer(const wxString& str,
+                                             const wxString& delims,
+                                             wxStringTokenizerMode mode)
+    : m_begin(str.wx_str()),
+      m_end(m_begin + GetUnitsCount(str)),
+      m_pos(m_begin),
+      m_nextNonDelim(nullptr),
+      m_delims(delims),
+      m_mode(GetActualMode(delims, mode)),
+      m_lastDelim(wxT('\0')),
+      m_afterDelim(false)
+{
+}
+
+bool wxStringViewTokenizer::HasMoreTokens() const
+{
+    switch ( m_mode )
+    {
+        case wxTOKEN_RET_EMPTY_ALL:
+            // We always have a token if we're not at the end yet, but also if
+            // we're just after the last delimiter.
+            return m_pos != m_end || m_afterDelim;
+
+        case wxTOKEN_RET_EMPTY:
+        case wxTOKEN_RET_DELIMS:
+        case wxTOKEN_STRTOK:
+            break;
+
+        case wxTOKEN_INVALID:
+        case wxTOKEN_DEFAULT:
+            wxFAIL_MSG( wxT("unexpected tokenizer mode") );
+            return false;
+    }
+
+    // The cached value remains valid until we advance beyond it, and reusing
+    // it avoids quadratic behaviour for long sequences of delimiters.
+    if ( !m_nextNonDelim || m_nextNonDelim < m_pos )
+        m_nextNonDelim = m_delims.FindFirstNotOf(m_pos, m_end);
+
+    if ( m_nextNonDelim != m_end )
+        return true;
+
+    // As in wxStringTokenizer, return the initial empty token even if there
+    // are only delimiters after it when not using wxTOKEN_STRTOK.
+    return m_mode != wxTOKEN_STRTOK && m_pos == m_begin && m_begin != m_end;
+}
+
+wxStringTokenView wxStringViewTokenizer::GetNextToken()
+{
+    if ( !HasMoreTokens() )
+        return wxStringTokenView(m_end, m_end);
+
+    // Skip the empty tokens if we don't return them: we know that there is
+    // a non-delimiter character if HasMoreTokens() returned true.
+    if ( m_mode == wxTOKEN_STRTOK )
+        m_pos = m_nextNonDelim;
+
+    const wxStringCharType* const start = m_pos;
+
+    // Find the end of this token, avoiding searching for it if we already
+    // know that we're positioned at a delimiter.
+    const wxStringCharType* delim;
+    if ( m_nextNonDelim && m_nextNonDelim > m_pos )
+        delim = m_pos;
+    else
+        delim = m_delims.FindFirstOf(m_pos, m_end);
+
+    if ( delim == m_end )
+    {
+        // no more delimiters, the token is everything till the end of string
+        m_pos = m_end;
+        m_lastDelim = wxT('\0');
+        m_afterDelim = false;
+
+        return wxStringTokenView(start, m_end);
+    }
+
+#if wxUSE_UNICODE_UTF8
+    if ( GetUnitValue(*delim) < 128 )
+    {
+        m_pos = delim + 1;
+        m_lastDelim = *delim;
+    }
+    else
+    {
+        const size_t len = GetUTF8SeqLength(delim, m_end);
+        m_pos = delim + len;
+        m_lastDelim = wxString::FromUTF8Unchecked(delim, len)[0];
+    }
+#else
+    m_pos = delim + 1;
+    m_lastDelim = *delim;
+#endif
+
+    m_afterDelim = true;
+
+    // in wxTOKEN_RET_DELIMS mode we return the delimiter character with
+    // token, otherwise leave it out
+    return wxStringTokenView(start, m_mode == wxTOKEN_RET_DELIMS ? m_pos : delim);
+}
+
 // ----------------------------------------------------------------------------
 // public functions
 // ----------------------------------------------------------------------------
@@ -71,6 +71,17 @@ wxWebSessionImplPtr FromOwned(wxWebSessionImpl& impl)
     return wxWebSessionImplPtr{&impl};
 }
 
+// Maximal number of the response buffers kept by the session for reusing
+// them and the maximal size of such buffers: there is no need to keep huge
+// buffers around, as allocating them is fast compared to downloading as much
+// data anyhow.
+constexpr size_t MAX_FREE_RESPONSE_BUFFERS = 8;
+constexpr size_t MAX_FREE_RESPONSE_BUFFER_SIZE = 1024*1024;
+
+// Size of the buffer used for the file storage: using a big buffer avoids
+// writing each, typically small, chunk of data received separately.
+constexpr size_t FILE_STORAGE_BUFFER_SIZE = 256*1024;
+
 } // anonymous namespace
 
 //
@@ -262,6 +273,13 @@ void wxWebRequestImpl::SetState(wxWebRequest::State state, const wxString & fail
     }
 }
 
+void wxWebRequestImpl::Resume()
+{
+    const wxWebResponseImplPtr response = GetResponse();
+    if ( response )
+        response->ResumeSink();
+}
+
 void wxWebRequestImpl::ReportDataReceived(size_t sizeReceived)
 {
     m_bytesReceived += sizeReceived;
@@ -478,6 +496,16 @@ void wxWebRequestBase::SetTimeouts(long connectionTimeoutMs, long dataTimeoutMs)
 }
 
 
+void wxWebRequestBase::SetDataSink(wxWebRequestSink* sink)
+{
+    wxCHECK_IMPL_VOID();
+
+    wxCHECK_RET( m_impl->GetState() == wxWebRequest::State_Idle,
+                 "Data sink must be set before starting the request" );
+
+    m_impl->SetDataSink(sink);
+}
+
 wxWebRequestBase::Storage wxWebRequestBase::GetStorage() const
 {
     wxCHECK_IMPL( Storage_None );
@@ -489,7 +517,15 @@ wxWebRequestSync::Result wxWebRequestSync::Execute() const
 {
     wxCHECK_IMPL( wxWebRequestSync::Result::Error("Invalid session object") );
 
-    return m_impl->Execute();
+    const Result result = m_impl->Execute();
+
+    // Unlike for the asynchronous requests, there is no state change
+    // notification to do this in, so ensure that all the data written to the
+    // file, if any, is flushed to it before the caller can access it.
+    if ( const wxWebResponseImplPtr response = m_impl->GetResponse() )
+        response->Finalize();
+
+    return result;
 }
 
 void wxWebRequest::Start()
@@ -512,6 +548,13 @@ void wxWebRequest::Cancel()
     m_impl->Cancel();
 }
 
+void wxWebRequest::Resume()
+{
+    wxCHECK_IMPL_VOID();
+
+    m_impl->Resume();
+}
+
 wxWebResponse wxWebRequestBase::GetResponse() const
 {
     wxCHECK_IMPL( wxWebResponse() );
@@ -631,14 +674,29 @@ wxWebAuthChallenge::SetCredentials(const wxWebCredentials& cred)
 //
 
 wxWebResponseImpl::wxWebResponseImpl(wxWebRequestImpl& request) :
-    m_request(request)
+    m_request(request),
+    m_sessionImpl(FromOwned(request.GetSessionImpl()))
 {
+    // Only the buffers used for storing the entire response can be reused,
+    // the ones used with Storage_None are passed to the event handlers.
+    m_reuseBuffer = !request.GetDataSink() &&
+                        request.GetStorage() == wxWebRequest::Storage_Memory;
+    if ( m_reuseBuffer )
+        m_readBuffer = m_sessionImpl->GetResponseBuffer();
 }
 
 wxWebResponseImpl::~wxWebResponseImpl()
 {
     if ( wxFileExists(m_file.GetName()) )
         wxRemoveFile(m_file.GetName());
+
+    if ( m_reuseBuffer )
+    {
+        // The stream uses our buffer, so destroy it before giving it away.
+        m_stream.reset();
+
+        m_sessionImpl->ReleaseResponseBuffer(m_readBuffer);
+    }
 }
 
 wxWebRequest::Result wxWebResponseImpl::InitFileStorage()
@@ -679,6 +737,8 @@ wxWebRequest::Result wxWebResponseImpl::InitFileStorage()
                     )
                 );
         }
+
+        setvbuf(m_file.fp(), nullptr, _IOFBF, FILE_STORAGE_BUFFER_SIZE);
     }
 
     return wxWebRequest::Result::Ok();
@@ -762,16 +822,128 @@ wxString wxWebResponseImpl::AsString() const
 
 void* wxWebResponseImpl::GetDataBuffer(size_t sizeNeeded)
 {
+    wxCriticalSectionLocker lock(m_sinkCS);
+
+    if ( m_request.GetDataSink() )
+        m_sinkAppending = true;
+
+    // wxMemoryBuffer only grows by a small fixed amount, which would result
+    // in quadratic behaviour when receiving a lot of data of unknown size, so
+    // grow it exponentially instead.
+    const size_t sizeTotal = m_readBuffer.GetDataLen() + sizeNeeded;
+    if ( sizeTotal > m_readBuffer.GetBufSize() )
+        m_readBuffer.SetBufSize(wxMax(sizeTotal, 2*m_readBuffer.GetBufSize()));
+
     return m_readBuffer.GetAppendBuf(sizeNeeded);
 }
 
 void wxWebResponseImpl::PreAllocBuffer(size_t sizeNeeded)
 {
+    // The data is not stored when using a sink.
+    if ( m_request.GetDataSink() )
+        return;
+
     m_readBuffer.SetBufSize(sizeNeeded);
 }
 
+wxWebResponseImpl::DataResult
+wxWebResponseImpl::HandleData(const void* data, size_t size)
+{
+    if ( wxWebRequestSink* const sink = m_request.GetDataSink() )
+    {
+        // Pass the data to the sink directly, without copying it.
+        if ( sink->OnData(data, size) == wxWebRequestSink::Action_Pause )
+        {
+            wxCHECK_MSG( m_request.IsAsync(), DataResult::Failed,
+                         "Synchronous requests can't be paused" );
+
+            return DataResult::Paused;
+        }
+
+        m_request.ReportDataReceived(size);
+
+        return DataResult::Consumed;
+    }
+
+    switch ( m_request.GetStorage() )
+    {
+        case wxWebRequest::Storage_File:
+            // The file is already buffered, so write to it directly.
+            if ( m_file.Write(data, size) != size )
+                return DataResult::Failed;
+
+            m_request.ReportDataReceived(size);
+
+            return DataResult::Consumed;
+
+        case wxWebRequest::Storage_Memory:
+        case wxWebRequest::Storage_None:
+            break;
+    }
+
+    memcpy(GetDataBuffer(size), data, size);
+    ReportDataReceived(size);
+
+    return DataResult::Consumed;
+}
+
+void wxWebResponseImpl::FlushToSink()
+{
+    // Must be called with m_sinkCS locked.
+    if ( m_readBuffer.IsEmpty() )
+        return;
+
+    if ( m_request.GetDataSink()->OnData(m_readBuffer.GetData(),
+                                         m_readBuffer.GetDataLen())
+            == wxWebRequestSink::Action_Pause )
+    {
+        wxASSERT_MSG( m_request.IsAsync(),
+                      "Synchronous requests can't be paused" );
+
+        m_sinkPaused = true;
+        return;
+    }
+
+    // Keep the same buffer for the next chunk of data.
+    m_readBuffer.Clear();
+}
+
+void wxWebResponseImpl::ResumeSink()
+{
+    wxCriticalSectionLocker lock(m_sinkCS);
+
+    if ( !m_sinkPaused )
+        return;
+
+    m_sinkPaused = false;
+
+    // If the worker thread is currently appending to the buffer, we can't
+    // touch it, but ReportDataReceived() will flush it soon anyhow.
+    if ( m_sinkAppending )
+        return;
+
+    FlushToSink();
+}
+
 void wxWebResponseImpl::ReportDataReceived(size_t sizeReceived)
 {
+    if ( m_request.GetDataSink() )
+    {
+        wxCriticalSectionLocker lock(m_sinkCS);
+
+        m_sinkAppending = false;
+
+        m_readBuffer.UngetAppendBuf(sizeReceived);
+        m_request.ReportDataReceived(sizeReceived);
+
+        // Just accumulate the data while the sink is paused, this backend
+        // doesn't allow pausing the transfer itself.
+        if ( !m_sinkPaused )
+            FlushToSink();
+
+        return;
+    }
+
     m_readBuffer.UngetAppendBuf(sizeReceived);
     m_request.ReportDataReceived(sizeReceived);
 
@@ -982,6 +1154,39 @@ const wxURI* wxWebSessionImpl::GetBaseURL() const
     return m_baseURL ? m_baseURL.get() : nullptr;
 }
 
+wxMemoryBuffer wxWebSessionImpl::GetResponseBuffer()
+{
+    wxCriticalSectionLocker lock(m_freeBuffersCS);
+
+    if ( m_freeBuffers.empty() )
+        return wxMemoryBuffer();
+
+    // Note that wxMemoryBuffer reference count is not atomic, so it must only
+    // be modified while holding the lock as long as the buffer is shared.
+    wxMemoryBuffer buffer = m_freeBuffers.back();
+    m_freeBuffers.pop_back();
+
+    return buffer;
+}
+
+void wxWebSessionImpl::ReleaseResponseBuffer(wxMemoryBuffer& buffer)
+{
+    if ( buffer.GetBufSize() > MAX_FREE_RESPONSE_BUFFER_SIZE )
+        return;
+
+    wxCriticalSectionLocker lock(m_freeBuffersCS);
+
+    if ( m_freeBuffers.size() == MAX_FREE_RESPONSE_BUFFERS )
+        return;
+
+    buffer.Clear();
+    m_freeBuffers.push_back(buffer);
+
+    // Don't share the buffer, which can be used by another thread as soon as
+    // we release the lock, with the caller.
+    buffer = wxMemoryBuffer(0);
+}
+
 wxString wxWebSessionImpl::GetTempDir() const
 {
     if ( m_tempDir.empty() )
@@ -1212,6 +1417,22 @@ bool wxWebSessionBase::EnablePersistentStorage(bool enable)
     return m_impl->EnablePersistentStorage(enable);
 }
 
+bool wxWebSessionBase::SetMaxConnectionsPerHost(int maxConnections)
+{
+    wxCHECK_IMPL( false );
+
+    wxCHECK_MSG( maxConnections >= 0, false, "invalid number of connections" );
+
+    return m_impl->SetMaxConnectionsPerHost(maxConnections);
+}
+
+wxWebSessionStats wxWebSessionBase::GetStats() const
+{
+    wxCHECK_IMPL( wxWebSessionStats() );
+
+    return m_impl->GetStats();
+}
+
 // ----------------------------------------------------------------------------
 // Module ensuring all global/singleton objects are destroyed on shutdown.
 // ----------------------------------------------------------------------------
@@ -1232,6 +1453,7 @@ public:
     {
         gs_factoryMap.clear();
         gs_defaultSession.Close();
+        gs_defaultSessionSync.Close();
     }
 
 private:
@@ -162,16 +162,9 @@ void wxCURLSetOpt(CURL* handle, CURLoption option, const wxString& value)
     wxCURLSetOpt(handle, option, value.utf8_str().data());
 }
 
-// Define wrapper function for initializing CURL handles.
-CURL* wxCURLEasyInit()
+// Set the options which are common to all handles.
+void wxCURLSetDefaults(CURL* handle)
 {
-    CURL* handle = curl_easy_init();
-    if ( !handle )
-    {
-        wxLogDebug("curl_easy_init() failed");
-        return nullptr;
-    }
-
     // Honour the same environment variables that curl tool itself uses for
     // customizing the certificates locations.
     wxString path;
@@ -188,9 +181,49 @@ CURL* wxCURLEasyInit()
             wxCURLSetOpt(handle, CURLOPT_CAINFO, path);
     }
 
-    return handle;
+    #if CURL_AT_LEAST_VERSION(7, 43, 0)
+    if ( wxWebSessionBaseCURL::CurlRuntimeAtLeastVersion(7, 43, 0) )
+    {
+        // Prefer waiting for an existing connection to become available for
+        // multiplexing to opening a new one.
+        wxCURLSetOpt(handle, CURLOPT_PIPEWAIT, 1L);
+    }
+    #endif // curl >= 7.43
+
+    #if CURL_AT_LEAST_VERSION(7, 47, 0)
+    // Newer versions use HTTP/2 for HTTPS by default, but enable it for the
+    // older ones too, if supported.
+    if ( wxWebSessionBaseCURL::CurlRuntimeAtLeastVersion(7, 47, 0) &&
+            !wxWebSessionBaseCURL::CurlRuntimeAtLeastVersion(7, 62, 0) &&
+                (curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) )
+    {
+        wxCURLSetOpt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    }
+    #endif // curl >= 7.47
+}
+
+// Functions used for locking the data of the share handle, which can be used
+// by the sessions in different threads: the user data pointer points to the
+// array of CURL_LOCK_DATA_LAST critical sections.
+void wxCURLShareLock(CURL* WXUNUSED(handle),
+                     curl_lock_data data,
+                     curl_lock_access WXUNUSED(access),
+                     void* userptr)
+{
+    static_cast<wxCriticalSection*>(userptr)[data].Enter();
+}
+
+void wxCURLShareUnlock(CURL* WXUNUSED(handle),
+                       curl_lock_data data,
+                       void* userptr)
+{
+    static_cast<wxCriticalSection*>(userptr)[data].Leave();
 }
 
+// Maximal number of the easy handles kept by the async session for reusing
+// them in the subsequent requests.
+constexpr size_t MAX_FREE_HANDLES = 16;
+
 } // anonymous namespace
 
 wxWebResponseCURL::wxWebResponseCURL(wxWebRequestCURL& request) :
@@ -227,10 +260,22 @@ wxWebResponseCURL::wxWebResponseCURL(wxWebRequestCURL& request) :
 
 size_t wxWebResponseCURL::CURLOnWrite(void* buffer, size_t size)
 {
-    void* buf = GetDataBuffer(size);
-    memcpy(buf, buffer, size);
-    ReportDataReceived(size);
-    return size;
+    switch ( HandleData(buffer, size) )
+    {
+        case DataResult::Consumed:
+            return size;
+
+        case DataResult::Paused:
+            // libcurl will pass the same data to us again when the transfer
+            // is resumed in wxWebRequestCURL::Resume().
+            return CURL_WRITEFUNC_PAUSE;
+
+        case DataResult::Failed:
+            break;
+    }
+
+    // Returning anything different from the size makes the transfer fail.
+    return 0;
 }
 
 size_t wxWebResponseCURL::CURLOnHeader(const char * buffer, size_t size)
@@ -342,7 +387,7 @@ wxWebRequestCURL::wxWebRequestCURL(wxWebSession & session,
                                    int id):
     wxWebRequestImpl(session, sessionImpl, handler, id),
     m_sessionCURL(&sessionImpl),
-    m_handle(wxCURLEasyInit())
+    m_handle(sessionImpl.AcquireHandle())
 {
 
     DoStartPrepare(url);
@@ -434,7 +479,8 @@ wxWebRequestCURL::~wxWebRequestCURL()
     {
         m_sessionCURL->RequestHasTerminated(this);
 
-        curl_easy_cleanup(m_handle);
+        if ( m_handle )
+            m_sessionCURL->ReleaseHandle(m_handle);
     }
 }
 
@@ -509,7 +555,11 @@ wxWebRequest::Result wxWebRequestCURL::Execute()
         return result;
 
     const CURLcode err = curl_easy_perform(m_handle);
-    if ( err != CURLE_OK )
+    if ( err == CURLE_OK )
+    {
+        static_cast<wxWebSessionBaseCURL&>(GetSessionImpl()).UpdateStats(m_handle);
+    }
+    else
     {
         // This ensures that DoHandleCompletion() returns failure and uses
         // libcurl error message.
@@ -579,6 +629,20 @@ void wxWebRequestCURL::DoCancel()
     m_sessionCURL->CancelRequest(this);
 }
 
+void wxWebRequestCURL::Resume()
+{
+    wxCHECK_RET( m_sessionCURL, "Synchronous requests can't be resumed" );
+
+    // This may call our write callback with the data which couldn't be
+    // delivered before from inside this function.
+    const CURLcode rc = curl_easy_pause(m_handle, CURLPAUSE_CONT);
+    if ( rc != CURLE_OK )
+    {
+        wxLogTrace(wxTRACE_WEBREQUEST, "Request %p: resuming failed: %s",
+                   this, curl_easy_strerror(rc));
+    }
+}
+
 wxWebRequest::Result wxWebRequestCURL::DoHandleCompletion()
 {
     // This is a special case, we want to use libcurl error message if there is
@@ -1131,6 +1195,8 @@ public:
 
 int wxWebSessionBaseCURL::ms_activeSessions = 0;
 unsigned int wxWebSessionBaseCURL::ms_runtimeVersion = 0;
+CURLSH* wxWebSessionBaseCURL::ms_share = nullptr;
+wxCriticalSection* wxWebSessionBaseCURL::ms_shareLocks = nullptr;
 
 wxWebSessionBaseCURL::wxWebSessionBaseCURL(Mode mode)
     : wxWebSessionImpl(mode)
@@ -1146,6 +1212,22 @@ wxWebSessionBaseCURL::wxWebSessionBaseCURL(Mode mode)
         {
             curl_version_info_data* data = curl_version_info(CURLVERSION_NOW);
             ms_runtimeVersion = data->version_num;
+
+            // Share DNS and TLS sessions caches between all sessions, which
+            // avoids redoing name resolutions and full TLS handshakes for
+            // each of them. Note that connections can't be shared between
+            // the sessions used from different threads, so each session
+            // keeps its own connection cache.
+            ms_share = curl_share_init();
+            if ( ms_share )
+            {
+                ms_shareLocks = new wxCriticalSection[CURL_LOCK_DATA_LAST];
+                curl_share_setopt(ms_share, CURLSHOPT_USERDATA, ms_shareLocks);
+                curl_share_setopt(ms_share, CURLSHOPT_LOCKFUNC, wxCURLShareLock);
+                curl_share_setopt(ms_share, CURLSHOPT_UNLOCKFUNC, wxCURLShareUnlock);
+                curl_share_setopt(ms_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+                curl_share_setopt(ms_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            }
         }
     }
 
@@ -1157,7 +1239,56 @@ wxWebSessionBaseCURL::~wxWebSessionBaseCURL()
     // Global CURL cleanup if this is the last session
     --ms_activeSessions;
     if ( ms_activeSessions == 0 )
+    {
+        if ( ms_share )
+        {
+            curl_share_cleanup(ms_share);
+            ms_share = nullptr;
+
+            delete [] ms_shareLocks;
+            ms_shareLocks = nullptr;
+        }
+
         curl_global_cleanup();
+    }
+}
+
+CURL* wxWebSessionBaseCURL::PrepareHandle(CURL* handle)
+{
+    if ( handle )
+    {
+        m_stats.handlesReused++;
+    }
+    else
+    {
+        handle = curl_easy_init();
+        if ( !handle )
+        {
+            wxLogDebug("curl_easy_init() failed");
+            return nullptr;
+        }
+    }
+
+    wxCURLSetDefaults(handle);
+
+    if ( ms_share )
+        wxCURLSetOpt(handle, CURLOPT_SHARE, ms_share);
+
+    return handle;
+}
+
+void wxWebSessionBaseCURL::UpdateStats(CURL* handle)
+{
+    m_stats.requests++;
+
+    long connects = 0;
+    if ( curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects) != CURLE_OK )
+        return;
+
+    if ( connects )
+        m_stats.connectionsCreated += connects;
+    else
+        m_stats.connectionsReused++;
 }
 
 //
@@ -1179,18 +1310,14 @@ wxWebRequestImplPtr
 wxWebSessionSyncCURL::CreateRequestSync(wxWebSessionSync& WXUNUSED(session),
                                         const wxString& url)
 {
-    if ( !m_handle )
-    {
-        // Allocate it the first time we need it and keep it later.
-        m_handle = wxCURLEasyInit();
-    }
-    else
-    {
-        // But when reusing it subsequently, we must reset all the previously
-        // set options to prevent the settings from one request from applying
-        // to the subsequent ones.
+    // Allocate the handle the first time we need it and keep reusing it
+    // later, which allows to reuse its connections too. But when reusing it,
+    // we must reset all the previously set options to prevent the settings
+    // from one request from applying to the subsequent ones.
+    if ( m_handle )
         curl_easy_reset(m_handle);
-    }
+
+    m_handle = PrepareHandle(m_handle);
 
     return wxWebRequestImplPtr(new wxWebRequestCURL(*this, url));
 }
@@ -1211,6 +1338,9 @@ wxWebSessionCURL::wxWebSessionCURL()
 
 wxWebSessionCURL::~wxWebSessionCURL()
 {
+    for ( CURL* handle : m_freeHandles )
+        curl_easy_cleanup(handle);
+
     if ( m_handle )
         curl_multi_cleanup(m_handle);
 
@@ -1240,12 +1370,75 @@ wxWebSessionCURL::CreateRequest(wxWebSession& session,
             curl_multi_setopt(m_handle, CURLMOPT_SOCKETFUNCTION, SocketCallback);
             curl_multi_setopt(m_handle, CURLMOPT_TIMERDATA, this);
             curl_multi_setopt(m_handle, CURLMOPT_TIMERFUNCTION, TimerCallback);
+
+            #if CURL_AT_LEAST_VERSION(7, 43, 0)
+            // Use HTTP/2 multiplexing when possible, this is the default
+            // since 7.62 but not in the earlier versions.
+            if ( CurlRuntimeAtLeastVersion(7, 43, 0) )
+                curl_multi_setopt(m_handle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+            #endif // curl >= 7.43
+
+            if ( m_maxConnectionsPerHost )
+                SetMaxConnectionsPerHost(m_maxConnectionsPerHost);
         }
     }
 
     return wxWebRequestImplPtr(new wxWebRequestCURL(session, *this, handler, url, id));
 }
 
+bool wxWebSessionCURL::SetMaxConnectionsPerHost(int maxConnections)
+{
+#if CURL_AT_LEAST_VERSION(7, 30, 0)
+    if ( !CurlRuntimeAtLeastVersion(7, 30, 0) )
+        return false;
+
+    m_maxConnectionsPerHost = maxConnections;
+
+    // If we don't have the handle yet, this will be done when it's created.
+    if ( m_handle )
+    {
+        if ( curl_multi_setopt(m_handle, CURLMOPT_MAX_HOST_CONNECTIONS,
+                               m_maxConnectionsPerHost) != CURLM_OK )
+            return false;
+    }
+
+    return true;
+#else // curl < 7.30
+    wxUnusedVar(maxConnections);
+
+    return false;
+#endif // curl >= 7.30
+}
+
+CURL* wxWebSessionCURL::AcquireHandle()
+{
+    CURL* handle = nullptr;
+    if ( !m_freeHandles.empty() )
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+
+    return PrepareHandle(handle);
+}
+
+void wxWebSessionCURL::ReleaseHandle(CURL* handle)
+{
+    if ( m_freeHandles.size() < MAX_FREE_HANDLES )
+    {
+        // Reset the handle immediately as its options refer to the request
+        // which is being destroyed: notice that this preserves its DNS and
+        // TLS sessions caches.
+        curl_easy_reset(handle);
+
+        m_freeHandles.push_back(handle);
+    }
+    else
+    {
+        curl_easy_cleanup(handle);
+    }
+}
+
 bool wxWebSessionCURL::StartRequest(wxWebRequestCURL & request)
 {
     // Add request easy handle to multi handle
@@ -1485,6 +1678,8 @@ void wxWebSessionCURL::CheckForCompletedTransfers()
             {
                 wxWebRequestCURL* request = it->second;
                 curl_multi_remove_handle(m_handle, curl);
+                if ( msg->data.result == CURLE_OK )
+                    UpdateStats(curl);
                 request->HandleCompletion();
                 m_activeTransfers.erase(it);
                 RemoveActiveSocket(curl);
@@ -26,6 +26,10 @@
 
 #include <errno.h>
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 // ============================================================================
 // printf() implementation
 // ============================================================================
@@ -84,6 +88,73 @@ static int wxCopyStrWithPercents(
     return written;
 }
 
+// Parsed format string.
+//
+// Parsing the format string is relatively expensive, while the same format
+// strings are typically used over and over again, so we cache the results of
+// parsing them in objects of this class.
+//
+// Notice that the specifiers in the parser point into the copy of the format
+// string stored in the same object.
+template<typename CharType>
+struct wxPrintfParsedFormat
+{
+    explicit wxPrintfParsedFormat(const CharType *format_)
+        : format(format_),
+          parser(format.c_str())
+    {
+    }
+
+    const std::basic_string<CharType> format;
+    const wxPrintfConvSpecParser<CharType> parser;
+
+    wxDECLARE_NO_COPY_CLASS(wxPrintfParsedFormat);
+};
+
+// Return the parsed representation of the given format string.
+//
+// The cache is per-thread to avoid any need for locking. We return shared
+// pointer and not a reference to make it safe to call this function
+// recursively (which can happen in case of asserts during parsing).
+template<typename CharType>
+static std::shared_ptr< const wxPrintfParsedFormat<CharType> >
+wxGetPrintfParsedFormat(const CharType *format)
+{
+    typedef std::shared_ptr< const wxPrintfParsedFormat<CharType> > FormatPtr;
+
+    // The limit is arbitrary, it's supposed to be enough to contain all the
+    // formats used by a typical application, but not to grow indefinitely if
+    // it uses dynamically generated formats.
+    static const size_t MAX_CACHE_SIZE = 256;
+
+    // The formats are almost always string literals, so use their addresses
+    // as keys to avoid constructing a string for each lookup. As a format can
+    // also be stored in a buffer which is later reused for another one, we
+    // still need to check that it didn't change.
+    static thread_local
+        std::unordered_map<const CharType*, FormatPtr> s_cache;
+
+    const auto it = s_cache.find(format);
+    if ( it != s_cache.end() )
+    {
+        if ( it->second->format.compare(format) != 0 )
+            it->second = std::make_shared< wxPrintfParsedFormat<CharType> >(format);
+
+        return it->second;
+    }
+
+    const FormatPtr parsed = std::make_shared< wxPrintfParsedFormat<CharType> >(format);
+
+    // Evict just a single entry when the cache is full, so that the formats
+    // used most often are not all reparsed at once.
+    if ( s_cache.size() >= MAX_CACHE_SIZE )
+        s_cache.erase(s_cache.begin());
+
+    s_cache.emplace(format, parsed);
+
+    return parsed;
+}
+
 template<typename CharType>
 static int wxDoVsnprintf(CharType *buf, size_t lenMax,
                          const CharType *format, va_list argptr)
@@ -94,7 +165,10 @@ static int wxDoVsnprintf(CharType *buf, size_t lenMax,
     wprintf(L"Using wxCRT_VsnprintfW\n");
 #endif
 
-    wxPrintfConvSpecParser<CharType> parser(format);
+    const std::shared_ptr< const wxPrintfParsedFormat<CharType> >
+        parsed = wxGetPrintfParsedFormat(format);
+    const wxPrintfConvSpecParser<CharType>& parser = parsed->parser;
+    const CharType* const base = parsed->format.c_str();
 
     wxPrintfArg argdata[wxMAX_SVNPRINTF_ARGUMENTS];
 
@@ -112,6 +186,21 @@ static int wxDoVsnprintf(CharType *buf, size_t lenMax,
         return -1;      // format strings with both positional and
     }                   // non-positional conversion specifier are unsupported !!
 
+    // The specifiers are modified when loading the arguments, so we need to
+    // use their copies, which also need to point into our format string.
+    wxPrintfConvSpec<CharType> specs[wxMAX_SVNPRINTF_ARGUMENTS];
+    for (i=0; i < parser.nspecs; i++)
+    {
+        const wxPrintfConvSpec<CharType>& spec = parser.specs[i];
+
+        specs[i] = spec;
+        if ( spec.m_pArgPos )
+        {
+            specs[i].m_pArgPos = format + (spec.m_pArgPos - base);
+            specs[i].m_pArgEnd = format + (spec.m_pArgEnd - base);
+        }
+    }
+
     // on platforms where va_list is an array type, it is necessary to make a
     // copy to be able to pass it to LoadArg as a reference.
     bool ok = true;
@@ -124,7 +213,8 @@ static int wxDoVsnprintf(CharType *buf, size_t lenMax,
         // !pspec[i] means that the user forgot a positional parameter (e.g. %$1s %$3s);
         // LoadArg == false means that wxPrintfConvSpec::Parse failed to set the
         // conversion specifier 'type' to a valid value...
-        ok = parser.pspec[i] && parser.pspec[i]->LoadArg(&argdata[i], ap);
+        ok = parser.pspec[i] &&
+                specs[parser.pspec[i] - parser.specs].LoadArg(&argdata[i], ap);
     }
 
     va_end(ap);
@@ -142,7 +232,7 @@ static int wxDoVsnprintf(CharType *buf, size_t lenMax,
     const CharType *toparse = format;
     for (i=0; i < parser.nspecs; i++)
     {
-        wxPrintfConvSpec<CharType>& spec = parser.specs[i];
+        wxPrintfConvSpec<CharType>& spec = specs[i];
 
         // skip any asterisks, they're processed as part of the conversion they
         // apply to
@@ -296,10 +296,9 @@ void wxGridCellChoiceRenderer::SetParameters(const wxString& params)
     if ( params.empty() )
         return;
 
-    wxStringTokenizer tk(params, wxT(','));
-    while ( tk.HasMoreTokens() )
+    for ( const wxStringTokenView& token : wxStringViewTokenizer(params, wxT(',')) )
     {
-        m_choices.Add(tk.GetNextToken());
+        m_choices.Add(token.ToString());
     }
 }
 
@@ -438,10 +437,10 @@ wxGridCellAutoWrapStringRenderer::BreakLine(wxReadOnlyDC& dc,
     wxString line;
 
     // For each word
-    wxStringTokenizer wordTokenizer(logicalLine, wxS(" \t"), wxTOKEN_RET_DELIMS);
-    while ( wordTokenizer.HasMoreTokens() )
+    for ( const wxStringTokenView& token :
+            wxStringViewTokenizer(logicalLine, wxS(" \t"), wxTOKEN_RET_DELIMS) )
     {
-        const wxString word = wordTokenizer.GetNextToken();
+        const wxString word = token.ToString();
         const wxCoord wordWidth = dc.GetTextExtent(word).x;
         if ( lineWidth + wordWidth < maxWidth )
         {
@@ -26,6 +26,9 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <limits>
+
 //-----------------------------------------------------------------------------
 // Helper classes
 //-----------------------------------------------------------------------------
@@ -318,6 +321,18 @@ wxHtmlWordCell::wxHtmlWordCell(const wxString& word, const wxDC& dc) : wxHtmlCel
     m_allowLinebreak = true;
 }
 
+wxHtmlWordCell::wxHtmlWordCell(const wxString& word,
+                               int width, int height, int descent)
+    : wxHtmlCell()
+    , m_Word(word)
+{
+    m_Width = width;
+    m_Height = height;
+    m_Descent = descent;
+    SetCanLiveOnPagebreak(false);
+    m_allowLinebreak = true;
+}
+
 void wxHtmlWordCell::SetPreviousWord(wxHtmlWordCell *cell)
 {
     if ( cell && m_Parent == cell->m_Parent &&
@@ -1003,6 +1018,76 @@ void wxHtmlContainerCell::Layout(int w)
     m_MaxTotalWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
     MaxLineWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
     if (m_Width < MaxLineWidth) m_Width = MaxLineWidth;
+
+    BuildChildrenIndex();
+}
+
+void wxHtmlContainerCell::BuildChildrenIndex()
+{
+    ClearChildrenIndex();
+
+    // Don't bother with the index for the containers with just a few children.
+    static const size_t MIN_INDEXED_CHILDREN = 16;
+
+    size_t count = 0;
+    for ( wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+        count++;
+
+    if ( count < MIN_INDEXED_CHILDREN )
+        return;
+
+    m_childrenIndex.reserve(count);
+
+    int maxBottom = std::numeric_limits<int>::min();
+    for ( wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+    {
+        const int bottom = cell->GetPosY() + cell->GetHeight();
+        if ( bottom > maxBottom )
+            maxBottom = bottom;
+
+        if ( !wxDynamicCast(cell, wxHtmlWordCell) )
+            m_nonWordChildren.push_back(m_childrenIndex.size());
+
+        ChildIndexEntry entry;
+        entry.cell = cell;
+        entry.maxBottom = maxBottom;
+        m_childrenIndex.push_back(entry);
+    }
+
+    int minTop = std::numeric_limits<int>::max();
+    for ( size_t n = count; n > 0; n-- )
+    {
+        ChildIndexEntry& entry = m_childrenIndex[n - 1];
+
+        const int top = entry.cell->GetPosY();
+        if ( top < minTop )
+            minTop = top;
+
+        entry.minTop = minTop;
+    }
+}
+
+void wxHtmlContainerCell::ClearChildrenIndex()
+{
+    m_childrenIndex.clear();
+    m_nonWordChildren.clear();
+}
+
+void wxHtmlContainerCell::GetChildrenInBand(int y1, int y2,
+                                            size_t *first, size_t *last) const
+{
+    // All children before the first one are above y1 and all the children
+    // starting from the last one are below y2.
+    const auto begin = m_childrenIndex.begin();
+    const auto end = m_childrenIndex.end();
+
+    const auto itFirst = std::partition_point(begin, end,
+        [y1](const ChildIndexEntry& entry) { return entry.maxBottom <= y1; });
+    const auto itLast = std::partition_point(itFirst, end,
+        [y2](const ChildIndexEntry& entry) { return entry.minTop <= y2; });
+
+    *first = itFirst - begin;
+    *last = itLast - begin;
 }
 
 void wxHtmlContainerCell::UpdateRenderingStatePre(wxHtmlRenderingInfo& info,
@@ -1116,7 +1201,47 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
         dc.DrawLines(2, &poly[1], x, y - 1); // between 1 and 2
         dc.DrawLines(2, &poly[4], x, y - 1); // between 4 and 5
     }
-    if (m_Cells)
+    if ( !m_childrenIndex.empty() )
+    {
+        // only draw the children in the visible band, but still process the
+        // font, colour etc changes done by the other ones
+        size_t first, last;
+        GetChildrenInBand(view_y1 - ylocal, view_y2 - ylocal, &first, &last);
+
+        const auto nonWordsBegin = m_nonWordChildren.begin();
+        const auto nonWordsEnd = m_nonWordChildren.end();
+        const auto nonWordsFirst = std::lower_bound(nonWordsBegin, nonWordsEnd,
+                                                    first);
+        for ( auto it = nonWordsBegin; it != nonWordsFirst; ++it )
+            m_childrenIndex[*it].cell->DrawInvisible(dc, xlocal, ylocal, info);
+
+        for ( size_t n = first; n < last; n++ )
+        {
+            wxHtmlCell* const cell = m_childrenIndex[n].cell;
+
+            if ((ylocal + cell->GetPosY() <= view_y2) &&
+                (ylocal + cell->GetPosY() + cell->GetHeight() > view_y1))
+            {
+                UpdateRenderingStatePre(info, cell);
+                cell->Draw(dc,
+                           xlocal, ylocal, view_y1, view_y2,
+                           info);
+                UpdateRenderingStatePost(info, cell);
+            }
+            else
+            {
+                cell->DrawInvisible(dc, xlocal, ylocal, info);
+            }
+        }
+
+        for ( auto it = std::lower_bound(nonWordsFirst, nonWordsEnd, last);
+              it != nonWordsEnd;
+              ++it )
+        {
+            m_childrenIndex[*it].cell->DrawInvisible(dc, xlocal, ylocal, info);
+        }
+    }
+    else if (m_Cells)
     {
         // draw container's contents:
         for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
@@ -1148,6 +1273,29 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
 void wxHtmlContainerCell::DrawInvisible(wxDC& dc, int x, int y,
                                         wxHtmlRenderingInfo& info)
 {
+    if ( !m_childrenIndex.empty() )
+    {
+        // Words don't do anything in DrawInvisible(), so we can skip them,
+        // unless the selection starts or ends at one of them, as the
+        // selection state must be updated in this case.
+        const wxHtmlSelection* const s = info.GetSelection();
+        if ( !s ||
+                ((!s->GetFromCell() || s->GetFromCell()->GetParent() != this) &&
+                 (!s->GetToCell() || s->GetToCell()->GetParent() != this)) )
+        {
+            for ( size_t n : m_nonWordChildren )
+            {
+                wxHtmlCell* const cell = m_childrenIndex[n].cell;
+
+                UpdateRenderingStatePre(info, cell);
+                cell->DrawInvisible(dc, x + m_PosX, y + m_PosY, info);
+                UpdateRenderingStatePost(info, cell);
+            }
+
+            return;
+        }
+    }
+
     if (m_Cells)
     {
         for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
@@ -1190,6 +1338,7 @@ void wxHtmlContainerCell::InsertCell(wxHtmlCell *f)
     }
     f->SetParent(this);
     m_LastLayout = -1;
+    ClearChildrenIndex();
 }
 
 
@@ -1227,6 +1376,9 @@ void wxHtmlContainerCell::Detach(wxHtmlCell *cell)
 
     cell->SetParent(nullptr);
     cell->SetNext(nullptr);
+
+    ClearChildrenIndex();
+    m_LastLayout = -1;
 }
 
 
@@ -1291,6 +1443,9 @@ const wxHtmlCell* wxHtmlContainerCell::Find(int condition, const void* param) co
 wxHtmlCell *wxHtmlContainerCell::FindCellByPos(wxCoord x, wxCoord y,
                                                unsigned flags) const
 {
+    if ( !m_childrenIndex.empty() )
+        return FindCellByPosIndexed(x, y, flags);
+
     if ( flags & wxHTML_FIND_EXACT )
     {
         for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
@@ -1343,6 +1498,87 @@ wxHtmlCell *wxHtmlContainerCell::FindCellByPos(wxCoord x, wxCoord y,
 }
 
 
+wxHtmlCell *wxHtmlContainerCell::FindCellByPosIndexed(wxCoord x, wxCoord y,
+                                                      unsigned flags) const
+{
+    // This does exactly the same thing as the loops in FindCellByPos() but
+    // skips the children which can't match the given position.
+    size_t first, last;
+    GetChildrenInBand(y, y, &first, &last);
+
+    const size_t count = m_childrenIndex.size();
+
+    if ( flags & wxHTML_FIND_EXACT )
+    {
+        for ( size_t n = first; n < last; n++ )
+        {
+            const wxHtmlCell* const cell = m_childrenIndex[n].cell;
+
+            int cx = cell->GetPosX(),
+                cy = cell->GetPosY();
+
+            if ( (cx <= x) && (cx + cell->GetWidth() > x) &&
+                 (cy <= y) && (cy + cell->GetHeight() > y) )
+            {
+                return cell->FindCellByPos(x - cx, y - cy, flags);
+            }
+        }
+    }
+    else if ( flags & wxHTML_FIND_NEAREST_AFTER )
+    {
+        // All the children before the first one are entirely above y.
+        for ( size_t n = first; n < count; n++ )
+        {
+            const wxHtmlCell* const cell = m_childrenIndex[n].cell;
+
+            if ( cell->IsFormattingCell() )
+                continue;
+            int cellY = cell->GetPosY();
+            if (!( y < cellY || (y < cellY + cell->GetHeight() &&
+                                 x < cell->GetPosX() + cell->GetWidth()) ))
+                continue;
+
+            wxHtmlCell* const c = cell->FindCellByPos(x - cell->GetPosX(),
+                                                      y - cellY, flags);
+            if (c) return c;
+        }
+    }
+    else if ( flags & wxHTML_FIND_NEAREST_BEFORE )
+    {
+        // All the children before the first one are entirely above y and so
+        // are never the cell where the search stops, find this cell first.
+        size_t end = first;
+        for ( ; end < count; end++ )
+        {
+            const wxHtmlCell* const cell = m_childrenIndex[end].cell;
+
+            if ( cell->IsFormattingCell() )
+                continue;
+            int cellY = cell->GetPosY();
+            if (!( cellY + cell->GetHeight() <= y ||
+                   (y >= cellY && x >= cell->GetPosX()) ))
+                break;
+        }
+
+        // And then return the last cell found before it.
+        for ( size_t n = end; n > 0; n-- )
+        {
+            const wxHtmlCell* const cell = m_childrenIndex[n - 1].cell;
+
+            if ( cell->IsFormattingCell() )
+                continue;
+
+            wxHtmlCell* const c = cell->FindCellByPos(x - cell->GetPosX(),
+                                                      y - cell->GetPosY(),
+                                                      flags);
+            if (c) return c;
+        }
+    }
+
+    return nullptr;
+}
+
+
 bool wxHtmlContainerCell::ProcessMouseClick(wxHtmlWindowInterface *window,
                                             const wxPoint& pos,
                                             const wxMouseEvent& event)
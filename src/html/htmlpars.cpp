@@ -99,6 +99,27 @@ wxObject* wxHtmlParser::Parse(const wxString& source)
     return result;
 }
 
+wxObject* wxHtmlParser::ParseFragment(const wxString& fragment)
+{
+    // Parse() replaces the existing source, so take it away from it.
+    std::unique_ptr<const wxString> source(m_Source);
+    m_Source = nullptr;
+
+    wxObject *result = Parse(fragment);
+
+    if ( source )
+    {
+        // It's safe to modify the string as it's always allocated by us in
+        // SetSource() and appending to it avoids copying it.
+        wxString* const full = const_cast<wxString*>(source.release());
+        *full += *m_Source;
+        delete m_Source;
+        m_Source = full;
+    }
+
+    return result;
+}
+
 void wxHtmlParser::InitParser(const wxString& source)
 {
     SetSource(source);
@@ -458,16 +458,10 @@ bool wxHtmlWindow::SetPage(const wxString& source)
     return DoSetPage(source);
 }
 
-bool wxHtmlWindow::DoSetPage(const wxString& source)
+wxString wxHtmlWindow::ApplyProcessors(const wxString& source) const
 {
     wxString newsrc(source);
 
-    wxDELETE(m_selection);
-
-    // we will soon delete all the cells, so clear pointers to them:
-    m_tmpSelFromCell = nullptr;
-
-    // pass HTML through registered processors:
     if (m_Processors || m_GlobalProcessors)
     {
         wxHtmlProcessorList::iterator nodeL, nodeG;
@@ -512,6 +506,19 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
         }
     }
 
+    return newsrc;
+}
+
+bool wxHtmlWindow::DoSetPage(const wxString& source)
+{
+    wxDELETE(m_selection);
+
+    // we will soon delete all the cells, so clear pointers to them:
+    m_tmpSelFromCell = nullptr;
+
+    // pass HTML through registered processors...
+    const wxString newsrc = ApplyProcessors(source);
+
     // ...and run the parser on it:
     wxClientDC dc(this);
     dc.SetMapMode(wxMM_TEXT);
@@ -550,6 +557,43 @@ bool wxHtmlWindow::AppendToPage(const wxString& source)
     return DoSetPage(*(GetParser()->GetSource()) + source);
 }
 
+bool wxHtmlWindow::AppendBlockToPage(const wxString& source)
+{
+    if ( !m_Cell )
+        return DoSetPage(source);
+
+    const wxString newsrc = ApplyProcessors(source);
+
+    wxClientDC dc(this);
+    dc.SetMapMode(wxMM_TEXT);
+
+    double pixelScale = 1.0;
+#ifndef wxHAS_DPI_INDEPENDENT_PIXELS
+    pixelScale = GetDPIScaleFactor();
+#endif
+
+    // Parse just the new fragment, but still append it to the parser source
+    // to allow re-parsing the entire page later if necessary.
+    m_Parser->SetDC(&dc, pixelScale, 1.0);
+    std::unique_ptr<wxHtmlContainerCell>
+        cell(static_cast<wxHtmlContainerCell*>(m_Parser->ParseFragment(newsrc)));
+    m_Parser->SetDC(nullptr);
+
+    // Move the cells created for it to the end of the existing page: as the
+    // cells already on it are not modified, they don't need to be laid out
+    // again, so CreateLayout() below only lays out the new ones.
+    while ( wxHtmlCell* const child = cell->GetFirstChild() )
+    {
+        cell->Detach(child);
+        m_Cell->InsertCell(child);
+    }
+
+    CreateLayout();
+    if (m_tmpCanDrawLocks == 0)
+        Refresh();
+    return true;
+}
+
 bool wxHtmlWindow::LoadPage(const wxString& location)
 {
     wxCHECK_MSG( !location.empty(), false, "location must be non-empty" );
@@ -45,6 +45,10 @@ wxHtmlWinParser::wxHtmlWinParser(wxHtmlWindowInterface *wndIface)
     m_whitespaceMode = Whitespace_Normal;
     m_lastWordCell = nullptr;
     m_posColumn = 0;
+    m_currentFont = nullptr;
+    m_extentsScaleX =
+    m_extentsScaleY =
+    m_extentsContentScale = 0.0;
 
     {
         int i, j, k, l, m;
@@ -153,6 +157,10 @@ void wxHtmlWinParser::SetFonts(const wxString& normal_face,
                             m_FontsTable[i][j][k][l][m] = nullptr;
                         }
                     }
+
+    // The extents measured using the fonts we've just deleted are useless now.
+    m_wordExtents.clear();
+    m_currentFont = nullptr;
 }
 
 void wxHtmlWinParser::SetStandardFonts(int size,
@@ -421,6 +429,39 @@ void wxHtmlWinParser::AddWord(wxHtmlWordCell *word)
     m_lastWordCell = word;
 }
 
+void wxHtmlWinParser::AddWord(const wxString& word)
+{
+    // Measuring the text is relatively expensive and the same words occur
+    // many times in a typical document, so reuse the extents of the words
+    // already measured using the same font. Notice that this can only be done
+    // if the font selected into the DC is really the one we think it is and
+    // wasn't changed by some tag handler.
+    if ( !m_currentFont ||
+            m_DC->GetFont().GetRefData() != m_currentFont->GetRefData() )
+    {
+        AddWord(new wxHtmlWordCell(word, *m_DC));
+        return;
+    }
+
+    WordExtents& extents = m_wordExtents[m_currentFont];
+    auto it = extents.find(word);
+    if ( it == extents.end() )
+    {
+        // Don't let the cache grow indefinitely when parsing huge documents
+        // consisting mostly of unique words.
+        static const size_t MAX_CACHED_WORDS = 100000;
+        if ( extents.size() >= MAX_CACHED_WORDS )
+            extents.clear();
+
+        WordExtent ext;
+        m_DC->GetTextExtent(word, &ext.width, &ext.height, &ext.descent);
+        it = extents.emplace(word, ext).first;
+    }
+
+    const WordExtent& ext = it->second;
+    AddWord(new wxHtmlWordCell(word, ext.width, ext.height, ext.descent));
+}
+
 void wxHtmlWinParser::AddPreBlock(const wxString& text)
 {
     if ( text.find('\t') != wxString::npos )
@@ -510,6 +551,28 @@ void wxHtmlWinParser::SetDC(wxDC *dc, double pixel_scale, double font_scale)
     m_DC = dc;
     m_PixelScale = pixel_scale;
     m_FontScale = font_scale;
+
+    if ( !dc )
+        return;
+
+    // The cached word extents can only be reused with a compatible DC.
+    double scaleX, scaleY;
+    dc->GetUserScale(&scaleX, &scaleY);
+
+    const wxSize ppi = dc->GetPPI();
+    const double contentScale = dc->GetContentScaleFactor();
+    if ( ppi != m_extentsPPI ||
+            scaleX != m_extentsScaleX ||
+                scaleY != m_extentsScaleY ||
+                    contentScale != m_extentsContentScale )
+    {
+        m_wordExtents.clear();
+
+        m_extentsPPI = ppi;
+        m_extentsScaleX = scaleX;
+        m_extentsScaleY = scaleY;
+        m_extentsContentScale = contentScale;
+    }
 }
 
 void wxHtmlWinParser::SetFontPointSize(int pt)
@@ -556,6 +619,7 @@ wxFont* wxHtmlWinParser::CreateCurrentFont()
 
     if (*fontptr != nullptr && (*faceptr != face))
     {
+        m_wordExtents.erase(*fontptr);
         wxDELETE(*fontptr);
     }
 
@@ -571,6 +635,7 @@ wxFont* wxHtmlWinParser::CreateCurrentFont()
                        );
     }
     m_DC->SetFont(**fontptr);
+    m_currentFont = *fontptr;
     return (*fontptr);
 }
 
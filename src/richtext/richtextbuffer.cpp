@@ -44,6 +44,8 @@
 #include "wx/listimpl.cpp"
 #include "wx/arrimpl.cpp"
 
+#include <algorithm>
+
 WX_DEFINE_LIST(wxRichTextObjectList)
 
 // Switch off if the platform doesn't like it for some reason
@@ -1367,6 +1369,7 @@ size_t wxRichTextCompositeObject::AppendChild(wxRichTextObject* child)
 {
     m_children.Append(child);
     child->SetParent(this);
+    OnChildrenChanged();
     return m_children.GetCount() - 1;
 }
 
@@ -1381,6 +1384,7 @@ bool wxRichTextCompositeObject::InsertChild(wxRichTextObject* child, wxRichTextO
     else
         m_children.Insert(child);
     child->SetParent(this);
+    OnChildrenChanged();
 
     return true;
 }
@@ -1393,6 +1397,7 @@ bool wxRichTextCompositeObject::RemoveChild(wxRichTextObject* child, bool delete
     {
         wxRichTextObject* obj = node->GetData();
         m_children.Erase(node);
+        OnChildrenChanged();
         if (deleteChild)
             delete obj;
 
@@ -1401,6 +1406,22 @@ bool wxRichTextCompositeObject::RemoveChild(wxRichTextObject* child, bool delete
     return false;
 }
 
+/// Replace the child
+bool wxRichTextCompositeObject::ReplaceChild(wxRichTextObject* oldChild, wxRichTextObject* newChild, bool deleteOldChild)
+{
+    wxRichTextObjectList::compatibility_iterator node = m_children.Find(oldChild);
+    if (!node)
+        return false;
+
+    node->SetData(newChild);
+    newChild->SetParent(this);
+    OnChildrenChanged();
+    if (deleteOldChild)
+        delete oldChild;
+
+    return true;
+}
+
 /// Delete all children
 bool wxRichTextCompositeObject::DeleteChildren()
 {
@@ -1416,6 +1437,8 @@ bool wxRichTextCompositeObject::DeleteChildren()
         m_children.Erase(oldNode);
     }
 
+    OnChildrenChanged();
+
     return true;
 }
 
@@ -1442,6 +1465,8 @@ void wxRichTextCompositeObject::Copy(const wxRichTextCompositeObject& obj)
 
         node = node->GetNext();
     }
+
+    OnChildrenChanged();
 }
 
 /// Hit-testing: returns a flag indicating hit test details, plus
@@ -1657,6 +1682,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                         {
                             nextChild->Dereference();
                             m_children.Erase(node->GetNext());
+                            OnChildrenChanged();
                         }
                         else
                             node = node->GetNext();
@@ -1703,6 +1729,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                         {
                             nextChild->Dereference();
                             m_children.Erase(node->GetNext());
+                            OnChildrenChanged();
 
                             // Don't set node -- we'll see if we can merge again with the next
                             // child. UNLESS we split this or the next child, in which case we know we have to
@@ -1741,6 +1768,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                 {
                     child->Dereference();
                     m_children.Erase(node);
+                    OnChildrenChanged();
                 }
                 node = next;
             }
@@ -1952,6 +1980,8 @@ void wxRichTextParagraphLayoutBox::Init()
 
     m_partialParagraph = false;
     m_floatCollector = nullptr;
+
+    m_childrenIndexValid = false;
 }
 
 void wxRichTextParagraphLayoutBox::Clear()
@@ -2033,6 +2063,44 @@ void wxRichTextParagraphLayoutBox::UpdateRanges()
     CalculateRange(start, end);
 }
 
+size_t wxRichTextParagraphLayoutBox::GetFirstChildToUpdate(long pos) const
+{
+    size_t n;
+    if (!FindChildAtPosition(pos, &n) || n == GetChildrenIndex().size())
+        return 0;
+
+    // Also update the previous child in case the change affects it too, e.g.
+    // when merging paragraphs.
+    return n > 0 ? n - 1 : 0;
+}
+
+void wxRichTextParagraphLayoutBox::UpdateRangesFrom(size_t n)
+{
+    // The range of a non-top-level box depends on its children, so don't
+    // bother with optimizing this case.
+    const std::vector<wxRichTextObject*>& index = GetChildrenIndex();
+    if (n == 0 || n >= index.size() || !IsTopLevel())
+    {
+        UpdateRanges();
+        return;
+    }
+
+    // This does the same thing as CalculateRange() for a top-level object,
+    // but without recalculating the ranges of the unchanged children.
+    long current = index[n - 1]->GetRange().GetEnd() + 1;
+    long lastEnd = current - 1;
+    for (; n < index.size(); n++)
+    {
+        long childEnd = 0;
+        index[n]->CalculateRange(current, childEnd);
+        lastEnd = childEnd;
+
+        current = childEnd + 1;
+    }
+
+    m_ownRange.SetRange(0, lastEnd);
+}
+
 // HitTest
 int wxRichTextParagraphLayoutBox::HitTest(wxReadOnlyDC& dc, wxRichTextDrawingContext& context, const wxPoint& pt, long& textPosition, wxRichTextObject** obj, wxRichTextObject** contextObj, int flags)
 {
@@ -2170,6 +2238,15 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
         if (line)
             startPos = line->GetAbsoluteRange().GetStart();
 
+        // The paragraphs which haven't been laid out yet don't have any lines
+        // and so can't be found above, but must be laid out if they're visible.
+        if (style & wxRICHTEXT_LAYOUT_ESTIMATE)
+        {
+            wxRichTextParagraph* para = GetFirstEstimatedParagraph(rect.y);
+            if (para && (!line || para->GetRange().GetStart() < startPos))
+                startPos = para->GetRange().GetStart();
+        }
+
         Invalidate(wxRichTextRange(startPos, GetOwnRange().GetEnd()));
     }
     else
@@ -2251,6 +2328,11 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
     // A way to force speedy rest-of-buffer layout (the 'else' below)
     bool forceQuickLayout = false;
 
+    // Whether the paragraphs not laid out yet should only have their size
+    // estimated during the quick layout.
+    const bool estimate = formatRect && (style & wxRICHTEXT_LAYOUT_ESTIMATE);
+    wxSize estimateCharSize;
+
     // First get the size of the paragraphs we won't be laying out
     wxRichTextObjectList::compatibility_iterator n = m_children.GetFirst();
     while (n && n != node)
@@ -2313,6 +2395,9 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
                         child = wxDynamicCast(node->GetData(), wxRichTextParagraph);
                         if (child)
                         {
+                            if (estimate && child->GetLines().empty())
+                                break;
+
                             int oldImpactedByFloats = child->GetImpactedByFloatingObjects();
 
                             child->SetImpactedByFloatingObjects(-1);
@@ -2340,6 +2425,7 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
                 }
 
                 int inc = 0;
+                bool recomputeInc = false;
                 if (node)
                 {
                     child = wxDynamicCast(node->GetData(), wxRichTextParagraph);
@@ -2351,7 +2437,35 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
                     wxRichTextParagraph* nodeChild = wxDynamicCast(node->GetData(), wxRichTextParagraph);
                     if (nodeChild)
                     {
-                        if (nodeChild->GetLines().empty())
+                        if (nodeChild->GetLines().empty() && estimate)
+                        {
+                            // Reuse the size from the previous layout if the
+                            // paragraph had been laid out before, otherwise
+                            // assume it uses the default font.
+                            wxSize size = nodeChild->GetCachedSize();
+                            if (size.y == 0)
+                            {
+                                if (estimateCharSize.y == 0)
+                                {
+                                    wxFont font(GetBuffer()->GetFontTable().FindFont(attr));
+                                    dc.SetFont(font.IsOk() ? font : *wxNORMAL_FONT);
+                                    estimateCharSize.Set(dc.GetCharWidth(), dc.GetCharHeight());
+                                }
+
+                                const int width = wxMax(availableSpace.width, estimateCharSize.x);
+                                const int textWidth = nodeChild->GetRange().GetLength() * estimateCharSize.x;
+                                size.Set(wxMin(textWidth, width),
+                                         (textWidth / width + 1) * estimateCharSize.y);
+                            }
+
+                            nodeChild->SetPosition(availableSpace.GetPosition());
+                            nodeChild->SetCachedSize(size);
+
+                            // The size may have changed, so the offset of the
+                            // next paragraphs needs to be recomputed.
+                            recomputeInc = true;
+                        }
+                        else if (nodeChild->GetLines().empty())
                         {
                             nodeChild->SetImpactedByFloatingObjects(-1);
 
@@ -2362,6 +2476,12 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
                         }
                         else
                         {
+                            if (recomputeInc)
+                            {
+                                inc = availableSpace.y - nodeChild->GetPosition().y;
+                                recomputeInc = false;
+                            }
+
                             if (wxRichTextBuffer::GetFloatingLayoutMode() && GetFloatCollector())
                                 GetFloatCollector()->CollectFloat(nodeChild);
                             nodeChild->Move(wxPoint(nodeChild->GetPosition().x, nodeChild->GetPosition().y + inc));
@@ -2568,12 +2688,86 @@ bool wxRichTextParagraphLayoutBox::GetRangeSize(const wxRichTextRange& range, wx
     return true;
 }
 
+const std::vector<wxRichTextObject*>& wxRichTextParagraphLayoutBox::GetChildrenIndex() const
+{
+    // Also check the number of children in case m_children was modified
+    // directly via GetChildren() without calling OnChildrenChanged(), although
+    // this can't detect replacing the children, so ReplaceChild() must be
+    // used for this.
+    if (!m_childrenIndexValid || m_childrenIndex.size() != m_children.GetCount())
+    {
+        m_childrenIndex.clear();
+        m_childrenIndex.reserve(m_children.GetCount());
+
+        wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
+        while (node)
+        {
+            m_childrenIndex.push_back(node->GetData());
+            node = node->GetNext();
+        }
+
+        m_childrenIndexValid = true;
+    }
+
+    return m_childrenIndex;
+}
+
+bool wxRichTextParagraphLayoutBox::FindChildAtPosition(long pos, size_t* n) const
+{
+    const std::vector<wxRichTextObject*>& index = GetChildrenIndex();
+    *n = index.size();
+    if (index.empty())
+        return true;
+
+    // The children ranges are consecutive, so their ends are sorted.
+    const auto it = std::partition_point(index.begin(), index.end(),
+        [pos](const wxRichTextObject* obj) { return obj->GetRange().GetEnd() < pos; });
+
+    if (it != index.end() && (*it)->GetRange().Contains(pos))
+    {
+        // Check that the ranges were really consecutive, they may be not if
+        // they haven't been updated yet after modifying the buffer.
+        if (it != index.begin() && (*(it - 1))->GetRange().Contains(pos))
+            return false;
+
+        *n = it - index.begin();
+        return true;
+    }
+
+    // There is nothing to find if the position is outside of all children.
+    return pos < index.front()->GetRange().GetStart() ||
+            pos > index.back()->GetRange().GetEnd();
+}
+
+wxRichTextLine* wxRichTextParagraphLayoutBox::GetLastLine() const
+{
+    wxRichTextObjectList::compatibility_iterator node = m_children.GetLast();
+    while (node)
+    {
+        wxRichTextParagraph* child = wxDynamicCast(node->GetData(), wxRichTextParagraph);
+        if (child && !child->GetLines().empty())
+            return child->GetLines().back();
+
+        node = node->GetPrevious();
+    }
+
+    return nullptr;
+}
+
 /// Get the paragraph at the given position
 wxRichTextParagraph* wxRichTextParagraphLayoutBox::GetParagraphAtPosition(long pos, bool caretPosition) const
 {
     if (caretPosition)
         pos ++;
 
+    size_t n;
+    if (FindChildAtPosition(pos, &n))
+    {
+        const std::vector<wxRichTextObject*>& index = GetChildrenIndex();
+        return n < index.size() ? wxDynamicCast(index[n], wxRichTextParagraph)
+                                : nullptr;
+    }
+
     // First find the first paragraph whose starting position is within the range.
     wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
     while (node)
@@ -2603,11 +2797,23 @@ wxRichTextLine* wxRichTextParagraphLayoutBox::GetLineAtPosition(long pos, bool c
     if (caretPosition)
         pos ++;
 
-    // First find the first paragraph whose starting position is within the range.
-    wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
-    while (node)
+    // Only the child containing the position needs to be checked if we can
+    // find it directly, otherwise check all of them.
+    const std::vector<wxRichTextObject*>& index = GetChildrenIndex();
+    auto start = index.begin(),
+         end = index.end();
+
+    size_t n;
+    if (FindChildAtPosition(pos, &n))
     {
-        wxRichTextObject* obj = (wxRichTextObject*) node->GetData();
+        start += n;
+        if (start != end)
+            end = start + 1;
+    }
+
+    for (auto node = start; node != end; ++node)
+    {
+        wxRichTextObject* obj = *node;
         if (obj->GetRange().Contains(pos))
         {
             // child is a paragraph
@@ -2634,24 +2840,26 @@ wxRichTextLine* wxRichTextParagraphLayoutBox::GetLineAtPosition(long pos, bool c
                 }
             }
         }
-
-        node = node->GetNext();
     }
 
-    int lineCount = GetLineCount();
-    if (lineCount > 0)
-        return GetLineForVisibleLineNumber(lineCount-1);
-    else
-        return nullptr;
+    return GetLastLine();
 }
 
 /// Get the line at the given y pixel position, or the last line.
 wxRichTextLine* wxRichTextParagraphLayoutBox::GetLineAtYPosition(int y) const
 {
-    wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
-    while (node)
+    // Skip all the paragraphs above the given position: as their lines are
+    // inside them, none of these lines could be returned anyhow.
+    const std::vector<wxRichTextObject*>& index = GetChildrenIndex();
+    const auto start = std::partition_point(index.begin(), index.end(),
+        [y](const wxRichTextObject* obj)
+        {
+            return obj->GetPosition().y + obj->GetCachedSize().y <= y;
+        });
+
+    for (auto node = start; node != index.end(); ++node)
     {
-        wxRichTextParagraph* child = wxDynamicCast(node->GetData(), wxRichTextParagraph);
+        wxRichTextParagraph* child = wxDynamicCast(*node, wxRichTextParagraph);
         // wxASSERT (child != nullptr);
 
         if (child)
@@ -2669,16 +2877,36 @@ wxRichTextLine* wxRichTextParagraphLayoutBox::GetLineAtYPosition(int y) const
                 ++it;
             }
         }
-
-        node = node->GetNext();
     }
 
     // Return last line
-    int lineCount = GetLineCount();
-    if (lineCount > 0)
-        return GetLineForVisibleLineNumber(lineCount-1);
-    else
-        return nullptr;
+    return GetLastLine();
+}
+
+wxRichTextParagraph* wxRichTextParagraphLayoutBox::GetFirstEstimatedParagraph(int y) const
+{
+    const std::vector<wxRichTextObject*>& index = GetChildrenIndex();
+
+    // The paragraphs which were never laid out have no position at all, so
+    // don't skip anything when looking for them from the top.
+    auto it = index.begin();
+    if (y > 0)
+    {
+        it = std::partition_point(it, index.end(),
+            [y](const wxRichTextObject* obj)
+            {
+                return obj->GetPosition().y + obj->GetCachedSize().y <= y;
+            });
+    }
+
+    for (; it != index.end(); ++it)
+    {
+        wxRichTextParagraph* child = wxDynamicCast(*it, wxRichTextParagraph);
+        if (child && child->IsShown() && child->GetLines().empty())
+            return child;
+    }
+
+    return nullptr;
 }
 
 /// Get the number of visible lines
@@ -3511,13 +3739,16 @@ bool wxRichTextParagraphLayoutBox::SetStyle(const wxRichTextRange& range, const
 
     bool haveControl = (buffer->GetRichTextCtrl() != nullptr);
 
-    wxRichTextAction* action = nullptr;
-
     if (haveControl && withUndo)
     {
-        action = new wxRichTextAction(nullptr, _("Change Style"), wxRICHTEXT_CHANGE_STYLE, buffer, this, buffer->GetRichTextCtrl());
+        // Let the action apply the style itself, so that only the attributes
+        // changed by it need to be stored instead of copies of the paragraphs.
+        wxRichTextAction* action = new wxRichTextAction(nullptr, _("Change Style"), wxRICHTEXT_CHANGE_STYLE, buffer, this, buffer->GetRichTextCtrl());
         action->SetRange(range);
         action->SetPosition(buffer->GetRichTextCtrl()->GetCaretPosition());
+        action->SetStyleChange(style, flags & ~wxRICHTEXT_SETSTYLE_WITH_UNDO);
+
+        return buffer->SubmitAction(action);
     }
 
     wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
@@ -3534,20 +3765,7 @@ bool wxRichTextParagraphLayoutBox::SetStyle(const wxRichTextRange& range, const
 
             if (!para->GetRange().IsOutside(range))
             {
-                // We'll be using a copy of the paragraph to make style changes,
-                // not updating the buffer directly.
-                wxRichTextParagraph* newPara wxDUMMY_INITIALIZE(nullptr);
-
-                if (haveControl && withUndo)
-                {
-                    newPara = new wxRichTextParagraph(*para);
-                    action->GetNewParagraphs().AppendChild(newPara);
-
-                    // Also store the old ones for Undo
-                    action->GetOldParagraphs().AppendChild(new wxRichTextParagraph(*para));
-                }
-                else
-                    newPara = para;
+                wxRichTextParagraph* newPara = para;
 
                 // If we're specifying paragraphs only, then we really mean character formatting
                 // to be included in the paragraph style
@@ -3674,10 +3892,6 @@ bool wxRichTextParagraphLayoutBox::SetStyle(const wxRichTextRange& range, const
         node = node->GetNext();
     }
 
-    // Do action, or delay it until end of batch.
-    if (haveControl && withUndo)
-        buffer->SubmitAction(action);
-
     return true;
 }
 
@@ -7777,15 +7991,72 @@ int                         wxRichTextBuffer::sm_bulletRightMargin = 20;
 float                       wxRichTextBuffer::sm_bulletProportion = (float) 0.3;
 bool                        wxRichTextBuffer::sm_floatingLayoutMode = true;
 
+// The command processor used by wxRichTextBuffer: it only differs from the
+// base class by allowing to discard the oldest commands.
+class wxRichTextBufferCommandProcessor : public wxCommandProcessor
+{
+public:
+    // Discards the oldest commands, but never the current one nor the ones
+    // which can be redone, while the memory used by all of them exceeds the
+    // given limit.
+    void LimitMemoryUsage(size_t limit)
+    {
+        size_t usage = 0;
+        wxList::compatibility_iterator node;
+        for (node = m_commands.GetFirst(); node; node = node->GetNext())
+            usage += GetMemoryUsage((wxCommand*) node->GetData());
+
+        // If everything was undone, all the commands can still be redone.
+        if (!m_currentCommand)
+            return;
+
+        while (usage > limit)
+        {
+            node = m_commands.GetFirst();
+            if (!node || node == m_currentCommand)
+                break;
+
+            // The state in which the document was saved can't be reached any
+            // more, so make m_lastSavedCommand refer to a node which is never
+            // current, instead of resetting it, which would make IsDirty()
+            // return false after undoing everything.
+            if (m_lastSavedCommand && m_lastSavedCommand == node)
+            {
+                if (m_discardedSavedCommand.IsEmpty())
+                    m_discardedSavedCommand.Append(nullptr);
+                m_lastSavedCommand = m_discardedSavedCommand.GetFirst();
+            }
+
+            wxCommand* command = (wxCommand*) node->GetData();
+            usage -= GetMemoryUsage(command);
+            delete command;
+            m_commands.Erase(node);
+        }
+    }
+
+private:
+    static size_t GetMemoryUsage(const wxCommand* command)
+    {
+        const wxRichTextCommand* cmd = dynamic_cast<const wxRichTextCommand*>(command);
+        return cmd ? cmd->GetMemoryUsage() : sizeof(wxCommand);
+    }
+
+    // Contains the single node used as m_lastSavedCommand after discarding
+    // the command corresponding to the saved state.
+    wxList m_discardedSavedCommand;
+};
+
 /// Initialisation
 void wxRichTextBuffer::Init()
 {
-    m_commandProcessor = new wxCommandProcessor;
+    m_commandProcessor = new wxRichTextBufferCommandProcessor;
     m_styleSheet = nullptr;
     m_modified = false;
     m_batchedCommandDepth = 0;
     m_batchedCommand = nullptr;
     m_suppressUndo = 0;
+    m_undoMemoryLimit = 0;
+    m_mergeTypingUndo = false;
     m_handlerFlags = 0;
     m_scale = 1.0;
     m_dimensionScale = 1.0;
@@ -8322,13 +8593,62 @@ bool wxRichTextBuffer::EndBatchUndo()
 
     if (m_batchedCommandDepth == 0)
     {
-        GetCommandProcessor()->Store(m_batchedCommand);
+        if (m_mergeTypingUndo && MergeTypingCommand(m_batchedCommand))
+            delete m_batchedCommand;
+        else
+        {
+            GetCommandProcessor()->Store(m_batchedCommand);
+            LimitUndoMemory();
+        }
+
         m_batchedCommand = nullptr;
     }
 
     return true;
 }
 
+/// Discards the oldest commands if the undo history uses too much memory
+void wxRichTextBuffer::LimitUndoMemory()
+{
+    if (m_undoMemoryLimit)
+        static_cast<wxRichTextBufferCommandProcessor*>(m_commandProcessor)->LimitMemoryUsage(m_undoMemoryLimit);
+}
+
+/// Merges the command with the current one if both insert typed text
+bool wxRichTextBuffer::MergeTypingCommand(wxRichTextCommand* cmd)
+{
+    // The command must consist of a single character insertion, as done
+    // when typing.
+    if (cmd->GetActions().GetCount() != 1)
+        return false;
+
+    wxRichTextAction* action = (wxRichTextAction*) cmd->GetActions().GetFirst()->GetData();
+    if (action->GetRange().GetLength() != 1)
+        return false;
+
+    // And it can only be merged into the last command, as otherwise the
+    // commands following it would become invalid, and only if the state after
+    // it hasn't been saved.
+    wxCommandProcessor* processor = GetCommandProcessor();
+    wxList::compatibility_iterator last = processor->GetCommands().GetLast();
+    if (!last || processor->GetCurrentCommand() != last->GetData() || !processor->IsDirty())
+        return false;
+
+    wxRichTextCommand* lastCmd = dynamic_cast<wxRichTextCommand*>(processor->GetCurrentCommand());
+    if (!lastCmd || lastCmd->GetName() != cmd->GetName() || lastCmd->GetActions().IsEmpty())
+        return false;
+
+    wxRichTextAction* lastAction = (wxRichTextAction*) lastCmd->GetActions().GetLast()->GetData();
+
+    // Start a new command for every word.
+    const wxString lastText = lastAction->GetNewParagraphs().GetText();
+    const wxString text = action->GetNewParagraphs().GetText();
+    if (!lastText.empty() && !text.empty() && wxIsspace(lastText.Last()) && !wxIsspace(text[0]))
+        return false;
+
+    return lastAction->MergeInsertion(*action);
+}
+
 /// Submit immediately, or delay according to whether collapsing is on
 bool wxRichTextBuffer::SubmitAction(wxRichTextAction* action)
 {
@@ -8356,11 +8676,14 @@ bool wxRichTextBuffer::SubmitAction(wxRichTextAction* action)
         // Only store it if we're not suppressing undo.
         if (!action->GetIgnoreFirstTime())
         {
-            return GetCommandProcessor()->Submit(cmd, !SuppressingUndo());
+            bool success = GetCommandProcessor()->Submit(cmd, !SuppressingUndo());
+            LimitUndoMemory();
+            return success;
         }
         else if (!SuppressingUndo())
         {
             GetCommandProcessor()->Store(cmd); // Just store it, without Do()ing anything
+            LimitUndoMemory();
         }
         else
             delete cmd;
@@ -11757,6 +12080,15 @@ void wxRichTextCommand::ClearActions()
     wxClearList(m_actions);
 }
 
+size_t wxRichTextCommand::GetMemoryUsage() const
+{
+    size_t usage = sizeof(wxRichTextCommand);
+    for (wxList::compatibility_iterator node = m_actions.GetFirst(); node; node = node->GetNext())
+        usage += ((wxRichTextAction*) node->GetData())->GetMemoryUsage();
+
+    return usage;
+}
+
 /*!
  * Individual action
  *
@@ -11774,6 +12106,9 @@ wxRichTextAction::wxRichTextAction(wxRichTextCommand* cmd, const wxString& name,
     m_position = -1;
     m_ctrl = ctrl;
     m_name = name;
+    m_hasStyleChange = false;
+    m_styleFlags = 0;
+    m_memoryUsage = 0;
     m_newParagraphs.SetDefaultStyle(buffer->GetDefaultStyle());
     m_newParagraphs.SetBasicStyle(buffer->GetBasicStyle());
     if (cmd)
@@ -11899,8 +12234,9 @@ bool wxRichTextAction::Do()
             CalculateRefreshOptimizations(optimizationLineCharPositions, optimizationLineYPositions, oldFloatRect);
 #endif
 
+            const size_t firstChanged = container->GetFirstChildToUpdate(GetRange().GetStart());
             container->InsertFragment(GetRange().GetStart(), m_newParagraphs);
-            container->UpdateRanges();
+            container->UpdateRangesFrom(firstChanged);
 
             // InvalidateHierarchy goes up the hierarchy as well as down, otherwise with a nested object,
             // Layout() would stop prematurely at the top level.
@@ -11963,8 +12299,9 @@ bool wxRichTextAction::Do()
                 }
             }
 
+            const size_t firstChanged = container->GetFirstChildToUpdate(GetRange().GetStart());
             container->DeleteRange(GetRange());
-            container->UpdateRanges();
+            container->UpdateRangesFrom(firstChanged);
             // InvalidateHierarchy goes up the hierarchy as well as down, otherwise with a nested object,
             // Layout() would stop prematurely at the top level.
             container->InvalidateHierarchy(wxRichTextRange(GetRange().GetStart(), GetRange().GetStart()));
@@ -11990,7 +12327,10 @@ bool wxRichTextAction::Do()
     case wxRICHTEXT_CHANGE_STYLE:
     case wxRICHTEXT_CHANGE_PROPERTIES:
         {
-            ApplyParagraphs(GetNewParagraphs());
+            if (m_hasStyleChange)
+                container->wxRichTextParagraphLayoutBox::SetStyle(GetRange(), m_attributes, m_styleFlags);
+            else
+                ApplyParagraphs(GetNewParagraphs());
 
             // Invalidate the whole buffer if there were floating objects
             if (wxRichTextBuffer::GetFloatingLayoutMode() && container->GetFloatingObjectCount() > 0)
@@ -12069,16 +12409,8 @@ bool wxRichTextAction::Do()
                 // (An alternative would be to return the parent too from m_objectAddress.GetObject(),
                 // or to set obj's parent there before returning)
                 m_object->SetParent(parent);
-                if (parent)
-                {
-                    wxRichTextObjectList::compatibility_iterator node = parent->GetChildren().Find(obj);
-                    if (node)
-                    {
-                        wxRichTextObject* nodeObj = node->GetData();
-                        node->SetData(m_object);
-                        m_object = nodeObj;
-                    }
-                }
+                if (parent && parent->ReplaceChild(obj, m_object))
+                    m_object = obj;
             }
 
             // We can't rely on the current focus-object remaining valid, if it's e.g. a table's cell.
@@ -12144,8 +12476,9 @@ bool wxRichTextAction::Undo()
                 }
             }
 
+            const size_t firstChanged = container->GetFirstChildToUpdate(GetRange().GetStart());
             container->DeleteRange(GetRange());
-            container->UpdateRanges();
+            container->UpdateRangesFrom(firstChanged);
 
             // InvalidateHierarchy goes up the hierarchy as well as down, otherwise with a nested object,
             // Layout() would stop prematurely at the top level.
@@ -12177,8 +12510,9 @@ bool wxRichTextAction::Undo()
             CalculateRefreshOptimizations(optimizationLineCharPositions, optimizationLineYPositions, oldFloatRect);
 #endif
 
+            const size_t firstChanged = container->GetFirstChildToUpdate(GetRange().GetStart());
             container->InsertFragment(GetRange().GetStart(), m_oldParagraphs);
-            container->UpdateRanges();
+            container->UpdateRangesFrom(firstChanged);
 
             // InvalidateHierarchy goes up the hierarchy as well as down, otherwise with a nested object,
             // Layout() would stop prematurely at the top level.
@@ -12201,7 +12535,10 @@ bool wxRichTextAction::Undo()
     case wxRICHTEXT_CHANGE_STYLE:
     case wxRICHTEXT_CHANGE_PROPERTIES:
         {
-            ApplyParagraphs(GetOldParagraphs());
+            if (m_hasStyleChange)
+                RestoreOldStyles();
+            else
+                ApplyParagraphs(GetOldParagraphs());
             // InvalidateHierarchy goes up the hierarchy as well as down, otherwise with a nested object,
             // Layout() would stop prematurely at the top level.
             container->InvalidateHierarchy(GetRange());
@@ -12437,22 +12774,241 @@ void wxRichTextAction::ApplyParagraphs(const wxRichTextParagraphLayoutBox& fragm
         wxRichTextParagraph* existingPara = container->GetParagraphAtPosition(para->GetRange().GetStart());
         if (existingPara)
         {
-            wxRichTextObjectList::compatibility_iterator bufferParaNode = container->GetChildren().Find(existingPara);
-            if (bufferParaNode)
-            {
-                wxRichTextParagraph* newPara = new wxRichTextParagraph(*para);
-                newPara->SetParent(container);
+            wxRichTextParagraph* newPara = new wxRichTextParagraph(*para);
+            if (!container->ReplaceChild(existingPara, newPara, true))
+                delete newPara;
+        }
+
+        node = node->GetNext();
+    }
+}
+
+// Makes the action apply the style itself, storing only the old attributes
+// of the objects it changes.
+void wxRichTextAction::SetStyleChange(const wxRichTextAttr& style, int flags)
+{
+    wxRichTextParagraphLayoutBox* container = GetContainer();
+    wxASSERT(container != nullptr);
+    if (!container)
+        return;
+
+    m_hasStyleChange = true;
+    m_attributes = style;
+    m_styleFlags = flags;
+    m_oldStyles.clear();
+    m_memoryUsage = 0;
+
+    // Use the same conditions as SetStyle() for deciding what is changed.
+    const bool parasOnly = ((flags & wxRICHTEXT_SETSTYLE_PARAGRAPHS_ONLY) != 0);
+    const bool charactersOnly = ((flags & wxRICHTEXT_SETSTYLE_CHARACTERS_ONLY) != 0);
+    const bool changesParas = (style.IsParagraphStyle() || parasOnly) && !charactersOnly;
+    const bool changesChars = !parasOnly && (style.IsCharacterStyle() || charactersOnly);
+
+    const wxRichTextRange& range = GetRange();
+
+    wxRichTextParagraph* firstPara = container->GetParagraphAtPosition(range.GetStart());
+    wxRichTextObjectList::compatibility_iterator node = firstPara ? container->GetChildren().Find(firstPara)
+                                                                  : container->GetChildren().GetFirst();
+    for (; node; node = node->GetNext())
+    {
+        wxRichTextParagraph* para = wxDynamicCast(node->GetData(), wxRichTextParagraph);
+        if (!para || para->GetChildCount() == 0)
+            continue;
+
+        if (para->GetRange().GetStart() > range.GetEnd())
+            break;
+
+        if (para->GetRange().IsOutside(range))
+            continue;
+
+        if (changesParas)
+        {
+            OldStyle oldStyle;
+            oldStyle.range = para->GetRange();
+            oldStyle.attr = para->GetAttributes();
+            oldStyle.isPara = true;
+            m_oldStyles.push_back(oldStyle);
+        }
+
+        if (!changesChars || range.GetStart() == para->GetRange().GetEnd())
+            continue;
+
+        wxRichTextRange childRange(range);
+        childRange.LimitTo(para->GetRange());
+
+        // Store a single entry for the adjacent objects with the same
+        // attributes, they will be split again if necessary when undoing.
+        const size_t firstRun = m_oldStyles.size();
+        wxRichTextObjectList::compatibility_iterator node2;
+        for (node2 = para->GetChildren().GetFirst(); node2; node2 = node2->GetNext())
+        {
+            wxRichTextObject* child = node2->GetData();
+            if (child->GetRange().IsOutside(childRange))
+                continue;
 
-                bufferParaNode->SetData(newPara);
+            wxRichTextRange runRange(child->GetRange());
+            runRange.LimitTo(childRange);
 
-                delete existingPara;
+            if (m_oldStyles.size() > firstRun && m_oldStyles.back().attr == child->GetAttributes())
+            {
+                m_oldStyles.back().range.SetEnd(runRange.GetEnd());
+            }
+            else
+            {
+                OldStyle oldStyle;
+                oldStyle.range = runRange;
+                oldStyle.attr = child->GetAttributes();
+                oldStyle.isPara = false;
+                m_oldStyles.push_back(oldStyle);
             }
         }
+    }
+}
 
-        node = node->GetNext();
+// Restores the attributes stored by SetStyleChange().
+void wxRichTextAction::RestoreOldStyles()
+{
+    wxRichTextParagraphLayoutBox* container = GetContainer();
+    wxASSERT(container != nullptr);
+    if (!container)
+        return;
+
+    for (const OldStyle& oldStyle : m_oldStyles)
+    {
+        wxRichTextParagraph* para = container->GetParagraphAtPosition(oldStyle.range.GetStart());
+        if (!para || para->GetChildCount() == 0)
+            continue;
+
+        if (oldStyle.isPara)
+        {
+            para->GetAttributes() = oldStyle.attr;
+            continue;
+        }
+
+        // The objects may have been merged or split differently since the
+        // style was changed, so split them at the run boundaries, as
+        // SetStyle() does.
+        wxRichTextObject* firstObject wxDUMMY_INITIALIZE(nullptr);
+        wxRichTextObject* lastObject wxDUMMY_INITIALIZE(nullptr);
+
+        if (oldStyle.range.GetStart() == para->GetRange().GetStart())
+            firstObject = para->GetChildren().GetFirst()->GetData();
+        else
+            firstObject = para->SplitAt(oldStyle.range.GetStart());
+
+        long splitPoint = oldStyle.range.GetEnd();
+        if (splitPoint != para->GetRange().GetEnd())
+            splitPoint ++;
+
+        if (splitPoint == para->GetRange().GetEnd())
+            lastObject = para->GetChildren().GetLast()->GetData();
+        else
+            (void) para->SplitAt(splitPoint, & lastObject);
+
+        if (!firstObject || !lastObject)
+            continue;
+
+        wxRichTextObjectList::compatibility_iterator node = para->GetChildren().Find(firstObject);
+        while (node)
+        {
+            wxRichTextObject* child = node->GetData();
+            child->GetAttributes() = oldStyle.attr;
+
+            if (child == lastObject)
+                break;
+
+            node = node->GetNext();
+        }
     }
 }
 
+// Appends the text inserted by the following action to this one.
+bool wxRichTextAction::MergeInsertion(const wxRichTextAction& action)
+{
+    if (m_cmdId != wxRICHTEXT_INSERT || action.m_cmdId != wxRICHTEXT_INSERT)
+        return false;
+
+    if (GetContainer() != action.GetContainer() || GetRange().GetEnd() + 1 != action.GetRange().GetStart())
+        return false;
+
+    // Only merge the insertions of plain text inside a single paragraph.
+    if (!m_newParagraphs.GetPartialParagraph() || !action.m_newParagraphs.GetPartialParagraph() ||
+        m_newParagraphs.GetChildCount() != 1 || action.m_newParagraphs.GetChildCount() != 1)
+        return false;
+
+    wxRichTextParagraph* para = wxDynamicCast(m_newParagraphs.GetChild(0), wxRichTextParagraph);
+    const wxRichTextParagraph* newPara = wxDynamicCast(action.m_newParagraphs.GetChild(0), wxRichTextParagraph);
+    if (!para || !newPara || para->GetChildCount() == 0 || !(para->GetAttributes() == newPara->GetAttributes()))
+        return false;
+
+    wxRichTextObjectList::compatibility_iterator node;
+    for (node = newPara->GetChildren().GetFirst(); node; node = node->GetNext())
+    {
+        wxRichTextPlainText* newText = wxDynamicCast(node->GetData(), wxRichTextPlainText);
+        if (!newText || newText->GetText().empty() || newText->GetText().Find(wxRichTextLineBreakChar) != wxNOT_FOUND)
+            return false;
+    }
+
+    for (node = newPara->GetChildren().GetFirst(); node; node = node->GetNext())
+    {
+        wxRichTextPlainText* newText = (wxRichTextPlainText*) node->GetData();
+        wxRichTextPlainText* lastText = wxDynamicCast(para->GetChildren().GetLast()->GetData(), wxRichTextPlainText);
+        if (lastText && lastText->GetAttributes() == newText->GetAttributes())
+            lastText->SetText(lastText->GetText() + newText->GetText());
+        else
+            para->AppendChild(newText->Clone());
+    }
+
+    m_newParagraphs.UpdateRanges();
+    m_range.SetEnd(action.GetRange().GetEnd());
+    m_memoryUsage = 0;
+
+    return true;
+}
+
+// Returns the approximate amount of memory used by the object and its children.
+static size_t wxRichTextGetObjectMemoryUsage(wxRichTextObject* obj)
+{
+    size_t usage = sizeof(wxRichTextParagraph);
+
+    wxRichTextPlainText* text = wxDynamicCast(obj, wxRichTextPlainText);
+    if (text)
+        usage += text->GetText().length() * sizeof(wxChar);
+
+    wxRichTextImage* image = wxDynamicCast(obj, wxRichTextImage);
+    if (image)
+        usage += image->GetImageBlock().GetDataSize();
+
+    wxRichTextCompositeObject* composite = wxDynamicCast(obj, wxRichTextCompositeObject);
+    if (composite)
+    {
+        wxRichTextObjectList::compatibility_iterator node;
+        for (node = composite->GetChildren().GetFirst(); node; node = node->GetNext())
+            usage += wxRichTextGetObjectMemoryUsage(node->GetData());
+    }
+
+    return usage;
+}
+
+size_t wxRichTextAction::GetMemoryUsage() const
+{
+    if (!m_memoryUsage)
+    {
+        m_memoryUsage = sizeof(wxRichTextAction) + m_oldStyles.size() * sizeof(OldStyle);
+
+        wxRichTextObjectList::compatibility_iterator node;
+        for (node = m_newParagraphs.GetChildren().GetFirst(); node; node = node->GetNext())
+            m_memoryUsage += wxRichTextGetObjectMemoryUsage(node->GetData());
+        for (node = m_oldParagraphs.GetChildren().GetFirst(); node; node = node->GetNext())
+            m_memoryUsage += wxRichTextGetObjectMemoryUsage(node->GetData());
+
+        if (m_object)
+            m_memoryUsage += wxRichTextGetObjectMemoryUsage(m_object);
+    }
+
+    return m_memoryUsage;
+}
+
 
 /*!
  * wxRichTextRange
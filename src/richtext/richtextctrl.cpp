@@ -65,6 +65,7 @@ wxDEFINE_EVENT( wxEVT_RICHTEXT_PROPERTIES_CHANGED, wxRichTextEvent );
 wxDEFINE_EVENT( wxEVT_RICHTEXT_SELECTION_CHANGED, wxRichTextEvent );
 wxDEFINE_EVENT( wxEVT_RICHTEXT_BUFFER_RESET, wxRichTextEvent );
 wxDEFINE_EVENT( wxEVT_RICHTEXT_FOCUS_OBJECT_CHANGED, wxRichTextEvent );
+wxDEFINE_EVENT( wxEVT_RICHTEXT_LAYOUT_COMPLETE, wxRichTextEvent );
 
 #if wxRICHTEXT_USE_OWN_CARET
 
@@ -373,6 +374,7 @@ void wxRichTextCtrl::Init()
     m_fullLayoutRequired = false;
     m_fullLayoutTime = 0;
     m_fullLayoutSavedPosition = 0;
+    m_incrementalLayoutRequired = false;
     m_delayedLayoutThreshold = wxRICHTEXT_DEFAULT_DELAYED_LAYOUT_THRESHOLD;
     m_caretPositionForDefaultStyle = -2;
     m_focusObject = & m_buffer;
@@ -470,7 +472,9 @@ void wxRichTextCtrl::OnPaint(wxPaintEvent& WXUNUSED(event))
             GetBuffer().Defragment(context);
             GetBuffer().UpdateRanges();     // If items were deleted, ranges need recalculation
 
-            DoLayoutBuffer(GetBuffer(), dc, context, availableSpace, availableSpace, wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT);
+            wxRect layoutRect(availableSpace);
+            const int layoutFlags = PrepareLayout(layoutRect, false);
+            DoLayoutBuffer(GetBuffer(), dc, context, layoutRect, layoutRect, layoutFlags);
 
             GetBuffer().Invalidate(wxRICHTEXT_NONE);
 
@@ -478,6 +482,29 @@ void wxRichTextCtrl::OnPaint(wxPaintEvent& WXUNUSED(event))
 
             SetupScrollbars(false, true /* from OnPaint */);
         }
+        else if (m_incrementalLayoutRequired)
+        {
+            // The user may have scrolled to the part of the buffer which
+            // hasn't been laid out yet, do it now before drawing it.
+            wxRect layoutRect(availableSpace);
+            layoutRect.SetPosition(GetUnscaledPoint(GetLogicalPoint(wxPoint(0, 0))));
+
+            wxRichTextParagraph* para = GetBuffer().GetFirstEstimatedParagraph(layoutRect.y);
+            if (para && para->GetPosition().y <= layoutRect.GetBottom())
+            {
+                dc.SetUserScale(GetScale(), GetScale());
+
+                DoLayoutBuffer(GetBuffer(), dc, context, layoutRect, layoutRect,
+                               wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT|
+                               wxRICHTEXT_LAYOUT_SPECIFIED_RECT|wxRICHTEXT_LAYOUT_ESTIMATE);
+
+                GetBuffer().Invalidate(wxRICHTEXT_NONE);
+
+                dc.SetUserScale(1.0, 1.0);
+
+                SetupScrollbars(false, true /* from OnPaint */);
+            }
+        }
 
         // Paint the background
         PaintBackground(dc);
@@ -1807,6 +1834,15 @@ bool wxRichTextCtrl::ScrollIntoView(long position, int keyCode)
 
     wxRichTextLine* line = GetVisibleLineForCaretPosition(position);
 
+    // The position may be in a part of the buffer which hasn't been laid out
+    // yet, so continue laying it out until it is.
+    if (!line && m_incrementalLayoutRequired)
+    {
+        const int height = wxMax(GetUnscaledSize(GetClientSize()).y, 10)*wxRICHTEXT_INCREMENTAL_LAYOUT_PAGES;
+        while (!line && ContinueIncrementalLayout(height))
+            line = GetVisibleLineForCaretPosition(position);
+    }
+
     if (!line)
         return false;
 
@@ -2839,6 +2875,12 @@ void wxRichTextCtrl::ForceDelayedLayout()
         Refresh(false);
         Update();
     }
+
+    if (m_incrementalLayoutRequired)
+    {
+        while (ContinueIncrementalLayout(INT_MAX / 2))
+            ;
+    }
 }
 
 /// Idle-time processing
@@ -2864,6 +2906,14 @@ void wxRichTextCtrl::OnIdle(wxIdleEvent& event)
         ShowPosition(m_fullLayoutSavedPosition);
         Refresh(false);
     }
+    else if (m_incrementalLayoutRequired && !m_fullLayoutRequired && !IsFrozen())
+    {
+        // Lay out the next part of the buffer and ask for more idle events
+        // to continue with the rest of it, without blocking the UI for long.
+        const int height = GetUnscaledSize(GetClientSize()).y;
+        if (ContinueIncrementalLayout(wxMax(height, 10)*wxRICHTEXT_INCREMENTAL_LAYOUT_PAGES))
+            event.RequestMore();
+    }
 
     const int imageProcessingInterval = wxRICHTEXT_DEFAULT_DELAYED_IMAGE_PROCESSING_INTERVAL;
 
@@ -4264,12 +4314,7 @@ bool wxRichTextCtrl::LayoutContent(bool onlyVisibleRect)
         if (availableSpace.height == 0)
             availableSpace.height = 10;
 
-        int flags = wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT;
-        if (onlyVisibleRect)
-        {
-            flags |= wxRICHTEXT_LAYOUT_SPECIFIED_RECT;
-            availableSpace.SetPosition(GetUnscaledPoint(GetLogicalPoint(wxPoint(0, 0))));
-        }
+        const int flags = PrepareLayout(availableSpace, onlyVisibleRect);
 
         wxInfoDC dc(this);
 
@@ -4299,6 +4344,124 @@ void wxRichTextCtrl::DoLayoutBuffer(wxRichTextBuffer& buffer, wxReadOnlyDC& dc,
     buffer.Layout(dc, context, rect, parentRect, flags);
 }
 
+int wxRichTextCtrl::PrepareLayout(wxRect& rect, bool onlyVisibleRect)
+{
+    // When the entire large buffer needs to be laid out, e.g. after loading
+    // a file, only lay out its visible part now and estimate the size of the
+    // rest of it, which will be laid out in idle time.
+    const wxRichTextRange invalidRange = GetBuffer().GetInvalidRange(true);
+    if (GetBuffer().GetOwnRange().GetEnd() > m_delayedLayoutThreshold)
+    {
+        if (invalidRange == wxRICHTEXT_ALL ||
+                (invalidRange != wxRICHTEXT_NONE &&
+                    invalidRange.GetStart() <= GetBuffer().GetOwnRange().GetStart() &&
+                        invalidRange.GetEnd() >= GetBuffer().GetOwnRange().GetEnd()))
+        {
+            // Paragraphs without lines are the ones still to be laid out, but
+            // their cached size from the previous layout, if any, is kept and
+            // used as the estimate.
+            for (wxRichTextObjectList::compatibility_iterator node = GetBuffer().GetChildren().GetFirst();
+                 node;
+                 node = node->GetNext())
+            {
+                wxRichTextParagraph* para = wxDynamicCast(node->GetData(), wxRichTextParagraph);
+                if (para)
+                    para->ClearLines();
+            }
+
+            m_incrementalLayoutRequired = true;
+        }
+    }
+
+    // While the incremental layout is in progress, only the visible part of
+    // the buffer is laid out and the paragraphs below it are just moved, so
+    // those changed since the last layout would keep their outdated lines.
+    // Discard them to lay out these paragraphs again when they become
+    // visible or in idle time, using their current size as the estimate.
+    if (m_incrementalLayoutRequired && invalidRange != wxRICHTEXT_NONE &&
+            invalidRange != wxRICHTEXT_ALL)
+    {
+        wxRichTextParagraph* para = GetBuffer().GetParagraphAtPosition(invalidRange.GetStart());
+        wxRichTextObjectList::compatibility_iterator node;
+        if (para)
+            node = GetBuffer().GetChildren().Find(para);
+        for (; node; node = node->GetNext())
+        {
+            para = wxDynamicCast(node->GetData(), wxRichTextParagraph);
+            if (!para)
+                continue;
+
+            if (para->GetRange().GetStart() > invalidRange.GetEnd())
+                break;
+
+            para->ClearLines();
+        }
+    }
+
+    int flags = wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT;
+    if (onlyVisibleRect || m_incrementalLayoutRequired)
+    {
+        flags |= wxRICHTEXT_LAYOUT_SPECIFIED_RECT|wxRICHTEXT_LAYOUT_ESTIMATE;
+        rect.SetPosition(GetUnscaledPoint(GetLogicalPoint(wxPoint(0, 0))));
+    }
+
+    return flags;
+}
+
+bool wxRichTextCtrl::ContinueIncrementalLayout(int height)
+{
+    // Any changes to the buffer must be taken into account first.
+    if (GetBuffer().IsDirty())
+    {
+        LayoutContent();
+        return m_incrementalLayoutRequired;
+    }
+
+    wxRichTextParagraph* para = GetBuffer().GetFirstEstimatedParagraph();
+    if (!para)
+    {
+        m_incrementalLayoutRequired = false;
+
+        SetupScrollbars();
+
+        wxRichTextEvent cmdEvent(wxEVT_RICHTEXT_LAYOUT_COMPLETE, GetId());
+        cmdEvent.SetEventObject(this);
+        GetEventHandler()->ProcessEvent(cmdEvent);
+
+        return false;
+    }
+
+    wxRect rect(0, para->GetPosition().y, GetUnscaledSize(GetClientSize()).x, height);
+    if (rect.width <= 0)
+        rect.width = 10;
+
+    wxInfoDC dc(this);
+
+    PrepareDC(dc);
+    dc.SetUserScale(GetScale(), GetScale());
+
+    wxRichTextDrawingContext context(& GetBuffer());
+    DoLayoutBuffer(GetBuffer(), dc, context, rect, rect,
+                   wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT|
+                   wxRICHTEXT_LAYOUT_SPECIFIED_RECT|wxRICHTEXT_LAYOUT_ESTIMATE);
+    GetBuffer().Invalidate(wxRICHTEXT_NONE);
+
+    dc.SetUserScale(1.0, 1.0);
+
+    SetupScrollbars();
+
+    // Laying out the paragraphs above the bottom of the window may have
+    // changed its contents.
+    const wxRect viewRect(GetUnscaledPoint(GetLogicalPoint(wxPoint(0, 0))),
+                          GetUnscaledSize(GetClientSize()));
+    if (rect.y <= viewRect.GetBottom())
+        Refresh(false);
+
+    // Even if everything has been laid out now, return true to send the
+    // completion event from the next call.
+    return true;
+}
+
 /// Is all of the selection, or the current caret position, bold?
 bool wxRichTextCtrl::IsSelectionBold()
 {
@@ -73,41 +73,65 @@ bool wxRichTextXMLHandler::DoLoadFile(wxRichTextBuffer *buffer, wxInputStream& s
     buffer->ResetAndClearCommands();
     buffer->Clear();
 
-    wxXmlDocument* xmlDoc = new wxXmlDocument;
-    bool success = true;
+    // Read the document sequentially instead of loading all of it into memory
+    // first, so that only the nodes of a single paragraph exist at any time.
+    wxXmlReader reader(stream);
 
-    if (!xmlDoc->Load(stream))
+    wxXmlReaderItem item;
+    do
     {
-        buffer->ResetAndClearCommands();
-        success = false;
+        item = reader.Next();
     }
-    else
+    while (item != wxXML_READER_START_ELEMENT && item != wxXML_READER_EOF && item != wxXML_READER_ERROR);
+
+    bool success = item == wxXML_READER_START_ELEMENT && reader.GetName() == wxT("richtext");
+    if (success)
     {
-        if (xmlDoc->GetRoot() && xmlDoc->GetRoot()->GetType() == wxXML_ELEMENT_NODE && xmlDoc->GetRoot()->GetName() == wxT("richtext"))
+        const int depth = reader.GetDepth();
+        for (;;)
         {
-            wxXmlNode* child = xmlDoc->GetRoot()->GetChildren();
-            while (child)
+            item = reader.Next();
+            if (item == wxXML_READER_END_ELEMENT && reader.GetDepth() == depth)
+                break;
+
+            if (item == wxXML_READER_EOF || item == wxXML_READER_ERROR)
+            {
+                success = false;
+                break;
+            }
+
+            if (item != wxXML_READER_START_ELEMENT)
+                continue;
+
+            const wxString name = reader.GetName();
+            if (name == wxT("richtext-version"))
             {
-                if (child->GetType() == wxXML_ELEMENT_NODE)
+                success = reader.SkipSubtree();
+            }
+            else if (name == wxT("stylesheet"))
+            {
+                // The style sheet is small and needs all of its definitions
+                // at once, so just create the nodes for it.
+                wxXmlNode* node = reader.ReadSubtree();
+                if (node)
                 {
-                    wxString name = child->GetName();
-                    if (name == wxT("richtext-version"))
-                    {
-                    }
-                    else
-                        ImportXML(buffer, buffer, child);
+                    ImportXML(buffer, buffer, node);
+                    delete node;
                 }
-
-                child = child->GetNext();
+                else
+                    success = false;
             }
+            else
+                success = ImportXML(buffer, buffer, reader);
+
+            if (!success)
+                break;
         }
-        else
-        {
-            success = false;
-        }
-    }
 
-    delete xmlDoc;
+        // Don't leave partially loaded contents in case of a parsing error.
+        if (!success)
+            buffer->ResetAndClearCommands();
+    }
 
     buffer->UpdateRanges();
 
@@ -165,6 +189,89 @@ bool wxRichTextXMLHandler::ImportXML(wxRichTextBuffer* buffer, wxRichTextObject*
     return true;
 }
 
+/// Import an object from the element at the current reader position,
+/// reading its children one by one
+bool wxRichTextXMLHandler::ImportXML(wxRichTextBuffer* buffer, wxRichTextObject* obj, wxXmlReader& reader)
+{
+    // Create the node for the element itself, without the child objects but
+    // with the other children, such as properties, used by ImportFromXML().
+    wxXmlNode node(wxXML_ELEMENT_NODE, reader.GetName(), wxString(), reader.GetLineNumber());
+    for (size_t i = 0; i < reader.GetAttributeCount(); i++)
+        node.AddAttribute(reader.GetAttributeName(i), reader.GetAttributeValue(i));
+
+    wxRichTextCompositeObject* compositeParent = wxDynamicCast(obj, wxRichTextCompositeObject);
+    bool imported = false;
+    bool recurse = false;
+
+    const int depth = reader.GetDepth();
+    for (;;)
+    {
+        switch (reader.Next())
+        {
+            case wxXML_READER_EOF:
+            case wxXML_READER_ERROR:
+                return false;
+
+            case wxXML_READER_END_ELEMENT:
+                if (reader.GetDepth() == depth)
+                {
+                    if (!imported)
+                        obj->ImportFromXML(buffer, & node, this, & recurse);
+                    return true;
+                }
+                break;
+
+            case wxXML_READER_START_ELEMENT:
+                {
+                    const wxString name = reader.GetName();
+                    if (name == wxT("properties") || name == wxT("stylesheet"))
+                    {
+                        wxXmlNode* child = reader.ReadSubtree();
+                        if (!child)
+                            return false;
+
+                        node.AddChild(child);
+                        break;
+                    }
+
+                    // These children precede the objects in the files we
+                    // write, so the object itself can be imported now.
+                    if (!imported)
+                    {
+                        obj->ImportFromXML(buffer, & node, this, & recurse);
+                        imported = true;
+                    }
+
+                    wxRichTextObject* childObj = nullptr;
+                    if (recurse && compositeParent)
+                        childObj = CreateObjectForXMLName(obj, name);
+
+                    if (!childObj)
+                    {
+                        if (!reader.SkipSubtree())
+                            return false;
+                        break;
+                    }
+
+                    wxXmlNode* child = reader.ReadSubtree();
+                    if (!child)
+                    {
+                        delete childObj;
+                        return false;
+                    }
+
+                    compositeParent->AppendChild(childObj);
+                    ImportXML(buffer, childObj, child);
+                    delete child;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
 bool wxRichTextXMLHandler::DoSaveFile(wxRichTextBuffer *buffer, wxOutputStream& stream)
 {
     if (!stream.IsOk())
@@ -253,61 +360,68 @@ bool wxRichTextXMLHandler::DoSaveFile(wxRichTextBuffer *buffer, wxOutputStream&
 #else
     // !(wxRICHTEXT_HAVE_XMLDOCUMENT_OUTPUT && wxRICHTEXT_USE_XMLDOCUMENT_OUTPUT)
 
+    // Many small strings are written, so buffer them to avoid writing each of
+    // them to the underlying stream, e.g. file, individually.
+    wxBufferedOutputStream bufferedStream(stream, 65536);
+
     wxString s ;
     s.Printf(wxT("<?xml version=\"%s\" encoding=\"%s\"?>\n"),
              version.c_str(), fileEncoding.c_str());
-    m_helper.OutputString(stream, s);
-    m_helper.OutputString(stream, wxT("<richtext version=\"1.0.0.0\" xmlns=\"http://www.wxwidgets.org\">"));
+    m_helper.OutputString(bufferedStream, s);
+    m_helper.OutputString(bufferedStream, wxT("<richtext version=\"1.0.0.0\" xmlns=\"http://www.wxwidgets.org\">"));
 
     int level = 1;
 
     if (buffer->GetStyleSheet() && (GetFlags() & wxRICHTEXT_HANDLER_INCLUDE_STYLESHEET))
     {
-        m_helper.OutputIndentation(stream, level);
+        m_helper.OutputIndentation(bufferedStream, level);
         wxString nameAndDescr;
         if (!buffer->GetStyleSheet()->GetName().empty())
             nameAndDescr << wxT(" name=\"") << buffer->GetStyleSheet()->GetName() << wxT("\"");
         if (!buffer->GetStyleSheet()->GetDescription().empty())
             nameAndDescr << wxT(" description=\"") << buffer->GetStyleSheet()->GetDescription() << wxT("\"");
-        m_helper.OutputString(stream, wxString(wxT("<stylesheet")) + nameAndDescr + wxT(">"));
+        m_helper.OutputString(bufferedStream, wxString(wxT("<stylesheet")) + nameAndDescr + wxT(">"));
 
         int i;
 
         for (i = 0; i < (int) buffer->GetStyleSheet()->GetCharacterStyleCount(); i++)
         {
             wxRichTextCharacterStyleDefinition* def = buffer->GetStyleSheet()->GetCharacterStyle(i);
-            m_helper.ExportStyleDefinition(stream, def, level + 1);
+            m_helper.ExportStyleDefinition(bufferedStream, def, level + 1);
         }
 
         for (i = 0; i < (int) buffer->GetStyleSheet()->GetParagraphStyleCount(); i++)
         {
             wxRichTextParagraphStyleDefinition* def = buffer->GetStyleSheet()->GetParagraphStyle(i);
-            m_helper.ExportStyleDefinition(stream, def, level + 1);
+            m_helper.ExportStyleDefinition(bufferedStream, def, level + 1);
         }
 
         for (i = 0; i < (int) buffer->GetStyleSheet()->GetListStyleCount(); i++)
         {
             wxRichTextListStyleDefinition* def = buffer->GetStyleSheet()->GetListStyle(i);
-            m_helper.ExportStyleDefinition(stream, def, level + 1);
+            m_helper.ExportStyleDefinition(bufferedStream, def, level + 1);
         }
 
         for (i = 0; i < (int) buffer->GetStyleSheet()->GetBoxStyleCount(); i++)
         {
             wxRichTextBoxStyleDefinition* def = buffer->GetStyleSheet()->GetBoxStyle(i);
-            m_helper.ExportStyleDefinition(stream, def, level + 1);
+            m_helper.ExportStyleDefinition(bufferedStream, def, level + 1);
         }
 
-        m_helper.WriteProperties(stream, buffer->GetStyleSheet()->GetProperties(), level);
+        m_helper.WriteProperties(bufferedStream, buffer->GetStyleSheet()->GetProperties(), level);
 
-        m_helper.OutputIndentation(stream, level);
-        m_helper.OutputString(stream, wxT("</stylesheet>"));
+        m_helper.OutputIndentation(bufferedStream, level);
+        m_helper.OutputString(bufferedStream, wxT("</stylesheet>"));
     }
 
 
-    bool success = ExportXML(stream, *buffer, level);
+    bool success = ExportXML(bufferedStream, *buffer, level);
+
+    m_helper.OutputString(bufferedStream, wxT("\n</richtext>"));
+    m_helper.OutputString(bufferedStream, wxT("\n"));
 
-    m_helper.OutputString(stream, wxT("\n</richtext>"));
-    m_helper.OutputString(stream, wxT("\n"));
+    if (!bufferedStream.Close())
+        success = false;
 #endif
 
     return success;
@@ -362,7 +476,7 @@ bool wxRichTextObject::ExportXML(wxOutputStream& stream, int indent, wxRichTextX
     handler->GetHelper().OutputIndentation(stream, indent);
     handler->GetHelper().OutputString(stream, wxT("<") + GetXMLNodeName());
 
-    wxString style = handler->GetHelper().AddAttributes(this, true);
+    wxString style = handler->GetHelper().GetAttributesString(this, true);
 
     handler->GetHelper().OutputString(stream, style + wxT(">"));
 
@@ -505,7 +619,7 @@ bool wxRichTextPlainText::ImportFromXML(wxRichTextBuffer* buffer, wxXmlNode* nod
 // Export this object directly to the given stream.
 bool wxRichTextPlainText::ExportXML(wxOutputStream& stream, int indent, wxRichTextXMLHandler* handler)
 {
-    wxString style = handler->GetHelper().AddAttributes(this, false);
+    wxString style = handler->GetHelper().GetAttributesString(this, false);
 
     int i;
     int last = 0;
@@ -757,7 +871,7 @@ bool wxRichTextImage::ImportFromXML(wxRichTextBuffer* buffer, wxXmlNode* node, w
 // Export this object directly to the given stream.
 bool wxRichTextImage::ExportXML(wxOutputStream& stream, int indent, wxRichTextXMLHandler* handler)
 {
-    wxString style = handler->GetHelper().AddAttributes(this, false);
+    wxString style = handler->GetHelper().GetAttributesString(this, false);
 
     handler->GetHelper().OutputIndentation(stream, indent);
     handler->GetHelper().OutputString(stream, wxT("<image"));
@@ -893,7 +1007,7 @@ bool wxRichTextParagraphLayoutBox::ExportXML(wxOutputStream& stream, int indent,
     wxString nodeName = GetXMLNodeName();
     handler->GetHelper().OutputString(stream, wxT("<") + nodeName);
 
-    wxString style = handler->GetHelper().AddAttributes(this, true);
+    wxString style = handler->GetHelper().GetAttributesString(this, true);
 
     if (GetPartialParagraph())
         style << wxT(" partialparagraph=\"true\"");
@@ -991,7 +1105,7 @@ bool wxRichTextTable::ExportXML(wxOutputStream& stream, int indent, wxRichTextXM
     wxString nodeName = GetXMLNodeName();
     handler->GetHelper().OutputString(stream, wxT("<") + nodeName);
 
-    wxString style = handler->GetHelper().AddAttributes(this, true);
+    wxString style = handler->GetHelper().GetAttributesString(this, true);
 
     style << wxT(" rows=\"") << m_rowCount << wxT("\"");
     style << wxT(" cols=\"") << m_colCount << wxT("\"");
@@ -1057,6 +1171,7 @@ void wxRichTextXMLHelper::Init()
     m_deleteConvFile = false;
     m_convMem = nullptr;
     m_convFile = nullptr;
+    m_lastAttributes = nullptr;
 #endif
     m_flags = 0;
 }
@@ -1069,6 +1184,8 @@ void wxRichTextXMLHelper::Clear()
     m_convFile = nullptr;
     m_convMem = nullptr;
     m_deleteConvFile = false;
+    m_attributesCache.clear();
+    m_lastAttributes = nullptr;
 #endif
     m_fileEncoding.clear();
 }
@@ -1917,53 +2034,44 @@ void wxRichTextXMLHelper::OutputIndentation(wxOutputStream& stream, int indent)
 void wxRichTextXMLHelper::OutputStringEnt(wxOutputStream& stream, const wxString& str,
                             wxMBConv *convMem, wxMBConv *convFile)
 {
-    size_t i, last, len;
-    wxChar c;
+    // Build the entire string first instead of outputting each fragment and
+    // entity separately: as all non-ASCII characters are replaced with
+    // entities, the result can be converted in one go.
+    wxString out;
+    out.reserve(str.length());
 
-    len = str.Len();
-    last = 0;
-    for (i = 0; i < len; i++)
+    for (wxString::const_iterator it = str.begin(); it != str.end(); ++it)
     {
-        c = str.GetChar(i);
+        const wxChar c = *it;
 
         // Original code excluded "&amp;" but we _do_ want to convert
         // the ampersand beginning &amp; because otherwise when read in,
         // the original "&amp;" becomes "&".
 
-        if (c == wxT('<') || c == wxT('>') || c == wxT('"') ||
-            (c == wxT('&') /* && (str.Mid(i+1, 4) != wxT("amp;")) */ ))
-        {
-            OutputString(stream, str.Mid(last, i - last), convMem, convFile);
-            switch (c)
-            {
-            case wxT('<'):
-                OutputString(stream, wxT("&lt;"), nullptr, nullptr);
-                break;
-            case wxT('>'):
-                OutputString(stream, wxT("&gt;"), nullptr, nullptr);
-                break;
-            case wxT('&'):
-                OutputString(stream, wxT("&amp;"), nullptr, nullptr);
-                break;
-            case wxT('"'):
-                OutputString(stream, wxT("&quot;"), nullptr, nullptr);
-                break;
-            default: break;
-            }
-            last = i + 1;
-        }
-        else if (wxUChar(c) > 127)
-        {
-            OutputString(stream, str.Mid(last, i - last), convMem, convFile);
-
-            wxString s(wxT("&#"));
-            s << (int) c;
-            s << wxT(";");
-            OutputString(stream, s, nullptr, nullptr);
-            last = i + 1;
+        switch (c)
+        {
+        case wxT('<'):
+            out += wxT("&lt;");
+            break;
+        case wxT('>'):
+            out += wxT("&gt;");
+            break;
+        case wxT('&'):
+            out += wxT("&amp;");
+            break;
+        case wxT('"'):
+            out += wxT("&quot;");
+            break;
+        default:
+            if (wxUChar(c) > 127)
+                out << wxT("&#") << (int) c << wxT(";");
+            else
+                out += c;
+            break;
         }
     }
-    OutputString(stream, str.Mid(last, i - last), convMem, convFile);
+
+    OutputString(stream, out, convMem, convFile);
 }
 
 void wxRichTextXMLHelper::OutputString(wxOutputStream& stream, const wxString& str)
@@ -2233,6 +2341,94 @@ wxString wxRichTextXMLHelper::AddAttributes(wxRichTextObject* obj, bool isPara)
     return style;
 }
 
+namespace
+{
+
+// Maximal number of the different attributes strings cached while saving.
+const size_t MAX_CACHED_ATTRIBUTES = 1024;
+
+// Combine the values of some of the attributes, which must be equal for the
+// attributes comparing equal, into a hash.
+size_t GetAttributesHash(const wxRichTextAttr& attr, bool isPara)
+{
+    size_t hash = attr.GetFlags();
+
+    const auto combine = [&hash](size_t value)
+    {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+
+    combine(isPara);
+    combine(attr.GetTextBoxAttr().GetFlags());
+    if (attr.HasTextColour())
+        combine(attr.GetTextColour().GetRGBA());
+    if (attr.HasBackgroundColour())
+        combine(attr.GetBackgroundColour().GetRGBA());
+    if (attr.HasFontSize())
+        combine(attr.GetFontSize());
+    if (attr.HasFontWeight())
+        combine(attr.GetFontWeight());
+    if (attr.HasFontItalic())
+        combine(attr.GetFontStyle());
+    if (attr.HasFontFaceName())
+        combine(std::hash<wxString>()(attr.GetFontFaceName()));
+    if (attr.HasAlignment())
+        combine(attr.GetAlignment());
+    if (attr.HasLeftIndent())
+        combine(attr.GetLeftIndent());
+    if (attr.HasCharacterStyleName())
+        combine(std::hash<wxString>()(attr.GetCharacterStyleName()));
+    if (attr.HasParagraphStyleName())
+        combine(std::hash<wxString>()(attr.GetParagraphStyleName()));
+    if (attr.HasURL())
+        combine(std::hash<wxString>()(attr.GetURL()));
+
+    return hash;
+}
+
+} // anonymous namespace
+
+wxString wxRichTextXMLHelper::GetAttributesString(wxRichTextObject* obj, bool isPara)
+{
+    const wxRichTextAttr& attr = obj->GetAttributes();
+
+    const AttributesCacheEntry* entry = m_lastAttributes;
+    if (!entry || entry->isPara != isPara || !(entry->attr == attr))
+    {
+        entry = nullptr;
+
+        const size_t hash = GetAttributesHash(attr, isPara);
+        const auto range = m_attributesCache.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second.isPara == isPara && it->second.attr == attr)
+            {
+                entry = &it->second;
+                break;
+            }
+        }
+
+        if (!entry)
+        {
+            if (m_attributesCache.size() >= MAX_CACHED_ATTRIBUTES)
+                return AddAttributes(obj, isPara);
+
+            const auto it = m_attributesCache.emplace(hash,
+                AttributesCacheEntry{attr, isPara, AddAttributes(attr, isPara)});
+            entry = &it->second;
+        }
+
+        m_lastAttributes = entry;
+    }
+
+    if (obj->IsShown())
+        return entry->str;
+
+    wxString style = entry->str;
+    style << wxT(" show=\"0\"");
+    return style;
+}
+
 // Write the properties
 bool wxRichTextXMLHelper::WriteProperties(wxOutputStream& stream, const wxRichTextProperties& properties, int level)
 {
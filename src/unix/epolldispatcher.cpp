@@ -39,9 +39,22 @@
 // implementation
 // ============================================================================
 
+namespace
+{
+
+// the initial and the maximal size of the buffer used for epoll_wait()
+const unsigned MIN_EVENTS_BUFFER_SIZE = 16;
+const unsigned MAX_EVENTS_BUFFER_SIZE = 1024;
+
+// the number of consecutive polls using at most a quarter of the buffer
+// after which it is shrunk
+const unsigned SHRINK_BUFFER_AFTER = 128;
+
+} // anonymous namespace
+
 // helper: return EPOLLxxx mask corresponding to the given flags (and also log
 // debugging messages about it)
-static uint32_t GetEpollMask(int flags, int fd)
+static uint32_t GetEpollMask(int flags, int fd, const wxFDIOHandler* handler)
 {
     wxUnusedVar(fd); // unused if wxLogTrace() disabled
 
@@ -68,6 +81,17 @@ static uint32_t GetEpollMask(int flags, int fd)
                    wxT("Registered fd %d for exceptional events"), fd);
     }
 
+    // handlers which always read or write everything they can don't need to
+    // be notified again about the same data, so use edge-triggered mode for
+    // them, which avoids the kernel checking their state again on each call
+    // to epoll_wait()
+    if ( handler->DrainsFully() )
+    {
+        ep |= EPOLLET;
+        wxLogTrace(wxEpollDispatcher_Trace,
+                   wxT("Using edge-triggered events for fd %d"), fd);
+    }
+
     return ep;
 }
 
@@ -94,6 +118,11 @@ wxEpollDispatcher::wxEpollDispatcher(int epollDescriptor)
     wxASSERT_MSG( epollDescriptor != -1, wxT("invalid descriptor") );
 
     m_epollDescriptor = epollDescriptor;
+
+    m_underusedPolls = 0;
+    m_stats.bufferSize = MIN_EVENTS_BUFFER_SIZE;
+
+    m_hasPendingEvent = false;
 }
 
 wxEpollDispatcher::~wxEpollDispatcher()
@@ -104,11 +133,25 @@ wxEpollDispatcher::~wxEpollDispatcher()
     }
 }
 
+void
+wxEpollDispatcher::SetEntry(int fd, wxFDIOHandler* handler, uint32_t events)
+{
+    if ( static_cast<size_t>(fd) >= m_entries.size() )
+        m_entries.resize(fd + 1);
+
+    Entry& entry = m_entries[fd];
+    entry.handler = handler;
+    entry.events = events;
+}
+
 bool wxEpollDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
 {
+    wxCHECK_MSG( fd >= 0 && handler, false, wxT("invalid fd or handler") );
+
     epoll_event ev;
-    ev.events = GetEpollMask(flags, fd);
-    ev.data.ptr = handler;
+    ev.events = GetEpollMask(flags, fd, handler);
+    ev.data.u64 = 0;
+    ev.data.fd = fd;
 
     const int ret = epoll_ctl(m_epollDescriptor, EPOLL_CTL_ADD, fd, &ev);
     if ( ret != 0 )
@@ -118,6 +161,9 @@ bool wxEpollDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
 
         return false;
     }
+
+    SetEntry(fd, handler, ev.events);
+
     wxLogTrace(wxEpollDispatcher_Trace,
                wxT("Added fd %d (handler %p) to epoll %d"), fd, handler, m_epollDescriptor);
 
@@ -126,9 +172,12 @@ bool wxEpollDispatcher::RegisterFD(int fd, wxFDIOHandler* handler, int flags)
 
 bool wxEpollDispatcher::ModifyFD(int fd, wxFDIOHandler* handler, int flags)
 {
+    wxCHECK_MSG( fd >= 0 && handler, false, wxT("invalid fd or handler") );
+
     epoll_event ev;
-    ev.events = GetEpollMask(flags, fd);
-    ev.data.ptr = handler;
+    ev.events = GetEpollMask(flags, fd, handler);
+    ev.data.u64 = 0;
+    ev.data.fd = fd;
 
     const int ret = epoll_ctl(m_epollDescriptor, EPOLL_CTL_MOD, fd, &ev);
     if ( ret != 0 )
@@ -139,6 +188,8 @@ bool wxEpollDispatcher::ModifyFD(int fd, wxFDIOHandler* handler, int flags)
         return false;
     }
 
+    SetEntry(fd, handler, ev.events);
+
     wxLogTrace(wxEpollDispatcher_Trace,
                 wxT("Modified fd %d (handler: %p) on epoll %d"), fd, handler, m_epollDescriptor);
     return true;
@@ -148,20 +199,67 @@ bool wxEpollDispatcher::UnregisterFD(int fd)
 {
     epoll_event ev;
     ev.events = 0;
-    ev.data.ptr = nullptr;
+    ev.data.u64 = 0;
 
     if ( epoll_ctl(m_epollDescriptor, EPOLL_CTL_DEL, fd, &ev) != 0 )
     {
         wxLogSysError(_("Failed to unregister descriptor %d from epoll descriptor %d"),
                       fd, m_epollDescriptor);
     }
+
+    // forget about this descriptor even if we failed to remove it, e.g.
+    // because it had been already closed, to ensure that we don't dispatch
+    // any events, possibly retrieved by HasPending() before, for it
+    if ( fd >= 0 && static_cast<size_t>(fd) < m_entries.size() )
+    {
+        Entry& entry = m_entries[fd];
+        entry.handler = nullptr;
+        entry.events = 0;
+    }
+
+    // the descriptor could be reused for another handler before the next
+    // Dispatch(), which shouldn't get the event retrieved for this one
+    if ( m_hasPendingEvent && m_pendingEvent.data.fd == fd )
+        m_hasPendingEvent = false;
+
     wxLogTrace(wxEpollDispatcher_Trace,
                 wxT("removed fd %d from %d"), fd, m_epollDescriptor);
     return true;
 }
 
-int
-wxEpollDispatcher::DoPoll(epoll_event *events, int numEvents, int timeout) const
+void wxEpollDispatcher::AdaptBufferSize(int numEvents) const
+{
+    const unsigned size = m_stats.bufferSize;
+
+    if ( static_cast<unsigned>(numEvents) >= size )
+    {
+        // there may be more events waiting, get more of them at once the
+        // next time
+        m_stats.fullPolls++;
+
+        if ( size < MAX_EVENTS_BUFFER_SIZE )
+            m_stats.bufferSize = size*2;
+
+        m_underusedPolls = 0;
+    }
+    else if ( size > MIN_EVENTS_BUFFER_SIZE &&
+                static_cast<unsigned>(numEvents) <= size / 4 )
+    {
+        // don't keep a big buffer around if we don't need it any more, but
+        // avoid shrinking it too eagerly when the load is bursty
+        if ( ++m_underusedPolls == SHRINK_BUFFER_AFTER )
+        {
+            m_stats.bufferSize = size / 2;
+            m_underusedPolls = 0;
+        }
+    }
+    else
+    {
+        m_underusedPolls = 0;
+    }
+}
+
+int wxEpollDispatcher::DoPoll(int timeout) const
 {
     // the code below relies on TIMEOUT_INFINITE being -1 so that we can pass
     // timeout value directly to epoll_wait() which interprets -1 as meaning to
@@ -169,6 +267,10 @@ wxEpollDispatcher::DoPoll(epoll_event *events, int numEvents, int timeout) const
     // TIMEOUT_INFINITE ever changes
     wxCOMPILE_TIME_ASSERT( TIMEOUT_INFINITE == -1, UpdateThisCode );
 
+    // resize the buffer if AdaptBufferSize() decided to do it the last time
+    if ( m_events.size() != m_stats.bufferSize )
+        m_events.resize(m_stats.bufferSize);
+
     wxMilliClock_t timeEnd;
     if ( timeout > 0 )
         timeEnd = wxGetLocalTimeMillis();
@@ -176,7 +278,7 @@ wxEpollDispatcher::DoPoll(epoll_event *events, int numEvents, int timeout) const
     int rc;
     for ( ;; )
     {
-        rc = epoll_wait(m_epollDescriptor, events, numEvents, timeout);
+        rc = epoll_wait(m_epollDescriptor, &m_events[0], m_events.size(), timeout);
         if ( rc != -1 || errno != EINTR )
             break;
 
@@ -189,25 +291,45 @@ wxEpollDispatcher::DoPoll(epoll_event *events, int numEvents, int timeout) const
         }
     }
 
+    if ( rc != -1 )
+    {
+        m_stats.polls++;
+
+        AdaptBufferSize(rc);
+    }
+
     return rc;
 }
 
 bool wxEpollDispatcher::HasPending() const
 {
-    epoll_event event;
+    if ( m_hasPendingEvent )
+        return true;
 
     // NB: it's not really clear if epoll_wait() can return a number greater
     //     than the number of events passed to it but just in case it can, use
     //     >= instead of == here, see #10397
-    return DoPoll(&event, 1, 0) >= 1;
+    int rc;
+    do
+    {
+        rc = epoll_wait(m_epollDescriptor, &m_pendingEvent, 1, 0);
+    }
+    while ( rc == -1 && errno == EINTR );
+
+    // keep the event for the next Dispatch() call: the descriptors using
+    // edge-triggered mode won't be reported by epoll_wait() again until they
+    // get new data, so discarding it would lose it
+    m_hasPendingEvent = rc >= 1;
+
+    return m_hasPendingEvent;
 }
 
 int wxEpollDispatcher::Dispatch(int timeout)
 {
-    epoll_event events[16];
-
-    const int rc = DoPoll(events, WXSIZEOF(events), timeout);
+    m_stats.dispatches++;
 
+    // don't block if we already have an event retrieved by HasPending()
+    int rc = DoPoll(m_hasPendingEvent ? 0 : timeout);
     if ( rc == -1 )
     {
         wxLogSysError(_("Waiting for IO on epoll descriptor %d failed"),
@@ -215,13 +337,59 @@ int wxEpollDispatcher::Dispatch(int timeout)
         return -1;
     }
 
+    if ( m_hasPendingEvent )
+    {
+        m_hasPendingEvent = false;
+
+        // the same descriptor is reported again if it's still ready and uses
+        // level-triggered mode, don't call its handler twice then
+        int n;
+        for ( n = 0; n < rc; n++ )
+        {
+            if ( m_events[n].data.fd == m_pendingEvent.data.fd )
+            {
+                m_events[n].events |= m_pendingEvent.events;
+                break;
+            }
+        }
+
+        if ( n == rc )
+        {
+            if ( static_cast<size_t>(rc) < m_events.size() )
+                m_events[rc] = m_pendingEvent;
+            else
+                m_events.push_back(m_pendingEvent);
+
+            rc++;
+        }
+    }
+
+    // take the buffer containing the events while we're dispatching them,
+    // as the handlers could call Dispatch() recursively, e.g. by running a
+    // nested event loop, and overwrite its contents otherwise
+    std::vector<epoll_event> events;
+    events.swap(m_events);
+
     int numEvents = 0;
-    for ( epoll_event *p = events; p < events + rc; p++ )
+    for ( int n = 0; n < rc; n++ )
     {
-        wxFDIOHandler * const handler = (wxFDIOHandler *)(p->data.ptr);
+        const epoll_event& ev = events[n];
+
+        // the descriptor could have been unregistered by one of the handlers
+        // called before, or modified to not be interested in this event any
+        // more since then
+        wxFDIOHandler* handler = nullptr;
+        uint32_t flags = ev.events;
+        if ( static_cast<size_t>(ev.data.fd) < m_entries.size() )
+        {
+            const Entry& entry = m_entries[ev.data.fd];
+            handler = entry.handler;
+            flags &= entry.events | EPOLLERR | EPOLLHUP;
+        }
+
         if ( !handler )
         {
-            wxFAIL_MSG( wxT("null handler in epoll_event?") );
+            m_stats.staleEvents++;
             continue;
         }
 
@@ -229,19 +397,44 @@ int wxEpollDispatcher::Dispatch(int timeout)
         // OnReadWaiting() on EPOLLHUP as this is what epoll_wait() returns
         // when the write end of a pipe is closed while with select() the
         // remaining pipe end becomes ready for reading when this happens
-        if ( p->events & (EPOLLIN | EPOLLHUP) )
+        if ( flags & (EPOLLIN | EPOLLHUP) )
             handler->OnReadWaiting();
-        else if ( p->events & EPOLLOUT )
+        else if ( flags & EPOLLOUT )
             handler->OnWriteWaiting();
-        else if ( p->events & EPOLLERR )
+        else if ( flags & EPOLLERR )
             handler->OnExceptionWaiting();
         else
+        {
+            m_stats.staleEvents++;
             continue;
+        }
 
         numEvents++;
     }
 
+    // give the buffer back, it's fine to discard the one possibly allocated
+    // by a nested call as we don't keep any events in it
+    m_events.swap(events);
+
+    m_stats.events += numEvents;
+    m_stats.lastBatch = numEvents;
+    if ( static_cast<unsigned>(numEvents) > m_stats.maxBatch )
+        m_stats.maxBatch = numEvents;
+
     return numEvents;
 }
 
+const wxEpollDispatcher::Stats& wxEpollDispatcher::GetStats() const
+{
+    return m_stats;
+}
+
+void wxEpollDispatcher::ResetStats()
+{
+    const unsigned bufferSize = m_stats.bufferSize;
+
+    m_stats = Stats();
+    m_stats.bufferSize = bufferSize;
+}
+
 #endif // wxUSE_EPOLL_DISPATCHER
@@ -46,6 +46,126 @@
 
 #include <memory>
 
+// timerfd is available under Linux, where epoll is also available, so just
+// reuse the check for the latter instead of having a separate one
+#if wxUSE_TIMER && wxUSE_EPOLL_DISPATCHER
+    #define wxHAS_TIMERFD
+
+    #include <sys/timerfd.h>
+    #include <unistd.h>
+    #include <errno.h>
+    #include <string.h>
+#endif
+
+#ifdef wxHAS_TIMERFD
+
+// ===========================================================================
+// wxTimerFD: wakes up the event loop when the next timer expires
+// ===========================================================================
+
+// Using timerfd allows to wake up exactly when the timer expires, unlike the
+// dispatcher timeout which is in milliseconds, and avoids reprogramming the
+// wake up if the next expiration time didn't change.
+class wxTimerFD : public wxEventLoopSourceHandler
+{
+public:
+    wxTimerFD()
+    {
+        m_source = nullptr;
+        m_armed = false;
+
+        m_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if ( m_fd == -1 )
+        {
+            wxLogDebug("Failed to create timerfd: %s", wxSysErrorMsgStr());
+            return;
+        }
+
+        m_source = wxEventLoopBase::AddSourceForFD(m_fd, this, wxFDIO_INPUT);
+    }
+
+    virtual ~wxTimerFD()
+    {
+        delete m_source;
+
+        if ( m_fd != -1 )
+            close(m_fd);
+    }
+
+    bool IsOk() const { return m_source != nullptr; }
+
+    // Wake up the event loop at the given time, which is after the given
+    // (positive) delay. Returns false if this couldn't be done.
+    bool SetWakeUp(wxUsecClock_t when, wxUsecClock_t remaining)
+    {
+        if ( m_armed && when == m_wakeUp )
+            return true;
+
+        const wxLongLong_t usec = remaining.GetValue();
+
+        itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        spec.it_value.tv_sec = usec / 1000000;
+        spec.it_value.tv_nsec = (usec % 1000000) * 1000;
+
+        if ( timerfd_settime(m_fd, 0, &spec, nullptr) != 0 )
+        {
+            wxLogDebug("Failed to set timerfd: %s", wxSysErrorMsgStr());
+            return false;
+        }
+
+        m_armed = true;
+        m_wakeUp = when;
+
+        return true;
+    }
+
+    // Cancel the wake up if it had been set.
+    void Disarm()
+    {
+        if ( !m_armed )
+            return;
+
+        itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        timerfd_settime(m_fd, 0, &spec, nullptr);
+
+        m_armed = false;
+    }
+
+    virtual void OnReadWaiting() override
+    {
+        // Just reset the timerfd state, the expired timers are notified by
+        // the event loop itself after dispatching the events.
+        wxUint64 expirations;
+        if ( read(m_fd, &expirations, sizeof(expirations)) == -1 &&
+                errno != EAGAIN )
+        {
+            wxLogDebug("Failed to read from timerfd: %s", wxSysErrorMsgStr());
+        }
+
+        m_armed = false;
+    }
+
+    virtual void OnWriteWaiting() override { }
+    virtual void OnExceptionWaiting() override { }
+
+    // A single read() always resets the timerfd.
+    virtual bool DrainsFully() const override { return true; }
+
+private:
+    int m_fd;
+    wxEventLoopSource* m_source;
+
+    // true if the timer is set to expire at m_wakeUp
+    bool m_armed;
+    wxUsecClock_t m_wakeUp;
+
+    wxDECLARE_NO_COPY_CLASS(wxTimerFD);
+};
+
+#endif // wxHAS_TIMERFD
+
 // ===========================================================================
 // wxEventLoop implementation
 // ===========================================================================
@@ -60,6 +180,7 @@ wxConsoleEventLoop::wxConsoleEventLoop()
     m_dispatcher = nullptr;
     m_wakeupPipe = nullptr;
     m_wakeupSource = nullptr;
+    m_timerFD = nullptr;
 
     // Create the pipe.
     std::unique_ptr<wxWakeUpPipeMT> wakeupPipe(new wxWakeUpPipeMT);
@@ -87,10 +208,22 @@ wxConsoleEventLoop::wxConsoleEventLoop()
     m_dispatcher = wxFDIODispatcher::Get();
 
     m_wakeupPipe = wakeupPipe.release();
+
+#ifdef wxHAS_TIMERFD
+    // This is optional, we fall back to using the dispatcher timeout if we
+    // can't use timerfd for some reason.
+    std::unique_ptr<wxTimerFD> timerFD(new wxTimerFD);
+    if ( timerFD->IsOk() )
+        m_timerFD = timerFD.release();
+#endif // wxHAS_TIMERFD
 }
 
 wxConsoleEventLoop::~wxConsoleEventLoop()
 {
+#ifdef wxHAS_TIMERFD
+    delete m_timerFD;
+#endif // wxHAS_TIMERFD
+
     if ( m_wakeupPipe )
     {
         delete m_wakeupSource;
@@ -182,12 +315,37 @@ int wxConsoleEventLoop::DispatchTimeout(unsigned long timeout)
 #if wxUSE_TIMER
     // check if we need to decrease the timeout to account for a timer
     wxUsecClock_t nextTimer;
-    if ( wxTimerScheduler::Get().GetNext(&nextTimer) )
+    if ( wxTimerScheduler::Get().GetNextWakeUp(&nextTimer) )
     {
-        unsigned long timeUntilNextTimer = wxMilliClockToLong(nextTimer / 1000);
-        if ( timeUntilNextTimer < timeout )
-            timeout = timeUntilNextTimer;
+        const wxUsecClock_t remaining = nextTimer - wxGetUTCTimeUSec();
+        if ( remaining <= 0 )
+        {
+            // don't wait at all, the timer has already expired
+            timeout = 0;
+        }
+#ifdef wxHAS_TIMERFD
+        else if ( m_timerFD && m_timerFD->SetWakeUp(nextTimer, remaining) )
+        {
+            // nothing else to do, the dispatcher will return when the timer
+            // expires
+        }
+#endif // wxHAS_TIMERFD
+        else
+        {
+            // round the timeout up as waking up before the timer expiration
+            // would be useless
+            unsigned long timeUntilNextTimer =
+                wxMilliClockToLong((remaining + 999) / 1000);
+            if ( timeUntilNextTimer < timeout )
+                timeout = timeUntilNextTimer;
+        }
     }
+#ifdef wxHAS_TIMERFD
+    else if ( m_timerFD )
+    {
+        m_timerFD->Disarm();
+    }
+#endif // wxHAS_TIMERFD
 #endif // wxUSE_TIMER
 
     bool hadEvent = m_dispatcher->Dispatch(timeout) > 0;
@@ -200,6 +358,18 @@ int wxConsoleEventLoop::DispatchTimeout(unsigned long timeout)
     return hadEvent ? 1 : -1;
 }
 
+#if wxUSE_TIMER
+
+/* static */
+void wxConsoleEventLoop::SetTimerSlack(int milliseconds)
+{
+    wxCHECK_RET( milliseconds >= 0, wxS("timer slack can't be negative") );
+
+    wxTimerScheduler::Get().SetSlack(wxUsecClock_t(milliseconds)*1000);
+}
+
+#endif // wxUSE_TIMER
+
 void wxConsoleEventLoop::WakeUp()
 {
 #if wxUSE_THREADS
@@ -48,55 +48,154 @@ wxTimerScheduler *wxTimerScheduler::ms_instance = nullptr;
 
 void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    DoAddTimer(wxTimerSchedule(timer, expiration));
+    DoAddTimer(wxTimerSchedule(timer, expiration, m_seq++));
 }
 
 void wxTimerScheduler::DoAddTimer(const wxTimerSchedule& s)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
-    {
-        wxASSERT_MSG( node->m_timer != s.m_timer,
-                      wxT("adding the same timer twice?") );
-
-        if ( node->m_expiration > s.m_expiration )
-            break;
-    }
+    wxASSERT_MSG( s.m_timer->m_heapIndex >= m_timers.size() ||
+                    m_timers[s.m_timer->m_heapIndex].m_timer != s.m_timer,
+                  wxT("adding the same timer twice?") );
 
-    m_timers.insert(node, s);
+    m_timers.push_back(s);
+    s.m_timer->m_heapIndex = m_timers.size() - 1;
+    SiftUp(m_timers.size() - 1);
 
     wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
                s.m_timer->GetId(),
                s.m_expiration.ToString());
 }
 
+void wxTimerScheduler::UpdateTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+{
+    const size_t n = timer->m_heapIndex;
+    wxCHECK_RET( n < m_timers.size() && m_timers[n].m_timer == timer,
+                 wxT("updating inexistent timer?") );
+
+    wxLogTrace(wxTrace_Timer, wxT("Rescheduling timer %d to expire at %s"),
+               timer->GetId(),
+               expiration.ToString());
+
+    // Use a new sequence number for consistency with removing and adding the
+    // timer again.
+    wxTimerSchedule& s = m_timers[n];
+    s.m_expiration = expiration;
+    s.m_seq = m_seq++;
+
+    // Only one of these calls will actually move the timer.
+    SiftUp(n);
+    SiftDown(timer->m_heapIndex);
+}
+
 void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
 {
     wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
 
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
+    const size_t n = timer->m_heapIndex;
+    wxCHECK_RET( n < m_timers.size() && m_timers[n].m_timer == timer,
+                 wxT("removing inexistent timer?") );
+
+    DoRemoveAt(n);
+}
+
+void wxTimerScheduler::DoRemoveAt(size_t n)
+{
+    const wxTimerSchedule last = m_timers.back();
+    m_timers.pop_back();
+
+    if ( n == m_timers.size() )
+        return;
+
+    // Put the last element in place of the removed one and move it to its
+    // correct position.
+    DoPlace(n, last);
+    SiftUp(n);
+    SiftDown(last.m_timer->m_heapIndex);
+}
+
+void wxTimerScheduler::DoPlace(size_t n, const wxTimerSchedule& s)
+{
+    m_timers[n] = s;
+    s.m_timer->m_heapIndex = n;
+}
+
+void wxTimerScheduler::SiftUp(size_t n)
+{
+    const wxTimerSchedule s = m_timers[n];
+    while ( n > 0 )
+    {
+        const size_t parent = (n - 1) / 4;
+        if ( !(s < m_timers[parent]) )
+            break;
+
+        DoPlace(n, m_timers[parent]);
+        n = parent;
+    }
+
+    DoPlace(n, s);
+}
+
+void wxTimerScheduler::SiftDown(size_t n)
+{
+    const size_t count = m_timers.size();
+    const wxTimerSchedule s = m_timers[n];
+    for ( ;; )
     {
-        if ( node->m_timer == timer )
+        const size_t first = 4*n + 1;
+        if ( first >= count )
+            break;
+
+        // find the smallest child
+        const size_t last = wxMin(first + 4, count);
+        size_t smallest = first;
+        for ( size_t child = first + 1; child < last; ++child )
         {
-            m_timers.erase(node);
-            return;
+            if ( m_timers[child] < m_timers[smallest] )
+                smallest = child;
         }
+
+        if ( !(m_timers[smallest] < s) )
+            break;
+
+        DoPlace(n, m_timers[smallest]);
+        n = smallest;
     }
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+    DoPlace(n, s);
 }
 
-bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
+bool wxTimerScheduler::GetNextWakeUp(wxUsecClock_t *when) const
 {
     if ( m_timers.empty() )
       return false;
 
+    wxCHECK_MSG( when, false, wxT("null pointer") );
+
+    wxUsecClock_t next = m_timers[0].m_expiration;
+    if ( m_slack > 0 )
+    {
+        // Round the expiration time up to the next multiple of the slack:
+        // this ensures that all timers expiring during the same interval are
+        // notified together, at its end, and never before their expiration.
+        const wxUsecClock_t rem = next % m_slack;
+        if ( rem != 0 )
+            next += m_slack - rem;
+    }
+
+    *when = next;
+
+    return true;
+}
+
+bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
+{
+    wxUsecClock_t when;
+    if ( !GetNextWakeUp(&when) )
+        return false;
+
     wxCHECK_MSG( remaining, false, wxT("null pointer") );
 
-    *remaining = m_timers.begin()->m_expiration - wxGetUTCTimeUSec();
+    *remaining = when - wxGetUTCTimeUSec();
     if ( *remaining < 0 )
     {
         // timer already expired, don't wait at all before notifying it
@@ -115,24 +214,12 @@ bool wxTimerScheduler::NotifyExpired()
 
     typedef wxVector<wxUnixTimerImpl *> TimerImpls;
     TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
+    while ( !m_timers.empty() && m_timers[0].m_expiration <= now )
     {
-        wxTimerSchedule s = *cur;
-        if ( s.m_expiration > now )
-        {
-            // as the list is sorted by expiration time, we can skip the rest
-            break;
-        }
-
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
-
-        m_timers.erase(cur);
+        wxUnixTimerImpl * const timer = m_timers[0].m_timer;
+        DoRemoveAt(0);
 
         // check whether we need to keep this timer
-        wxUnixTimerImpl * const timer = s.m_timer;
         if ( timer->IsOneShot() )
         {
             // the timer needs to be stopped but don't call its Stop() from
@@ -140,26 +227,36 @@ bool wxTimerScheduler::NotifyExpired()
             // we had already done it, so we just need to reset its state
             timer->MarkStopped();
         }
-        else // reschedule the next timer expiration
-        {
-            // always keep the expiration time in the future, i.e. base it on
-            // the current time instead of just offsetting it from the current
-            // expiration time because it could happen that we're late and the
-            // current expiration time is (far) in the past
-            s.m_expiration = now + timer->GetInterval()*1000;
-            DoAddTimer(s);
-        }
 
         // we can't notify the timer from this loop as the timer event handler
         // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
-        // loop end
+        // timer), so do it after the loop end
         toNotify.push_back(timer);
     }
 
     if ( toNotify.empty() )
         return false;
 
+    // reschedule the next expiration of the periodic timers only now, to
+    // avoid processing them again in the loop above if their interval is 0
+    for ( TimerImpls::const_iterator i = toNotify.begin(),
+                                     end = toNotify.end();
+          i != end;
+          ++i )
+    {
+        wxUnixTimerImpl * const timer = *i;
+        if ( timer->IsOneShot() )
+            continue;
+
+        // always keep the expiration time in the future, i.e. base it on
+        // the current time instead of just offsetting it from the current
+        // expiration time because it could happen that we're late and the
+        // current expiration time is (far) in the past
+        DoAddTimer(wxTimerSchedule(timer,
+                                   now + wxUsecClock_t(timer->GetInterval())*1000,
+                                   m_seq++));
+    }
+
     for ( TimerImpls::const_iterator i = toNotify.begin(),
                                      end = toNotify.end();
           i != end;
@@ -179,14 +276,25 @@ wxUnixTimerImpl::wxUnixTimerImpl(wxTimer* timer)
                : wxTimerImpl(timer)
 {
     m_isRunning = false;
+    m_heapIndex = static_cast<size_t>(-1);
 }
 
 bool wxUnixTimerImpl::Start(int milliseconds, bool oneShot)
 {
-    // notice that this will stop an already running timer
+    // Restarting an already running timer is common, e.g. when it's used for
+    // a timeout which is reset on activity, so don't let the base class stop
+    // it and just reschedule it below instead, which is more efficient.
+    const bool wasRunning = m_isRunning;
+    m_isRunning = false;
+
     wxTimerImpl::Start(milliseconds, oneShot);
 
-    wxTimerScheduler::Get().AddTimer(this, wxGetUTCTimeUSec() + m_milli*1000);
+    const wxUsecClock_t expiration = wxGetUTCTimeUSec() + wxUsecClock_t(m_milli)*1000;
+    if ( wasRunning )
+        wxTimerScheduler::Get().UpdateTimer(this, expiration);
+    else
+        wxTimerScheduler::Get().AddTimer(this, expiration);
+
     m_isRunning = true;
 
     return true;
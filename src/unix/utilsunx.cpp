@@ -126,6 +126,7 @@
 #include <sys/wait.h>
 #include <unistd.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <netdb.h>
 #include <signal.h>
 #include <time.h>           // nanosleep() and/or usleep()
@@ -517,6 +518,91 @@ long wxExecute(const wchar_t* const* wargv, int flags, wxProcess* process,
 namespace
 {
 
+#ifndef O_CLOEXEC
+    #define O_CLOEXEC 0
+#endif
+
+// Simple wrapper for the descriptor of a file to which the child output is
+// redirected: we don't use wxFile here because we only need the descriptor
+// and it's not necessarily available anyhow.
+class wxExecuteOutputFile
+{
+public:
+    wxExecuteOutputFile() = default;
+    ~wxExecuteOutputFile() { Close(); }
+
+    // Create the file or truncate it if it already exists.
+    bool Create(const wxString& path)
+    {
+        m_fd = open(path.fn_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                    0666);
+        if ( m_fd == -1 )
+        {
+            wxLogSysError(_("can't create file '%s'"), path);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool IsOpened() const { return m_fd != -1; }
+    int fd() const { return m_fd; }
+
+    void Close()
+    {
+        if ( m_fd != -1 )
+        {
+            close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+private:
+    int m_fd = -1;
+
+    wxDECLARE_NO_COPY_CLASS(wxExecuteOutputFile);
+};
+
+#if wxUSE_STREAMS
+
+// Try to create the handler generating wxEVT_PROCESS_OUTPUT events for the
+// data read from the given FD, return false if this couldn't be done and the
+// FD must be read from in the usual way.
+bool
+CreateOutputEventsHandler(std::unique_ptr<wxExecuteOutputEventsHandler>& handler,
+                          wxProcess& process,
+                          int fd,
+                          bool isError)
+{
+    const int flags = fcntl(fd, F_GETFL);
+    if ( flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1 )
+    {
+        wxLogLastError(wxS("fcntl(O_NONBLOCK)"));
+        return false;
+    }
+
+#ifdef F_SETPIPE_SZ
+    // Use a bigger pipe buffer, if possible, to allow the child to write more
+    // output before blocking and for us to read it using fewer calls. This is
+    // just an optimization, so don't complain if it fails.
+    fcntl(fd, F_SETPIPE_SZ, 1024*1024);
+#endif // F_SETPIPE_SZ
+
+    handler.reset(new wxExecuteOutputEventsHandler(process, fd, isError));
+    if ( !handler->IsOk() )
+    {
+        // Restore the blocking mode expected by wxPipeInputStream.
+        fcntl(fd, F_SETFL, flags);
+
+        handler.reset();
+        return false;
+    }
+
+    return true;
+}
+
+#endif // wxUSE_STREAMS
+
 // Helper function of wxExecute(): wait for the process termination without
 // dispatching any events.
 //
@@ -560,18 +646,27 @@ int BlockUntilChildExit(wxExecuteData& execData)
         stderrHandler;
     if ( execData.IsRedirected() )
     {
-        stdoutHandler.reset(new wxExecuteFDIOHandler
-                                (
-                                    dispatcher,
-                                    execData.m_fdOut,
-                                    execData.m_bufOut
-                                ));
-        stderrHandler.reset(new wxExecuteFDIOHandler
-                                (
-                                    dispatcher,
-                                    execData.m_fdErr,
-                                    execData.m_bufErr
-                                ));
+        // Notice that the FDs are not valid if the corresponding output is
+        // redirected to a file.
+        if ( execData.m_fdOut != wxPipe::INVALID_FD )
+        {
+            stdoutHandler.reset(new wxExecuteFDIOHandler
+                                    (
+                                        dispatcher,
+                                        execData.m_fdOut,
+                                        execData.m_bufOut
+                                    ));
+        }
+
+        if ( execData.m_fdErr != wxPipe::INVALID_FD )
+        {
+            stderrHandler.reset(new wxExecuteFDIOHandler
+                                    (
+                                        dispatcher,
+                                        execData.m_fdErr,
+                                        execData.m_bufErr
+                                    ));
+        }
     }
 #endif // wxUSE_STREAMS
 
@@ -632,14 +727,39 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
     execData.m_flags = flags;
     execData.m_process = process;
 
-    // create pipes for inter process communication
+    // open the files to redirect the child output to, if any: this is more
+    // efficient than reading the output from the pipes and writing it to the
+    // file ourselves, as the data doesn't need to be copied at all
+    wxExecuteOutputFile fileOut,
+                        fileErr;
+
+    bool errToOut = false;
+    if ( process && !process->GetOutputFile().empty() )
+    {
+        const wxString& errFile = process->GetErrorFile();
+        errToOut = errFile == process->GetOutputFile();
+
+        if ( !fileOut.Create(process->GetOutputFile()) ||
+                (!errFile.empty() && !errToOut &&
+                    !fileErr.Create(errFile)) )
+        {
+            wxLogError( _("Failed to execute '%s'\n"), *argv );
+
+            return ERROR_RETURN_CODE;
+        }
+    }
+
+    // create pipes for inter process communication, except for the streams
+    // redirected to the files
     wxPipe pipeIn,      // stdin
            pipeOut,     // stdout
            pipeErr;     // stderr
 
     if ( process && process->IsRedirected() )
     {
-        if ( !pipeIn.Create() || !pipeOut.Create() || !pipeErr.Create() )
+        if ( !pipeIn.Create() ||
+                (!fileOut.IsOpened() && !pipeOut.Create()) ||
+                (!fileErr.IsOpened() && !errToOut && !pipeErr.Create()) )
         {
             wxLogError( _("Failed to execute '%s'\n"), *argv );
 
@@ -647,6 +767,25 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
         }
     }
 
+    // the descriptors which should become the child stdout and stderr
+    int fdChildOut = wxPipe::INVALID_FD,
+        fdChildErr = wxPipe::INVALID_FD;
+    if ( fileOut.IsOpened() )
+    {
+        fdChildOut = fileOut.fd();
+        if ( errToOut )
+            fdChildErr = fdChildOut;
+    }
+    else if ( pipeOut.IsOk() )
+    {
+        fdChildOut = pipeOut[wxPipe::Write];
+    }
+
+    if ( fileErr.IsOpened() )
+        fdChildErr = fileErr.fd();
+    else if ( pipeErr.IsOk() )
+        fdChildErr = pipeErr[wxPipe::Write];
+
     // priority: we need to map wxWidgets priority which is in the range 0..100
     // to Unix nice value which is in the range -20..19. As there is an odd
     // number of elements in our range and an even number in the Unix one, we
@@ -703,20 +842,20 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
 #endif // HAVE_SETPRIORITY
 
         // redirect stdin, stdout and stderr
-        if ( pipeIn.IsOk() )
+        if ( (pipeIn.IsOk() &&
+                dup2(pipeIn[wxPipe::Read], STDIN_FILENO) == -1) ||
+             (fdChildOut != wxPipe::INVALID_FD &&
+                dup2(fdChildOut, STDOUT_FILENO) == -1) ||
+             (fdChildErr != wxPipe::INVALID_FD &&
+                dup2(fdChildErr, STDERR_FILENO) == -1) )
         {
-            if ( dup2(pipeIn[wxPipe::Read], STDIN_FILENO) == -1 ||
-                 dup2(pipeOut[wxPipe::Write], STDOUT_FILENO) == -1 ||
-                 dup2(pipeErr[wxPipe::Write], STDERR_FILENO) == -1 )
-            {
-                wxLogSysError(_("Failed to redirect child process input/output"));
-            }
-
-            pipeIn.Close();
-            pipeOut.Close();
-            pipeErr.Close();
+            wxLogSysError(_("Failed to redirect child process input/output"));
         }
 
+        pipeIn.Close();
+        pipeOut.Close();
+        pipeErr.Close();
+
         // Close all (presumably accidentally) inherited file descriptors to
         // avoid descriptor leaks. This means that we don't allow inheriting
         // them purposefully but this seems like a lesser evil in wx code.
@@ -823,11 +962,31 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
             wxOutputStream *inStream =
                 new wxPipeOutputStream(pipeIn.Detach(wxPipe::Write));
 
+            // If output events are used, the child output is read by the
+            // event handlers and not via the streams, which are not created
+            // at all then.
+            const bool useEvents = process->AreOutputEventsEnabled() &&
+                                    !(flags & wxEXEC_SYNC);
+
             const int fdOut = pipeOut.Detach(wxPipe::Read);
-            wxPipeInputStream *outStream = new wxPipeInputStream(fdOut);
+            wxPipeInputStream *outStream = nullptr;
+            if ( fdOut != wxPipe::INVALID_FD )
+            {
+                if ( !useEvents ||
+                        !CreateOutputEventsHandler(execData.m_outEvents,
+                                                   *process, fdOut, false) )
+                    outStream = new wxPipeInputStream(fdOut);
+            }
 
             const int fdErr = pipeErr.Detach(wxPipe::Read);
-            wxPipeInputStream *errStream = new wxPipeInputStream(fdErr);
+            wxPipeInputStream *errStream = nullptr;
+            if ( fdErr != wxPipe::INVALID_FD )
+            {
+                if ( !useEvents ||
+                        !CreateOutputEventsHandler(execData.m_errEvents,
+                                                   *process, fdErr, true) )
+                    errStream = new wxPipeInputStream(fdErr);
+            }
 
             process->SetPipeStreams(outStream, inStream, errStream);
 
@@ -842,12 +1001,12 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
         }
 #endif // HAS_PIPE_STREAMS
 
-        if ( pipeIn.IsOk() )
-        {
-            pipeIn.Close();
-            pipeOut.Close();
-            pipeErr.Close();
-        }
+        pipeIn.Close();
+        pipeOut.Close();
+        pipeErr.Close();
+
+        fileOut.Close();
+        fileErr.Close();
 
         if ( !(flags & wxEXEC_SYNC) )
         {
@@ -1607,14 +1766,21 @@ wxAppTraits::RunLoopUntilChildExit(wxExecuteData& execData,
         stderrHandler;
     if ( execData.IsRedirected() )
     {
-        stdoutHandler.reset(new wxExecuteEventLoopSourceHandler
-                                (
-                                    execData.m_fdOut, execData.m_bufOut
-                                ));
-        stderrHandler.reset(new wxExecuteEventLoopSourceHandler
-                                (
-                                    execData.m_fdErr, execData.m_bufErr
-                                ));
+        if ( execData.m_fdOut != wxPipe::INVALID_FD )
+        {
+            stdoutHandler.reset(new wxExecuteEventLoopSourceHandler
+                                    (
+                                        execData.m_fdOut, execData.m_bufOut
+                                    ));
+        }
+
+        if ( execData.m_fdErr != wxPipe::INVALID_FD )
+        {
+            stderrHandler.reset(new wxExecuteEventLoopSourceHandler
+                                    (
+                                        execData.m_fdErr, execData.m_bufErr
+                                    ));
+        }
     }
 #endif // wxUSE_STREAMS
 
@@ -1629,6 +1795,182 @@ wxAppTraits::RunLoopUntilChildExit(wxExecuteData& execData,
     return execData.m_exitcode;
 }
 
+// ----------------------------------------------------------------------------
+// wxExecuteOutputEventsHandler
+// ----------------------------------------------------------------------------
+
+#if wxUSE_STREAMS
+
+namespace
+{
+
+// The size of the first read done when the child output becomes available:
+// if it fills the entire buffer, the size of the subsequent reads is doubled,
+// up to the maximal size, to read big amounts of output using fewer calls.
+const size_t OUTPUT_READ_SIZE_MIN = 64*1024;
+const size_t OUTPUT_READ_SIZE_MAX = 1024*1024;
+
+// The maximal amount of data read during a single notification, to avoid
+// starving the other event sources if the child writes its output faster than
+// we can read it.
+const size_t OUTPUT_READ_PER_DISPATCH = 4*1024*1024;
+
+} // anonymous namespace
+
+wxExecuteOutputEventsHandler::wxExecuteOutputEventsHandler(wxProcess& process,
+                                                           int fd,
+                                                           bool isError)
+    : m_process(process),
+      m_fd(fd),
+      m_isError(isError),
+      m_readSize(OUTPUT_READ_SIZE_MIN),
+      m_readBuf(OUTPUT_READ_SIZE_MIN),
+      m_destroyed(nullptr)
+{
+    m_source = wxEventLoop::AddSourceForFD(fd, this, wxEVENT_SOURCE_INPUT);
+
+    // Don't take ownership of the FD if we can't use it, the caller will.
+    if ( !m_source )
+        m_fd = wxPipe::INVALID_FD;
+}
+
+wxExecuteOutputEventsHandler::~wxExecuteOutputEventsHandler()
+{
+    if ( m_destroyed )
+        *m_destroyed = true;
+
+    Close();
+}
+
+void wxExecuteOutputEventsHandler::Close()
+{
+    delete m_source;
+    m_source = nullptr;
+
+    if ( m_fd != wxPipe::INVALID_FD )
+    {
+        close(m_fd);
+        m_fd = wxPipe::INVALID_FD;
+    }
+}
+
+void wxExecuteOutputEventsHandler::OnReadWaiting()
+{
+    ReadAvailable(OUTPUT_READ_PER_DISPATCH);
+}
+
+void wxExecuteOutputEventsHandler::ReadAll()
+{
+    while ( ReadAvailable(OUTPUT_READ_PER_DISPATCH) )
+        ;
+}
+
+bool wxExecuteOutputEventsHandler::ReadAvailable(size_t maxSize)
+{
+    if ( m_fd == wxPipe::INVALID_FD )
+        return false;
+
+    wxMemoryBuffer data;
+    bool more = true,
+         eof = false;
+    while ( more && data.GetDataLen() < maxSize )
+    {
+        // The first read is done into our own buffer as we don't know how
+        // much data there is, and we don't want to allocate a big buffer for
+        // the event if there is only a little of it, while the subsequent
+        // reads, if any, are done directly into the event buffer.
+        char* const buf = data.IsEmpty()
+                            ? m_readBuf.data()
+                            : static_cast<char*>(data.GetAppendBuf(m_readSize));
+        const size_t size = data.IsEmpty() ? m_readBuf.length() : m_readSize;
+
+        const ssize_t rc = read(m_fd, buf, size);
+        if ( rc > 0 )
+        {
+            const size_t len = static_cast<size_t>(rc);
+            if ( buf == m_readBuf.data() )
+                data.AppendData(buf, len);
+            else
+                data.UngetAppendBuf(len);
+
+            if ( len < size )
+            {
+                // We've read everything there was, don't try reading again
+                // as it would just fail with EAGAIN and, if the next reads
+                // are small, use smaller buffer for them too.
+                more = false;
+
+                if ( m_readSize > OUTPUT_READ_SIZE_MIN && len < size / 2 )
+                    m_readSize /= 2;
+            }
+            else if ( m_readSize < OUTPUT_READ_SIZE_MAX && buf != m_readBuf.data() )
+            {
+                m_readSize *= 2;
+            }
+        }
+        else if ( rc == 0 )
+        {
+            eof = true;
+        }
+        else // error
+        {
+            if ( buf != m_readBuf.data() )
+                data.UngetAppendBuf(0);
+
+            switch ( errno )
+            {
+                case EINTR:
+                    continue;
+
+                case EAGAIN:
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+                case EWOULDBLOCK:
+#endif
+                    more = false;
+                    break;
+
+                default:
+                    wxLogSysError(_("Failed to read child process output"));
+                    eof = true;
+            }
+        }
+
+        if ( eof )
+            more = false;
+    }
+
+    // Closing the FD when the child closes its end of the pipe also ensures
+    // that we stop getting the notifications for it.
+    if ( eof )
+        Close();
+
+    if ( data.IsEmpty() )
+        return false;
+
+    // The event handler may run a nested event loop calling us recursively,
+    // so remember the flag of the outer call and restore it when we're done.
+    bool destroyed = false;
+    bool* const destroyedOuter = m_destroyed;
+    m_destroyed = &destroyed;
+
+    m_process.SendOutputEvent(m_isError, data);
+
+    if ( destroyed )
+    {
+        // Only the innermost flag was set by our dtor, propagate it.
+        if ( destroyedOuter )
+            *destroyedOuter = true;
+
+        return false;
+    }
+
+    m_destroyed = destroyedOuter;
+
+    return !eof && data.GetDataLen() >= maxSize;
+}
+
+#endif // wxUSE_STREAMS
+
 // ----------------------------------------------------------------------------
 // wxExecuteData
 // ----------------------------------------------------------------------------
@@ -1693,6 +2035,10 @@ bool CheckForChildExit(int pid, int* exitcodeOut)
 
 wxExecuteData::ChildProcessesData wxExecuteData::ms_childProcesses;
 
+// This is defined here because wxExecuteOutputEventsHandler is only forward
+// declared in the header.
+wxExecuteData::~wxExecuteData() = default;
+
 /* static */
 void wxExecuteData::OnSomeChildExited(int WXUNUSED(sig))
 {
@@ -1781,6 +2127,21 @@ void wxExecuteData::OnExit(int exitcode)
         // available in the streams buffers.
         m_bufOut.ReadAll();
         m_bufErr.ReadAll();
+
+        // Also generate the events for all the remaining output, if we use
+        // them, to ensure that they're all processed before the termination
+        // notification.
+        if ( m_outEvents )
+        {
+            m_outEvents->ReadAll();
+            m_outEvents.reset();
+        }
+
+        if ( m_errEvents )
+        {
+            m_errEvents->ReadAll();
+            m_errEvents.reset();
+        }
     }
 #endif // wxUSE_STREAMS
 
@@ -98,7 +98,13 @@ void wxWakeUpPipe::OnReadWaiting()
         {
             wxASSERT_MSG( size == 1, "Too many writes to wake-up pipe?" );
 
-            break;
+            // Reading less than we asked for means that the pipe is empty
+            // now, otherwise keep reading as we must leave it empty for the
+            // edge-triggered notifications to work.
+            if ( size < static_cast<int>(WXSIZEOF(buf)) )
+                break;
+
+            continue;
         }
 
         if ( size == 0 || (size == -1 && errno == EAGAIN) )
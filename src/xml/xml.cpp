@@ -28,6 +28,10 @@
 #include "wx/versioninfo.h"
 
 #include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "expat.h" // from Expat
 
@@ -42,6 +46,234 @@ wxIMPLEMENT_CLASS(wxXmlDocument, wxObject);
 static bool wxIsWhiteOnly(const wxString& buf);
 
 
+//-----------------------------------------------------------------------------
+//  wxXmlArena
+//-----------------------------------------------------------------------------
+
+// Memory arena used by the documents loaded with wxXMLDOC_COMPACT flag: the
+// nodes, attributes and text are allocated from big blocks of memory which
+// are only freed all at once, when the arena is destroyed.
+//
+// The arena is reference-counted, with each node and attribute allocated from
+// it holding a reference to it, so that it stays alive as long as they do,
+// even if they're detached from the document. Notice that, just as the rest
+// of wxXmlDocument, this is not thread-safe.
+class wxXmlArena
+{
+public:
+    wxXmlArena() = default;
+
+    void IncRef() { m_refCount++; }
+    void DecRef()
+    {
+        if ( !--m_refCount )
+            delete this;
+    }
+
+    // Allocate memory suitably aligned for any object.
+    void* Alloc(size_t size)
+    {
+        char* const aligned = AlignUp(m_cur);
+        m_cur = aligned < m_end ? aligned : m_end;
+        return AllocBytes(AlignUp(size));
+    }
+
+    // Copy UTF-8 text into the arena.
+    const char* CopyText(const char* s, size_t len)
+    {
+        char* const text = AllocBytes(len);
+        memcpy(text, s, len);
+        return text;
+    }
+
+    // Append more text to the text previously returned by CopyText(), which
+    // is done in place if possible, i.e. if nothing else had been allocated
+    // since then, which is typically the case.
+    const char* AppendText(const char* text, size_t len,
+                           const char* s, size_t more)
+    {
+        if ( text + len == m_cur && more <= static_cast<size_t>(m_end - m_cur) )
+        {
+            memcpy(m_cur, s, more);
+            m_cur += more;
+            return text;
+        }
+
+        char* const textNew = AllocBytes(len + more);
+        memcpy(textNew, text, len);
+        memcpy(textNew + len, s, more);
+        return textNew;
+    }
+
+    // Return the unique string with the given UTF-8 contents.
+    const wxString* Intern(const char* s)
+    {
+        wxString& atom = m_atoms[s];
+        if ( atom.empty() && *s )
+            atom = wxString::FromUTF8Unchecked(s);
+        return &atom;
+    }
+
+private:
+    ~wxXmlArena()
+    {
+        for ( size_t n = 0; n < m_blocks.size(); n++ )
+            free(m_blocks[n]);
+    }
+
+    // The block size grows up to the maximal one for big documents.
+    enum
+    {
+        BLOCK_SIZE_MIN = 64*1024,
+        BLOCK_SIZE_MAX = 1024*1024,
+        ALIGNMENT = 16
+    };
+
+    template <typename T>
+    static T AlignUp(T n)
+    {
+        return (T)(((wxUIntPtr)n + ALIGNMENT - 1) & ~(wxUIntPtr)(ALIGNMENT - 1));
+    }
+
+    char* AllocBytes(size_t size)
+    {
+        if ( size > static_cast<size_t>(m_end - m_cur) )
+            NewBlock(size);
+
+        char* const p = m_cur;
+        m_cur += size;
+        return p;
+    }
+
+    void NewBlock(size_t sizeMin)
+    {
+        size_t size = m_blockSize;
+        if ( m_blockSize < BLOCK_SIZE_MAX )
+            m_blockSize *= 2;
+
+        if ( size < sizeMin )
+            size = sizeMin;
+
+        char* const block = static_cast<char*>(malloc(size));
+        if ( !block )
+            throw std::bad_alloc();
+
+        m_blocks.push_back(block);
+        m_cur = block;
+        m_end = block + size;
+    }
+
+    std::vector<char*> m_blocks;
+    char* m_cur = nullptr;
+    char* m_end = nullptr;
+    size_t m_blockSize = BLOCK_SIZE_MIN;
+
+    std::unordered_map<std::string, wxString> m_atoms;
+
+    size_t m_refCount = 1;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlArena);
+};
+
+namespace
+{
+
+// All objects allocated from the arena are preceded by this header, which
+// allows to release the reference to the arena when they're deleted.
+union wxXmlArenaHeader
+{
+    wxXmlArena* arena;
+
+    // Ensure that the object following the header is suitably aligned.
+    char align[16];
+};
+
+void* wxXmlArenaAlloc(size_t size, wxXmlArena& arena)
+{
+    wxXmlArenaHeader* const
+        header = static_cast<wxXmlArenaHeader*>(
+                    arena.Alloc(sizeof(wxXmlArenaHeader) + size));
+
+    header->arena = &arena;
+    arena.IncRef();
+
+    return header + 1;
+}
+
+void wxXmlArenaFree(void* p)
+{
+    // Memory allocated from the arena is not freed individually, but we need
+    // to release the reference to it.
+    if ( p )
+        (static_cast<wxXmlArenaHeader*>(p) - 1)->arena->DecRef();
+}
+
+// Attribute of a document loaded with wxXMLDOC_COMPACT flag.
+class wxXmlCompactAttribute : public wxXmlAttribute
+{
+public:
+    wxXmlCompactAttribute(const wxString& name, const wxString& value)
+        : wxXmlAttribute(name, value)
+    {
+    }
+
+    static void* operator new(size_t size, wxXmlArena& arena)
+    {
+        return wxXmlArenaAlloc(size, arena);
+    }
+
+    static void operator delete(void* p)
+    {
+        wxXmlArenaFree(p);
+    }
+
+    static void operator delete(void* p, wxXmlArena& WXUNUSED(arena))
+    {
+        wxXmlArenaFree(p);
+    }
+};
+
+} // anonymous namespace
+
+// Node of a document loaded with wxXMLDOC_COMPACT flag: until it's modified,
+// it refers to its name in the arena atom table and keeps its content as
+// UTF-8 text in the arena, which is only converted to wxString when it's
+// accessed for the first time.
+class wxXmlCompactNode : public wxXmlNode
+{
+public:
+    wxXmlCompactNode(wxXmlNodeType type, const wxString* name, int lineNo)
+        : wxXmlNode(type, wxString(), wxString(), lineNo),
+          m_nameAtom(name),
+          m_contentUTF8(nullptr),
+          m_contentLen(0)
+    {
+        m_compactStrings = true;
+    }
+
+    static void* operator new(size_t size, wxXmlArena& arena)
+    {
+        return wxXmlArenaAlloc(size, arena);
+    }
+
+    static void operator delete(void* p)
+    {
+        wxXmlArenaFree(p);
+    }
+
+    static void operator delete(void* p, wxXmlArena& WXUNUSED(arena))
+    {
+        wxXmlArenaFree(p);
+    }
+
+    const wxString* m_nameAtom;
+
+    // Null if there is no content or if it had been already converted.
+    mutable const char* m_contentUTF8;
+    size_t m_contentLen;
+};
+
+
 //-----------------------------------------------------------------------------
 //  wxXmlNode
 //-----------------------------------------------------------------------------
@@ -53,7 +285,8 @@ wxXmlNode::wxXmlNode(wxXmlNode *parent,wxXmlNodeType type,
       m_attrs(attrs), m_parent(parent),
       m_children(nullptr), m_next(next),
       m_lineNo(lineNo),
-      m_noConversion(false)
+      m_noConversion(false),
+      m_compactStrings(false)
 {
     wxASSERT_MSG ( type != wxXML_ELEMENT_NODE || content.empty(), "element nodes can't have content" );
 
@@ -75,7 +308,7 @@ wxXmlNode::wxXmlNode(wxXmlNodeType type, const wxString& name,
     : m_type(type), m_name(name), m_content(content),
       m_attrs(nullptr), m_parent(nullptr),
       m_children(nullptr), m_next(nullptr),
-      m_lineNo(lineNo), m_noConversion(false)
+      m_lineNo(lineNo), m_noConversion(false), m_compactStrings(false)
 {
     wxASSERT_MSG ( type != wxXML_ELEMENT_NODE || content.empty(), "element nodes can't have content" );
 }
@@ -123,8 +356,9 @@ void wxXmlNode::DoFree()
 void wxXmlNode::DoCopy(const wxXmlNode& node)
 {
     m_type = node.m_type;
-    m_name = node.m_name;
-    m_content = node.m_content;
+    m_name = node.GetName();
+    m_content = node.GetContent();
+    m_compactStrings = false;
     m_lineNo = node.m_lineNo;
     m_noConversion = node.m_noConversion;
     m_children = nullptr;
@@ -145,6 +379,31 @@ void wxXmlNode::DoCopy(const wxXmlNode& node)
     }
 }
 
+const wxString& wxXmlNode::DoGetCompactName() const
+{
+    return *static_cast<const wxXmlCompactNode*>(this)->m_nameAtom;
+}
+
+const wxString& wxXmlNode::DoGetCompactContent() const
+{
+    const wxXmlCompactNode* const self = static_cast<const wxXmlCompactNode*>(this);
+    if ( self->m_contentUTF8 )
+    {
+        const_cast<wxXmlNode*>(this)->m_content =
+            wxString::FromUTF8Unchecked(self->m_contentUTF8, self->m_contentLen);
+        self->m_contentUTF8 = nullptr;
+    }
+
+    return m_content;
+}
+
+void wxXmlNode::DoDetachCompactStrings()
+{
+    m_name = DoGetCompactName();
+    DoGetCompactContent();
+    m_compactStrings = false;
+}
+
 bool wxXmlNode::HasAttribute(const wxString& attrName) const
 {
     wxXmlAttribute *attr = GetAttributes();
@@ -380,7 +639,7 @@ int wxXmlNode::GetDepth(const wxXmlNode *grandparent) const
 
 bool wxXmlNode::IsWhitespaceOnly() const
 {
-    return wxIsWhiteOnly(m_content);
+    return wxIsWhiteOnly(GetContent());
 }
 
 
@@ -608,6 +867,19 @@ bool wxIsWhiteOnly(const wxString& buf)
 }
 
 
+// returns true if the given UTF-8 string contains only whitespaces
+static bool wxIsWhiteOnlyUTF8(const char *s, size_t len)
+{
+    for ( const char* const end = s + len; s != end; ++s )
+    {
+        const char c = *s;
+        if ( c != ' ' && c != '\t' && c != '\n' && c != '\r' )
+            return false;
+    }
+    return true;
+}
+
+
 struct wxXmlParsingContext
 {
     wxXmlParsingContext()
@@ -615,9 +887,80 @@ struct wxXmlParsingContext
           lastChild(nullptr),
           lastAsText(nullptr),
           doctype(nullptr),
+          arena(nullptr),
           removeWhiteOnlyNodes(false)
     {}
 
+    // create a new node with the given name and content, both in UTF-8,
+    // allocating it from the arena if we use one
+    wxXmlNode *CreateNode(wxXmlNodeType type, const char *name,
+                          const char *content = "", size_t len = 0)
+    {
+        const int lineNo = XML_GetCurrentLineNumber(parser);
+        if ( !arena )
+        {
+            return new wxXmlNode(type,
+                                 wxString::FromUTF8Unchecked(name),
+                                 wxString::FromUTF8Unchecked(content, len),
+                                 lineNo);
+        }
+
+        wxXmlCompactNode *n =
+            new(*arena) wxXmlCompactNode(type, arena->Intern(name), lineNo);
+        if ( len )
+        {
+            n->m_contentUTF8 = arena->CopyText(content, len);
+            n->m_contentLen = len;
+        }
+
+        return n;
+    }
+
+    // add the attributes in the format used by expat to the given node
+    void AddAttributes(wxXmlNode *n, const char **atts)
+    {
+        wxXmlAttribute *last = nullptr;
+        for ( const char **a = atts; *a; a += 2 )
+        {
+            wxXmlAttribute *attr;
+            const wxString name = wxString::FromUTF8Unchecked(a[0]);
+            const wxString value = wxString::FromUTF8Unchecked(a[1]);
+            if ( arena )
+                attr = new(*arena) wxXmlCompactAttribute(name, value);
+            else
+                attr = new wxXmlAttribute(name, value);
+
+            // don't use wxXmlNode::AddAttribute() which would need to find
+            // the last attribute every time
+            if ( last )
+                last->SetNext(attr);
+            else
+                n->SetAttributes(attr);
+            last = attr;
+        }
+    }
+
+    // append more UTF-8 text to the content of the given node
+    void AppendText(wxXmlNode *n, const char *s, size_t len)
+    {
+        if ( !arena )
+        {
+            n->SetContent(n->GetContent() + wxString::FromUTF8Unchecked(s, len));
+            return;
+        }
+
+        // all the nodes are compact ones when using the arena and the text
+        // couldn't have been converted yet while loading
+        wxXmlCompactNode * const cn = static_cast<wxXmlCompactNode *>(n);
+        if ( cn->m_contentUTF8 )
+            cn->m_contentUTF8 = arena->AppendText(cn->m_contentUTF8,
+                                                  cn->m_contentLen, s, len);
+        else // there is no content yet
+            cn->m_contentUTF8 = arena->CopyText(s, len);
+
+        cn->m_contentLen += len;
+    }
+
     XML_Parser parser;
     wxXmlNode *node;                    // the node being parsed
     wxXmlNode *lastChild;               // the last child of "node"
@@ -625,6 +968,7 @@ struct wxXmlParsingContext
     wxString   encoding;
     wxString   version;
     wxXmlDoctype *doctype;
+    wxXmlArena *arena;                  // only used with wxXMLDOC_COMPACT
     bool       removeWhiteOnlyNodes;
 };
 
@@ -639,18 +983,10 @@ extern "C" {
 static void StartElementHnd(void *userData, const char *name, const char **atts)
 {
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
-    wxXmlNode *node = new wxXmlNode(wxXML_ELEMENT_NODE,
-                                    wxString::FromUTF8Unchecked(name),
-                                    wxEmptyString,
-                                    XML_GetCurrentLineNumber(ctx->parser));
-    const char **a = atts;
+    wxXmlNode *node = ctx->CreateNode(wxXML_ELEMENT_NODE, name);
 
     // add node attributes
-    while (*a)
-    {
-        node->AddAttribute(wxString::FromUTF8Unchecked(a[0]), wxString::FromUTF8Unchecked(a[1]));
-        a += 2;
-    }
+    ctx->AddAttributes(node, atts);
 
     ASSERT_LAST_CHILD_OK(ctx);
     ctx->node->InsertChildAfter(node, ctx->lastChild);
@@ -676,23 +1012,21 @@ static void EndElementHnd(void *userData, const char* WXUNUSED(name))
 static void TextHnd(void *userData, const char *s, int len)
 {
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
-    wxString str = wxString::FromUTF8Unchecked(s, len);
 
     if (ctx->lastAsText)
     {
-        ctx->lastAsText->SetContent(ctx->lastAsText->GetContent() + str);
+        ctx->AppendText(ctx->lastAsText, s, len);
     }
     else
     {
         bool whiteOnly = false;
         if (ctx->removeWhiteOnlyNodes)
-            whiteOnly = wxIsWhiteOnly(str);
+            whiteOnly = wxIsWhiteOnlyUTF8(s, len);
 
         if (!whiteOnly)
         {
             wxXmlNode *textnode =
-                new wxXmlNode(wxXML_TEXT_NODE, wxS("text"), str,
-                              XML_GetCurrentLineNumber(ctx->parser));
+                ctx->CreateNode(wxXML_TEXT_NODE, "text", s, len);
 
             ASSERT_LAST_CHILD_OK(ctx);
             ctx->node->InsertChildAfter(textnode, ctx->lastChild);
@@ -705,9 +1039,7 @@ static void StartCdataHnd(void *userData)
 {
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
 
-    wxXmlNode *textnode =
-        new wxXmlNode(wxXML_CDATA_SECTION_NODE, wxS("cdata"), wxS(""),
-                      XML_GetCurrentLineNumber(ctx->parser));
+    wxXmlNode *textnode = ctx->CreateNode(wxXML_CDATA_SECTION_NODE, "cdata");
 
     ASSERT_LAST_CHILD_OK(ctx);
     ctx->node->InsertChildAfter(textnode, ctx->lastChild);
@@ -730,9 +1062,7 @@ static void CommentHnd(void *userData, const char *data)
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
 
     wxXmlNode *commentnode =
-        new wxXmlNode(wxXML_COMMENT_NODE,
-                      wxS("comment"), wxString::FromUTF8Unchecked(data),
-                      XML_GetCurrentLineNumber(ctx->parser));
+        ctx->CreateNode(wxXML_COMMENT_NODE, "comment", data, strlen(data));
 
     ASSERT_LAST_CHILD_OK(ctx);
     ctx->node->InsertChildAfter(commentnode, ctx->lastChild);
@@ -745,9 +1075,7 @@ static void PIHnd(void *userData, const char *target, const char *data)
     wxXmlParsingContext *ctx = (wxXmlParsingContext*)userData;
 
     wxXmlNode *pinode =
-        new wxXmlNode(wxXML_PI_NODE, wxString::FromUTF8Unchecked(target),
-                      wxString::FromUTF8Unchecked(data),
-                      XML_GetCurrentLineNumber(ctx->parser));
+        ctx->CreateNode(wxXML_PI_NODE, target, data, strlen(data));
 
     ASSERT_LAST_CHILD_OK(ctx);
     ctx->node->InsertChildAfter(pinode, ctx->lastChild);
@@ -829,9 +1157,20 @@ bool wxXmlDocument::Load(wxInputStream& stream, int flags,
     wxXmlParsingContext ctx;
     bool done;
     XML_Parser parser = XML_ParserCreate(nullptr);
-    wxXmlNode *root = new wxXmlNode(wxXML_DOCUMENT_NODE, wxEmptyString);
+
+    // the arena is kept alive by the nodes allocated from it, so we can
+    // release our reference to it as soon as we're done with loading
+    std::unique_ptr<wxXmlArena, void (*)(wxXmlArena*)>
+        arena(flags & wxXMLDOC_COMPACT ? new wxXmlArena : nullptr,
+              [](wxXmlArena* a) { a->DecRef(); });
+
+    wxXmlNode *root = arena
+                        ? new(*arena) wxXmlCompactNode(wxXML_DOCUMENT_NODE,
+                                                       arena->Intern(""), -1)
+                        : new wxXmlNode(wxXML_DOCUMENT_NODE, wxString());
 
     ctx.encoding = wxS("UTF-8"); // default in absence of encoding=""
+    ctx.arena = arena.get();
     ctx.doctype = &m_doctype;
     ctx.removeWhiteOnlyNodes = (flags & wxXMLDOC_KEEP_WHITESPACE_NODES) == 0;
     ctx.parser = parser;
@@ -895,6 +1234,618 @@ bool wxXmlDocument::Load(wxInputStream& stream, int flags,
 
 
 
+//-----------------------------------------------------------------------------
+//  wxXmlReader
+//-----------------------------------------------------------------------------
+
+class wxXmlReaderImpl
+{
+public:
+    wxXmlReaderImpl(wxInputStream& stream, int flags, size_t bufSize);
+    ~wxXmlReaderImpl() { XML_ParserFree(m_parser); }
+
+    wxXmlReaderItem Next();
+
+    // An item produced by the parser: notice that we keep the UTF-8 data
+    // and only convert it to wxString when it's accessed, as the application
+    // is typically interested only in some of the items.
+    struct Item
+    {
+        wxXmlReaderItem kind = wxXML_READER_EOF;
+
+        // the name is either taken from the names cache or stored in nameOwn
+        const wxString *name = nullptr;
+        wxString nameOwn;
+
+        std::string text;
+        mutable wxString textConverted;
+        mutable bool isTextConverted = false;
+
+        // names and values of the attributes, only the first 2*attrCount
+        // elements are used as we reuse the strings for the next items
+        std::vector<std::string> attrs;
+        size_t attrCount = 0;
+
+        int depth = 0;
+        int lineNo = -1;
+
+        const wxString& GetName() const { return name ? *name : nameOwn; }
+
+        const wxString& GetText() const
+        {
+            if ( !isTextConverted )
+            {
+                textConverted = wxString::FromUTF8Unchecked(text.data(),
+                                                            text.length());
+                isTextConverted = true;
+            }
+
+            return textConverted;
+        }
+    };
+
+    // the current item, only valid if HasCurrent() returns true
+    bool HasCurrent() const { return m_itemCount != 0; }
+    const Item& GetCurrent() const { return m_items[m_itemCurrent]; }
+
+    wxXmlReaderItem GetItem() const
+    {
+        return m_itemCount ? GetCurrent().kind : m_state;
+    }
+
+    const wxXmlParseError& GetError() const { return m_error; }
+
+    // expat callbacks
+    void OnStartElement(const char *name, const char **atts);
+    void OnEndElement();
+    void OnText(const char *s, int len);
+    void OnStartCdata();
+    void OnEndCdata();
+    void OnComment(const char *data);
+    void OnPI(const char *target, const char *data);
+
+private:
+    // add a new item and suspend the parser to return it from Next()
+    Item& AddItem(wxXmlReaderItem kind);
+
+    // add the item for the text accumulated so far, if any
+    void FlushText();
+
+    // set the name of the item, using the cache if possible
+    void SetName(Item& item, const char *name);
+
+    // the maximal number of the entries in m_names: this is needed to avoid
+    // using unbounded amounts of memory for the documents with many distinct
+    // element names
+    enum { MAX_CACHED_NAMES = 4096 };
+
+    XML_Parser m_parser;
+    wxInputStream& m_stream;
+    const size_t m_bufSize;
+    const bool m_keepWhitespace;
+
+    // the items produced by the parser since the last time it was resumed,
+    // this is typically just one or two of them, but the vector is never
+    // shrunk to avoid reallocating the strings of the items
+    std::vector<Item> m_items;
+    size_t m_itemCount = 0,
+           m_itemCurrent = 0;
+
+    // the state returned by GetItem() when there are no items
+    wxXmlReaderItem m_state = wxXML_READER_EOF;
+
+    // the text or CDATA contents accumulated until the next item
+    std::string m_text;
+    int m_textLineNo = -1;
+    bool m_inCdata = false;
+
+    int m_depth = 0;
+
+    bool m_suspended = false,
+         m_final = false,
+         m_finished = false;
+
+    wxXmlParseError m_error;
+
+    std::unordered_map<std::string, wxString> m_names;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlReaderImpl);
+};
+
+extern "C" {
+static void ReaderStartElementHnd(void *userData, const char *name,
+                                  const char **atts)
+{
+    static_cast<wxXmlReaderImpl*>(userData)->OnStartElement(name, atts);
+}
+
+static void ReaderEndElementHnd(void *userData, const char* WXUNUSED(name))
+{
+    static_cast<wxXmlReaderImpl*>(userData)->OnEndElement();
+}
+
+static void ReaderTextHnd(void *userData, const char *s, int len)
+{
+    static_cast<wxXmlReaderImpl*>(userData)->OnText(s, len);
+}
+
+static void ReaderStartCdataHnd(void *userData)
+{
+    static_cast<wxXmlReaderImpl*>(userData)->OnStartCdata();
+}
+
+static void ReaderEndCdataHnd(void *userData)
+{
+    static_cast<wxXmlReaderImpl*>(userData)->OnEndCdata();
+}
+
+static void ReaderCommentHnd(void *userData, const char *data)
+{
+    static_cast<wxXmlReaderImpl*>(userData)->OnComment(data);
+}
+
+static void ReaderPIHnd(void *userData, const char *target, const char *data)
+{
+    static_cast<wxXmlReaderImpl*>(userData)->OnPI(target, data);
+}
+} // extern "C"
+
+wxXmlReaderImpl::wxXmlReaderImpl(wxInputStream& stream,
+                                 int flags,
+                                 size_t bufSize)
+    : m_parser(XML_ParserCreate(nullptr)),
+      m_stream(stream),
+      m_bufSize(bufSize),
+      m_keepWhitespace((flags & wxXMLDOC_KEEP_WHITESPACE_NODES) != 0)
+{
+    XML_SetUserData(m_parser, this);
+    XML_SetElementHandler(m_parser, ReaderStartElementHnd, ReaderEndElementHnd);
+    XML_SetCharacterDataHandler(m_parser, ReaderTextHnd);
+    XML_SetCdataSectionHandler(m_parser, ReaderStartCdataHnd, ReaderEndCdataHnd);
+    XML_SetCommentHandler(m_parser, ReaderCommentHnd);
+    XML_SetProcessingInstructionHandler(m_parser, ReaderPIHnd);
+    XML_SetUnknownEncodingHandler(m_parser, UnknownEncodingHnd, nullptr);
+}
+
+wxXmlReaderItem wxXmlReaderImpl::Next()
+{
+    if ( m_itemCurrent + 1 < m_itemCount )
+        return m_items[++m_itemCurrent].kind;
+
+    m_itemCount =
+    m_itemCurrent = 0;
+
+    while ( !m_itemCount )
+    {
+        if ( m_finished || m_state == wxXML_READER_ERROR )
+            return m_state;
+
+        XML_Status status;
+        if ( m_suspended )
+        {
+            m_suspended = false;
+            status = XML_ResumeParser(m_parser);
+        }
+        else
+        {
+            // read the data directly into the parser buffer to avoid copying
+            void* const buf = XML_GetBuffer(m_parser, m_bufSize);
+            size_t len = 0;
+            if ( buf )
+            {
+                len = m_stream.Read(buf, m_bufSize).LastRead();
+                m_final = len < m_bufSize;
+                status = XML_ParseBuffer(m_parser, len, m_final);
+            }
+            else
+            {
+                status = XML_STATUS_ERROR;
+            }
+        }
+
+        switch ( status )
+        {
+            case XML_STATUS_ERROR:
+                m_error.message = XML_ErrorString(XML_GetErrorCode(m_parser));
+                m_error.line = (int)XML_GetCurrentLineNumber(m_parser);
+                m_error.column = (int)XML_GetCurrentColumnNumber(m_parser);
+                m_error.offset = XML_GetCurrentByteIndex(m_parser);
+
+                m_itemCount = 0;
+                m_state = wxXML_READER_ERROR;
+                return m_state;
+
+            case XML_STATUS_SUSPENDED:
+                m_suspended = true;
+                break;
+
+            case XML_STATUS_OK:
+                if ( m_final )
+                    m_finished = true;
+                break;
+        }
+    }
+
+    return m_items[0].kind;
+}
+
+wxXmlReaderImpl::Item& wxXmlReaderImpl::AddItem(wxXmlReaderItem kind)
+{
+    if ( m_itemCount == m_items.size() )
+        m_items.push_back(Item());
+
+    Item& item = m_items[m_itemCount++];
+    item.kind = kind;
+    item.name = nullptr;
+    item.nameOwn.clear();
+    item.text.clear();
+    item.isTextConverted = false;
+    item.attrCount = 0;
+    item.depth = m_depth;
+    item.lineNo = XML_GetCurrentLineNumber(m_parser);
+
+    // return to Next() as soon as possible, this does nothing if the parser
+    // is already suspended
+    XML_StopParser(m_parser, XML_TRUE);
+
+    return item;
+}
+
+void wxXmlReaderImpl::SetName(Item& item, const char *name)
+{
+    const auto it = m_names.find(name);
+    if ( it != m_names.end() )
+    {
+        item.name = &it->second;
+    }
+    else if ( m_names.size() < MAX_CACHED_NAMES )
+    {
+        wxString& cached = m_names[name];
+        cached = wxString::FromUTF8Unchecked(name);
+        item.name = &cached;
+    }
+    else
+    {
+        item.nameOwn = wxString::FromUTF8Unchecked(name);
+    }
+}
+
+void wxXmlReaderImpl::FlushText()
+{
+    if ( m_text.empty() )
+        return;
+
+    if ( m_keepWhitespace || !wxIsWhiteOnlyUTF8(m_text.data(), m_text.length()) )
+    {
+        Item& item = AddItem(wxXML_READER_TEXT);
+        item.text.swap(m_text);
+        item.lineNo = m_textLineNo;
+    }
+
+    m_text.clear();
+}
+
+void wxXmlReaderImpl::OnStartElement(const char *name, const char **atts)
+{
+    FlushText();
+
+    m_depth++;
+
+    Item& item = AddItem(wxXML_READER_START_ELEMENT);
+    SetName(item, name);
+
+    for ( const char **a = atts; *a; a += 2 )
+    {
+        const size_t n = 2*item.attrCount++;
+        if ( item.attrs.size() < n + 2 )
+            item.attrs.resize(n + 2);
+
+        item.attrs[n] = a[0];
+        item.attrs[n + 1] = a[1];
+    }
+}
+
+void wxXmlReaderImpl::OnEndElement()
+{
+    FlushText();
+
+    AddItem(wxXML_READER_END_ELEMENT);
+
+    m_depth--;
+}
+
+void wxXmlReaderImpl::OnText(const char *s, int len)
+{
+    if ( m_text.empty() )
+        m_textLineNo = XML_GetCurrentLineNumber(m_parser);
+
+    m_text.append(s, len);
+}
+
+void wxXmlReaderImpl::OnStartCdata()
+{
+    FlushText();
+
+    m_inCdata = true;
+    m_textLineNo = XML_GetCurrentLineNumber(m_parser);
+}
+
+void wxXmlReaderImpl::OnEndCdata()
+{
+    Item& item = AddItem(wxXML_READER_CDATA);
+    item.text.swap(m_text);
+    item.lineNo = m_textLineNo;
+
+    m_text.clear();
+    m_inCdata = false;
+}
+
+void wxXmlReaderImpl::OnComment(const char *data)
+{
+    FlushText();
+
+    AddItem(wxXML_READER_COMMENT).text = data;
+}
+
+void wxXmlReaderImpl::OnPI(const char *target, const char *data)
+{
+    FlushText();
+
+    Item& item = AddItem(wxXML_READER_PI);
+    SetName(item, target);
+    item.text = data;
+}
+
+
+wxXmlReader::wxXmlReader(wxInputStream& stream, int flags, size_t bufSize)
+    : m_impl(new wxXmlReaderImpl(stream, flags, bufSize))
+{
+}
+
+wxXmlReader::~wxXmlReader()
+{
+    delete m_impl;
+}
+
+wxXmlReaderItem wxXmlReader::Next()
+{
+    return m_impl->Next();
+}
+
+wxXmlReaderItem wxXmlReader::GetItem() const
+{
+    return m_impl->GetItem();
+}
+
+const wxString& wxXmlReader::GetName() const
+{
+    if ( !m_impl->HasCurrent() )
+    {
+        // We need to return a reference to something.
+        static const wxString s_empty;
+        return s_empty;
+    }
+
+    return m_impl->GetCurrent().GetName();
+}
+
+const wxString& wxXmlReader::GetText() const
+{
+    if ( !m_impl->HasCurrent() )
+    {
+        // We need to return a reference to something.
+        static const wxString s_empty;
+        return s_empty;
+    }
+
+    return m_impl->GetCurrent().GetText();
+}
+
+int wxXmlReader::GetDepth() const
+{
+    if ( !m_impl->HasCurrent() )
+        return 0;
+
+    return m_impl->GetCurrent().depth;
+}
+
+int wxXmlReader::GetLineNumber() const
+{
+    if ( !m_impl->HasCurrent() )
+        return -1;
+
+    return m_impl->GetCurrent().lineNo;
+}
+
+size_t wxXmlReader::GetAttributeCount() const
+{
+    if ( GetItem() != wxXML_READER_START_ELEMENT )
+        return 0;
+
+    return m_impl->GetCurrent().attrCount;
+}
+
+wxString wxXmlReader::GetAttributeName(size_t n) const
+{
+    wxCHECK_MSG( n < GetAttributeCount(), wxString(), "invalid index" );
+
+    return wxString::FromUTF8Unchecked(m_impl->GetCurrent().attrs[2*n]);
+}
+
+wxString wxXmlReader::GetAttributeValue(size_t n) const
+{
+    wxCHECK_MSG( n < GetAttributeCount(), wxString(), "invalid index" );
+
+    return wxString::FromUTF8Unchecked(m_impl->GetCurrent().attrs[2*n + 1]);
+}
+
+bool wxXmlReader::GetAttribute(const wxString& attrName, wxString *value) const
+{
+    const size_t count = GetAttributeCount();
+    if ( !count )
+        return false;
+
+    // compare UTF-8 strings to avoid converting all attribute names
+    const wxScopedCharBuffer name = attrName.utf8_str();
+
+    const wxXmlReaderImpl::Item& item = m_impl->GetCurrent();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const std::string& attr = item.attrs[2*n];
+        if ( attr.length() == name.length() &&
+                memcmp(attr.data(), name.data(), name.length()) == 0 )
+        {
+            if ( value )
+                *value = wxString::FromUTF8Unchecked(item.attrs[2*n + 1]);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+wxString wxXmlReader::GetAttribute(const wxString& attrName,
+                                   const wxString& defaultVal) const
+{
+    wxString value;
+    if ( !GetAttribute(attrName, &value) )
+        return defaultVal;
+
+    return value;
+}
+
+bool wxXmlReader::HasAttribute(const wxString& attrName) const
+{
+    return GetAttribute(attrName, nullptr);
+}
+
+wxXmlNode *wxXmlReader::ReadSubtree()
+{
+    wxCHECK_MSG( GetItem() == wxXML_READER_START_ELEMENT, nullptr,
+                 "must be called at the start of an element" );
+
+    const int depth = GetDepth();
+
+    // the last child of each of the currently open elements
+    std::vector<wxXmlNode*> lastChildren;
+
+    wxXmlNode *top = nullptr,
+              *parent = nullptr;
+    for ( ;; )
+    {
+        wxXmlNode *node = nullptr;
+        switch ( GetItem() )
+        {
+            case wxXML_READER_EOF:
+            case wxXML_READER_ERROR:
+                delete top;
+                return nullptr;
+
+            case wxXML_READER_START_ELEMENT:
+                {
+                    node = new wxXmlNode(wxXML_ELEMENT_NODE, GetName(),
+                                         wxString(), GetLineNumber());
+
+                    wxXmlAttribute *last = nullptr;
+                    const size_t count = GetAttributeCount();
+                    for ( size_t n = 0; n < count; n++ )
+                    {
+                        wxXmlAttribute * const
+                            attr = new wxXmlAttribute(GetAttributeName(n),
+                                                      GetAttributeValue(n));
+                        if ( last )
+                            last->SetNext(attr);
+                        else
+                            node->SetAttributes(attr);
+                        last = attr;
+                    }
+                }
+                break;
+
+            case wxXML_READER_END_ELEMENT:
+                if ( GetDepth() == depth )
+                    return top;
+
+                lastChildren.pop_back();
+                parent = parent->GetParent();
+                break;
+
+            case wxXML_READER_TEXT:
+                node = new wxXmlNode(wxXML_TEXT_NODE, wxS("text"), GetText(),
+                                     GetLineNumber());
+                break;
+
+            case wxXML_READER_CDATA:
+                node = new wxXmlNode(wxXML_CDATA_SECTION_NODE, wxS("cdata"),
+                                     GetText(), GetLineNumber());
+                break;
+
+            case wxXML_READER_COMMENT:
+                node = new wxXmlNode(wxXML_COMMENT_NODE, wxS("comment"),
+                                     GetText(), GetLineNumber());
+                break;
+
+            case wxXML_READER_PI:
+                node = new wxXmlNode(wxXML_PI_NODE, GetName(), GetText(),
+                                     GetLineNumber());
+                break;
+        }
+
+        if ( node )
+        {
+            if ( parent )
+            {
+                parent->InsertChildAfter(node, lastChildren.back());
+                lastChildren.back() = node;
+            }
+            else
+            {
+                top = node;
+            }
+
+            if ( node->GetType() == wxXML_ELEMENT_NODE )
+            {
+                parent = node;
+                lastChildren.push_back(nullptr);
+            }
+        }
+
+        Next();
+    }
+}
+
+bool wxXmlReader::SkipSubtree()
+{
+    wxCHECK_MSG( GetItem() == wxXML_READER_START_ELEMENT, false,
+                 "must be called at the start of an element" );
+
+    const int depth = GetDepth();
+    for ( ;; )
+    {
+        switch ( Next() )
+        {
+            case wxXML_READER_EOF:
+            case wxXML_READER_ERROR:
+                return false;
+
+            case wxXML_READER_END_ELEMENT:
+                if ( GetDepth() == depth )
+                    return true;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+const wxXmlParseError& wxXmlReader::GetError() const
+{
+    return m_impl->GetError();
+}
+
+
+
 //-----------------------------------------------------------------------------
 //  wxXmlDocument saving routines
 //-----------------------------------------------------------------------------
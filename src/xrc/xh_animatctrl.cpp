@@ -23,6 +23,9 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxAnimationCtrlXmlHandler, wxXmlResourceHandler);
 
 wxAnimationCtrlXmlHandler::wxAnimationCtrlXmlHandler() : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxAnimationCtrl"));
+    AddHandledClass(wxT("wxGenericAnimationCtrl"));
+
     XRC_ADD_STYLE(wxAC_NO_AUTORESIZE);
     XRC_ADD_STYLE(wxAC_DEFAULT_STYLE);
     AddWindowStyles();
@@ -21,6 +21,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxBannerWindowXmlHandler, wxXmlResourceHandler);
 wxBannerWindowXmlHandler::wxBannerWindowXmlHandler()
     : wxXmlResourceHandler()
 {
+    AddHandledClass(wxS("wxBannerWindow"));
+
     AddWindowStyles();
 }
 
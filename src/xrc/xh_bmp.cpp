@@ -24,6 +24,7 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxBitmapXmlHandler, wxXmlResourceHandler);
 wxBitmapXmlHandler::wxBitmapXmlHandler()
                    :wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxBitmap"));
 }
 
 wxObject *wxBitmapXmlHandler::DoCreateResource()
@@ -41,6 +42,7 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxIconXmlHandler, wxXmlResourceHandler);
 wxIconXmlHandler::wxIconXmlHandler()
 : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxIcon"));
 }
 
 wxObject *wxIconXmlHandler::DoCreateResource()
@@ -42,7 +42,8 @@ int wxBookCtrlXmlHandlerBase::PageWithAttrs::GetImageId() const
 }
 
 wxBookCtrlXmlHandlerBase::wxBookCtrlXmlHandlerBase()
-                        : m_isInside(false)
+                        : m_isInside(false),
+                          m_deferPages(false)
 {
 }
 
@@ -65,6 +66,9 @@ void wxBookCtrlXmlHandlerBase::DoCreatePages(wxBookCtrlBase* book)
     bool old_ins = m_isInside;
     m_isInside = true;
 
+    bool old_defer = m_deferPages;
+    m_deferPages = GetBool(wxT("deferred"));
+
     wxVector<PageWithAttrs> pagesSave;
     m_bookPages.swap(pagesSave);
 
@@ -88,6 +92,7 @@ void wxBookCtrlXmlHandlerBase::DoCreatePages(wxBookCtrlBase* book)
     m_bookImages.swap(imagesSave);
     m_bookPages.swap(pagesSave);
 
+    m_deferPages = old_defer;
     m_isInside = old_ins;
 }
 
@@ -101,9 +106,16 @@ wxBookCtrlXmlHandlerBase::DoCreatePage(wxBookCtrlBase* book)
 
     if (n)
     {
+        // Don't defer creating the contents of the first page, as it's shown
+        // by default, and of the selected one.
+        const bool defer = m_deferPages &&
+                            !m_bookPages.empty() &&
+                                !GetBool(wxT("selected"));
+
         bool old_ins = m_isInside;
         m_isInside = false;
-        wxObject *item = CreateResFromNode(n, book, nullptr);
+        wxObject *item = defer ? CreateResFromNodeWithDeferredChildren(n, book)
+                               : CreateResFromNode(n, book, nullptr);
         m_isInside = old_ins;
         wxWindow *wnd = wxDynamicCast(item, wxWindow);
 
@@ -24,6 +24,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxButtonXmlHandler, wxXmlResourceHandler);
 wxButtonXmlHandler::wxButtonXmlHandler()
 : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxButton"));
+
     XRC_ADD_STYLE(wxBU_LEFT);
     XRC_ADD_STYLE(wxBU_RIGHT);
     XRC_ADD_STYLE(wxBU_TOP);
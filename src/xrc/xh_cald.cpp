@@ -26,6 +26,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxCalendarCtrlXmlHandler, wxXmlResourceHandler);
 wxCalendarCtrlXmlHandler::wxCalendarCtrlXmlHandler()
 : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxCalendarCtrl"));
+
     XRC_ADD_STYLE(wxCAL_SUNDAY_FIRST);
     XRC_ADD_STYLE(wxCAL_MONDAY_FIRST);
     XRC_ADD_STYLE(wxCAL_SHOW_HOLIDAYS);
@@ -20,6 +20,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxColourPickerCtrlXmlHandler, wxXmlResourceHandler);
 
 wxColourPickerCtrlXmlHandler::wxColourPickerCtrlXmlHandler() : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxColourPickerCtrl"));
+
     XRC_ADD_STYLE(wxCLRP_USE_TEXTCTRL);
     XRC_ADD_STYLE(wxCLRP_SHOW_LABEL);
     XRC_ADD_STYLE(wxCLRP_DEFAULT_STYLE);
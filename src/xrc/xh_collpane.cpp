@@ -23,8 +23,11 @@
 wxIMPLEMENT_DYNAMIC_CLASS(wxCollapsiblePaneXmlHandler, wxXmlResourceHandler);
 
 wxCollapsiblePaneXmlHandler::wxCollapsiblePaneXmlHandler()
-: wxXmlResourceHandler(), m_isInside(false)
+: wxXmlResourceHandler(), m_isInside(false), m_deferPane(false)
 {
+    AddHandledClass(wxT("wxCollapsiblePane"));
+    AddHandledClass(wxT("panewindow"));
+
     XRC_ADD_STYLE(wxCP_NO_TLW_RESIZE);
     XRC_ADD_STYLE(wxCP_DEFAULT_STYLE);
     AddWindowStyles();
@@ -41,6 +44,13 @@ wxObject *wxCollapsiblePaneXmlHandler::DoCreateResource()
 
         if (n)
         {
+            // Create the contents only when the pane is expanded if requested.
+            if (m_deferPane && m_collpane->IsCollapsed())
+            {
+                CreateResFromNodeLater(n, m_collpane->GetPane());
+                return nullptr;
+            }
+
             bool old_ins = m_isInside;
             m_isInside = false;
             wxObject *item = CreateResFromNode(n, m_collpane->GetPane(), nullptr);
@@ -80,7 +90,10 @@ wxObject *wxCollapsiblePaneXmlHandler::DoCreateResource()
         m_collpane = ctrl;
         bool old_ins = m_isInside;
         m_isInside = true;
+        bool old_defer = m_deferPane;
+        m_deferPane = GetBool(wxT("deferred"));
         CreateChildren(m_collpane, true/*only this handler*/);
+        m_deferPane = old_defer;
         m_isInside = old_ins;
         m_collpane = old_par;
 
@@ -29,6 +29,8 @@ wxComboBoxXmlHandler::wxComboBoxXmlHandler()
                      :wxXmlResourceHandler()
                      ,m_insideBox(false)
 {
+    AddHandledClass(wxT("wxComboBox"));
+
     XRC_ADD_STYLE(wxCB_SIMPLE);
     XRC_ADD_STYLE(wxCB_SORT);
     XRC_ADD_STYLE(wxCB_READONLY);
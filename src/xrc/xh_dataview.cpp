@@ -21,6 +21,10 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxDataViewXmlHandler, wxXmlResourceHandler);
 wxDataViewXmlHandler::wxDataViewXmlHandler()
     : wxXmlResourceHandler()
 {
+    AddHandledClass("wxDataViewCtrl");
+    AddHandledClass("wxDataViewListCtrl");
+    AddHandledClass("wxDataViewTreeCtrl");
+
     XRC_ADD_STYLE(wxDV_SINGLE);
     XRC_ADD_STYLE(wxDV_MULTIPLE);
     XRC_ADD_STYLE(wxDV_NO_HEADER);
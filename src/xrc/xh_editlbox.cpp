@@ -50,6 +50,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxEditableListBoxXmlHandler, wxXmlResourceHandler);
 
 wxEditableListBoxXmlHandler::wxEditableListBoxXmlHandler()
 {
+    AddHandledClass(EDITLBOX_CLASS_NAME);
+
     m_insideBox = false;
 
     XRC_ADD_STYLE(wxEL_ALLOW_NEW);
@@ -20,6 +20,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxFileCtrlXmlHandler, wxXmlResourceHandler);
 
 wxFileCtrlXmlHandler::wxFileCtrlXmlHandler() : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxFileCtrl"));
+
     XRC_ADD_STYLE(wxFC_DEFAULT_STYLE);
     XRC_ADD_STYLE(wxFC_OPEN);
     XRC_ADD_STYLE(wxFC_SAVE);
@@ -20,6 +20,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxFilePickerCtrlXmlHandler, wxXmlResourceHandler);
 
 wxFilePickerCtrlXmlHandler::wxFilePickerCtrlXmlHandler() : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxFilePickerCtrl"));
+
     XRC_ADD_STYLE(wxFLP_OPEN);
     XRC_ADD_STYLE(wxFLP_SAVE);
     XRC_ADD_STYLE(wxFLP_OVERWRITE_PROMPT);
@@ -26,6 +26,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxGaugeXmlHandler, wxXmlResourceHandler);
 wxGaugeXmlHandler::wxGaugeXmlHandler()
                   :wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxGauge"));
+
     XRC_ADD_STYLE(wxGA_HORIZONTAL);
     XRC_ADD_STYLE(wxGA_VERTICAL);
     XRC_ADD_STYLE(wxGA_SMOOTH);   // windows only
@@ -46,6 +46,9 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxHyperlinkCtrlXmlHandler, wxXmlResourceHandler);
 
 wxHyperlinkCtrlXmlHandler::wxHyperlinkCtrlXmlHandler()
 {
+    AddHandledClass(wxT("wxHyperlinkCtrl"));
+    AddHandledClass(wxT("wxGenericHyperlinkCtrl"));
+
     XRC_ADD_STYLE(wxHL_CONTEXTMENU);
     XRC_ADD_STYLE(wxHL_ALIGN_LEFT);
     XRC_ADD_STYLE(wxHL_ALIGN_RIGHT);
@@ -38,6 +38,10 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxListCtrlXmlHandler, wxXmlResourceHandler);
 wxListCtrlXmlHandler::wxListCtrlXmlHandler()
     : wxXmlResourceHandler()
 {
+    AddHandledClass(LISTCTRL_CLASS_NAME);
+    AddHandledClass(LISTITEM_CLASS_NAME);
+    AddHandledClass(LISTCOL_CLASS_NAME);
+
     // wxListItem styles
     XRC_ADD_STYLE(wxLIST_FORMAT_LEFT);
     XRC_ADD_STYLE(wxLIST_FORMAT_RIGHT);
@@ -26,6 +26,9 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxMdiXmlHandler, wxXmlResourceHandler);
 
 wxMdiXmlHandler::wxMdiXmlHandler() : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxMDIParentFrame"));
+    AddHandledClass(wxT("wxMDIChildFrame"));
+
     XRC_ADD_STYLE(wxSTAY_ON_TOP);
     XRC_ADD_STYLE(wxCAPTION);
     XRC_ADD_STYLE(wxDEFAULT_DIALOG_STYLE);
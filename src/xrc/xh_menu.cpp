@@ -27,6 +27,11 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxMenuXmlHandler, wxXmlResourceHandler);
 wxMenuXmlHandler::wxMenuXmlHandler() :
         wxXmlResourceHandler(), m_insideMenu(false)
 {
+    AddHandledClass(wxT("wxMenu"));
+    AddHandledClass(wxT("wxMenuItem"));
+    AddHandledClass(wxT("break"));
+    AddHandledClass(wxT("separator"));
+
     XRC_ADD_STYLE(wxMENU_TEAROFF);
 }
 
@@ -186,6 +191,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxMenuBarXmlHandler, wxXmlResourceHandler);
 
 wxMenuBarXmlHandler::wxMenuBarXmlHandler() : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxMenuBar"));
+
     XRC_ADD_STYLE(wxMB_DOCKABLE);
 }
 
@@ -26,6 +26,9 @@ IMPLEMENT_DYNAMIC_CLASS(wxPropertyGridXmlHandler, wxXmlResourceHandler)
 wxPropertyGridXmlHandler::wxPropertyGridXmlHandler()
                      :wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxPropertyGrid"));
+    AddHandledClass(wxT("wxPropertyGridManager"));
+
     XRC_ADD_STYLE(wxTAB_TRAVERSAL);
     XRC_ADD_STYLE(wxPG_AUTO_SORT);
     XRC_ADD_STYLE(wxPG_HIDE_CATEGORIES);
@@ -24,6 +24,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxRadioButtonXmlHandler, wxXmlResourceHandler);
 wxRadioButtonXmlHandler::wxRadioButtonXmlHandler()
 : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxRadioButton"));
+
     XRC_ADD_STYLE(wxRB_GROUP);
     XRC_ADD_STYLE(wxRB_SINGLE);
     AddWindowStyles();
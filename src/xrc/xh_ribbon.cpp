@@ -42,6 +42,17 @@ wxRibbonXmlHandler::wxRibbonXmlHandler()
     : wxXmlResourceHandler(),
       m_isInside(nullptr)
 {
+    AddHandledClass(wxT("wxRibbonBar"));
+    AddHandledClass(wxT("wxRibbonButtonBar"));
+    AddHandledClass(wxT("wxRibbonPage"));
+    AddHandledClass(wxT("wxRibbonPanel"));
+    AddHandledClass(wxT("wxRibbonGallery"));
+    AddHandledClass(wxT("wxRibbonControl"));
+    AddHandledClass(wxT("button"));
+    AddHandledClass(wxT("page"));
+    AddHandledClass(wxT("panel"));
+    AddHandledClass(wxT("item"));
+
     XRC_ADD_STYLE(wxRIBBON_BAR_SHOW_PAGE_LABELS);
     XRC_ADD_STYLE(wxRIBBON_BAR_SHOW_PAGE_ICONS);
     XRC_ADD_STYLE(wxRIBBON_BAR_FLOW_HORIZONTAL);
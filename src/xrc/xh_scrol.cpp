@@ -24,6 +24,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxScrollBarXmlHandler, wxXmlResourceHandler);
 wxScrollBarXmlHandler::wxScrollBarXmlHandler()
 : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxScrollBar"));
+
     XRC_ADD_STYLE(wxSB_HORIZONTAL);
     XRC_ADD_STYLE(wxSB_VERTICAL);
     AddWindowStyles();
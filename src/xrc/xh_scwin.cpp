@@ -25,6 +25,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxScrolledWindowXmlHandler, wxXmlResourceHandler);
 wxScrolledWindowXmlHandler::wxScrolledWindowXmlHandler()
 : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxScrolledWindow"));
+
     XRC_ADD_STYLE(wxHSCROLL);
     XRC_ADD_STYLE(wxVSCROLL);
 
@@ -25,8 +25,12 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxSimplebookXmlHandler, wxXmlResourceHandler);
 wxSimplebookXmlHandler::wxSimplebookXmlHandler()
                       : wxXmlResourceHandler(),
                         m_isInside(false),
+                        m_deferPages(false),
                         m_simplebook(nullptr)
 {
+    AddHandledClass(wxS("wxSimplebook"));
+    AddHandledClass(wxS("simplebookpage"));
+
     AddWindowStyles();
 }
 
@@ -41,9 +45,17 @@ wxObject *wxSimplebookXmlHandler::DoCreateResource()
 
         if (n)
         {
+            // Don't defer creating the contents of the first page, as it's
+            // shown by default, and of the selected one.
+            const bool defer = m_deferPages &&
+                                m_simplebook->GetPageCount() &&
+                                    !GetBool(wxS("selected"));
+
             bool old_ins = m_isInside;
             m_isInside = false;
-            wxObject *item = CreateResFromNode(n, m_simplebook, nullptr);
+            wxObject *item = defer
+                ? CreateResFromNodeWithDeferredChildren(n, m_simplebook)
+                : CreateResFromNode(n, m_simplebook, nullptr);
             m_isInside = old_ins;
             wxWindow *wnd = wxDynamicCast(item, wxWindow);
 
@@ -81,7 +93,10 @@ wxObject *wxSimplebookXmlHandler::DoCreateResource()
         m_simplebook = sb;
         bool old_ins = m_isInside;
         m_isInside = true;
+        bool old_defer = m_deferPages;
+        m_deferPages = GetBool(wxS("deferred"));
         CreateChildren(m_simplebook, true/*only this handler*/);
+        m_deferPages = old_defer;
         m_isInside = old_ins;
         m_simplebook = old_par;
 
@@ -45,6 +45,15 @@ wxSizerXmlHandler::wxSizerXmlHandler()
                    m_isGBS(false),
                    m_parentSizer(nullptr)
 {
+    AddHandledClass(wxT("wxBoxSizer"));
+    AddHandledClass(wxT("wxStaticBoxSizer"));
+    AddHandledClass(wxT("wxGridSizer"));
+    AddHandledClass(wxT("wxFlexGridSizer"));
+    AddHandledClass(wxT("wxGridBagSizer"));
+    AddHandledClass(wxT("wxWrapSizer"));
+    AddHandledClass(wxT("sizeritem"));
+    AddHandledClass(wxT("spacer"));
+
     XRC_ADD_STYLE(wxHORIZONTAL);
     XRC_ADD_STYLE(wxVERTICAL);
 
@@ -954,6 +963,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxStdDialogButtonSizerXmlHandler, wxXmlResourceHandler
 wxStdDialogButtonSizerXmlHandler::wxStdDialogButtonSizerXmlHandler()
     : m_isInside(false), m_parentSizer(nullptr)
 {
+    AddHandledClass(wxT("wxStdDialogButtonSizer"));
+    AddHandledClass(wxT("button"));
 }
 
 wxObject *wxStdDialogButtonSizerXmlHandler::DoCreateResource()
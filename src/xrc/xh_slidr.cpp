@@ -29,6 +29,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxSliderXmlHandler, wxXmlResourceHandler);
 wxSliderXmlHandler::wxSliderXmlHandler()
                    :wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxSlider"));
+
     XRC_ADD_STYLE(wxSL_HORIZONTAL);
     XRC_ADD_STYLE(wxSL_VERTICAL);
     XRC_ADD_STYLE(wxSL_AUTOTICKS);
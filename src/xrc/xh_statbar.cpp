@@ -27,6 +27,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxStatusBarXmlHandler, wxXmlResourceHandler);
 wxStatusBarXmlHandler::wxStatusBarXmlHandler()
                       :wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxStatusBar"));
+
     XRC_ADD_STYLE(wxSTB_SIZEGRIP);
     XRC_ADD_STYLE(wxSTB_SHOW_TIPS);
     XRC_ADD_STYLE(wxSTB_ELLIPSIZE_START);
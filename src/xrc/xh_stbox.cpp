@@ -24,6 +24,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxStaticBoxXmlHandler, wxXmlResourceHandler);
 wxStaticBoxXmlHandler::wxStaticBoxXmlHandler()
                       :wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxStaticBox"));
+
     AddWindowStyles();
 }
 
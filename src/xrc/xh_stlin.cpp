@@ -21,6 +21,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxStaticLineXmlHandler, wxXmlResourceHandler);
 wxStaticLineXmlHandler::wxStaticLineXmlHandler()
 : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxStaticLine"));
+
     XRC_ADD_STYLE(wxLI_HORIZONTAL);
     XRC_ADD_STYLE(wxLI_VERTICAL);
     AddWindowStyles();
@@ -20,6 +20,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxTimeCtrlXmlHandler, wxXmlResourceHandler);
 
 wxTimeCtrlXmlHandler::wxTimeCtrlXmlHandler()
 {
+    AddHandledClass(wxS("wxTimePickerCtrl"));
+
     XRC_ADD_STYLE(wxTP_DEFAULT);
     AddWindowStyles();
 }
@@ -30,6 +30,9 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxToolbookXmlHandler, wxXmlResourceHandler);
 wxToolbookXmlHandler::wxToolbookXmlHandler()
                     : m_toolbook(nullptr)
 {
+    AddHandledClass(wxT("wxToolbook"));
+    AddHandledClass(wxT("toolbookpage"));
+
     XRC_ADD_STYLE(wxBK_DEFAULT);
     XRC_ADD_STYLE(wxBK_TOP);
     XRC_ADD_STYLE(wxBK_BOTTOM);
@@ -21,6 +21,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxTreeCtrlXmlHandler, wxXmlResourceHandler);
 wxTreeCtrlXmlHandler::wxTreeCtrlXmlHandler()
 : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxTreeCtrl"));
+
     XRC_ADD_STYLE(wxTR_EDIT_LABELS);
     XRC_ADD_STYLE(wxTR_NO_BUTTONS);
     XRC_ADD_STYLE(wxTR_HAS_BUTTONS);
@@ -29,6 +29,9 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxTreebookXmlHandler, wxXmlResourceHandler);
 wxTreebookXmlHandler::wxTreebookXmlHandler()
                     : m_tbk(nullptr)
 {
+    AddHandledClass(wxT("wxTreebook"));
+    AddHandledClass(wxT("treebookpage"));
+
     XRC_ADD_STYLE(wxBK_DEFAULT);
     XRC_ADD_STYLE(wxBK_TOP);
     XRC_ADD_STYLE(wxBK_BOTTOM);
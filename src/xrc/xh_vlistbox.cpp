@@ -21,6 +21,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxVListBoxXmlHandler, wxXmlResourceHandler);
 
 wxVListBoxXmlHandler::wxVListBoxXmlHandler() : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxVListBox"));
+
     // panel styles
     XRC_ADD_STYLE(wxTAB_TRAVERSAL);
 
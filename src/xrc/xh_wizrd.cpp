@@ -25,6 +25,10 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxWizardXmlHandler, wxXmlResourceHandler);
 
 wxWizardXmlHandler::wxWizardXmlHandler() : wxXmlResourceHandler()
 {
+    AddHandledClass(wxT("wxWizard"));
+    AddHandledClass(wxT("wxWizardPage"));
+    AddHandledClass(wxT("wxWizardPageSimple"));
+
     m_wizard = nullptr;
     m_lastSimplePage = nullptr;
 
@@ -42,10 +42,20 @@
 #include "wx/config.h"
 #include "wx/platinfo.h"
 
+#include "wx/xrc/private/xmlresbin.h"
+
+#if wxUSE_NOTEBOOK
+    #include "wx/notebook.h"
+#endif
+#if wxUSE_COLLPANE
+    #include "wx/collpane.h"
+#endif
+
 #include <limits.h>
 #include <locale.h>
 
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -90,6 +100,102 @@ enum
 
 } // namespace // XRCWhence
 
+// Contents of a compiled binary XRC file, see wx/xrc/private/xmlresbin.h.
+//
+// The nodes of the top-level resources are only created when they're needed,
+// so loading a big file containing many of them is cheap.
+class wxXmlResourceBinary
+{
+public:
+    wxXmlResourceBinary() = default;
+
+    // Check that the data is valid and index it, returns false if it isn't.
+    bool Init(const wxMemoryBuffer& data);
+
+    // Create the document containing the root node and all the top-level
+    // nodes which must be created immediately or, if all is true, all of them,
+    // skipping the inactive ones.
+    wxXmlDocument *CreateDocument(bool all,
+                                  const std::unordered_set<wxString>& features);
+
+    // Return the indices of the top-level entries with the given name or of
+    // the entries containing a nested object with this name, or null if none.
+    const std::vector<size_t> *FindEntries(const wxString& name) const
+    {
+        return DoFind(m_index, name);
+    }
+
+    const std::vector<size_t> *FindNestedEntries(const wxString& name) const
+    {
+        return DoFind(m_nestedIndex, name);
+    }
+
+    // Return true if the node of this entry was already created, in which
+    // case it can be retrieved using GetNode(), possibly returning null if it
+    // was inactive.
+    bool IsCreated(size_t entry) const { return m_entries[entry].created; }
+    wxXmlNode *GetNode(size_t entry) const { return m_entries[entry].node; }
+
+    // Create the node of the entry which must not have been created yet and
+    // remember it. Returns null if the data is invalid.
+    wxXmlNode *CreateNode(size_t entry);
+
+    // Must be called if the node of the entry is deleted.
+    void ResetNode(size_t entry) { m_entries[entry].node = nullptr; }
+
+private:
+    struct Entry
+    {
+        wxUint32 name = 0,
+                 flags = 0,
+                 offset = 0;
+
+        wxXmlNode *node = nullptr;
+        bool created = false;
+    };
+
+    using Index = std::unordered_map<wxString, std::vector<size_t>>;
+
+    static const std::vector<size_t> *DoFind(const Index& index,
+                                             const wxString& name)
+    {
+        const Index::const_iterator it = index.find(name);
+        return it == index.end() ? nullptr : &it->second;
+    }
+
+    // Read the next integer from the data, advancing the pointer, returns
+    // false if there is not enough data left.
+    static bool Read(const char*& p, const char* end, wxUint32& n);
+
+    // Create the node stored at the given position and all of its children.
+    wxXmlNode *DoCreateNode(const char*& p, const char* end, int depth);
+
+    // Return the string with the given index or null if it is invalid.
+    const wxString *GetString(wxUint32 n);
+
+    wxMemoryBuffer m_data;
+
+    // The string offsets and data.
+    const char *m_stringsOffsets = nullptr;
+    const char *m_stringsData = nullptr;
+    wxUint32 m_stringsCount = 0;
+
+    // The strings are converted from UTF-8 only once, when they're used.
+    std::vector<wxString> m_strings;
+    std::vector<bool> m_stringsConverted;
+
+    // The data of all nodes.
+    const char *m_nodes = nullptr;
+    const char *m_nodesEnd = nullptr;
+
+    std::vector<Entry> m_entries;
+
+    Index m_index,
+          m_nestedIndex;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlResourceBinary);
+};
+
 class wxXmlResourceDataRecord
 {
 public:
@@ -126,11 +232,44 @@ public:
 
     ~wxXmlResourceDataRecord() = default;
 
+    // Replace the document and the compiled data, if any, used by this
+    // record. Takes ownership of both pointers.
+    void Reset(wxXmlDocument *doc, wxXmlResourceBinary *binary)
+    {
+        Doc.reset(doc);
+        Binary.reset(binary);
+
+        m_index.clear();
+        m_indexed = false;
+    }
+
+    // Return all top-level object nodes with the given name, in the document
+    // order.
+    std::vector<wxXmlNode*>
+    FindTopLevel(const wxString& name,
+                 const std::unordered_set<wxString>& features);
+
+    // Ensure that all the nodes containing the nested objects with the given
+    // name exist in the document.
+    void CreateNested(const wxString& name,
+                      const std::unordered_set<wxString>& features);
+
     wxString File;
     std::unique_ptr<wxXmlDocument> Doc;
+    std::unique_ptr<wxXmlResourceBinary> Binary;
 #if wxUSE_DATETIME
     wxDateTime Time;
 #endif
+
+private:
+    // Return the node for the given entry of Binary, creating it if necessary.
+    wxXmlNode *GetBinaryNode(size_t entry,
+                             const std::unordered_set<wxString>& features);
+
+    // Index of the top-level objects of Doc by name, only used if there is no
+    // Binary and created on demand.
+    std::unordered_map<wxString, std::vector<wxXmlNode*>> m_index;
+    bool m_indexed = false;
 };
 
 class wxXmlResourceDataRecords : public std::vector<wxXmlResourceDataRecord>
@@ -138,18 +277,137 @@ class wxXmlResourceDataRecords : public std::vector<wxXmlResourceDataRecord>
     // this is a class so that it can be forward-declared
 };
 
+// Creates the contents of the windows whose creation was deferred when they
+// are shown for the first time.
+class wxXmlResourceDeferred : public wxEvtHandler
+{
+public:
+    explicit wxXmlResourceDeferred(wxXmlResource *resource)
+        : m_resource(resource)
+    {
+    }
+
+    // Remember to create the object described by the node, which is copied,
+    // as a child of the given window later.
+    void Add(wxWindow *parent, const wxXmlNode& node, const wxString& file);
+
+    // Create the deferred contents of the given window and, if recursive is
+    // true, of all its children, return true if anything was created.
+    bool Create(wxWindow *window, bool recursive);
+
+private:
+    struct Contents
+    {
+        // The file the nodes come from, for resolving the relative paths.
+        wxString file;
+
+        // Copies of the nodes to create.
+        std::vector<std::unique_ptr<wxXmlNode>> nodes;
+    };
+
+    void OnShow(wxShowEvent& event);
+    void OnDestroy(wxWindowDestroyEvent& event);
+#if wxUSE_NOTEBOOK
+    void OnNotebookPageChanged(wxBookCtrlEvent& event);
+#endif
+#if wxUSE_COLLPANE
+    void OnCollapsiblePaneChanged(wxCollapsiblePaneEvent& event);
+#endif
+
+    wxXmlResource* const m_resource;
+
+    std::unordered_map<wxWindow*, Contents> m_contents;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlResourceDeferred);
+};
+
 class wxXmlResourceInternal
 {
 public:
+    // Return the handlers that may be able to handle the objects of the given
+    // class, in the order in which they should be tried.
+    const std::vector<wxXmlResourceHandler*>&
+    GetHandlersForClass(const wxString& classname);
+
+    // Must be called whenever m_handlers changes.
+    void ResetHandlersIndex()
+    {
+        m_handlersByClass.clear();
+        m_handlersForAnyClass.clear();
+        m_handlersIndexed = false;
+    }
+
     std::vector<std::unique_ptr<wxXmlResourceHandler>> m_handlers;
     wxXmlResourceDataRecords m_data;
 
     // Enabled features.
     std::unordered_set<wxString> m_features;
 
+    // Node whose children creation should be deferred when the handler
+    // creating it calls CreateChildren(), if any.
+    wxXmlNode *m_deferChildrenOf = nullptr;
+
+    // Deferred contents of the windows, created on demand.
+    std::unique_ptr<wxXmlResourceDeferred> m_deferred;
+
     static std::vector<std::unique_ptr<wxXmlSubclassFactory>> ms_subclassFactories;
+
+private:
+    // Index of m_handlers by the classes they declared as handled, with each
+    // vector also containing the handlers which didn't declare any classes
+    // and so can handle anything, in the same order as in m_handlers.
+    std::unordered_map<wxString, std::vector<wxXmlResourceHandler*>> m_handlersByClass;
+
+    // Handlers which didn't declare their classes, used for the classes not
+    // present in m_handlersByClass.
+    std::vector<wxXmlResourceHandler*> m_handlersForAnyClass;
+
+    bool m_handlersIndexed = false;
 };
 
+const std::vector<wxXmlResourceHandler*>&
+wxXmlResourceInternal::GetHandlersForClass(const wxString& classname)
+{
+    if ( !m_handlersIndexed )
+    {
+        for ( const auto& handler : m_handlers )
+        {
+            const wxArrayString& classes = handler->GetHandledClasses();
+            if ( classes.empty() )
+            {
+                for ( auto& kv : m_handlersByClass )
+                    kv.second.push_back(handler.get());
+
+                m_handlersForAnyClass.push_back(handler.get());
+                continue;
+            }
+
+            for ( const wxString& cls : classes )
+            {
+                auto it = m_handlersByClass.find(cls);
+                if ( it == m_handlersByClass.end() )
+                {
+                    it = m_handlersByClass.emplace(cls,
+                                                   m_handlersForAnyClass).first;
+                }
+                else if ( !it->second.empty() &&
+                            it->second.back() == handler.get() )
+                {
+                    // Class specified more than once by the same handler.
+                    continue;
+                }
+
+                it->second.push_back(handler.get());
+            }
+        }
+
+        m_handlersIndexed = true;
+    }
+
+    const auto it = m_handlersByClass.find(classname);
+    return it != m_handlersByClass.end() ? it->second : m_handlersForAnyClass;
+}
+
 class wxIdRange // Holds data for a particular rangename
 {
 public:
@@ -267,6 +525,176 @@ GetFileNameFromNode(const wxXmlNode *node, const wxXmlResourceDataRecords& files
 
 } // anonymous namespace
 
+// ----------------------------------------------------------------------------
+// wxXmlResourceDeferred
+// ----------------------------------------------------------------------------
+
+void
+wxXmlResourceDeferred::Add(wxWindow *parent,
+                           const wxXmlNode& node,
+                           const wxString& file)
+{
+    Contents& contents = m_contents[parent];
+    if ( contents.nodes.empty() )
+    {
+        contents.file = file;
+
+        parent->Bind(wxEVT_SHOW, &wxXmlResourceDeferred::OnShow, this);
+        parent->Bind(wxEVT_DESTROY, &wxXmlResourceDeferred::OnDestroy, this);
+
+        // Native notebook pages and collapsible pane contents may become
+        // visible without being shown, and so without getting wxEVT_SHOW,
+        // so also use their own events for them. Unbind the handlers first
+        // to avoid connecting them more than once for the same control.
+        wxWindow* const grandparent = parent->GetParent();
+#if wxUSE_NOTEBOOK
+        if ( wxDynamicCast(grandparent, wxNotebook) )
+        {
+            grandparent->Unbind(wxEVT_NOTEBOOK_PAGE_CHANGED,
+                                &wxXmlResourceDeferred::OnNotebookPageChanged,
+                                this);
+            grandparent->Bind(wxEVT_NOTEBOOK_PAGE_CHANGED,
+                              &wxXmlResourceDeferred::OnNotebookPageChanged,
+                              this);
+        }
+#endif // wxUSE_NOTEBOOK
+#if wxUSE_COLLPANE
+        wxCollapsiblePane* const
+            collpane = wxDynamicCast(grandparent, wxCollapsiblePane);
+        if ( collpane && collpane->GetPane() == parent )
+        {
+            collpane->Unbind(wxEVT_COLLAPSIBLEPANE_CHANGED,
+                             &wxXmlResourceDeferred::OnCollapsiblePaneChanged,
+                             this);
+            collpane->Bind(wxEVT_COLLAPSIBLEPANE_CHANGED,
+                           &wxXmlResourceDeferred::OnCollapsiblePaneChanged,
+                           this);
+        }
+#endif // wxUSE_COLLPANE
+    }
+
+    std::unique_ptr<wxXmlNode> copy(new wxXmlNode(node));
+
+    // The copy is not part of any document, so remember its file, see
+    // GetFileNameFromNode().
+    if ( !copy->HasAttribute(ATTR_INPUT_FILENAME) )
+        copy->AddAttribute(ATTR_INPUT_FILENAME, file);
+
+    contents.nodes.push_back(std::move(copy));
+}
+
+bool wxXmlResourceDeferred::Create(wxWindow *window, bool recursive)
+{
+    bool created = false;
+    for ( ;; )
+    {
+        auto it = m_contents.find(window);
+        if ( it == m_contents.end() && recursive )
+        {
+            for ( it = m_contents.begin(); it != m_contents.end(); ++it )
+            {
+                wxWindow* w;
+                for ( w = it->first; w && w != window; w = w->GetParent() )
+                {
+                    if ( w->IsTopLevel() )
+                    {
+                        w = nullptr;
+                        break;
+                    }
+                }
+
+                if ( w )
+                    break;
+            }
+        }
+
+        if ( it == m_contents.end() )
+            break;
+
+        wxWindow* const parent = it->first;
+        const Contents contents = std::move(it->second);
+        m_contents.erase(it);
+
+        parent->Unbind(wxEVT_SHOW, &wxXmlResourceDeferred::OnShow, this);
+        parent->Unbind(wxEVT_DESTROY, &wxXmlResourceDeferred::OnDestroy, this);
+
+#if wxUSE_FILESYSTEM
+        // Ensure that relative paths work, as FindResource() does.
+        m_resource->m_curFileSystem.ChangePathTo(contents.file);
+#endif
+
+        for ( const auto& node : contents.nodes )
+            m_resource->DoCreateResFromNode(*node, parent, nullptr);
+
+        // The window was already laid out before its contents was created.
+        parent->Layout();
+
+        created = true;
+
+        // The contents of the window itself can't be deferred again, so
+        // there is nothing more to do for it if we're not recursive.
+        if ( !recursive )
+            break;
+    }
+
+    return created;
+}
+
+void wxXmlResourceDeferred::OnShow(wxShowEvent& event)
+{
+    event.Skip();
+
+    if ( event.IsShown() )
+        Create(static_cast<wxWindow*>(event.GetEventObject()), false);
+}
+
+void wxXmlResourceDeferred::OnDestroy(wxWindowDestroyEvent& event)
+{
+    event.Skip();
+
+    // Notice that this event propagates upwards, so we can get it for the
+    // children of our windows too, but as they can have deferred contents
+    // too, we still need to forget about them if they do.
+    m_contents.erase(event.GetWindow());
+}
+
+#if wxUSE_NOTEBOOK
+
+void wxXmlResourceDeferred::OnNotebookPageChanged(wxBookCtrlEvent& event)
+{
+    event.Skip();
+
+    wxNotebook* const notebook = wxDynamicCast(event.GetEventObject(), wxNotebook);
+    const int sel = event.GetSelection();
+    if ( notebook && sel != wxNOT_FOUND )
+        Create(notebook->GetPage(sel), false);
+}
+
+#endif // wxUSE_NOTEBOOK
+
+#if wxUSE_COLLPANE
+
+void wxXmlResourceDeferred::OnCollapsiblePaneChanged(wxCollapsiblePaneEvent& event)
+{
+    event.Skip();
+
+    wxCollapsiblePane* const
+        collpane = wxDynamicCast(event.GetEventObject(), wxCollapsiblePane);
+    if ( !collpane || collpane->IsCollapsed() )
+        return;
+
+    if ( Create(collpane->GetPane(), false) )
+    {
+        // The control size was computed before its contents was created, so
+        // expand it again to update it and, possibly, the parent size, as
+        // doing it doesn't generate any events.
+        collpane->Collapse();
+        collpane->Expand();
+    }
+}
+
+#endif // wxUSE_COLLPANE
+
 
 wxXmlResource *wxXmlResource::ms_instance = nullptr;
 
@@ -425,11 +853,17 @@ bool wxXmlResource::Load(const wxString& filemask_)
         else // a single resource URL
 #endif // wxUSE_FILESYSTEM
         {
-            wxXmlDocument * const doc = DoLoadFile(fnd);
+            wxXmlResourceBinary *binary = nullptr;
+            wxXmlDocument * const doc = DoLoadFileOrBinary(fnd, &binary);
             if ( !doc )
+            {
                 thisOK = false;
+            }
             else
+            {
                 Data().emplace_back(fnd, doc);
+                Data().back().Binary.reset(binary);
+            }
         }
 
         if ( thisOK )
@@ -493,11 +927,20 @@ bool wxXmlResource::Unload(const wxString& filename)
 }
 
 
+bool wxXmlResource::CreateDeferredContents(wxWindow *window)
+{
+    wxCHECK_MSG( window, false, "window must be valid" );
+
+    return m_internal->m_deferred &&
+            m_internal->m_deferred->Create(window, true);
+}
+
 void wxXmlResource::AddHandler(wxXmlResourceHandler *handler)
 {
     wxXmlResourceHandlerImpl *impl = new wxXmlResourceHandlerImpl(handler);
     handler->SetImpl(impl);
     m_internal->m_handlers.push_back(std::unique_ptr<wxXmlResourceHandler>{handler});
+    m_internal->ResetHandlersIndex();
     handler->SetParentResource(this);
 }
 
@@ -506,6 +949,7 @@ void wxXmlResource::InsertHandler(wxXmlResourceHandler *handler)
     wxXmlResourceHandlerImpl *impl = new wxXmlResourceHandlerImpl(handler);
     handler->SetImpl(impl);
     m_internal->m_handlers.insert(m_internal->m_handlers.begin(), std::unique_ptr<wxXmlResourceHandler>{handler});
+    m_internal->ResetHandlersIndex();
     handler->SetParentResource(this);
 }
 
@@ -514,6 +958,7 @@ void wxXmlResource::InsertHandler(wxXmlResourceHandler *handler)
 void wxXmlResource::ClearHandlers()
 {
     m_internal->m_handlers.clear();
+    m_internal->ResetHandlersIndex();
 }
 
 
@@ -646,37 +1091,46 @@ static bool HasAnyMatchingTokens(const wxString& s, const Pred& pred)
     return false;
 }
 
-// This function removes the nodes of the XRC document that are "inactive",
-// i.e. shouldn't be taken into account at all, e.g. because they use a
-// "platform" attribute not matching the current platform.
-static void
-FilterOurInactiveNodes(wxXmlNode *node,
-                       const std::unordered_set<wxString>& features)
+// This function returns false if the node is "inactive", i.e. shouldn't be
+// taken into account at all, e.g. because it uses a "platform" attribute not
+// matching the current platform.
+static bool
+IsActiveNode(const wxXmlNode *node,
+             const std::unordered_set<wxString>& features)
 {
     static const wxString wxXRC_PLATFORM_ATTRIBUTE(wxS("platform"));
     static const wxString wxXRC_FEATURE_ATTRIBUTE(wxS("feature"));
 
     wxString s;
 
-    wxXmlNode *c = node->GetChildren();
-    while (c)
+    if (node->GetAttribute(wxXRC_PLATFORM_ATTRIBUTE, &s))
     {
-        bool isok = true;
-        if (c->GetAttribute(wxXRC_PLATFORM_ATTRIBUTE, &s))
-        {
-            isok = HasAnyMatchingTokens(s, [](const wxString& s)
-                        { return wxPlatformId::MatchesCurrent(s); }
-                    );
-        }
+        if ( !HasAnyMatchingTokens(s, [](const wxString& s)
+                    { return wxPlatformId::MatchesCurrent(s); }
+                ) )
+            return false;
+    }
 
-        if (isok && c->GetAttribute(wxXRC_FEATURE_ATTRIBUTE, &s))
-        {
-            isok = HasAnyMatchingTokens(s, [&](const wxString& s)
-                        { return features.count(s); }
-                    );
-        }
+    if (node->GetAttribute(wxXRC_FEATURE_ATTRIBUTE, &s))
+    {
+        if ( !HasAnyMatchingTokens(s, [&](const wxString& s)
+                    { return features.count(s); }
+                ) )
+            return false;
+    }
 
-        if (isok)
+    return true;
+}
+
+// This function removes the inactive nodes of the XRC document.
+static void
+FilterOurInactiveNodes(wxXmlNode *node,
+                       const std::unordered_set<wxString>& features)
+{
+    wxXmlNode *c = node->GetChildren();
+    while (c)
+    {
+        if (IsActiveNode(c, features))
         {
             FilterOurInactiveNodes(c, features);
             c = c->GetNext();
@@ -691,6 +1145,92 @@ FilterOurInactiveNodes(wxXmlNode *node,
     }
 }
 
+std::vector<wxXmlNode*>
+wxXmlResourceDataRecord::FindTopLevel(const wxString& name,
+                                      const std::unordered_set<wxString>& features)
+{
+    std::vector<wxXmlNode*> nodes;
+
+    if ( Binary )
+    {
+        const std::vector<size_t> * const entries = Binary->FindEntries(name);
+        if ( entries )
+        {
+            for ( size_t entry : *entries )
+            {
+                wxXmlNode * const node = GetBinaryNode(entry, features);
+                if ( node )
+                    nodes.push_back(node);
+            }
+        }
+
+        return nodes;
+    }
+
+    if ( !m_indexed )
+    {
+        for ( wxXmlNode *node = Doc->GetRoot()->GetChildren();
+              node;
+              node = node->GetNext() )
+        {
+            wxString nodeName;
+            if ( IsObjectNode(node) &&
+                    node->GetAttribute(wxS("name"), &nodeName) )
+                m_index[nodeName].push_back(node);
+        }
+
+        m_indexed = true;
+    }
+
+    const auto it = m_index.find(name);
+    if ( it != m_index.end() )
+        nodes = it->second;
+
+    return nodes;
+}
+
+void
+wxXmlResourceDataRecord::CreateNested(const wxString& name,
+                                      const std::unordered_set<wxString>& features)
+{
+    if ( !Binary )
+        return;
+
+    const std::vector<size_t> * const entries = Binary->FindNestedEntries(name);
+    if ( entries )
+    {
+        for ( size_t entry : *entries )
+            GetBinaryNode(entry, features);
+    }
+}
+
+wxXmlNode *
+wxXmlResourceDataRecord::GetBinaryNode(size_t entry,
+                                       const std::unordered_set<wxString>& features)
+{
+    if ( Binary->IsCreated(entry) )
+        return Binary->GetNode(entry);
+
+    wxXmlNode * const node = Binary->CreateNode(entry);
+    if ( !node )
+        return nullptr;
+
+    // Do the same thing as DoLoadDocument() does for the entire document when
+    // it's loaded.
+    if ( !IsActiveNode(node, features) )
+    {
+        delete node;
+        Binary->ResetNode(entry);
+        return nullptr;
+    }
+
+    FilterOurInactiveNodes(node, features);
+
+    Doc->GetRoot()->AddChild(node);
+
+    return node;
+}
+
 static void PreprocessForIdRanges(wxXmlNode *rootnode)
 {
     // First go through the top level, looking for the names of ID ranges
@@ -752,7 +1292,8 @@ bool wxXmlResource::UpdateResources()
             continue;
         }
 
-        wxXmlDocument * const doc = DoLoadFile(rec.File);
+        wxXmlResourceBinary *binary = nullptr;
+        wxXmlDocument * const doc = DoLoadFileOrBinary(rec.File, &binary);
         if ( !doc )
         {
             // Notice that we keep the old XML document: it seems better to
@@ -763,7 +1304,7 @@ bool wxXmlResource::UpdateResources()
         }
 
         // Replace the old resource contents with the new one.
-        rec.Doc.reset(doc);
+        rec.Reset(doc, binary);
 
         // And, now that we loaded it successfully, update the last load time.
 #if wxUSE_DATETIME
@@ -774,7 +1315,279 @@ bool wxXmlResource::UpdateResources()
     return rt;
 }
 
+// ----------------------------------------------------------------------------
+// wxXmlResourceBinary
+// ----------------------------------------------------------------------------
+
+/* static */
+bool wxXmlResourceBinary::Read(const char*& p, const char* end, wxUint32& n)
+{
+    if ( end - p < 4 )
+        return false;
+
+    memcpy(&n, p, 4);
+    n = wxUINT32_SWAP_ON_BE(n);
+    p += 4;
+
+    return true;
+}
+
+bool wxXmlResourceBinary::Init(const wxMemoryBuffer& data)
+{
+    using namespace wxXRCBinary;
+
+    m_data = data;
+
+    const char *p = static_cast<const char*>(m_data.GetData());
+    const char * const end = p + m_data.GetDataLen();
+
+    if ( static_cast<size_t>(end - p) < MAGIC_LEN ||
+            memcmp(p, MAGIC, MAGIC_LEN) != 0 )
+        return false;
+    p += MAGIC_LEN;
+
+    wxUint32 version, entriesCount, nestedCount, nodesSize;
+    if ( !Read(p, end, version) || version != VERSION ||
+            !Read(p, end, m_stringsCount) ||
+                !Read(p, end, entriesCount) ||
+                    !Read(p, end, nestedCount) ||
+                        !Read(p, end, nodesSize) )
+        return false;
+
+    // Check that the string table is valid once, so that we don't need to
+    // do it every time a string is used.
+    m_stringsOffsets = p;
+    if ( static_cast<size_t>(end - p)/4 <= m_stringsCount )
+        return false;
+    p += 4*(m_stringsCount + 1);
+    m_stringsData = p;
+
+    wxUint32 last = 0;
+    for ( wxUint32 n = 0; n <= m_stringsCount; n++ )
+    {
+        const char *q = m_stringsOffsets + 4*n;
+        wxUint32 offset;
+        if ( !Read(q, p, offset) || offset < last ||
+                offset > static_cast<size_t>(end - m_stringsData) )
+            return false;
+
+        last = offset;
+    }
+    p += last;
+
+    m_strings.resize(m_stringsCount);
+    m_stringsConverted.resize(m_stringsCount);
+
+    if ( static_cast<size_t>(end - p)/(4*ENTRY_FIELDS) < entriesCount )
+        return false;
+
+    m_entries.resize(entriesCount);
+    for ( wxUint32 n = 0; n < entriesCount; n++ )
+    {
+        Entry& entry = m_entries[n];
+        wxUint32 cls;
+        if ( !Read(p, end, entry.name) ||
+                !Read(p, end, cls) ||
+                    !Read(p, end, entry.offset) ||
+                        !Read(p, end, entry.flags) ||
+                            entry.offset >= nodesSize )
+            return false;
+
+        if ( entry.name != NO_STRING )
+        {
+            const wxString * const name = GetString(entry.name);
+            if ( !name )
+                return false;
+
+            m_index[*name].push_back(n);
+        }
+    }
+
+    if ( static_cast<size_t>(end - p)/(4*NESTED_FIELDS) < nestedCount )
+        return false;
+
+    for ( wxUint32 n = 0; n < nestedCount; n++ )
+    {
+        wxUint32 name, entry;
+        if ( !Read(p, end, name) || !Read(p, end, entry) ||
+                entry >= entriesCount )
+            return false;
+
+        const wxString * const nameStr = GetString(name);
+        if ( !nameStr )
+            return false;
+
+        std::vector<size_t>& entries = m_nestedIndex[*nameStr];
+        if ( entries.empty() || entries.back() != entry )
+            entries.push_back(entry);
+    }
+
+    if ( static_cast<size_t>(end - p) != nodesSize )
+        return false;
+
+    m_nodes = p;
+    m_nodesEnd = end;
+
+    return true;
+}
+
+const wxString *wxXmlResourceBinary::GetString(wxUint32 n)
+{
+    if ( n >= m_stringsCount )
+        return nullptr;
+
+    if ( !m_stringsConverted[n] )
+    {
+        // The offsets were already checked in Init().
+        wxUint32 start, end;
+        const char *p = m_stringsOffsets + 4*n;
+        Read(p, m_stringsData, start);
+        Read(p, m_stringsData, end);
+
+        m_strings[n] = wxString::FromUTF8(m_stringsData + start, end - start);
+        m_stringsConverted[n] = true;
+    }
+
+    return &m_strings[n];
+}
+
+wxXmlNode *
+wxXmlResourceBinary::DoCreateNode(const char*& p, const char* end, int depth)
+{
+    // Don't overflow the stack when reading a corrupted file.
+    if ( depth > 1000 )
+        return nullptr;
+
+    wxUint32 type, name, content, line, count;
+    if ( !Read(p, end, type) ||
+            !Read(p, end, name) ||
+                !Read(p, end, content) ||
+                    !Read(p, end, line) ||
+                        !Read(p, end, count) )
+        return nullptr;
+
+    if ( type != wxXML_ELEMENT_NODE &&
+            type != wxXML_TEXT_NODE &&
+                type != wxXML_CDATA_SECTION_NODE )
+        return nullptr;
+
+    const wxString * const nameStr = GetString(name);
+    const wxString * const contentStr = GetString(content);
+    if ( !nameStr || !contentStr )
+        return nullptr;
+
+    std::unique_ptr<wxXmlNode>
+        node(new wxXmlNode(static_cast<wxXmlNodeType>(type),
+                           *nameStr, *contentStr, line));
+
+    wxXmlAttribute *lastAttr = nullptr;
+    for ( wxUint32 n = 0; n < count; n++ )
+    {
+        wxUint32 attrName, attrValue;
+        if ( !Read(p, end, attrName) || !Read(p, end, attrValue) )
+            return nullptr;
+
+        const wxString * const attrNameStr = GetString(attrName);
+        const wxString * const attrValueStr = GetString(attrValue);
+        if ( !attrNameStr || !attrValueStr )
+            return nullptr;
+
+        wxXmlAttribute * const
+            attr = new wxXmlAttribute(*attrNameStr, *attrValueStr);
+        if ( lastAttr )
+            lastAttr->SetNext(attr);
+        else
+            node->SetAttributes(attr);
+        lastAttr = attr;
+    }
+
+    if ( !Read(p, end, count) )
+        return nullptr;
+
+    wxXmlNode *lastChild = nullptr;
+    for ( wxUint32 n = 0; n < count; n++ )
+    {
+        wxXmlNode * const child = DoCreateNode(p, end, depth + 1);
+        if ( !child )
+            return nullptr;
+
+        // This is faster than using AddChild() which has to find the last
+        // child every time.
+        node->InsertChildAfter(child, lastChild);
+        lastChild = child;
+    }
+
+    return node.release();
+}
+
+wxXmlNode *wxXmlResourceBinary::CreateNode(size_t entry)
+{
+    Entry& e = m_entries[entry];
+
+    wxASSERT_MSG( !e.created, "node already created" );
+
+    // Don't try to create it again even if we fail.
+    e.created = true;
+
+    const char *p = m_nodes + e.offset;
+    e.node = DoCreateNode(p, m_nodesEnd, 0);
+
+    return e.node;
+}
+
+wxXmlDocument *
+wxXmlResourceBinary::CreateDocument(bool all,
+                                    const std::unordered_set<wxString>& features)
+{
+    const char *p = m_nodes;
+    wxXmlNode * const root = DoCreateNode(p, m_nodesEnd, 0);
+    if ( !root || root->GetType() != wxXML_ELEMENT_NODE )
+    {
+        delete root;
+        return nullptr;
+    }
+
+    std::unique_ptr<wxXmlDocument> doc(new wxXmlDocument);
+    doc->SetRoot(root);
+
+    // The root node is stored without children.
+    wxXmlNode *last = nullptr;
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+    {
+        if ( !all && !(m_entries[n].flags & wxXRCBinary::ENTRY_EAGER) )
+            continue;
+
+        wxXmlNode * const node = CreateNode(n);
+        if ( !node )
+            return nullptr;
+
+        // Don't add the inactive nodes, which would be deleted by
+        // DoLoadDocument() later, to the document at all, as their entries
+        // would keep pointing to them otherwise.
+        if ( !IsActiveNode(node, features) )
+        {
+            delete node;
+            ResetNode(n);
+            continue;
+        }
+
+        root->InsertChildAfter(node, last);
+        last = node;
+    }
+
+    return doc.release();
+}
+
 wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
+{
+    // Create all nodes immediately, as we don't have anywhere to store the
+    // compiled data for loading them later.
+    return DoLoadFileOrBinary(filename, nullptr);
+}
+
+wxXmlDocument *
+wxXmlResource::DoLoadFileOrBinary(const wxString& filename,
+                                  wxXmlResourceBinary **binary)
 {
     wxLogTrace(wxT("xrc"), wxT("opening file '%s'"), filename);
 
@@ -800,6 +1613,55 @@ wxXmlDocument *wxXmlResource::DoLoadFile(const wxString& filename)
         return nullptr;
     }
 
+    // Check if this is a compiled file by looking at its signature.
+    char magic[wxXRCBinary::MAGIC_LEN];
+    const size_t magicLen = stream->Read(magic, sizeof(magic)).LastRead();
+    if ( magicLen == sizeof(magic) &&
+            memcmp(magic, wxXRCBinary::MAGIC, sizeof(magic)) == 0 )
+    {
+        // Read the entire file at once, the strings and nodes will be
+        // decoded from it when they are needed.
+        wxMemoryBuffer data;
+        const wxFileOffset len = stream->GetLength();
+        if ( len != wxInvalidOffset )
+            data.SetBufSize(len);
+
+        data.AppendData(magic, magicLen);
+        for ( ;; )
+        {
+            const size_t chunk = 65536;
+            void * const buf = data.GetAppendBuf(chunk);
+            const size_t read = stream->Read(buf, chunk).LastRead();
+            data.UngetAppendBuf(read);
+            if ( !read )
+                break;
+        }
+
+        std::unique_ptr<wxXmlResourceBinary> bin(new wxXmlResourceBinary);
+        std::unique_ptr<wxXmlDocument> doc;
+        if ( bin->Init(data) )
+            doc.reset(bin->CreateDocument(binary == nullptr,
+                                          m_internal->m_features));
+
+        if ( !doc )
+        {
+            wxLogError(_("Invalid compiled resources file '%s'."), filename);
+            return nullptr;
+        }
+
+        if ( !DoLoadDocument(*doc) )
+            return nullptr;
+
+        if ( binary )
+            *binary = bin.release();
+
+        return doc.release();
+    }
+
+    // Not a compiled file, parse it as XML after putting back the data we
+    // have read.
+    stream->Ungetch(magic, magicLen);
+
     std::unique_ptr<wxXmlDocument> doc(new wxXmlDocument);
     if (!doc->Load(*stream))
     {
@@ -874,6 +1736,34 @@ bool wxXmlResource::LoadDocument(wxXmlDocument* doc, const wxString& name)
     return true;
 }
 
+// Helper of DoFindResource() and GetResourceNodeAndLocation(): returns true if
+// the given node, which is known to have the correct name, matches the class.
+static bool
+IsResourceOfClass(const wxXmlResource& res,
+                  const wxXmlNode *node,
+                  const wxString& classname)
+{
+    // empty class name matches everything
+    if ( classname.empty() )
+        return true;
+
+    wxString cls(node->GetAttribute(wxS("class")));
+
+    // object_ref may not have 'class' attribute:
+    if (cls.empty() && node->GetName() == wxS("object_ref"))
+    {
+        wxString refName = node->GetAttribute(wxS("ref"));
+        if (refName.empty())
+            return false;
+
+        const wxXmlNode * const refNode = res.GetResourceNode(refName);
+        if ( refNode )
+            cls = refNode->GetAttribute(wxS("class"));
+    }
+
+    return cls == classname;
+}
+
 wxXmlNode *wxXmlResource::DoFindResource(wxXmlNode *parent,
                                          const wxString& name,
                                          const wxString& classname,
@@ -885,29 +1775,9 @@ wxXmlNode *wxXmlResource::DoFindResource(wxXmlNode *parent,
     // where the resource is most commonly looked for):
     for (node = parent->GetChildren(); node; node = node->GetNext())
     {
-        if ( IsObjectNode(node) && node->GetAttribute(wxS("name")) == name )
-        {
-            // empty class name matches everything
-            if ( classname.empty() )
-                return node;
-
-            wxString cls(node->GetAttribute(wxS("class")));
-
-            // object_ref may not have 'class' attribute:
-            if (cls.empty() && node->GetName() == wxS("object_ref"))
-            {
-                wxString refName = node->GetAttribute(wxS("ref"));
-                if (refName.empty())
-                    continue;
-
-                const wxXmlNode * const refNode = GetResourceNode(refName);
-                if ( refNode )
-                    cls = refNode->GetAttribute(wxS("class"));
-            }
-
-            if ( cls == classname )
-                return node;
-        }
+        if ( IsObjectNode(node) && node->GetAttribute(wxS("name")) == name &&
+                IsResourceOfClass(*this, node, classname) )
+            return node;
     }
 
     // then recurse in child nodes
@@ -970,14 +1840,32 @@ wxXmlResource::GetResourceNodeAndLocation(const wxString& name,
     // reloading of XRC files
     const_cast<wxXmlResource *>(this)->UpdateResources();
 
-    for ( const wxXmlResourceDataRecord& rec : Data() )
+    for ( wxXmlResourceDataRecord& rec : Data() )
     {
         wxXmlDocument * const doc = rec.Doc.get();
         if ( !doc || !doc->GetRoot() )
             continue;
 
-        wxXmlNode * const
-            found = DoFindResource(doc->GetRoot(), name, classname, recursive);
+        // Use the index to find the top-level resources without iterating
+        // over all of them, this also creates them if they were not loaded
+        // from a compiled file yet.
+        wxXmlNode *found = nullptr;
+        for ( wxXmlNode *node : rec.FindTopLevel(name, m_internal->m_features) )
+        {
+            if ( IsResourceOfClass(*this, node, classname) )
+            {
+                found = node;
+                break;
+            }
+        }
+
+        if ( !found && recursive )
+        {
+            rec.CreateNested(name, m_internal->m_features);
+
+            found = DoFindResource(doc->GetRoot(), name, classname, true);
+        }
+
         if ( found )
         {
             if ( path )
@@ -1088,6 +1976,9 @@ wxXmlResource::DoCreateResFromNode(wxXmlNode& node,
             // would overwrite linked object's properties. In this case,
             // we can simply create the resource from linked node.
 
+            if ( m_internal->m_deferChildrenOf == &node )
+                m_internal->m_deferChildrenOf = refNode;
+
             return DoCreateResFromNode(*refNode, parent, instance);
         }
         else
@@ -1104,6 +1995,9 @@ wxXmlResource::DoCreateResFromNode(wxXmlNode& node,
             copy.AddAttribute(ATTR_INPUT_FILENAME,
                               GetFileNameFromNode(refNode, Data()));
 
+            if ( m_internal->m_deferChildrenOf == &node )
+                m_internal->m_deferChildrenOf = &copy;
+
             return DoCreateResFromNode(copy, parent, instance);
         }
     }
@@ -1117,7 +2011,9 @@ wxXmlResource::DoCreateResFromNode(wxXmlNode& node,
     }
     else if (node.GetName() == wxT("object"))
     {
-        for ( const auto& handler : m_internal->m_handlers )
+        const wxString classname = node.GetAttribute(wxS("class"));
+        for ( wxXmlResourceHandler* handler :
+                m_internal->GetHandlersForClass(classname) )
         {
             if (handler->CanHandle(&node))
                 return handler->CreateResource(&node, parent, instance);
@@ -1465,6 +2361,35 @@ wxObject *wxXmlResourceHandlerImpl::CreateResFromNode(wxXmlNode *node,
     return m_handler->m_resource->CreateResFromNode(node, parent, instance);
 }
 
+wxObject *
+wxXmlResourceHandlerImpl::CreateResFromNodeWithDeferredChildren(wxXmlNode *node,
+                                                                wxObject *parent)
+{
+    wxXmlResourceInternal* const internal = m_handler->m_resource->m_internal;
+
+    // This will be reset by CreateChildren() if it's called for this node.
+    wxXmlNode* const deferChildrenOfOld = internal->m_deferChildrenOf;
+    internal->m_deferChildrenOf = node;
+
+    wxObject* const obj = CreateResFromNode(node, parent);
+
+    internal->m_deferChildrenOf = deferChildrenOfOld;
+
+    return obj;
+}
+
+void
+wxXmlResourceHandlerImpl::CreateResFromNodeLater(wxXmlNode *node,
+                                                 wxWindow *parent)
+{
+    wxXmlResource* const res = m_handler->m_resource;
+    wxXmlResourceInternal* const internal = res->m_internal;
+    if ( !internal->m_deferred )
+        internal->m_deferred.reset(new wxXmlResourceDeferred(res));
+
+    internal->m_deferred->Add(parent, *node, GetFileNameFromNode(node, res->Data()));
+}
+
 #if wxUSE_FILESYSTEM
 wxFileSystem& wxXmlResourceHandlerImpl::GetCurFileSystem()
 {
@@ -2828,6 +3753,25 @@ void wxXmlResourceHandlerImpl::SetupWindow(wxWindow *wnd)
 
 void wxXmlResourceHandlerImpl::CreateChildren(wxObject *parent, bool this_hnd_only)
 {
+    wxXmlResource* const res = m_handler->m_resource;
+    wxXmlResourceInternal* const internal = res->m_internal;
+    if ( m_handler->m_node == internal->m_deferChildrenOf && !this_hnd_only )
+    {
+        wxWindow* const window = wxDynamicCast(parent, wxWindow);
+        if ( window )
+        {
+            internal->m_deferChildrenOf = nullptr;
+
+            for ( wxXmlNode *n = m_handler->m_node->GetChildren(); n; n = n->GetNext() )
+            {
+                if ( IsObjectNode(n) )
+                    CreateResFromNodeLater(n, window);
+            }
+
+            return;
+        }
+    }
+
     for ( wxXmlNode *n = m_handler->m_node->GetChildren(); n; n = n->GetNext() )
     {
         if ( IsObjectNode(n) )
@@ -919,3 +919,78 @@ TEST_CASE("wxCmpNatural", "[wxString][compare]")
     // locale-dependent, so just run a simple sanity test
     CHECK(wxCmpNatural("same", "same") == 0);
 }
+
+TEST_CASE("wxGetStringSortKey", "[wxString][compare]")
+{
+    static const char* const strings[] =
+    {
+        "", " ", ",", "0", "00", "01", "1", "05", "5", "10", "a", "A", "AB",
+        "abc", "z", "1st", " 1st", ",1st", "01st", "5th", "10th", "a1st",
+        "a01st", "a5th", "a10th", "a 10th", "a1st1", "a01st01", "a5th 5",
+        "a 10th 10", "9999999999999999999", "file2.txt", "file10.txt",
+        "File1.TXT", "x\ty", "b-c", "b_c", "B.c",
+    };
+
+    const auto sign = [](int n) { return n < 0 ? -1 : n > 0 ? 1 : 0; };
+    const auto keyCmp = [&sign](const std::string& k1, const std::string& k2)
+    {
+        return sign(k1.compare(k2));
+    };
+
+    for ( const char* s1 : strings )
+    {
+        for ( const char* s2 : strings )
+        {
+            INFO("Comparing \"" << s1 << "\" and \"" << s2 << "\"");
+
+            CHECK( keyCmp(wxGetStringSortKey(s1), wxGetStringSortKey(s2)) ==
+                    sign(wxString(s1).Cmp(s2)) );
+
+            CHECK( keyCmp(wxGetStringSortKey(s1, wxSTRING_SORT_NOCASE),
+                          wxGetStringSortKey(s2, wxSTRING_SORT_NOCASE)) ==
+                    sign(wxString(s1).CmpNoCase(s2)) );
+
+            CHECK( keyCmp(wxGetStringSortKey(s1, wxSTRING_SORT_LOCALE),
+                          wxGetStringSortKey(s2, wxSTRING_SORT_LOCALE)) ==
+                    sign(wxStrcoll_String(wxString(s1), wxString(s2))) );
+
+            CHECK( keyCmp(wxGetStringSortKey(s1, wxSTRING_SORT_NATURAL),
+                          wxGetStringSortKey(s2, wxSTRING_SORT_NATURAL)) ==
+                    sign(wxCmpNaturalGeneric(s1, s2)) );
+        }
+    }
+}
+
+TEST_CASE("wxArrayString::SortByKey", "[dynarray]")
+{
+    wxArrayString a;
+    a.push_back("file10");
+    a.push_back("File2");
+    a.push_back("file1");
+
+    a.SortByKey();
+    CHECK( a[0] == "File2" );
+    CHECK( a[1] == "file1" );
+    CHECK( a[2] == "file10" );
+
+    a.SortByKey(wxSTRING_SORT_NATURAL);
+    CHECK( a[0] == "file1" );
+    CHECK( a[1] == "File2" );
+    CHECK( a[2] == "file10" );
+
+    a.SortByKey(wxSTRING_SORT_NATURAL | wxSTRING_SORT_REVERSE);
+    CHECK( a[0] == "file10" );
+    CHECK( a[1] == "File2" );
+    CHECK( a[2] == "file1" );
+
+    // Check that parallel sorting of a big array gives the same result.
+    wxArrayString big;
+    for ( int n = 0; n < 50000; n++ )
+        big.push_back(wxString::Format("item%d", (n * 7919) % 50000));
+
+    wxArrayString expected(big);
+    expected.Sort(wxCmpNaturalGeneric);
+
+    big.SortByKey(wxSTRING_SORT_NATURAL | wxSTRING_SORT_PARALLEL);
+    CHECK( big == expected );
+}
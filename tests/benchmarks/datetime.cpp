@@ -17,3 +17,77 @@ BENCHMARK_FUNC(ParseDate)
     return dt.ParseDate("May 23, 2011") && dt.GetMonth() == wxDateTime::May;
 }
 
+
+// ----------------------------------------------------------------------------
+// Formatting and parsing using fixed formats
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const char* const ISO_FORMAT = "%Y-%m-%dT%H:%M:%S";
+const char* const RFC822_FORMAT = "%a, %d %b %Y %H:%M:%S %z";
+
+const wxDateTime& GetTestDate()
+{
+    static const wxDateTime dt(23, wxDateTime::May, 2011, 12, 34, 56);
+    return dt;
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(FormatISO)
+{
+    return GetTestDate().Format(ISO_FORMAT).length() == 19;
+}
+
+BENCHMARK_FUNC(FormatISOCompiled)
+{
+    static const wxDateTimeFormatter fmt(ISO_FORMAT);
+    return fmt.Format(GetTestDate()).length() == 19;
+}
+
+BENCHMARK_FUNC(FormatRFC822)
+{
+    return !GetTestDate().Format(RFC822_FORMAT, wxDateTime::UTC).empty();
+}
+
+BENCHMARK_FUNC(FormatRFC822Compiled)
+{
+    static const wxDateTimeFormatter
+        fmt(RFC822_FORMAT, wxDateTimeFormatter::Flag_EnglishNames);
+    return !fmt.Format(GetTestDate(), wxDateTime::UTC).empty();
+}
+
+BENCHMARK_FUNC(ParseISO)
+{
+    wxDateTime dt;
+    return dt.ParseISOCombined("2011-05-23T12:34:56") &&
+            dt.GetMonth() == wxDateTime::May;
+}
+
+BENCHMARK_FUNC(ParseISOCompiled)
+{
+    static const wxDateTimeFormatter fmt(ISO_FORMAT);
+
+    wxDateTime dt;
+    return fmt.Parse("2011-05-23T12:34:56", &dt) &&
+            dt.GetMonth() == wxDateTime::May;
+}
+
+BENCHMARK_FUNC(ParseRFC822)
+{
+    wxDateTime dt;
+    return dt.ParseRfc822Date("Mon, 23 May 2011 12:34:56 +0200") &&
+            dt.GetMonth() == wxDateTime::May;
+}
+
+BENCHMARK_FUNC(ParseRFC822Compiled)
+{
+    static const wxDateTimeFormatter
+        fmt(RFC822_FORMAT, wxDateTimeFormatter::Flag_EnglishNames);
+
+    wxDateTime dt;
+    return fmt.Parse("Mon, 23 May 2011 12:34:56 +0200", &dt) &&
+            dt.GetMonth() == wxDateTime::May;
+}
@@ -0,0 +1,148 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/html.cpp
+// Purpose:     wxHTML parsing and layout benchmarks
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#if wxUSE_HTML
+
+#include "wx/bitmap.h"
+#include "wx/dcmemory.h"
+#include "wx/ffile.h"
+#include "wx/stopwatch.h"
+#include "wx/html/htmlcell.h"
+#include "wx/html/winpars.h"
+
+#include <memory>
+
+namespace
+{
+
+// The HTML used by the benchmarks: either the contents of the file given by
+// the string parameter or the synthetic document with the number of
+// paragraphs given by the numeric parameter.
+wxString theHtmlText;
+
+// The parser is reused for all iterations, just as wxHtmlWindow reuses its
+// parser for all the pages shown in it.
+std::unique_ptr<wxHtmlWinParser> theParser;
+
+// Time spent in the different phases of all the benchmark iterations.
+wxLongLong theParseTime,
+           theLayoutTime;
+long theIterations = 0;
+
+bool HtmlInit()
+{
+    const wxString filename = Bench::GetStringParameter();
+    if ( !filename.empty() )
+    {
+        if ( !wxFFile(filename).ReadAll(&theHtmlText, wxConvUTF8) )
+            return false;
+    }
+    else
+    {
+        static const char* const words[] =
+        {
+            "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog",
+            "wxWidgets", "window", "control", "event", "handler", "layout",
+            "paragraph", "document", "text", "font", "help", "page",
+        };
+
+        const long numParas = Bench::GetNumericParameter(2000);
+
+        theHtmlText = "<html><body>\n";
+        for ( long n = 0; n < numParas; n++ )
+        {
+            if ( n % 50 == 0 )
+                theHtmlText << "<h2>Section " << n / 50 + 1 << "</h2>\n";
+
+            theHtmlText += "<p>";
+            for ( int w = 0; w < 60; w++ )
+            {
+                const char* const word = words[(n * 7 + w * 13) % WXSIZEOF(words)];
+                switch ( w % 20 )
+                {
+                    case 5:
+                        theHtmlText << "<b>" << word << "</b> ";
+                        break;
+
+                    case 15:
+                        theHtmlText << "<i>" << word << "</i> ";
+                        break;
+
+                    default:
+                        theHtmlText << word << ' ';
+                }
+            }
+            theHtmlText += "</p>\n";
+
+            if ( n % 10 == 9 )
+            {
+                theHtmlText += "<ul>";
+                for ( int i = 0; i < 3; i++ )
+                    theHtmlText << "<li>item " << n << '.' << i << "</li>";
+                theHtmlText += "</ul>\n";
+            }
+        }
+        theHtmlText += "</body></html>\n";
+    }
+
+    theParser.reset(new wxHtmlWinParser());
+
+    theParseTime =
+    theLayoutTime = 0;
+    theIterations = 0;
+
+    return true;
+}
+
+void HtmlDone()
+{
+    if ( theIterations )
+    {
+        wxPrintf("%.1f KB of HTML, per iteration: parse %.2fms, layout %.2fms\n",
+                 theHtmlText.length() / 1024.,
+                 theParseTime.ToDouble() / theIterations / 1000.,
+                 theLayoutTime.ToDouble() / theIterations / 1000.);
+    }
+
+    theParser.reset();
+    theHtmlText.clear();
+}
+
+} // anonymous namespace
+
+// Parse the document and lay it out for a few different widths, as happens
+// when wxHtmlWindow is resized. Use the numeric parameter to change the number
+// of paragraphs in the generated document or the string one to use the given
+// file instead.
+BENCHMARK_FUNC_WITH_INIT(HtmlParseLayout, HtmlInit, HtmlDone)
+{
+    wxBitmap bmp(16, 16);
+    wxMemoryDC dc(bmp);
+
+    wxStopWatch sw;
+
+    theParser->SetDC(&dc);
+    std::unique_ptr<wxHtmlContainerCell>
+        cell(static_cast<wxHtmlContainerCell*>(theParser->Parse(theHtmlText)));
+    theParser->SetDC(nullptr);
+
+    theParseTime += sw.TimeInMicro();
+    sw.Start();
+
+    for ( int width = 800; width >= 400; width -= 200 )
+        cell->Layout(width);
+
+    theLayoutTime += sw.TimeInMicro();
+    theIterations++;
+
+    return cell->GetHeight() > 0;
+}
+
+#endif // wxUSE_HTML
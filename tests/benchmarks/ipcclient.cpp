@@ -9,6 +9,7 @@
 
 #include "bench.h"
 
+#include "wx/app.h"
 #include "wx/evtloop.h"
 
 // do this before including wx/ipc.h under Windows to use TCP even there
@@ -167,3 +168,240 @@ BENCHMARK_FUNC_WITH_INIT(IPCPokeAdvise, ConnInit, ConnDone)
 
     return true;
 }
+
+// ----------------------------------------------------------------------------
+// Benchmarks using a server running in the same process
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Use a different port from IPC_SERVICE to avoid conflicts with the server
+// used by the benchmark above.
+#define IPC_LOCAL_SERVICE "4243"
+
+class LocalClientConn : public wxConnection
+{
+public:
+    LocalClientConn() { m_numAdvised = 0; }
+
+    int GetNumAdvised() const { return m_numAdvised; }
+    void ResetNumAdvised() { m_numAdvised = 0; }
+
+    virtual bool OnAdvise(const wxString& WXUNUSED(topic),
+                          const wxString& WXUNUSED(item),
+                          const void *WXUNUSED(data),
+                          size_t WXUNUSED(size),
+                          wxIPCFormat WXUNUSED(format))
+    {
+        m_numAdvised++;
+
+        return true;
+    }
+
+private:
+    int m_numAdvised;
+
+    wxDECLARE_NO_COPY_CLASS(LocalClientConn);
+};
+
+class LocalClient : public wxClient
+{
+public:
+    virtual wxConnectionBase *OnMakeConnection()
+    {
+        return new LocalClientConn;
+    }
+};
+
+class LocalServerConn : public wxConnection
+{
+public:
+    LocalServerConn() { }
+
+    virtual bool OnStartAdvise(const wxString& WXUNUSED(topic),
+                               const wxString& WXUNUSED(item))
+    {
+        return true;
+    }
+
+private:
+    wxDECLARE_NO_COPY_CLASS(LocalServerConn);
+};
+
+class LocalServer : public wxServer
+{
+public:
+    LocalServer() { m_conn = nullptr; }
+
+    virtual ~LocalServer()
+    {
+        delete m_conn;
+    }
+
+    LocalServerConn *GetConn() const { return m_conn; }
+
+    virtual wxConnectionBase *OnAcceptConnection(const wxString& topic)
+    {
+        if ( topic != IPC_BENCHMARK_TOPIC )
+            return nullptr;
+
+        m_conn = new LocalServerConn;
+        return m_conn;
+    }
+
+private:
+    LocalServerConn *m_conn;
+
+    wxDECLARE_NO_COPY_CLASS(LocalServer);
+};
+
+// Socket events are queued and not processed while waiting for the reply to
+// a synchronous IPC call, which would result in a deadlock when both sides
+// of the connection live in the same thread, so process them immediately.
+class LocalEventLoop : public wxEventLoop
+{
+public:
+    LocalEventLoop() { }
+
+    virtual int DispatchTimeout(unsigned long timeout) override
+    {
+        const int rc = wxEventLoop::DispatchTimeout(timeout);
+
+        wxTheApp->ProcessPendingEvents();
+
+        return rc;
+    }
+
+private:
+    wxDECLARE_NO_COPY_CLASS(LocalEventLoop);
+};
+
+// Both the server and the client sides live in the main thread and use the
+// same event loop, which is also used while waiting for the replies.
+class LocalConnection
+{
+public:
+    LocalConnection()
+    {
+        m_loop = new LocalEventLoop;
+        m_activator = new wxEventLoopActivator(m_loop);
+
+        m_server = new LocalServer;
+        m_client = new LocalClient;
+        m_conn = nullptr;
+
+        if ( !m_server->Create(IPC_LOCAL_SERVICE) )
+            return;
+
+        m_conn = static_cast<LocalClientConn *>(
+                    m_client->MakeConnection(IPC_HOST,
+                                             IPC_LOCAL_SERVICE,
+                                             IPC_BENCHMARK_TOPIC));
+        if ( m_conn && !m_conn->StartAdvise(IPC_BENCHMARK_ITEM) )
+        {
+            delete m_conn;
+            m_conn = nullptr;
+        }
+    }
+
+    ~LocalConnection()
+    {
+        if ( m_conn )
+        {
+            m_conn->Disconnect();
+            delete m_conn;
+        }
+
+        delete m_client;
+        delete m_server;
+
+        delete m_activator;
+        delete m_loop;
+    }
+
+    bool IsOk() const { return m_conn && m_server->GetConn(); }
+
+    // Send the given number of advises from the server and wait until the
+    // client gets all of them.
+    bool SendAdvises(int count)
+    {
+        LocalServerConn * const serverConn = m_server->GetConn();
+
+        m_conn->ResetNumAdvised();
+
+        const wxString s(64, '@');
+        for ( int n = 0; n < count; n++ )
+        {
+            if ( !serverConn->Advise(IPC_BENCHMARK_ITEM, s) )
+                return false;
+        }
+
+        for ( ;; )
+        {
+            // Run the functions queued by the IPC code using CallAfter(),
+            // which is notably used for sending the batched messages.
+            wxTheApp->ProcessPendingEvents();
+
+            if ( m_conn->GetNumAdvised() == count )
+                return true;
+
+            if ( m_loop->DispatchTimeout(1000) <= 0 )
+                return false;
+        }
+    }
+
+    void EnableBatching(bool enable)
+    {
+        m_server->GetConn()->EnableBatching(enable);
+    }
+
+private:
+    wxEventLoop *m_loop;
+    wxEventLoopActivator *m_activator;
+
+    LocalServer *m_server;
+    LocalClient *m_client;
+    LocalClientConn *m_conn;
+
+    wxDECLARE_NO_COPY_CLASS(LocalConnection);
+};
+
+LocalConnection *theLocalConnection = nullptr;
+
+bool LocalInit()
+{
+    theLocalConnection = new LocalConnection;
+    if ( !theLocalConnection->IsOk() )
+    {
+        delete theLocalConnection;
+        theLocalConnection = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void LocalDone()
+{
+    delete theLocalConnection;
+    theLocalConnection = nullptr;
+}
+
+} // anonymous namespace
+
+// Use the numeric parameter to change the number of advises sent during each
+// iteration.
+BENCHMARK_FUNC_WITH_INIT(IPCAdviseLocal, LocalInit, LocalDone)
+{
+    theLocalConnection->EnableBatching(false);
+
+    return theLocalConnection->SendAdvises(Bench::GetNumericParameter(1000));
+}
+
+BENCHMARK_FUNC_WITH_INIT(IPCAdviseLocalBatched, LocalInit, LocalDone)
+{
+    theLocalConnection->EnableBatching(true);
+
+    return theLocalConnection->SendAdvises(Bench::GetNumericParameter(1000));
+}
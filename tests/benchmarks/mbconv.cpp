@@ -42,6 +42,40 @@ bool ConvertToMB(const wxMBConv& conv)
     return conv.FromWChar(buf.data(), outlen, TEST_STRING) == outlen;
 }
 
+// return a long string consisting of many copies of TEST_STRING with some
+// non-ASCII characters added to it
+const std::wstring& GetLargeTestString()
+{
+    static std::wstring s;
+    if ( s.empty() )
+    {
+        long num = Bench::GetNumericParameter();
+        if ( !num )
+            num = 1;
+
+        for ( long n = 0; n < 1000*num; n++ )
+        {
+            s += TEST_STRING;
+            s += L"\u00e9t\u00e9 \u0426\u0435\u043b\u043e\u0435 \u20ac ";
+        }
+    }
+
+    return s;
+}
+
+const std::string& GetLargeTestStringUTF8()
+{
+    static std::string s;
+    if ( s.empty() )
+    {
+        const std::wstring& ws = GetLargeTestString();
+        const wxCharBuffer buf = wxConvUTF8.cWC2MB(ws.c_str(), ws.length(), nullptr);
+        s.assign(buf.data(), buf.length());
+    }
+
+    return s;
+}
+
 } // anonymous namespace
 
 BENCHMARK_FUNC(UTF16InitWX)
@@ -76,3 +110,32 @@ BENCHMARK_FUNC(UTF16Sys)
     return ConvertToMB(wxCSConv("UTF-16LE"));
 }
 
+
+BENCHMARK_FUNC(UTF8LargeToMB)
+{
+    const std::wstring& ws = GetLargeTestString();
+
+    size_t len;
+    const wxCharBuffer buf = wxConvUTF8.cWC2MB(ws.c_str(), ws.length(), &len);
+    return len == GetLargeTestStringUTF8().length();
+}
+
+BENCHMARK_FUNC(UTF8LargeToWC)
+{
+    const std::string& s = GetLargeTestStringUTF8();
+
+    size_t len;
+    const wxWCharBuffer buf = wxConvUTF8.cMB2WC(s.c_str(), s.length(), &len);
+    return len == GetLargeTestString().length();
+}
+
+BENCHMARK_FUNC(UTF8LargeToWCPUA)
+{
+    const std::string& s = GetLargeTestStringUTF8();
+
+    wxMBConvUTF8 conv(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+
+    size_t len;
+    const wxWCharBuffer buf = conv.cMB2WC(s.c_str(), s.length(), &len);
+    return len == GetLargeTestString().length();
+}
@@ -40,6 +40,7 @@
 //
 
 #include "wx/string.h"
+#include "wx/private/wxprintf.h"
 #include "bench.h"
 
 // ----------------------------------------------------------------------------
@@ -132,3 +133,31 @@ BENCHMARK_FUNC(SystemSnprintf)
     return true;
 }
 
+
+// Parsing the format is what our own wxVsnprintf() implementation avoids doing
+// on each call by caching the parsed formats: as this implementation is not
+// used when the system vswprintf() supports positional parameters, e.g. with
+// glibc, this benchmark allows to measure the cost of parsing everywhere.
+BENCHMARK_FUNC(PrintfParseFormat)
+{
+    const wxPrintfConvSpecParser<wchar_t>
+        parserLong(L"This is a reasonably long string with various %s arguments, "
+                   L"exactly %d, and is used as benchmark for %s - %% %.2f %d %s");
+    const wxPrintfConvSpecParser<wchar_t>
+        parserPos(L"This is a %2$s and thus is harder to parse... nonetheless, %1$s !");
+
+    return parserLong.nargs == 6 && parserPos.nargs == 2;
+}
+
+BENCHMARK_FUNC(StringFormat)
+{
+    const wxString s = wxString::Format("Item %d of %d: %s (%.1f%%)",
+                                        17, 100, "some name", 17.0);
+    return !s.empty();
+}
+
+BENCHMARK_FUNC(StringFormatLong)
+{
+    const wxString s = wxString::Format("%s: %d", g_verylongString, 999);
+    return s.length() > g_verylongString.length();
+}
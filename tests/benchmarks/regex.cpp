@@ -38,6 +38,19 @@ BENCHMARK_FUNC(RECompileAndMatch)
 // Benchmark the cost of using a more complicated regex
 // ----------------------------------------------------------------------------
 
+static const char* const RE_EMAIL =
+    "^[[:alnum:]._%+-]+@([[:alnum:]-]+\\.)+[[:alpha:]]{2,}$";
+
+BENCHMARK_FUNC(RECompileComplex)
+{
+    return wxRegEx(RE_EMAIL).IsValid();
+}
+
+BENCHMARK_FUNC(RECompileAndMatchComplex)
+{
+    return wxRegEx(RE_EMAIL).Matches("someone@example.com");
+}
+
 namespace
 {
 
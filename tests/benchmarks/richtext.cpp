@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/richtext.cpp
+// Purpose:     wxRichTextXMLHandler loading and saving benchmarks
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#if wxUSE_RICHTEXT && wxUSE_XML
+
+#include "wx/mstream.h"
+#include "wx/stopwatch.h"
+#include "wx/wfstream.h"
+#include "wx/richtext/richtextbuffer.h"
+#include "wx/richtext/richtextxml.h"
+
+#include <memory>
+
+namespace
+{
+
+// The buffer saved and loaded by the benchmark: either loaded from the file
+// given by the string parameter or generated with the number of paragraphs
+// given by the numeric parameter.
+std::unique_ptr<wxRichTextBuffer> theBuffer;
+
+// Time spent in the different phases of all the benchmark iterations.
+wxLongLong theSaveTime,
+           theLoadTime;
+size_t theDataSize = 0;
+long theIterations = 0;
+
+bool RichTextInit()
+{
+    theBuffer.reset(new wxRichTextBuffer());
+
+    const wxString filename = Bench::GetStringParameter();
+    if ( !filename.empty() )
+    {
+        wxFileInputStream stream(filename);
+        wxRichTextXMLHandler handler;
+        if ( !stream.IsOk() || !handler.LoadFile(theBuffer.get(), stream) )
+            return false;
+    }
+    else
+    {
+        static const char* const words[] =
+        {
+            "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog",
+            "wxWidgets", "window", "control", "event", "handler", "layout",
+            "paragraph", "document", "text", "font", "\xc3\xa9t\xc3\xa9", "<&>",
+        };
+
+        wxRichTextAttr bold;
+        bold.SetFontWeight(wxFONTWEIGHT_BOLD);
+
+        wxRichTextAttr italic;
+        italic.SetFontStyle(wxFONTSTYLE_ITALIC);
+        italic.SetTextColour(*wxBLUE);
+
+        const long numParas = Bench::GetNumericParameter(5000);
+        for ( long n = 0; n < numParas; n++ )
+        {
+            wxRichTextParagraph* const
+                para = new wxRichTextParagraph(theBuffer.get());
+            theBuffer->AppendChild(para);
+
+            wxString text;
+            for ( int w = 0; w < 60; w++ )
+            {
+                text << wxString::FromUTF8(words[(n * 7 + w * 13) % WXSIZEOF(words)])
+                     << ' ';
+
+                // Split the text into runs alternating between two styles.
+                if ( w % 10 == 9 )
+                {
+                    wxRichTextAttr& attr = w % 20 == 9 ? bold : italic;
+                    para->AppendChild(new wxRichTextPlainText(text, para, &attr));
+                    text.clear();
+                }
+            }
+        }
+
+        theBuffer->UpdateRanges();
+    }
+
+    theSaveTime =
+    theLoadTime = 0;
+    theDataSize = 0;
+    theIterations = 0;
+
+    return true;
+}
+
+void RichTextDone()
+{
+    if ( theIterations )
+    {
+        wxPrintf("%.1f MB of XML, per iteration: save %.2fms, load %.2fms\n",
+                 theDataSize / 1024. / 1024.,
+                 theSaveTime.ToDouble() / theIterations / 1000.,
+                 theLoadTime.ToDouble() / theIterations / 1000.);
+    }
+
+    theBuffer.reset();
+}
+
+} // anonymous namespace
+
+// Save the buffer to XML and load it back. Use the numeric parameter to
+// change the number of paragraphs in the generated buffer or the string one
+// to use the given XML file instead.
+BENCHMARK_FUNC_WITH_INIT(RichTextXMLRoundTrip, RichTextInit, RichTextDone)
+{
+    wxRichTextXMLHandler handler;
+
+    wxStopWatch sw;
+
+    wxMemoryOutputStream out;
+    if ( !handler.SaveFile(theBuffer.get(), out) )
+        return false;
+
+    theSaveTime += sw.TimeInMicro();
+    sw.Start();
+
+    wxMemoryInputStream in(out);
+    wxRichTextBuffer buffer;
+    if ( !handler.LoadFile(&buffer, in) )
+        return false;
+
+    theLoadTime += sw.TimeInMicro();
+    theDataSize = out.GetLength();
+    theIterations++;
+
+    return buffer.GetOwnRange() == theBuffer->GetOwnRange();
+}
+
+#endif // wxUSE_RICHTEXT && wxUSE_XML
@@ -0,0 +1,394 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/sockets.cpp
+// Purpose:     wxSocket and socket event dispatching benchmarks
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#if wxUSE_SOCKETS
+
+#include "wx/evtloop.h"
+#include "wx/socket.h"
+
+#if wxUSE_EPOLL_DISPATCHER
+    #include "wx/unix/private/epolldispatcher.h"
+#endif
+
+#include <vector>
+
+namespace
+{
+
+// Size of the message sent by each client during a single round trip.
+const size_t ECHO_MESSAGE_SIZE = 256;
+
+enum
+{
+    ID_CLIENT = 1,
+    ID_PEER
+};
+
+// Set of the client sockets connected over the loopback interface to the
+// server side ones, which send back everything they receive, with all of
+// them using events.
+class EchoSockets : public wxEvtHandler
+{
+public:
+    explicit EchoSockets(int numClients)
+        : m_message(ECHO_MESSAGE_SIZE, 'x')
+    {
+        wxIPV4address addr;
+        addr.LocalHost();
+        addr.Service(0);
+
+        m_server = new wxSocketServer(addr, wxSOCKET_REUSEADDR);
+        if ( !m_server->IsOk() || !m_server->GetLocal(addr) )
+            return;
+
+        Bind(wxEVT_SOCKET, &EchoSockets::OnClientEvent, this, ID_CLIENT);
+        Bind(wxEVT_SOCKET, &EchoSockets::OnPeerEvent, this, ID_PEER);
+
+        for ( int n = 0; n < numClients; n++ )
+        {
+            wxSocketClient* const client = new wxSocketClient(wxSOCKET_NOWAIT);
+            m_sockets.push_back(client);
+
+            if ( !client->Connect(addr, true) )
+                return;
+
+            wxSocketBase* const peer = m_server->Accept(true);
+            if ( !peer )
+                return;
+
+            m_sockets.push_back(peer);
+
+            peer->SetFlags(wxSOCKET_NOWAIT);
+            SetupEvents(peer, ID_PEER);
+            SetupEvents(client, ID_CLIENT);
+
+            m_clients.push_back(client);
+        }
+
+        m_ok = true;
+    }
+
+    ~EchoSockets()
+    {
+        for ( size_t n = 0; n < m_sockets.size(); n++ )
+            m_sockets[n]->Destroy();
+
+        m_server->Destroy();
+    }
+
+    bool IsOk() const { return m_ok; }
+
+    // Send the message from all clients and run the event loop until all of
+    // them are echoed back.
+    bool RoundTrip()
+    {
+        m_received = 0;
+
+        for ( size_t n = 0; n < m_clients.size(); n++ )
+        {
+            m_clients[n]->Write(m_message.data(), m_message.size());
+            if ( m_clients[n]->LastCount() != m_message.size() )
+                return false;
+        }
+
+        wxEventLoop loop;
+        loop.Run();
+
+        return m_received == m_clients.size()*m_message.size();
+    }
+
+private:
+    void SetupEvents(wxSocketBase* socket, int id)
+    {
+        socket->SetEventHandler(*this, id);
+        socket->SetNotify(wxSOCKET_INPUT_FLAG);
+        socket->Notify(true);
+    }
+
+    void OnPeerEvent(wxSocketEvent& event)
+    {
+        wxSocketBase* const peer = event.GetSocket();
+
+        char buf[ECHO_MESSAGE_SIZE];
+        peer->Read(buf, sizeof(buf));
+        peer->Write(buf, peer->LastCount());
+    }
+
+    void OnClientEvent(wxSocketEvent& event)
+    {
+        wxSocketBase* const client = event.GetSocket();
+
+        char buf[ECHO_MESSAGE_SIZE];
+        client->Read(buf, sizeof(buf));
+        m_received += client->LastCount();
+
+        if ( m_received == m_clients.size()*m_message.size() )
+            wxEventLoopBase::GetActive()->Exit();
+    }
+
+    const std::string m_message;
+
+    wxSocketServer* m_server = nullptr;
+    std::vector<wxSocketBase*> m_sockets;
+    std::vector<wxSocketClient*> m_clients;
+
+    size_t m_received = 0;
+    bool m_ok = false;
+};
+
+EchoSockets* theEchoSockets = nullptr;
+
+bool EchoInit()
+{
+    theEchoSockets = new EchoSockets(Bench::GetNumericParameter(16));
+    if ( !theEchoSockets->IsOk() )
+    {
+        delete theEchoSockets;
+        theEchoSockets = nullptr;
+        return false;
+    }
+
+#if wxUSE_EPOLL_DISPATCHER
+    wxEpollDispatcher* const
+        epoll = dynamic_cast<wxEpollDispatcher*>(wxFDIODispatcher::Get());
+    if ( epoll )
+        epoll->ResetStats();
+#endif // wxUSE_EPOLL_DISPATCHER
+
+    return true;
+}
+
+void EchoDone()
+{
+#if wxUSE_EPOLL_DISPATCHER
+    wxEpollDispatcher* const
+        epoll = dynamic_cast<wxEpollDispatcher*>(wxFDIODispatcher::Get());
+    if ( epoll )
+    {
+        const wxEpollDispatcher::Stats& stats = epoll->GetStats();
+        wxPrintf("epoll: %" wxLongLongFmtSpec "u dispatches, "
+                 "%" wxLongLongFmtSpec "u polls "
+                 "(%" wxLongLongFmtSpec "u full), "
+                 "%.1f events per dispatch, max %u, buffer size %u\n",
+                 stats.dispatches,
+                 stats.polls, stats.fullPolls,
+                 stats.dispatches ? double(stats.events)/stats.dispatches : 0.,
+                 stats.maxBatch, stats.bufferSize);
+    }
+#endif // wxUSE_EPOLL_DISPATCHER
+
+    delete theEchoSockets;
+    theEchoSockets = nullptr;
+}
+
+// Blocking server socket listening on the loopback interface.
+class LoopbackServer
+{
+public:
+    LoopbackServer()
+    {
+        m_addr.LocalHost();
+        m_addr.Service(0);
+
+        m_server = new wxSocketServer(m_addr, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR);
+        if ( !m_server->IsOk() || !m_server->GetLocal(m_addr) )
+            wxDELETE(m_server);
+    }
+
+    ~LoopbackServer()
+    {
+        if ( m_server )
+            m_server->Destroy();
+    }
+
+    bool IsOk() const { return m_server != nullptr; }
+
+    wxSocketServer& GetServer() const { return *m_server; }
+    const wxIPV4address& GetAddress() const { return m_addr; }
+
+private:
+    wxIPV4address m_addr;
+    wxSocketServer* m_server = nullptr;
+};
+
+// Pair of connected blocking sockets.
+class SocketPair
+{
+public:
+    SocketPair()
+    {
+        if ( !m_server.IsOk() )
+            return;
+
+        m_client = new wxSocketClient(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+        if ( !m_client->Connect(m_server.GetAddress(), true) )
+            return;
+
+        m_peer = m_server.GetServer().Accept(true);
+        if ( !m_peer )
+            return;
+
+        m_peer->SetFlags(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+    }
+
+    ~SocketPair()
+    {
+        if ( m_peer )
+            m_peer->Destroy();
+        if ( m_client )
+            m_client->Destroy();
+    }
+
+    bool IsOk() const { return m_peer != nullptr; }
+
+    wxSocketBase& GetClient() const { return *m_client; }
+    wxSocketBase& GetPeer() const { return *m_peer; }
+
+private:
+    LoopbackServer m_server;
+    wxSocketClient* m_client = nullptr;
+    wxSocketBase* m_peer = nullptr;
+};
+
+SocketPair* theSocketPair = nullptr;
+
+bool PairInit()
+{
+    theSocketPair = new SocketPair();
+    if ( !theSocketPair->IsOk() )
+    {
+        delete theSocketPair;
+        theSocketPair = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void PairDone()
+{
+    delete theSocketPair;
+    theSocketPair = nullptr;
+}
+
+LoopbackServer* theLoopbackServer = nullptr;
+
+bool ServerInit()
+{
+    theLoopbackServer = new LoopbackServer();
+    if ( !theLoopbackServer->IsOk() )
+    {
+        delete theLoopbackServer;
+        theLoopbackServer = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void ServerDone()
+{
+    delete theLoopbackServer;
+    theLoopbackServer = nullptr;
+}
+
+} // anonymous namespace
+
+// Use the numeric parameter to change the number of sockets.
+BENCHMARK_FUNC_WITH_INIT(SocketEcho, EchoInit, EchoDone)
+{
+    return theEchoSockets->RoundTrip();
+}
+
+// Use the numeric parameter to change the number of connections established
+// during each iteration.
+BENCHMARK_FUNC_WITH_INIT(SocketConnect, ServerInit, ServerDone)
+{
+    const size_t numClients = Bench::GetNumericParameter(64);
+
+    std::vector<wxSocketClient*> clients;
+    std::vector<wxSocketBase*> peers;
+
+    // The connections are established by the system even before they're
+    // accepted, as long as they fit into the listen backlog.
+    bool ok = true;
+    for ( size_t n = 0; n < numClients; n++ )
+    {
+        wxSocketClient* const client = new wxSocketClient(wxSOCKET_BLOCK);
+        clients.push_back(client);
+
+        if ( !client->Connect(theLoopbackServer->GetAddress(), true) )
+        {
+            ok = false;
+            break;
+        }
+    }
+
+    while ( ok && peers.size() < clients.size() )
+    {
+        if ( !theLoopbackServer->GetServer().WaitForAccept(1) )
+            ok = false;
+        else
+            theLoopbackServer->GetServer().AcceptAll(peers);
+    }
+
+    for ( size_t n = 0; n < peers.size(); n++ )
+        peers[n]->Destroy();
+    for ( size_t n = 0; n < clients.size(); n++ )
+        clients[n]->Destroy();
+
+    return ok;
+}
+
+// Use the numeric parameter to change the size of the message.
+BENCHMARK_FUNC_WITH_INIT(SocketMsgRoundTrip, PairInit, PairDone)
+{
+    static std::vector<char> message, reply;
+    message.resize(Bench::GetNumericParameter(64), 'x');
+    reply.resize(message.size());
+
+    wxSocketBase& client = theSocketPair->GetClient();
+    wxSocketBase& peer = theSocketPair->GetPeer();
+
+    client.WriteMsg(&message[0], message.size());
+    peer.ReadMsg(&reply[0], reply.size());
+    if ( peer.LastReadCount() != message.size() )
+        return false;
+
+    peer.WriteMsg(&reply[0], reply.size());
+    client.ReadMsg(&message[0], message.size());
+
+    return !client.Error() && client.LastReadCount() == reply.size();
+}
+
+// Use the numeric parameter to change the amount of data transferred during
+// each iteration, in MiB.
+BENCHMARK_FUNC_WITH_INIT(SocketBulk, PairInit, PairDone)
+{
+    // Use chunks small enough to fit into the socket buffers, as we write and
+    // read them from the same thread.
+    static std::vector<char> chunk(64*1024, 'x');
+
+    wxSocketBase& client = theSocketPair->GetClient();
+    wxSocketBase& peer = theSocketPair->GetPeer();
+
+    const size_t numChunks = Bench::GetNumericParameter(16)*16;
+    for ( size_t n = 0; n < numChunks; n++ )
+    {
+        client.Write(&chunk[0], chunk.size());
+        peer.Read(&chunk[0], chunk.size());
+        if ( peer.LastReadCount() != chunk.size() )
+            return false;
+    }
+
+    return true;
+}
+
+#endif // wxUSE_SOCKETS
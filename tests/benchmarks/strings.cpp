@@ -10,6 +10,10 @@
 #include "wx/string.h"
 #include "wx/ffile.h"
 #include "wx/arrstr.h"
+#include "wx/internedstring.h"
+#include "wx/tokenzr.h"
+
+#include <unordered_map>
 
 #include "bench.h"
 #include "htmlparser/htmlpars.h"
@@ -59,6 +63,45 @@ const wxString& GetTestAsciiString()
     return testString;
 }
 
+// Return a big UTF-8 string consisting of the given string repeated many
+// times, the number of repetitions is multiplied by the numeric parameter.
+std::string MakeBigUTF8String(const char* str)
+{
+    long num = Bench::GetNumericParameter();
+    if ( !num )
+        num = 1;
+
+    std::string s;
+    for ( long n = 0; n < 1000*num; n++ )
+        s += str;
+
+    return s;
+}
+
+const std::string& GetBigAsciiUTF8String()
+{
+    static const std::string s = MakeBigUTF8String(asciistr);
+    return s;
+}
+
+const std::string& GetBigMixedUTF8String()
+{
+    static std::string s;
+    if ( s.empty() )
+    {
+        // Mostly ASCII text with occasional non-ASCII characters, as is
+        // typical for the real world data.
+        std::string line;
+        for ( int n = 0; n < 10; n++ )
+            line += asciistr;
+        line += utf8str;
+
+        s = MakeBigUTF8String(line.c_str());
+    }
+
+    return s;
+}
+
 } // anonymous namespace
 
 // this is just a baseline
@@ -116,6 +159,34 @@ BENCHMARK_FUNC(FromUTF8WithLen)
     return true;
 }
 
+BENCHMARK_FUNC(FromUTF8LargeAscii)
+{
+    const std::string& utf8 = GetBigAsciiUTF8String();
+
+    return wxString::FromUTF8(utf8.c_str(), utf8.length()).length() == utf8.length();
+}
+
+BENCHMARK_FUNC(FromUTF8LargeMixed)
+{
+    const std::string& utf8 = GetBigMixedUTF8String();
+
+    return !wxString::FromUTF8(utf8.c_str(), utf8.length()).empty();
+}
+
+BENCHMARK_FUNC(ToUTF8LargeAscii)
+{
+    static const wxString s = wxString::FromUTF8(GetBigAsciiUTF8String());
+
+    return s.utf8_str().length() == s.length();
+}
+
+BENCHMARK_FUNC(ToUTF8LargeMixed)
+{
+    static const wxString s = wxString::FromUTF8(GetBigMixedUTF8String());
+
+    return s.utf8_str().length() == GetBigMixedUTF8String().length();
+}
+
 // ----------------------------------------------------------------------------
 // FromUTF8Unchecked() benchmarks
 // ----------------------------------------------------------------------------
@@ -329,6 +400,138 @@ BENCHMARK_FUNC(ArrStrSort)
     return !a.empty();
 }
 
+// Return the array of file names in random order for sorting benchmarks.
+static const wxArrayString& GetFileNames()
+{
+    static wxArrayString s_names;
+    if ( s_names.empty() )
+    {
+        const long count = Bench::GetNumericParameter(10000);
+        s_names.reserve(count);
+
+        // Use a deterministic pseudo-random order.
+        unsigned long n = 1;
+        for ( long i = 0; i < count; ++i )
+        {
+            n = (n * 1103515245 + 12345) % 2147483648UL;
+            s_names.push_back(wxString::Format("Photo %lu - copy (%lu).jpg",
+                                               n % 1000, n % 97));
+        }
+    }
+
+    return s_names;
+}
+
+BENCHMARK_FUNC(ArrStrSortNatural)
+{
+    wxArrayString a(GetFileNames());
+    a.Sort(wxCmpNaturalGeneric);
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(ArrStrSortNaturalByKey)
+{
+    wxArrayString a(GetFileNames());
+    a.SortByKey(wxSTRING_SORT_NATURAL);
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(ArrStrSortNaturalByKeyParallel)
+{
+    wxArrayString a(GetFileNames());
+    a.SortByKey(wxSTRING_SORT_NATURAL | wxSTRING_SORT_PARALLEL);
+    return !a.empty();
+}
+
+// ----------------------------------------------------------------------------
+// Tokenizing benchmarks
+// ----------------------------------------------------------------------------
+
+// Return a CSV-like string with many short fields for tokenizing benchmarks.
+static const wxString& GetCSVString()
+{
+    static wxString s_csv;
+    if ( s_csv.empty() )
+    {
+        const long count = Bench::GetNumericParameter(10000);
+        for ( long n = 0; n < count; ++n )
+        {
+            s_csv += wxString::Format("%ld,Item number %ld,%ld.%02ld,,in stock;",
+                                      n, n, n % 100, n % 7);
+        }
+    }
+
+    return s_csv;
+}
+
+BENCHMARK_FUNC(Tokenizer)
+{
+    size_t len = 0;
+    wxStringTokenizer tkz(GetCSVString(), ",;");
+    while ( tkz.HasMoreTokens() )
+        len += tkz.GetNextToken().length();
+
+    return len != 0;
+}
+
+BENCHMARK_FUNC(ViewTokenizer)
+{
+    size_t len = 0;
+    wxStringViewTokenizer tkz(GetCSVString(), ",;");
+    while ( tkz.HasMoreTokens() )
+        len += tkz.GetNextToken().size();
+
+    return len != 0;
+}
+
+BENCHMARK_FUNC(TokenizerWhitespace)
+{
+    size_t len = 0;
+    wxStringTokenizer tkz(GetCSVString());
+    while ( tkz.HasMoreTokens() )
+        len += tkz.GetNextToken().length();
+
+    return len != 0;
+}
+
+BENCHMARK_FUNC(ViewTokenizerWhitespace)
+{
+    size_t len = 0;
+    for ( const wxStringTokenView& token : wxStringViewTokenizer(GetCSVString()) )
+        len += token.size();
+
+    return len != 0;
+}
+
+BENCHMARK_FUNC(Split)
+{
+    return !wxSplit(GetCSVString(), ',').empty();
+}
+
+BENCHMARK_FUNC(SplitEscaped)
+{
+    return !wxSplit(GetCSVString(), ',', '\\').empty();
+}
+
+static int wxCMPFUNC_CONV CmpNoCase(const wxString& s1, const wxString& s2)
+{
+    return s1.CmpNoCase(s2);
+}
+
+BENCHMARK_FUNC(ArrStrSortNoCase)
+{
+    wxArrayString a(GetFileNames());
+    a.Sort(CmpNoCase);
+    return !a.empty();
+}
+
+BENCHMARK_FUNC(ArrStrSortNoCaseByKey)
+{
+    wxArrayString a(GetFileNames());
+    a.SortByKey(wxSTRING_SORT_NOCASE);
+    return !a.empty();
+}
+
 BENCHMARK_FUNC(VectorStrPushBack)
 {
     std::vector<wxString> v;
@@ -485,6 +688,72 @@ BENCHMARK_FUNC(CharBuffer)
            wxStrlen(str.wc_str()) == ASCIISTR_LEN;
 }
 
+// ----------------------------------------------------------------------------
+// hash map lookups using wxString and wxInternedString keys
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const int NUM_KEYS = 100;
+
+wxString GetKey(int n)
+{
+    return wxString::Format("some_rather_long_property_name_%d", n);
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC(StringMapLookup)
+{
+    static std::unordered_map<wxString, int> s_map;
+    static wxString s_keys[NUM_KEYS];
+    if ( s_map.empty() )
+    {
+        for ( int n = 0; n < NUM_KEYS; n++ )
+        {
+            s_keys[n] = GetKey(n);
+            s_map[s_keys[n]] = n;
+        }
+    }
+
+    for ( int n = 0; n < NUM_KEYS; n++ )
+    {
+        if ( s_map[s_keys[n]] != n )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(InternedStringMapLookup)
+{
+    static std::unordered_map<wxInternedString, int> s_map;
+    static wxInternedString s_keys[NUM_KEYS];
+    if ( s_map.empty() )
+    {
+        for ( int n = 0; n < NUM_KEYS; n++ )
+        {
+            s_keys[n] = wxInternedString(GetKey(n));
+            s_map[s_keys[n]] = n;
+        }
+    }
+
+    for ( int n = 0; n < NUM_KEYS; n++ )
+    {
+        if ( s_map[s_keys[n]] != n )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC(InternString)
+{
+    static const wxString s_key = GetKey(0);
+    return !wxInternedString(s_key).empty();
+}
+
 
 // ----------------------------------------------------------------------------
 // wxString::operator[] - parse large HTML page
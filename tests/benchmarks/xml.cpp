@@ -0,0 +1,197 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/xml.cpp
+// Purpose:     wxXmlDocument and wxXmlReader benchmarks
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "bench.h"
+
+#if wxUSE_XML
+
+#include "wx/ffile.h"
+#include "wx/mstream.h"
+#include "wx/stopwatch.h"
+#include "wx/xml/xml.h"
+
+#include <memory>
+#include <string>
+
+namespace
+{
+
+// The XML data used by the benchmarks: either the contents of the file given
+// by the string parameter or the synthetic document with the number of
+// records given by the numeric parameter.
+std::string theXmlData;
+
+// Time spent in the different phases of all the benchmark iterations.
+wxLongLong theLoadTime,
+           theTraverseTime,
+           theFreeTime;
+long theIterations = 0;
+
+bool XmlInit()
+{
+    const wxString filename = Bench::GetStringParameter();
+    if ( !filename.empty() )
+    {
+        wxFFile file(filename, "rb");
+        if ( !file.IsOpened() )
+            return false;
+
+        theXmlData.resize(file.Length());
+        if ( file.Read(&theXmlData[0], theXmlData.size()) != theXmlData.size() )
+            return false;
+    }
+    else
+    {
+        const long numRecords = Bench::GetNumericParameter(10000);
+
+        theXmlData = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<records>\n";
+        for ( long n = 0; n < numRecords; n++ )
+        {
+            const std::string id = std::to_string(n);
+
+            theXmlData += "  <record id=\"" + id + "\" type=\"item\" "
+                          "status=\"active\">\n"
+                          "    <name>Item " + id + "</name>\n"
+                          "    <description>This is the description of the "
+                          "item number " + id + " which is long enough to "
+                          "not be stored inline.</description>\n"
+                          "    <value unit=\"kg\">" + id + ".5</value>\n"
+                          "    <!-- comment -->\n"
+                          "  </record>\n";
+        }
+        theXmlData += "</records>\n";
+    }
+
+    theLoadTime =
+    theTraverseTime =
+    theFreeTime = 0;
+    theIterations = 0;
+
+    return true;
+}
+
+void XmlDone()
+{
+    if ( theIterations )
+    {
+        wxPrintf("%.1f MB of XML, per iteration: load %.2fms, "
+                 "traverse %.2fms, free %.2fms\n",
+                 theXmlData.size() / 1024. / 1024.,
+                 theLoadTime.ToDouble() / theIterations / 1000.,
+                 theTraverseTime.ToDouble() / theIterations / 1000.,
+                 theFreeTime.ToDouble() / theIterations / 1000.);
+    }
+
+    theXmlData.clear();
+    theXmlData.shrink_to_fit();
+}
+
+// Access all the data of the given node and its children.
+size_t Traverse(const wxXmlNode* node)
+{
+    size_t total = 0;
+    for ( ; node; node = node->GetNext() )
+    {
+        total += node->GetName().length() + node->GetContent().length();
+
+        for ( const wxXmlAttribute* attr = node->GetAttributes();
+              attr;
+              attr = attr->GetNext() )
+        {
+            total += attr->GetName().length() + attr->GetValue().length();
+        }
+
+        total += Traverse(node->GetChildren());
+    }
+
+    return total;
+}
+
+bool DoXmlLoadTraverseFree(int flags)
+{
+    wxStopWatch sw;
+
+    wxMemoryInputStream stream(theXmlData.data(), theXmlData.size());
+    std::unique_ptr<wxXmlDocument> doc(new wxXmlDocument());
+    if ( !doc->Load(stream, flags) )
+        return false;
+
+    theLoadTime += sw.TimeInMicro();
+    sw.Start();
+
+    const size_t total = Traverse(doc->GetRoot());
+
+    theTraverseTime += sw.TimeInMicro();
+    sw.Start();
+
+    doc.reset();
+
+    theFreeTime += sw.TimeInMicro();
+    theIterations++;
+
+    return total != 0;
+}
+
+} // anonymous namespace
+
+// Use the numeric parameter to change the number of records in the generated
+// document or the string one to load the given file instead.
+BENCHMARK_FUNC_WITH_INIT(XmlLoad, XmlInit, XmlDone)
+{
+    return DoXmlLoadTraverseFree(wxXMLDOC_NONE);
+}
+
+BENCHMARK_FUNC_WITH_INIT(XmlLoadCompact, XmlInit, XmlDone)
+{
+    return DoXmlLoadTraverseFree(wxXMLDOC_COMPACT);
+}
+
+// Access the same data as Traverse() does using wxXmlReader.
+BENCHMARK_FUNC_WITH_INIT(XmlReader, XmlInit, XmlDone)
+{
+    wxStopWatch sw;
+
+    wxMemoryInputStream stream(theXmlData.data(), theXmlData.size());
+    wxXmlReader reader(stream);
+
+    size_t total = 0;
+    for ( ;; )
+    {
+        switch ( reader.Next() )
+        {
+            case wxXML_READER_EOF:
+                theLoadTime += sw.TimeInMicro();
+                theIterations++;
+                return total != 0;
+
+            case wxXML_READER_ERROR:
+                return false;
+
+            case wxXML_READER_START_ELEMENT:
+                total += reader.GetName().length();
+                for ( size_t n = 0; n < reader.GetAttributeCount(); n++ )
+                {
+                    total += reader.GetAttributeName(n).length() +
+                                reader.GetAttributeValue(n).length();
+                }
+                break;
+
+            case wxXML_READER_END_ELEMENT:
+                break;
+
+            case wxXML_READER_TEXT:
+            case wxXML_READER_CDATA:
+            case wxXML_READER_COMMENT:
+            case wxXML_READER_PI:
+                total += reader.GetName().length() + reader.GetText().length();
+                break;
+        }
+    }
+}
+
+#endif // wxUSE_XML
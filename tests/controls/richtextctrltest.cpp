@@ -17,6 +17,8 @@
 
 #include "wx/richtext/richtextctrl.h"
 #include "wx/richtext/richtextstyles.h"
+#include "wx/richtext/richtextxml.h"
+#include "wx/mstream.h"
 #include "testableframe.h"
 #include "asserthelper.h"
 #include "wx/uiaction.h"
@@ -41,6 +43,8 @@ private:
         WXUISIM_TEST( TextEvent );
         CPPUNIT_TEST( CutCopyPaste );
         CPPUNIT_TEST( UndoRedo );
+        CPPUNIT_TEST( UndoStyleChange );
+        CPPUNIT_TEST( UndoMergeTyping );
         CPPUNIT_TEST( CaretPosition );
         CPPUNIT_TEST( Selection );
         WXUISIM_TEST( Editable );
@@ -60,6 +64,11 @@ private:
         CPPUNIT_TEST( Delete );
         CPPUNIT_TEST( Url );
         CPPUNIT_TEST( Table );
+        CPPUNIT_TEST( ParagraphAtPosition );
+        CPPUNIT_TEST( ListStyleUndo );
+        CPPUNIT_TEST( IncrementalLayout );
+        CPPUNIT_TEST( IncrementalLayoutEdit );
+        CPPUNIT_TEST( XMLRoundTrip );
     CPPUNIT_TEST_SUITE_END();
 
     void IsModified();
@@ -72,6 +81,8 @@ private:
     void TextEvent();
     void CutCopyPaste();
     void UndoRedo();
+    void UndoStyleChange();
+    void UndoMergeTyping();
     void CaretPosition();
     void Selection();
     void Editable();
@@ -91,6 +102,11 @@ private:
     void Delete();
     void Url();
     void Table();
+    void ParagraphAtPosition();
+    void ListStyleUndo();
+    void IncrementalLayout();
+    void IncrementalLayoutEdit();
+    void XMLRoundTrip();
 
     wxRichTextCtrl* m_rich;
 
@@ -338,6 +354,102 @@ void RichTextCtrlTestCase::UndoRedo()
     m_rich->EndSuppressUndo();
 }
 
+void RichTextCtrlTestCase::UndoStyleChange()
+{
+    m_rich->SetValue("one two three four");
+
+    m_rich->SetSelection(4, 8);
+    m_rich->ApplyBoldToSelection();
+    m_rich->SetSelection(8, 14);
+    m_rich->ApplyBoldToSelection();
+
+    // Style changes must not store the copies of the paragraphs.
+    wxRichTextCommand* const
+        cmd = dynamic_cast<wxRichTextCommand*>(m_rich->GetCommandProcessor()->GetCurrentCommand());
+    CPPUNIT_ASSERT( cmd );
+    wxRichTextAction* const
+        action = (wxRichTextAction*)cmd->GetActions().GetFirst()->GetData();
+    CPPUNIT_ASSERT( action->HasStyleChange() );
+    CPPUNIT_ASSERT( action->GetOldParagraphs().IsEmpty() );
+    CPPUNIT_ASSERT( action->GetNewParagraphs().IsEmpty() );
+
+    // Merge "two three " into a single object, undoing must split it again.
+    wxRichTextDrawingContext context(&m_rich->GetBuffer());
+    m_rich->GetBuffer().Defragment(context);
+    m_rich->GetBuffer().UpdateRanges();
+
+    wxTextAttr attr;
+    m_rich->Undo();
+    CPPUNIT_ASSERT( m_rich->GetStyle(5, attr) );
+    CPPUNIT_ASSERT_EQUAL( wxFONTWEIGHT_BOLD, attr.GetFontWeight() );
+    CPPUNIT_ASSERT( m_rich->GetStyle(9, attr) );
+    CPPUNIT_ASSERT_EQUAL( wxFONTWEIGHT_NORMAL, attr.GetFontWeight() );
+
+    m_rich->Undo();
+    CPPUNIT_ASSERT( m_rich->GetStyle(5, attr) );
+    CPPUNIT_ASSERT_EQUAL( wxFONTWEIGHT_NORMAL, attr.GetFontWeight() );
+
+    m_rich->Redo();
+    m_rich->Redo();
+    CPPUNIT_ASSERT( m_rich->GetStyle(9, attr) );
+    CPPUNIT_ASSERT_EQUAL( wxFONTWEIGHT_BOLD, attr.GetFontWeight() );
+    CPPUNIT_ASSERT( m_rich->GetStyle(15, attr) );
+    CPPUNIT_ASSERT_EQUAL( wxFONTWEIGHT_NORMAL, attr.GetFontWeight() );
+    CPPUNIT_ASSERT_EQUAL( "one two three four", m_rich->GetValue() );
+
+    // The commands which can be redone are never discarded.
+    wxCommandProcessor* const proc = m_rich->GetCommandProcessor();
+    CPPUNIT_ASSERT_EQUAL( 2, proc->GetCommands().GetCount() );
+    m_rich->Undo();
+    m_rich->Undo();
+    m_rich->GetBuffer().SetUndoMemoryLimit(1);
+    CPPUNIT_ASSERT_EQUAL( 2, proc->GetCommands().GetCount() );
+    m_rich->Redo();
+    CPPUNIT_ASSERT_EQUAL( 2, proc->GetCommands().GetCount() );
+    proc->MarkAsSaved();
+    CPPUNIT_ASSERT( !proc->IsDirty() );
+
+    // The oldest commands are discarded when the memory limit is exceeded,
+    // but the document remains modified even if the saved one was discarded.
+    m_rich->Redo();
+    CPPUNIT_ASSERT_EQUAL( "one two three four", m_rich->GetValue() );
+    m_rich->GetBuffer().SetUndoMemoryLimit(1);
+    CPPUNIT_ASSERT_EQUAL( 1, proc->GetCommands().GetCount() );
+    CPPUNIT_ASSERT( proc->IsDirty() );
+    m_rich->Undo();
+    CPPUNIT_ASSERT( proc->IsDirty() );
+    m_rich->Redo();
+    CPPUNIT_ASSERT( proc->IsDirty() );
+}
+
+void RichTextCtrlTestCase::UndoMergeTyping()
+{
+    m_rich->GetBuffer().SetMergeTypingUndo(true);
+
+    // Simulate typing in the same way as the key handler does.
+    const wxString text("ab cd");
+    for ( wxString::const_iterator it = text.begin(); it != text.end(); ++it )
+    {
+        m_rich->BeginBatchUndo("Insert Text");
+        m_rich->WriteText(wxString(*it));
+        m_rich->EndBatchUndo();
+    }
+
+    CPPUNIT_ASSERT_EQUAL( "ab cd", m_rich->GetValue() );
+    CPPUNIT_ASSERT_EQUAL( 2, m_rich->GetCommandProcessor()->GetCommands().GetCount() );
+
+    m_rich->Undo();
+    CPPUNIT_ASSERT_EQUAL( "ab ", m_rich->GetValue() );
+
+    m_rich->Undo();
+    CPPUNIT_ASSERT_EQUAL( "", m_rich->GetValue() );
+    CPPUNIT_ASSERT( !m_rich->CanUndo() );
+
+    m_rich->Redo();
+    m_rich->Redo();
+    CPPUNIT_ASSERT_EQUAL( "ab cd", m_rich->GetValue() );
+}
+
 void RichTextCtrlTestCase::CaretPosition()
 {
     m_rich->AddParagraph("This is paragraph one");
@@ -878,4 +990,249 @@ void RichTextCtrlTestCase::Table()
     m_rich->SetFocusObject(nullptr);
 }
 
+// Helper function for ::ParagraphAtPosition()
+void CheckParagraphsAtPositions(wxRichTextBuffer& buffer)
+{
+    const size_t count = buffer.GetChildCount();
+    CPPUNIT_ASSERT( count > 1 );
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxRichTextParagraph* para = wxDynamicCast(buffer.GetChild(n), wxRichTextParagraph);
+        CPPUNIT_ASSERT( para );
+
+        const wxRichTextRange range = para->GetRange();
+        CPPUNIT_ASSERT( buffer.GetParagraphAtPosition(range.GetStart()) == para );
+        CPPUNIT_ASSERT( buffer.GetParagraphAtPosition(range.GetEnd()) == para );
+        CPPUNIT_ASSERT( buffer.GetParagraphAtPosition(range.GetStart() - 1, true) == para );
+    }
+
+    CPPUNIT_ASSERT( !buffer.GetParagraphAtPosition(-2) );
+    CPPUNIT_ASSERT( !buffer.GetParagraphAtPosition(buffer.GetChild(count - 1)->GetRange().GetEnd() + 1) );
+
+    // The ranges updated after editing must be the same as when recomputing
+    // all of them.
+    wxVector<wxRichTextRange> ranges;
+    for ( size_t n = 0; n < count; n++ )
+        ranges.push_back(buffer.GetChild(n)->GetRange());
+    const wxRichTextRange ownRange = buffer.GetOwnRange();
+
+    buffer.UpdateRanges();
+
+    for ( size_t n = 0; n < count; n++ )
+        CPPUNIT_ASSERT( ranges[n] == buffer.GetChild(n)->GetRange() );
+    CPPUNIT_ASSERT( ownRange == buffer.GetOwnRange() );
+}
+
+void RichTextCtrlTestCase::ParagraphAtPosition()
+{
+    for ( int n = 0; n < 100; n++ )
+        m_rich->AddParagraph(wxString::Format("Paragraph %d", n));
+
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    CheckParagraphsAtPositions(buffer);
+
+    // Check that the paragraphs are still found after adding and removing
+    // some of them.
+    const size_t count = buffer.GetChildCount();
+    const wxRichTextRange range = buffer.GetChild(50)->GetRange();
+    m_rich->SetInsertionPoint(range.GetStart() + 2);
+    m_rich->WriteText("new\nparagraph");
+    CPPUNIT_ASSERT_EQUAL( count + 1, buffer.GetChildCount() );
+    CheckParagraphsAtPositions(buffer);
+
+    m_rich->Delete(buffer.GetChild(10)->GetRange());
+    CPPUNIT_ASSERT_EQUAL( count, buffer.GetChildCount() );
+    CheckParagraphsAtPositions(buffer);
+
+    m_rich->Undo();
+    CPPUNIT_ASSERT_EQUAL( count + 1, buffer.GetChildCount() );
+    CheckParagraphsAtPositions(buffer);
+
+    m_rich->Undo();
+    CPPUNIT_ASSERT_EQUAL( count, buffer.GetChildCount() );
+    CheckParagraphsAtPositions(buffer);
+}
+
+void RichTextCtrlTestCase::ListStyleUndo()
+{
+    for ( int n = 0; n < 20; n++ )
+        m_rich->AddParagraph(wxString::Format("Paragraph %d", n));
+
+    wxRichTextListStyleDefinition def("Numbered List");
+    for ( int level = 0; level < 10; level++ )
+    {
+        def.SetAttributes(level, 60*(level + 1), 60,
+                          wxTEXT_ATTR_BULLET_STYLE_ARABIC |
+                          wxTEXT_ATTR_BULLET_STYLE_PERIOD);
+    }
+
+    // Changing the list style replaces all the paragraphs in the range, check
+    // that they can still be found by position afterwards.
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    const wxRichTextRange range(buffer.GetChild(5)->GetRange().GetStart(),
+                                buffer.GetChild(15)->GetRange().GetEnd());
+    CPPUNIT_ASSERT( m_rich->SetListStyle(range, &def) );
+    CheckParagraphsAtPositions(buffer);
+
+    wxRichTextAttr attr;
+    CPPUNIT_ASSERT( m_rich->GetStyle(range.GetStart() + 1, attr) );
+    CPPUNIT_ASSERT( attr.HasBulletStyle() );
+    CPPUNIT_ASSERT( m_rich->GetStyle(range.GetEnd() - 1, attr) );
+    CPPUNIT_ASSERT( attr.HasBulletStyle() );
+
+    m_rich->Undo();
+    CheckParagraphsAtPositions(buffer);
+    CPPUNIT_ASSERT( m_rich->GetStyle(range.GetStart() + 1, attr) );
+    CPPUNIT_ASSERT( !attr.HasBulletStyle() );
+
+    m_rich->Redo();
+    CheckParagraphsAtPositions(buffer);
+    CPPUNIT_ASSERT( m_rich->GetStyle(range.GetEnd() - 1, attr) );
+    CPPUNIT_ASSERT( attr.HasBulletStyle() );
+
+    CPPUNIT_ASSERT( m_rich->ClearListStyle(range) );
+    CheckParagraphsAtPositions(buffer);
+    CPPUNIT_ASSERT( m_rich->GetStyle(range.GetStart() + 1, attr) );
+    CPPUNIT_ASSERT( !attr.HasBulletStyle() );
+}
+
+void RichTextCtrlTestCase::IncrementalLayout()
+{
+    EventCounter complete(m_rich, wxEVT_RICHTEXT_LAYOUT_COMPLETE);
+
+    m_rich->SetDelayedLayoutThreshold(100);
+
+    wxString text;
+    for ( int n = 0; n < 500; n++ )
+        text << "This is the paragraph number " << n << "\n";
+    m_rich->SetValue(text);
+    m_rich->LayoutContent();
+
+    // Only the visible part of the buffer should have been laid out.
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    CPPUNIT_ASSERT( m_rich->GetIncrementalLayoutRequired() );
+    CPPUNIT_ASSERT( buffer.GetFirstEstimatedParagraph() );
+    CPPUNIT_ASSERT( buffer.GetCachedSize().y > m_rich->GetClientSize().y );
+    CPPUNIT_ASSERT_EQUAL( 0, complete.GetCount() );
+
+    m_rich->ForceDelayedLayout();
+
+    CPPUNIT_ASSERT( !m_rich->GetIncrementalLayoutRequired() );
+    CPPUNIT_ASSERT( !buffer.GetFirstEstimatedParagraph() );
+    CPPUNIT_ASSERT_EQUAL( 1, complete.GetCount() );
+
+    // Everything must be laid out in the same way as when doing it at once.
+    const int height = buffer.GetCachedSize().y;
+    const long lastPos = m_rich->GetLastPosition();
+    const int lastY = buffer.GetLineAtPosition(lastPos)->GetAbsolutePosition().y;
+
+    m_rich->SetDelayedLayoutThreshold(LONG_MAX);
+    buffer.Invalidate(wxRICHTEXT_ALL);
+    m_rich->LayoutContent();
+
+    CPPUNIT_ASSERT( !m_rich->GetIncrementalLayoutRequired() );
+    CPPUNIT_ASSERT_EQUAL( height, buffer.GetCachedSize().y );
+    CPPUNIT_ASSERT_EQUAL( lastY, buffer.GetLineAtPosition(lastPos)->GetAbsolutePosition().y );
+}
+
+void RichTextCtrlTestCase::IncrementalLayoutEdit()
+{
+    m_rich->SetDelayedLayoutThreshold(100);
+
+    wxString text;
+    for ( int n = 0; n < 500; n++ )
+        text << "This is the paragraph number " << n << "\n";
+    m_rich->SetValue(text);
+    m_rich->LayoutContent();
+
+    CPPUNIT_ASSERT( m_rich->GetIncrementalLayoutRequired() );
+
+    // Lay out the end of the buffer on demand and scroll back to the top.
+    m_rich->ShowPosition(m_rich->GetLastPosition());
+    m_rich->ShowPosition(0);
+
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    wxRichTextParagraph* const
+        para = buffer.GetParagraphAtPosition(m_rich->XYToPosition(0, 490));
+    CPPUNIT_ASSERT( para );
+    CPPUNIT_ASSERT( !para->GetLines().empty() );
+
+    // Make this paragraph, which is below the visible part of the window,
+    // long enough to wrap while the incremental layout is still pending.
+    buffer.InsertTextWithUndo(para->GetRange().GetStart(),
+                              wxString('x', 1000) + " ", m_rich);
+
+    CPPUNIT_ASSERT( m_rich->GetIncrementalLayoutRequired() );
+
+    m_rich->ForceDelayedLayout();
+
+    // The lines of the paragraph must cover all of its new range.
+    const wxRichTextLineVector& lines = para->GetLines();
+    CPPUNIT_ASSERT( lines.size() > 1 );
+    CPPUNIT_ASSERT_EQUAL( para->GetRange().GetStart(),
+                          lines.front()->GetAbsoluteRange().GetStart() );
+    CPPUNIT_ASSERT_EQUAL( para->GetRange().GetEnd(),
+                          lines.back()->GetAbsoluteRange().GetEnd() );
+
+    // And everything must be laid out in the same way as when doing it at
+    // once.
+    const int height = buffer.GetCachedSize().y;
+    const long lastPos = m_rich->GetLastPosition();
+    const int lastY = buffer.GetLineAtPosition(lastPos)->GetAbsolutePosition().y;
+
+    m_rich->SetDelayedLayoutThreshold(LONG_MAX);
+    buffer.Invalidate(wxRICHTEXT_ALL);
+    m_rich->LayoutContent();
+
+    CPPUNIT_ASSERT_EQUAL( height, buffer.GetCachedSize().y );
+    CPPUNIT_ASSERT_EQUAL( lastY, buffer.GetLineAtPosition(lastPos)->GetAbsolutePosition().y );
+}
+
+void RichTextCtrlTestCase::XMLRoundTrip()
+{
+    m_rich->WriteText("Plain <text> & ");
+    m_rich->BeginBold();
+    m_rich->WriteText("bold");
+    m_rich->EndBold();
+    m_rich->Newline();
+    m_rich->BeginTextColour(*wxRED);
+    m_rich->WriteText(wxString::FromUTF8("red \xc3\xa9t\xc3\xa9 "));
+    m_rich->EndTextColour();
+    m_rich->BeginBold();
+    m_rich->WriteText("bold again");
+    m_rich->EndBold();
+
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    buffer.GetProperties().SetProperty("custom", "value");
+
+    wxRichTextXMLHandler handler;
+    wxMemoryOutputStream out;
+    CPPUNIT_ASSERT( handler.SaveFile(&buffer, out) );
+
+    wxMemoryInputStream in(out);
+    wxRichTextBuffer loaded;
+    CPPUNIT_ASSERT( handler.LoadFile(&loaded, in) );
+
+    CPPUNIT_ASSERT_EQUAL( buffer.GetText(), loaded.GetText() );
+    CPPUNIT_ASSERT_EQUAL( buffer.GetChildCount(), loaded.GetChildCount() );
+    CPPUNIT_ASSERT_EQUAL( "value", loaded.GetProperties().GetPropertyString("custom") );
+
+    const long positions[] = { 0, 16, 22, 28, 33 };
+    for ( size_t n = 0; n < WXSIZEOF(positions); n++ )
+    {
+        wxRichTextAttr attr, attrLoaded;
+        CPPUNIT_ASSERT( buffer.GetStyle(positions[n], attr) );
+        CPPUNIT_ASSERT( loaded.GetStyle(positions[n], attrLoaded) );
+        CPPUNIT_ASSERT_EQUAL( attr.GetFontWeight(), attrLoaded.GetFontWeight() );
+        CPPUNIT_ASSERT_EQUAL( attr.GetTextColour(), attrLoaded.GetTextColour() );
+    }
+
+    // Loading a truncated document must fail without leaving partial contents.
+    wxMemoryInputStream inTruncated(out.GetOutputStreamBuffer()->GetBufferStart(),
+                                    out.GetLength() / 2);
+    CPPUNIT_ASSERT( !handler.LoadFile(&loaded, inTruncated) );
+    CPPUNIT_ASSERT( loaded.GetText().empty() );
+}
+
 #endif //wxUSE_RICHTEXT
@@ -1389,6 +1389,77 @@ TEST_CASE("wxDateTime::ParseISO", "[datetime]")
     }
 }
 
+TEST_CASE("wxDateTimeFormatter", "[datetime]")
+{
+    const wxDateTime dt(21, wxDateTime::Mar, 2006, 13, 42, 17, 123);
+
+    SECTION("Format")
+    {
+        static const char* const formats[] =
+        {
+            "%Y-%m-%d",
+            "%Y-%m-%dT%H:%M:%S",
+            "%Y-%m-%d %H:%M:%S.%l",
+            "%d/%m/%y",
+            "%%Y=%Y%%",
+            "%Y %j %c",
+            "%4Y-%-d",
+        };
+
+        for ( size_t n = 0; n < WXSIZEOF(formats); n++ )
+        {
+            INFO("Format: " << formats[n]);
+
+            const wxDateTimeFormatter fmt(formats[n]);
+            CHECK( fmt.Format(dt) == dt.Format(formats[n]) );
+            CHECK( fmt.Format(dt, wxDateTime::UTC) ==
+                    dt.Format(formats[n], wxDateTime::UTC) );
+        }
+
+        const wxDateTime dtOld(1, wxDateTime::Feb, 123);
+        CHECK( wxDateTimeFormatter("%F").Format(dtOld) == "0123-02-01" );
+
+        const wxDateTimeFormatter
+            rfc("%a, %d %b %Y %H:%M:%S %z", wxDateTimeFormatter::Flag_EnglishNames);
+        CHECK( rfc.Format(dt, wxDateTime::UTC) ==
+                dt.Format("%a, %d %b %Y %H:%M:%S", wxDateTime::UTC) + " +0000" );
+    }
+
+    SECTION("Parse")
+    {
+        const wxDateTimeFormatter fmt("%Y-%m-%dT%H:%M:%S");
+
+        wxDateTime dtParsed;
+        REQUIRE( fmt.Parse("2006-03-21T13:42:17", &dtParsed) );
+        CHECK( dtParsed == wxDateTime(21, wxDateTime::Mar, 2006, 13, 42, 17) );
+
+        // This doesn't use the fixed width fields, but must still work.
+        REQUIRE( fmt.Parse("2006-3-21T1:2:3", &dtParsed) );
+        CHECK( dtParsed == wxDateTime(21, wxDateTime::Mar, 2006, 1, 2, 3) );
+
+        CHECK( !fmt.Parse("2006-02-30T13:42:17", &dtParsed) );
+        CHECK( !fmt.Parse("2006-03-21T24:42:17", &dtParsed) );
+        CHECK( !fmt.Parse("2006-03-21", &dtParsed) );
+
+        // Trailing characters are only allowed if the end is requested.
+        CHECK( !fmt.Parse("2006-03-21T13:42:17Z", &dtParsed) );
+
+        const wxString str("2006-03-21T13:42:17Z");
+        wxString::const_iterator end;
+        REQUIRE( fmt.Parse(str, &dtParsed, &end) );
+        CHECK( end == str.end() - 1 );
+
+        const wxDateTimeFormatter
+            rfc("%a, %d %b %Y %H:%M:%S %z", wxDateTimeFormatter::Flag_EnglishNames);
+        REQUIRE( rfc.Parse("Tue, 21 Mar 2006 13:42:17 +0100", &dtParsed) );
+        CHECK( dtParsed ==
+                wxDateTime(21, wxDateTime::Mar, 2006, 12, 42, 17).FromUTC() );
+
+        // Week day doesn't correspond to the date.
+        CHECK( !rfc.Parse("Wed, 21 Mar 2006 13:42:17 +0100", &dtParsed) );
+    }
+}
+
 TEST_CASE("wxDateTime::ParseDateTime", "[datetime]")
 {
     wxGCC_WARNING_SUPPRESS(missing-field-initializers)
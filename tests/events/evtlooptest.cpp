@@ -13,8 +13,11 @@
 #include "testprec.h"
 
 
+#include "wx/app.h"
 #include "wx/timer.h"
 
+#include <thread>
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -122,3 +125,46 @@ void EvtloopTestCase::TestExit()
     timerRun2.StartOnce(1);
     CPPUNIT_ASSERT_EQUAL( EXIT_CODE_OUTER_LOOP, loopOuter.Run() );
 }
+
+#if wxUSE_THREADS
+
+// Check that the loop is still woken up after Pending() found the wake up
+// request made by an idle handler.
+TEST_CASE("wxEventLoop::WakeUpAfterPending", "[evtloop]")
+{
+    wxEventLoop loop;
+    wxEventLoopActivator activate(&loop);
+
+    int idleCount = 0;
+    auto onIdle = [&idleCount](wxIdleEvent& event)
+    {
+        // Request to wake up and continue generating idle events, so that
+        // Pending() is called before dispatching the events.
+        if ( ++idleCount == 1 )
+        {
+            wxWakeUpIdle();
+            event.RequestMore();
+        }
+    };
+    wxTheApp->Bind(wxEVT_IDLE, onIdle);
+
+    // Exit the loop from another thread, which relies on it being woken up.
+    std::thread thread([&loop]()
+    {
+        wxMilliSleep(100);
+        wxTheApp->CallAfter([&loop]() { loop.Exit(); });
+    });
+
+    // Stop waiting if the loop is not woken up, to avoid hanging the tests.
+    ScheduleLoopExitTimer timerExit(loop, EXIT_CODE_INNER_LOOP);
+    timerExit.StartOnce(2000);
+
+    const int rc = loop.Run();
+    timerExit.Stop();
+    thread.join();
+    wxTheApp->Unbind(wxEVT_IDLE, onIdle);
+
+    CHECK( rc == 0 );
+}
+
+#endif // wxUSE_THREADS
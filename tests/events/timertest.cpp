@@ -21,6 +21,8 @@
 #include "wx/evtloop.h"
 #include "wx/timer.h"
 
+#include <memory>
+
 // --------------------------------------------------------------------------
 // helper class counting the number of timer events
 // --------------------------------------------------------------------------
@@ -137,3 +139,65 @@ void TimerEventTestCase::Multiple()
     // more than one
     CPPUNIT_ASSERT( numTicks > 1 );
 }
+
+TEST_CASE("wxTimer::Order", "[timer]")
+{
+    class OrderHandler : public wxEvtHandler
+    {
+    public:
+        OrderHandler(wxEventLoopBase& loop, size_t count)
+            : m_loop(loop),
+              m_count(count)
+        {
+            Bind(wxEVT_TIMER, &OrderHandler::OnTimer, this);
+        }
+
+        const std::vector<int>& GetIds() const { return m_ids; }
+
+    private:
+        void OnTimer(wxTimerEvent& event)
+        {
+            m_ids.push_back(event.GetId());
+            if ( m_ids.size() == m_count )
+                m_loop.Exit();
+        }
+
+        wxEventLoopBase& m_loop;
+        const size_t m_count;
+        std::vector<int> m_ids;
+    };
+
+    wxEventLoop loop;
+
+    // Start the timers in an order different from their expiration order.
+    const int delays[] = { 250, 50, 200, 100, 150 };
+    OrderHandler handler(loop, WXSIZEOF(delays));
+
+    std::vector<std::unique_ptr<wxTimer>> timers;
+    for ( size_t n = 0; n < WXSIZEOF(delays); n++ )
+    {
+        timers.emplace_back(new wxTimer(&handler, n));
+        timers.back()->StartOnce(delays[n]);
+    }
+
+    // Restarting the first timer with a shorter delay should move it first.
+    timers[0]->StartOnce(10);
+    CHECK( timers[0]->IsRunning() );
+
+    // And stopping a timer should prevent it from being notified.
+    timers[2]->Stop();
+    timers[2]->StartOnce(300);
+    timers[2]->Stop();
+    CHECK( !timers[2]->IsRunning() );
+
+    // Restart it to have the expected number of events.
+    timers[2]->StartOnce(300);
+
+    loop.Run();
+
+    const std::vector<int> expected = { 0, 1, 3, 4, 2 };
+    CHECK( handler.GetIds() == expected );
+
+    for ( const auto& timer : timers )
+        CHECK( !timer->IsRunning() );
+}
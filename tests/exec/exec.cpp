@@ -372,6 +372,121 @@ TEST_CASE_METHOD(ExecTestCase, "wxExecute::AsyncRedirect", "[exec]")
     DoTestAsyncRedirect(COMMAND_STDERR, Check_Stderr, "file");
 }
 
+#ifdef __UNIX__
+
+// This class collects the output of the child process received in the output
+// events and exits the event loop when it terminates.
+class TestOutputEventsProcess : public TestAsyncProcess
+{
+public:
+    TestOutputEventsProcess()
+    {
+        Redirect();
+        EnableOutputEvents();
+
+        Bind(wxEVT_PROCESS_OUTPUT, &TestOutputEventsProcess::OnOutput, this);
+    }
+
+    virtual void OnTerminate(int pid, int status) override
+    {
+        m_terminated = true;
+
+        TestAsyncProcess::OnTerminate(pid, status);
+    }
+
+    wxString m_output,
+             m_error;
+    bool m_outputAfterTermination = false;
+
+private:
+    void OnOutput(wxProcessOutputEvent& event)
+    {
+        CHECK( event.GetPid() == GetPid() );
+
+        if ( m_terminated )
+            m_outputAfterTermination = true;
+
+        (event.IsError() ? m_error : m_output) += event.GetText();
+    }
+
+    bool m_terminated = false;
+};
+
+TEST_CASE_METHOD(ExecTestCase, "wxExecute::OutputEvents", "[exec]")
+{
+    AsyncInEventLoop asyncInEventLoop;
+    TestOutputEventsProcess proc;
+
+    // Produce enough output to fill the pipe buffer several times.
+    CHECK( asyncInEventLoop.DoExecute(
+                       AsyncExec_DontExitLoop,
+                       "sh -c 'seq 1 100000; echo done >&2'",
+                       wxEXEC_ASYNC, &proc) != 0 );
+
+    CHECK( !proc.m_outputAfterTermination );
+    CHECK( proc.GetInputStream() == nullptr );
+    CHECK( proc.GetErrorStream() == nullptr );
+
+    CHECK( proc.m_output.length() == 588895 );
+    CHECK( proc.m_output.StartsWith("1\n2\n3\n") );
+    CHECK( proc.m_output.EndsWith("\n99999\n100000\n") );
+    CHECK( proc.m_error == "done\n" );
+}
+
+TEST_CASE("wxExecute::RedirectToFiles", "[exec]")
+{
+    const wxString fnOut = wxFileName::CreateTempFileName("execout");
+    const wxString fnErr = wxFileName::CreateTempFileName("execerr");
+    wxON_BLOCK_EXIT1( wxRemoveFile, fnOut );
+    wxON_BLOCK_EXIT1( wxRemoveFile, fnErr );
+
+    const auto readFile = [](const wxString& fn)
+    {
+        wxFile file(fn);
+        wxString contents;
+        REQUIRE( file.ReadAll(&contents) );
+        return contents;
+    };
+
+    SECTION("Separate")
+    {
+        wxProcess proc;
+        proc.RedirectToFiles(fnOut, fnErr);
+        CHECK( wxExecute("sh -c 'echo out; echo err >&2'", wxEXEC_SYNC, &proc) == 0 );
+
+        CHECK( readFile(fnOut) == "out\n" );
+        CHECK( readFile(fnErr) == "err\n" );
+    }
+
+    SECTION("Same")
+    {
+        wxProcess proc;
+        proc.RedirectToFiles(fnOut, fnOut);
+        CHECK( wxExecute("sh -c 'echo out; echo err >&2'", wxEXEC_SYNC, &proc) == 0 );
+
+        CHECK( readFile(fnOut) == "out\nerr\n" );
+    }
+
+    SECTION("Stderr")
+    {
+        // Only stdout is redirected to the file, stderr is still available
+        // from the stream.
+        wxProcess proc;
+        proc.Redirect();
+        proc.RedirectToFiles(fnOut);
+        CHECK( wxExecute("sh -c 'echo out; echo err >&2'", wxEXEC_SYNC, &proc) == 0 );
+
+        CHECK( readFile(fnOut) == "out\n" );
+
+        CHECK( proc.GetInputStream() == nullptr );
+        REQUIRE( proc.GetErrorStream() );
+        wxTextInputStream tis(*proc.GetErrorStream());
+        CHECK( tis.ReadLine() == "err" );
+    }
+}
+
+#endif // __UNIX__
+
 // static
 wxString ExecTestCase::CreateSleepFile(const wxString& basename, int seconds)
 {
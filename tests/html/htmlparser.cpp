@@ -22,6 +22,7 @@
 #include "wx/html/winpars.h"
 
 #include <memory>
+#include <vector>
 
 // Test that parsing invalid HTML simply fails but doesn't crash for example.
 TEST_CASE("wxHtmlParser::ParseInvalid", "[html][parser][error]")
@@ -42,6 +43,48 @@ TEST_CASE("wxHtmlParser::ParseInvalid", "[html][parser][error]")
     delete p.Parse("<!---");
 }
 
+// Return the widths of all words in the given parsed document.
+static std::vector<int> GetWordWidths(const wxHtmlCell* top)
+{
+    std::vector<int> widths;
+    for ( wxHtmlTerminalCellsInterator i(top->GetFirstTerminal(),
+                                         top->GetLastTerminal());
+          i;
+          ++i )
+    {
+        if ( dynamic_cast<const wxHtmlWordCell*>(*i) )
+            widths.push_back(i->GetWidth());
+    }
+
+    return widths;
+}
+
+TEST_CASE("wxHtmlParser::WordExtents", "[html][parser]")
+{
+    wxHtmlWinParser p;
+    wxMemoryDC dc;
+    p.SetDC(&dc);
+
+    const wxString html("<p>Hello world Hello <b>world</b></p>");
+
+    std::unique_ptr<wxObject> top(p.Parse(html));
+    const std::vector<int> widths = GetWordWidths(static_cast<wxHtmlCell*>(top.get()));
+    REQUIRE( widths.size() == 4 );
+    CHECK( widths[0] == widths[2] );
+    CHECK( widths[1] > 0 );
+
+    // Parsing the same text again must reuse the extents measured before.
+    top.reset(p.Parse(html));
+    CHECK( GetWordWidths(static_cast<wxHtmlCell*>(top.get())) == widths );
+
+    // But not after changing the fonts.
+    p.SetStandardFonts(3*wxNORMAL_FONT->GetPointSize());
+    top.reset(p.Parse(html));
+    const std::vector<int> widthsBig = GetWordWidths(static_cast<wxHtmlCell*>(top.get()));
+    REQUIRE( widthsBig.size() == widths.size() );
+    CHECK( widthsBig[0] > widths[0] );
+}
+
 TEST_CASE("wxHtmlCell::Detach", "[html][cell]")
 {
     wxMemoryDC dc;
@@ -102,4 +145,53 @@ TEST_CASE("wxHtmlCell::Detach", "[html][cell]")
     }
 }
 
+TEST_CASE("wxHtmlCell::FindCellByPos", "[html][cell]")
+{
+    wxMemoryDC dc;
+
+    // Use enough cells for the container to use the index of its children.
+    std::unique_ptr<wxHtmlContainerCell> const top(new wxHtmlContainerCell(nullptr));
+    std::vector<wxHtmlCell*> words;
+    for ( int n = 0; n < 200; n++ )
+    {
+        if ( n % 10 == 5 )
+            top->InsertCell(new wxHtmlColourCell(*wxRED));
+
+        wxHtmlCell* const cell = new wxHtmlWordCell(wxString::Format("w%d", n), dc);
+        top->InsertCell(cell);
+        words.push_back(cell);
+    }
+
+    const auto checkAll = [&]()
+    {
+        for ( const wxHtmlCell* cell : words )
+        {
+            const int x = cell->GetPosX() + cell->GetWidth() / 2;
+            const int y = cell->GetPosY() + cell->GetHeight() / 2;
+            CHECK( top->FindCellByPos(x, y) == cell );
+            CHECK( top->FindCellByPos(x, y, wxHTML_FIND_NEAREST_AFTER) == cell );
+            CHECK( top->FindCellByPos(x, y, wxHTML_FIND_NEAREST_BEFORE) == cell );
+        }
+
+        CHECK( top->FindCellByPos(0, -1) == nullptr );
+        CHECK( top->FindCellByPos(0, -1, wxHTML_FIND_NEAREST_AFTER) == words.front() );
+        CHECK( top->FindCellByPos(0, top->GetHeight()) == nullptr );
+        CHECK( top->FindCellByPos(0, top->GetHeight(),
+                                  wxHTML_FIND_NEAREST_BEFORE) == words.back() );
+    };
+
+    top->Layout(100);
+    REQUIRE( words.back()->GetPosY() > words.front()->GetPosY() );
+    checkAll();
+
+    // Check that the index is updated when the children change.
+    wxHtmlCell* const first = words.front();
+    top->Detach(first);
+    delete first;
+    words.erase(words.begin());
+
+    top->Layout(100);
+    checkAll();
+}
+
 #endif //wxUSE_HTML
@@ -44,6 +44,7 @@ private:
         WXUISIM_TEST( LinkClick );
 #endif // wxUSE_UIACTIONSIMULATOR
         CPPUNIT_TEST( AppendToPage );
+        CPPUNIT_TEST( AppendBlockToPage );
     CPPUNIT_TEST_SUITE_END();
 
     void SelectionToText();
@@ -51,6 +52,7 @@ private:
     void CellClick();
     void LinkClick();
     void AppendToPage();
+    void AppendBlockToPage();
 
     wxHtmlWindow *m_win;
 
@@ -166,4 +168,24 @@ void HtmlWindowTestCase::AppendToPage()
 #endif // wxUSE_CLIPBOARD
 }
 
+void HtmlWindowTestCase::AppendBlockToPage()
+{
+    m_win->SetPage(TEST_MARKUP_LINK);
+    const int heightBefore = m_win->GetInternalRepresentation()->GetHeight();
+
+    m_win->AppendBlockToPage("A new paragraph");
+    CPPUNIT_ASSERT( m_win->GetInternalRepresentation()->GetHeight() > heightBefore );
+
+    // The full source must still be available.
+    CPPUNIT_ASSERT_EQUAL( wxString(TEST_MARKUP_LINK) + "A new paragraph",
+                          *m_win->GetParser()->GetSource() );
+
+#if wxUSE_CLIPBOARD
+    // Unlike with AppendToPage(), the new text is on its own line.
+    const wxString text = m_win->ToText();
+    CPPUNIT_ASSERT( text.StartsWith("link") );
+    CPPUNIT_ASSERT( text.EndsWith("\nA new paragraph") );
+#endif // wxUSE_CLIPBOARD
+}
+
 #endif //wxUSE_HTML
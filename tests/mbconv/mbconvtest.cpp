@@ -1508,3 +1508,52 @@ TEST_CASE("wxMBConv::cMB2WC", "[mbconv][mb2wc]")
     CHECK( wxConvUTF7.cMB2WC(wxCharBuffer()).length() == 0 );
     CHECK( wxConvUTF7.cMB2WC("+AKM-").length() == 1 );
 }
+
+TEST_CASE("wxMBConv::UTF8::ASCIIRuns", "[mbconv][utf8]")
+{
+    // Check that non-ASCII characters are handled correctly at any position
+    // relative to the blocks of ASCII characters converted at once.
+    wxMBConvStrictUTF8 convStrict;
+    wxMBConvUTF8 convPUA(wxMBConvUTF8::MAP_INVALID_UTF8_TO_PUA);
+    wxMBConvUTF8 convOctal(wxMBConvUTF8::MAP_INVALID_UTF8_TO_OCTAL);
+
+    const auto toMB = [](const wxMBConv& conv, const std::wstring& ws)
+    {
+        const wxCharBuffer buf = conv.cWC2MB(ws.c_str(), ws.length(), nullptr);
+        return std::string(buf.data(), buf.length());
+    };
+
+    const auto toWC = [](const wxMBConv& conv, const std::string& s)
+    {
+        const wxWCharBuffer buf = conv.cMB2WC(s.c_str(), s.length(), nullptr);
+        return std::wstring(buf.data(), buf.length());
+    };
+
+    for ( size_t len = 2; len < 40; len++ )
+    {
+        for ( size_t pos = 0; pos < len; pos++ )
+        {
+            INFO("Length " << len << ", non-ASCII at " << pos);
+
+            std::wstring ws(len, L'x');
+            ws[pos] = 0x391;
+
+            std::string s(pos, 'x');
+            s += "\xce\x91";
+            s += std::string(len - pos - 1, 'x');
+
+            CHECK( toMB(convStrict, ws) == s );
+            CHECK( toWC(convStrict, s) == ws );
+            CHECK( toWC(convPUA, s) == ws );
+
+            // Backslashes must still be escaped in octal mode.
+            s[pos == 0 ? len : 0] = '\\';
+            ws[pos == 0 ? len - 1 : 0] = L'\\';
+            std::wstring wsOctal = ws;
+            wsOctal.insert(pos == 0 ? len - 1 : 0, 1, L'\\');
+
+            CHECK( toWC(convOctal, s) == wsOctal );
+            CHECK( toMB(convOctal, wsOctal) == s );
+        }
+    }
+}
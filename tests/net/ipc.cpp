@@ -259,3 +259,258 @@ void IPCTestCase::Disconnect()
 #endif // wxUSE_THREADS
 
 #endif // !__WINDOWS__
+
+// ----------------------------------------------------------------------------
+// tests using both the server and the client in the main thread
+// ----------------------------------------------------------------------------
+
+#if wxUSE_IPC && wxUSE_SOCKETS
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif
+
+#include "wx/evtloop.h"
+#include "wx/filename.h"
+#include "wx/sckipc.h"
+
+#include <memory>
+
+namespace
+{
+
+const char *IPC_LOCAL_TEST_TOPIC = "IPC LOCAL TEST";
+
+wxString GetLocalTestService()
+{
+#ifdef __UNIX__
+    // Use Unix domain socket when possible, as, unlike TCP, it's not affected
+    // by Nagle's algorithm, which could delay sending the message following
+    // the reply to the request until after the reply is read.
+    return wxString::Format("%s/wxipctest%lu",
+                            wxFileName::GetTempDir(), wxGetProcessId());
+#else
+    return "4244";
+#endif
+}
+
+// Socket events are queued and so wouldn't be processed while waiting for the
+// reply to a synchronous call, which would deadlock when both sides of the
+// connection live in the same thread, so process them while waiting too.
+class LocalEventLoop : public wxEventLoop
+{
+public:
+    LocalEventLoop() { }
+
+    virtual int DispatchTimeout(unsigned long timeout) override
+    {
+        const int rc = wxEventLoop::DispatchTimeout(timeout);
+
+        wxTheApp->ProcessPendingEvents();
+
+        return rc;
+    }
+
+private:
+    wxDECLARE_NO_COPY_CLASS(LocalEventLoop);
+};
+
+class LocalServerConnection : public wxTCPConnection
+{
+public:
+    LocalServerConnection() { m_numPoked = 0; }
+
+    int GetNumPoked() const { return m_numPoked; }
+
+    virtual bool OnStartAdvise(const wxString& WXUNUSED(topic),
+                               const wxString& WXUNUSED(item)) override
+    {
+        return true;
+    }
+
+    virtual bool OnPoke(const wxString& WXUNUSED(topic),
+                        const wxString& WXUNUSED(item),
+                        const void *WXUNUSED(data),
+                        size_t WXUNUSED(size),
+                        wxIPCFormat WXUNUSED(format)) override
+    {
+        m_numPoked++;
+
+        return true;
+    }
+
+    virtual const void *OnRequest(const wxString& WXUNUSED(topic),
+                                  const wxString& WXUNUSED(item),
+                                  size_t *size,
+                                  wxIPCFormat WXUNUSED(format)) override
+    {
+        // Send another message right after the reply, so that it's received
+        // together with it by the client.
+        wxTheApp->CallAfter([this]()
+            {
+                Advise("after", "reply");
+                Flush();
+            });
+
+        static const char reply[] = "reply";
+        *size = sizeof(reply);
+        return reply;
+    }
+
+private:
+    int m_numPoked;
+
+    wxDECLARE_NO_COPY_CLASS(LocalServerConnection);
+};
+
+class LocalServer : public wxTCPServer
+{
+public:
+    LocalServer() { m_conn = nullptr; }
+
+    virtual ~LocalServer()
+    {
+        delete m_conn;
+    }
+
+    LocalServerConnection *GetConn() const { return m_conn; }
+
+    virtual wxConnectionBase *OnAcceptConnection(const wxString& topic) override
+    {
+        if ( topic != IPC_LOCAL_TEST_TOPIC )
+            return nullptr;
+
+        m_conn = new LocalServerConnection;
+        return m_conn;
+    }
+
+private:
+    LocalServerConnection *m_conn;
+
+    wxDECLARE_NO_COPY_CLASS(LocalServer);
+};
+
+class LocalClientConnection : public wxTCPConnection
+{
+public:
+    LocalClientConnection() { m_numAdvised = 0; }
+
+    int GetNumAdvised() const { return m_numAdvised; }
+    const wxString& GetReply() const { return m_reply; }
+
+    virtual bool OnAdvise(const wxString& WXUNUSED(topic),
+                          const wxString& item,
+                          const void *WXUNUSED(data),
+                          size_t WXUNUSED(size),
+                          wxIPCFormat WXUNUSED(format)) override
+    {
+        m_numAdvised++;
+
+        if ( item == "request" )
+        {
+            size_t size;
+            const void* const data = Request("item", &size);
+            if ( data )
+                m_reply = GetTextFromData(data, size, wxIPC_TEXT);
+        }
+
+        return true;
+    }
+
+private:
+    int m_numAdvised;
+    wxString m_reply;
+
+    wxDECLARE_NO_COPY_CLASS(LocalClientConnection);
+};
+
+class LocalClient : public wxTCPClient
+{
+public:
+    LocalClient() { }
+
+    virtual wxConnectionBase *OnMakeConnection() override
+    {
+        return new LocalClientConnection;
+    }
+
+private:
+    wxDECLARE_NO_COPY_CLASS(LocalClient);
+};
+
+// Dispatch the events until the given condition becomes true, return false if
+// nothing happens for too long.
+template <typename F>
+bool DispatchUntil(wxEventLoopBase& loop, const F& cond)
+{
+    for ( ;; )
+    {
+        // Process the functions queued by the IPC code using CallAfter(),
+        // notably for sending the batched messages.
+        wxTheApp->ProcessPendingEvents();
+
+        if ( cond() )
+            return true;
+
+        if ( loop.DispatchTimeout(1000) <= 0 )
+            return false;
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("IPC::Batching", "[ipc]")
+{
+    LocalEventLoop loop;
+    wxEventLoopActivator activate(&loop);
+
+    const wxString service = GetLocalTestService();
+
+    LocalServer server;
+    REQUIRE( server.Create(service) );
+
+    LocalClient client;
+    std::unique_ptr<LocalClientConnection> conn(
+        static_cast<LocalClientConnection*>(
+            client.MakeConnection("localhost", service, IPC_LOCAL_TEST_TOPIC)));
+    REQUIRE( conn );
+
+    LocalServerConnection* const serverConn = server.GetConn();
+    REQUIRE( serverConn );
+
+    REQUIRE( conn->StartAdvise("item") );
+
+    // Pokes sent with batching enabled are only sent when returning to the
+    // event loop, but must all arrive.
+    const int NUM_MESSAGES = 1000;
+
+    conn->EnableBatching(true);
+    for ( int n = 0; n < NUM_MESSAGES; n++ )
+        CHECK( conn->Poke("item", "poke") );
+
+    CHECK( serverConn->GetNumPoked() == 0 );
+    CHECK( DispatchUntil(loop,
+                         [&]() { return serverConn->GetNumPoked() == NUM_MESSAGES; }) );
+
+    // Check that the client can make a synchronous request from its advise
+    // handler, even when the server uses batching: note that the server sends
+    // another advise after replying to the request.
+    serverConn->EnableBatching(true);
+    for ( int n = 0; n < NUM_MESSAGES; n++ )
+        CHECK( serverConn->Advise("item", "advise") );
+    CHECK( serverConn->Advise("request", "advise") );
+
+    CHECK( DispatchUntil(loop,
+                         [&]() { return conn->GetNumAdvised() == NUM_MESSAGES + 2; }) );
+    CHECK( conn->GetReply() == "reply" );
+
+    // Flushing explicitly must work too.
+    CHECK( serverConn->Advise("item", "advise") );
+    CHECK( serverConn->Flush() );
+    CHECK( DispatchUntil(loop,
+                         [&]() { return conn->GetNumAdvised() == NUM_MESSAGES + 3; }) );
+
+    CHECK( conn->Disconnect() );
+}
+
+#endif // wxUSE_IPC && wxUSE_SOCKETS
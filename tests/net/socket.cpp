@@ -25,8 +25,10 @@
 #include "wx/url.h"
 #include "wx/sstream.h"
 #include "wx/evtloop.h"
+#include "wx/thread.h"
 
 #include <memory>
+#include <vector>
 
 typedef std::unique_ptr<wxSockAddress> wxSockAddressPtr;
 typedef std::unique_ptr<wxSocketClient> wxSocketClientPtr;
@@ -358,4 +360,163 @@ TEST_CASE("wxDatagramSocket::ShortPeek", "[socket][dgram]")
     CHECK(recvbuf[1] == sendbuf1[1]);
 }
 
+TEST_CASE("wxSocketServer::AcceptAll", "[socket]")
+{
+    wxIPV4address addr;
+    addr.LocalHost();
+    addr.Service(0);
+
+    wxSocketServer server(addr, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR);
+    REQUIRE( server.IsOk() );
+    REQUIRE( server.GetLocal(addr) );
+
+    std::vector<wxSocketBase*> peers;
+    CHECK( server.AcceptAll(peers) == 0 );
+    CHECK( !server.Error() );
+
+    const size_t NUM_CLIENTS = 8;
+    std::vector<std::unique_ptr<wxSocketClient>> clients;
+    for ( size_t n = 0; n < NUM_CLIENTS; n++ )
+    {
+        clients.emplace_back(new wxSocketClient(wxSOCKET_BLOCK));
+        REQUIRE( clients.back()->Connect(addr) );
+    }
+
+    // Check that the maximal count is respected.
+    CHECK( server.AcceptAll(peers, 3) == 3 );
+
+    while ( peers.size() < NUM_CLIENTS && server.WaitForAccept(1) )
+        server.AcceptAll(peers);
+
+    CHECK( peers.size() == NUM_CLIENTS );
+    CHECK( !server.Error() );
+
+    for ( size_t n = 0; n < peers.size(); n++ )
+    {
+        CHECK( peers[n]->IsConnected() );
+        peers[n]->Destroy();
+    }
+}
+
+TEST_CASE("wxSocketBase::ReadWriteMsg", "[socket]")
+{
+    wxIPV4address addr;
+    addr.LocalHost();
+    addr.Service(0);
+
+    wxSocketServer server(addr, wxSOCKET_BLOCK | wxSOCKET_REUSEADDR);
+    REQUIRE( server.IsOk() );
+    REQUIRE( server.GetLocal(addr) );
+
+    wxSocketClient client(wxSOCKET_BLOCK);
+    REQUIRE( client.Connect(addr) );
+
+    std::unique_ptr<wxSocketBase> peer(server.Accept());
+    REQUIRE( peer );
+
+    char buf[64];
+
+    SECTION("Normal")
+    {
+        client.WriteMsg("Hello", 5);
+        CHECK( !client.Error() );
+        CHECK( client.LastWriteCount() == 5 );
+
+        peer->ReadMsg(buf, sizeof(buf));
+        CHECK( !peer->Error() );
+        REQUIRE( peer->LastReadCount() == 5 );
+        CHECK( memcmp(buf, "Hello", 5) == 0 );
+    }
+
+    SECTION("Empty")
+    {
+        client.WriteMsg("", 0);
+        client.WriteMsg("!", 1);
+
+        peer->ReadMsg(buf, sizeof(buf));
+        CHECK( !peer->Error() );
+        CHECK( peer->LastReadCount() == 0 );
+
+        peer->ReadMsg(buf, sizeof(buf));
+        CHECK( !peer->Error() );
+        REQUIRE( peer->LastReadCount() == 1 );
+        CHECK( buf[0] == '!' );
+    }
+
+    SECTION("Truncated")
+    {
+        // The part of the message not fitting into the buffer is discarded.
+        client.WriteMsg("Hello, world", 12);
+        client.WriteMsg("Bye", 3);
+
+        peer->ReadMsg(buf, 5);
+        CHECK( !peer->Error() );
+        REQUIRE( peer->LastReadCount() == 5 );
+        CHECK( memcmp(buf, "Hello", 5) == 0 );
+
+        peer->ReadMsg(buf, sizeof(buf));
+        CHECK( !peer->Error() );
+        REQUIRE( peer->LastReadCount() == 3 );
+        CHECK( memcmp(buf, "Bye", 3) == 0 );
+    }
+
+    SECTION("Pushback")
+    {
+        // Check that the data returned by Unread() is used by ReadMsg().
+        client.WriteMsg("Hello", 5);
+
+        peer->Read(buf, 10);
+        REQUIRE( peer->LastReadCount() == 10 );
+        peer->Unread(buf, 10);
+
+        peer->ReadMsg(buf, sizeof(buf));
+        CHECK( !peer->Error() );
+        REQUIRE( peer->LastReadCount() == 5 );
+        CHECK( memcmp(buf, "Hello", 5) == 0 );
+    }
+
+    SECTION("Big")
+    {
+        std::vector<char> data(1024*1024);
+        for ( size_t n = 0; n < data.size(); n++ )
+            data[n] = static_cast<char>(n % 251);
+
+        // Use another thread to write the data, as it doesn't fit into the
+        // socket buffers.
+        class WriterThread : public wxThread
+        {
+        public:
+            WriterThread(wxSocketBase& sock, const std::vector<char>& data)
+                : wxThread(wxTHREAD_JOINABLE),
+                  m_sock(sock),
+                  m_data(data)
+            {
+            }
+
+            virtual void* Entry() override
+            {
+                m_sock.WriteMsg(&m_data[0], m_data.size());
+                return nullptr;
+            }
+
+        private:
+            wxSocketBase& m_sock;
+            const std::vector<char>& m_data;
+        };
+
+        WriterThread thread(client, data);
+        REQUIRE( thread.Run() == wxTHREAD_NO_ERROR );
+
+        std::vector<char> received(data.size());
+        peer->ReadMsg(&received[0], received.size());
+        thread.Wait();
+
+        CHECK( !client.Error() );
+        CHECK( client.LastWriteCount() == data.size() );
+        CHECK( !peer->Error() );
+        CHECK( peer->LastReadCount() == data.size() );
+        CHECK( received == data );
+    }
+}
+
 #endif // wxUSE_SOCKETS
@@ -362,6 +362,41 @@ public:
 // default buffer size works correctly.
 constexpr int DOWNLOAD_BYTES = 99999;
 
+// Sink counting the bytes it receives and optionally pausing the transfer
+// every few calls and resuming it later.
+class CountingSink : public wxWebRequestSink
+{
+public:
+    explicit CountingSink(wxWebRequest* request = nullptr, int pauseEvery = 0)
+        : m_request(request),
+          m_pauseEvery(pauseEvery)
+    {
+    }
+
+    Action OnData(const void* WXUNUSED(data), size_t size) override
+    {
+        if ( m_pauseEvery && ++m_calls % m_pauseEvery == 0 )
+        {
+            pauses++;
+
+            wxTheApp->CallAfter([this]() { m_request->Resume(); });
+            return Action_Pause;
+        }
+
+        received += size;
+
+        return Action_Continue;
+    }
+
+    wxInt64 received = 0;
+    int pauses = 0;
+
+private:
+    wxWebRequest* const m_request;
+    const int m_pauseEvery;
+    int m_calls = 0;
+};
+
 // Substring used to check that we got the expected response after
 // authenticating successfully. It is so weird because httpbin and go-httpbin
 // use different strings for this: one uses "authenticated" while the other
@@ -492,6 +527,34 @@ TEST_CASE_METHOD(RequestFixture,
     CHECK( dataSize == processingSize );
 }
 
+TEST_CASE_METHOD(RequestFixture,
+                 "WebRequest::Get::Sink", "[net][webrequest][get]")
+{
+    if ( !InitBaseURL() )
+        return;
+
+    SECTION("Continue")
+    {
+        CountingSink sink;
+        Create(wxString::Format("bytes/%d", DOWNLOAD_BYTES));
+        request.SetDataSink(&sink);
+        Run();
+        CHECK( request.GetBytesReceived() == DOWNLOAD_BYTES );
+        CHECK( sink.received == DOWNLOAD_BYTES );
+        CHECK( dataSize == 0 );
+    }
+
+    SECTION("Pause")
+    {
+        CountingSink sink(&request, 2);
+        Create(wxString::Format("bytes/%d", DOWNLOAD_BYTES));
+        request.SetDataSink(&sink);
+        Run();
+        CHECK( request.GetBytesReceived() == DOWNLOAD_BYTES );
+        CHECK( sink.received == DOWNLOAD_BYTES );
+    }
+}
+
 TEST_CASE_METHOD(RequestFixture,
                  "WebRequest::Error::HTTP", "[net][webrequest][error]")
 {
@@ -945,6 +1008,49 @@ TEST_CASE_METHOD(SyncRequestFixture,
     REQUIRE( Execute() );
 
     CHECK( request.GetBytesReceived() == expectedFileSize );
+    CHECK( wxFileName::GetSize(response.GetDataFile()) == wxULongLong(expectedFileSize) );
+}
+
+TEST_CASE_METHOD(SyncRequestFixture,
+                 "WebRequest::Sync::Get::Sink", "[net][webrequest][sync][get]")
+{
+    if ( !InitBaseURL() )
+        return;
+
+    CountingSink sink;
+    Create(wxString::Format("bytes/%d", DOWNLOAD_BYTES));
+    request.SetDataSink(&sink);
+
+    REQUIRE( Execute() );
+
+    CHECK( request.GetBytesReceived() == DOWNLOAD_BYTES );
+    CHECK( sink.received == DOWNLOAD_BYTES );
+}
+
+TEST_CASE_METHOD(SyncRequestFixture,
+                 "WebRequest::Sync::ConnectionReuse", "[net][webrequest][sync]")
+{
+    if ( !InitBaseURL() )
+        return;
+
+    const wxWebSessionStats before = GetSession().GetStats();
+
+    REQUIRE( Execute("bytes/100") );
+    REQUIRE( Execute("bytes/200") );
+
+    const wxWebSessionStats after = GetSession().GetStats();
+    if ( after.requests == before.requests )
+    {
+        WARN("Statistics not supported by " <<
+             GetSession().GetLibraryVersionInfo().GetName());
+        return;
+    }
+
+    CHECK( after.requests == before.requests + 2 );
+
+    // The second request should have reused the connection of the first one.
+    CHECK( after.connectionsReused > before.connectionsReused );
+    CHECK( after.handlesReused > before.handlesReused );
 }
 
 TEST_CASE_METHOD(SyncRequestFixture,
@@ -199,6 +199,46 @@ TEST_CASE("wxRegEx::Unicode", "[regex][unicode]")
     CHECK( re.GetMatch(cyrillicSmallA) == cyrillicSmallA );
 }
 
+TEST_CASE("wxRegEx::Shared", "[regex]")
+{
+    // Objects using the same pattern share the compiled code internally, but
+    // must still have their own independent matches.
+    wxRegEx re1("([a-z]+)([0-9]+)");
+    wxRegEx re2("([a-z]+)([0-9]+)");
+    REQUIRE( re1.IsValid() );
+    REQUIRE( re2.IsValid() );
+
+    REQUIRE( re1.Matches("foo123") );
+    REQUIRE( re2.Matches("--bar4") );
+
+    CHECK( re1.GetMatch("foo123", 1) == "foo" );
+    CHECK( re2.GetMatch("--bar4", 1) == "bar" );
+
+    // Different flags must result in different compiled code.
+    wxRegEx re3("([a-z]+)([0-9]+)", wxRE_ICASE);
+    CHECK( re3.Matches("FOO1") );
+    CHECK_FALSE( re1.Matches("FOO1") );
+
+    // And recompiling one of the objects must not affect the other one.
+    REQUIRE( re1.Compile("x") );
+    CHECK( re2.Matches("baz5") );
+    CHECK( re2.GetMatch("baz5", 2) == "5" );
+}
+
+TEST_CASE("wxRegEx::Backtracking", "[regex]")
+{
+    // Matching this pattern requires more stack than the JIT-compiled code
+    // has by default, but it must still work.
+    wxRegEx re("^(a|b)*$");
+    REQUIRE( re.IsValid() );
+
+    const wxString text(100000, 'a');
+    REQUIRE( re.Matches(text) );
+    CHECK( re.GetMatch(text, 1) == "a" );
+
+    CHECK_FALSE( re.Matches(text + "c") );
+}
+
 // This pseudo test can be used just to see the version of PCRE being used.
 TEST_CASE("wxRegEx::GetLibraryVersionInfo", "[.]")
 {
@@ -17,10 +17,13 @@
     #include "wx/wx.h"
 #endif // WX_PRECOMP
 
+#include "wx/internedstring.h"
 #include "wx/private/localeset.h"
 
 #include <errno.h>
 
+#include <unordered_set>
+
 // ----------------------------------------------------------------------------
 // tests
 // ----------------------------------------------------------------------------
@@ -71,7 +74,7 @@ TEST_CASE("StringFormat", "[wxString]")
     s2.Printf(wxT("Number 18: %s\n"), s1.c_str());
     CHECK( s2 == wxString::Format(wxT("Number 18: %s\n"), s1.c_str()) );
 
-    static const size_t lengths[] = { 1, 512, 1024, 1025, 2048, 4096, 4097 };
+    static const size_t lengths[] = { 1, 512, 1023, 1024, 1025, 2048, 4096, 4097 };
     for ( size_t n = 0; n < WXSIZEOF(lengths); n++ )
     {
         const size_t len = lengths[n];
@@ -1116,6 +1119,46 @@ TEST_CASE("StringIndexedAccess", "[wxString]")
     // the 3rd character of wxString should remain the same
     s[0] = L'\xe9';
     CHECK( (char)s[2] == 'r' );
+
+    // check that indexing still works correctly after the string which was
+    // known to be ASCII-only is modified to contain non-ASCII characters
+    wxString t("abcd");
+    CHECK( t.length() == 4 );
+    CHECK( (char)t[3] == 'd' );
+    t.insert(1, wxString::FromUTF8("\xc3\xa9"));
+    CHECK( (char)t[4] == 'd' );
+    CHECK( t[1] == wxUniChar(0xe9) );
+    CHECK( t.length() == 5 );
+    CHECK( (char)t[4] == 'd' );
+}
+
+TEST_CASE("wxInternedString", "[wxString][intern]")
+{
+    const wxInternedString empty;
+    CHECK( empty.empty() );
+    CHECK( empty == wxInternedString(wxString()) );
+
+    const wxInternedString foo("foo");
+    CHECK( foo == wxInternedString(wxString("f") + "oo") );
+    CHECK( foo != wxInternedString("bar") );
+    CHECK( foo != empty );
+
+    CHECK( foo == wxString("foo") );
+    CHECK( wxString("foo") == foo );
+    CHECK( foo.GetString() == "foo" );
+    CHECK( &foo.GetString() == &wxInternedString("foo").GetString() );
+    CHECK( foo.GetHash() == wxInternedString("foo").GetHash() );
+
+    const size_t count = wxInternedString::GetCount();
+    CHECK( wxInternedString("foo") == foo );
+    CHECK( wxInternedString::GetCount() == count );
+
+    std::unordered_set<wxInternedString> set;
+    set.insert(foo);
+    set.insert(wxInternedString("bar"));
+    set.insert(wxInternedString("foo"));
+    CHECK( set.size() == 2 );
+    CHECK( set.count(wxInternedString("bar")) == 1 );
 }
 
 TEST_CASE("StringBeforeAndAfter", "[wxString]")
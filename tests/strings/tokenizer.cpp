@@ -307,3 +307,87 @@ void TokenizerTestCase::AssignObj()
         CPPUNIT_ASSERT_EQUAL( tkzSrc.GetString(), tkz.GetString() );
     }
 }
+
+TEST_CASE("wxStringViewTokenizer", "[tokenizer]")
+{
+    SECTION("Same as wxStringTokenizer")
+    {
+        for ( size_t n = 0; n < WXSIZEOF(gs_testData); n++ )
+        {
+            const TokenizerTestData& ttd = gs_testData[n];
+            INFO( Nth(n) );
+
+            const wxString str(ttd.str);
+            wxStringTokenizer tkz(str, ttd.delims, ttd.mode);
+            wxStringViewTokenizer tkzView(str, ttd.delims, ttd.mode);
+            CHECK( tkzView.GetMode() == tkz.GetMode() );
+
+            size_t count = 0;
+            while ( tkz.HasMoreTokens() )
+            {
+                REQUIRE( tkzView.HasMoreTokens() );
+
+                const wxString token = tkz.GetNextToken();
+                const wxStringTokenView tokenView = tkzView.GetNextToken();
+                CHECK( tokenView.ToString() == token );
+                CHECK( tokenView == token );
+                CHECK( tokenView.length() == token.length() );
+                CHECK( tkzView.GetLastDelimiter() == tkz.GetLastDelimiter() );
+
+                count++;
+            }
+
+            CHECK( !tkzView.HasMoreTokens() );
+            CHECK( count == ttd.count );
+        }
+    }
+
+    SECTION("Range for")
+    {
+        const wxString str("first:second::third");
+
+        wxArrayString tokens;
+        for ( const wxStringTokenView& token : wxStringViewTokenizer(str, ":") )
+            tokens.push_back(token.ToString());
+
+        CHECK( tokens == wxSplit("first,second,,third", ',') );
+    }
+
+    SECTION("Many delimiters")
+    {
+        // Use a string long enough to exercise the vectorized search.
+        const wxString str("alpha beta,gamma;delta:epsilon zeta,,eta;theta");
+
+        wxStringViewTokenizer tkz(str, " ,;:", wxTOKEN_STRTOK);
+        const char* const expected[] =
+        {
+            "alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta"
+        };
+
+        for ( size_t n = 0; n < WXSIZEOF(expected); n++ )
+        {
+            REQUIRE( tkz.HasMoreTokens() );
+            CHECK( tkz.GetNextToken() == expected[n] );
+        }
+
+        CHECK( !tkz.HasMoreTokens() );
+    }
+
+    SECTION("Non-ASCII")
+    {
+        const wxString str = wxString::FromUTF8("\xc3\xa4" "b\xe2\x82\xac" "cd,\xc3\xa9");
+        const wxString delims = wxString::FromUTF8("\xe2\x82\xac,");
+
+        wxStringViewTokenizer tkz(str, delims);
+        CHECK( tkz.GetNextToken() == wxString::FromUTF8("\xc3\xa4" "b") );
+        CHECK( tkz.GetLastDelimiter() == wxChar(0x20ac) );
+        CHECK( tkz.GetNextToken() == "cd" );
+        CHECK( tkz.GetLastDelimiter() == ',' );
+
+        const wxStringTokenView last = tkz.GetNextToken();
+        CHECK( last.length() == 1 );
+        CHECK( last.ToString() == wxString::FromUTF8("\xc3\xa9") );
+        CHECK( tkz.GetLastDelimiter() == '\0' );
+        CHECK( !tkz.HasMoreTokens() );
+    }
+}
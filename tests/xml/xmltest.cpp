@@ -18,6 +18,7 @@
 #endif // WX_PRECOMP
 
 #include "wx/xml/xml.h"
+#include "wx/mstream.h"
 #include "wx/sstream.h"
 
 #include <stdarg.h>
@@ -610,6 +611,248 @@ void XmlTestCase::Doctype()
     CPPUNIT_ASSERT( !dt.IsValid() );
 }
 
+TEST_CASE("XML::Compact", "[xml]")
+{
+    const char *xmlText =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"<!-- Prolog comment -->\n"
+"<?xml-stylesheet href=\"style.css\" type=\"text/css\"?>\n"
+"<resource xmlns=\"http://www.wxwidgets.org/wxxrc\" version=\"2.3.0.1\">\n"
+"  <object class=\"wxDialog\" name=\"my_dialog\">\n"
+"    <label>Tom &amp; \xc3\xa9t\xc3\xa9</label>\n"
+"    <text>\n"
+"      <![CDATA[a < b]]>\n"
+"    </text>\n"
+"    <object class=\"wxButton\" name=\"my_button\"/>\n"
+"  </object>\n"
+"</resource>\n"
+    ;
+
+    const auto load = [xmlText](wxXmlDocument& doc, int flags)
+    {
+        wxMemoryInputStream mis(xmlText, strlen(xmlText));
+        REQUIRE( doc.Load(mis, flags) );
+    };
+
+    const auto save = [](const wxXmlDocument& doc)
+    {
+        wxStringOutputStream sos;
+        REQUIRE( doc.Save(sos) );
+        return sos.GetString();
+    };
+
+    wxXmlDocument doc;
+    load(doc, wxXMLDOC_COMPACT);
+
+    SECTION("Same")
+    {
+        wxXmlDocument docNormal;
+        load(docNormal, wxXMLDOC_NONE);
+
+        CHECK( save(doc) == save(docNormal) );
+        CHECK( save(doc) == wxString::FromUTF8(xmlText) );
+    }
+
+    SECTION("Access")
+    {
+        const wxXmlNode* const root = doc.GetRoot();
+        REQUIRE( root );
+        CHECK( root->GetName() == "resource" );
+        CHECK( root->GetAttribute("version") == "2.3.0.1" );
+
+        const wxXmlNode* const dialog = root->GetChildren();
+        REQUIRE( dialog );
+        CHECK( dialog->GetName() == "object" );
+        CHECK( dialog->GetLineNumber() == 5 );
+
+        const wxXmlNode* const label = dialog->GetChildren();
+        REQUIRE( label );
+        CHECK( label->GetNodeContent() == wxString::FromUTF8("Tom & \xc3\xa9t\xc3\xa9") );
+
+        const wxXmlNode* const text = label->GetNext();
+        REQUIRE( text );
+        CHECK( text->GetChildren()->GetType() == wxXML_CDATA_SECTION_NODE );
+        CHECK( text->GetNodeContent() == "a < b" );
+
+        const wxXmlNode* const button = text->GetNext();
+        REQUIRE( button );
+
+        // The names are shared between all the nodes.
+        CHECK( &button->GetName() == &dialog->GetName() );
+        CHECK( button->GetAttribute("name") == "my_button" );
+    }
+
+    SECTION("Modify")
+    {
+        wxXmlNode* const dialog = doc.GetRoot()->GetChildren();
+        dialog->SetName("dialog");
+        dialog->AddAttribute("title", "Title");
+        dialog->GetAttributes()->SetValue("wxFrame");
+        delete dialog->GetChildren()->GetNext()->GetNext();
+        dialog->GetChildren()->GetNext()->SetNext(nullptr);
+        dialog->AddChild(new wxXmlNode(wxXML_ELEMENT_NODE, "new"));
+
+        const wxString saved = save(doc);
+        CHECK( saved.Contains("<dialog class=\"wxFrame\" name=\"my_dialog\" title=\"Title\">") );
+        CHECK( saved.Contains("<new/>") );
+        CHECK( !saved.Contains("my_button") );
+    }
+
+    SECTION("Copy")
+    {
+        std::unique_ptr<wxXmlNode> root(new wxXmlNode(*doc.GetRoot()));
+        wxXmlAttribute attr(*root->GetAttributes());
+
+        doc = wxXmlDocument();
+
+        CHECK( root->GetName() == "resource" );
+        CHECK( root->GetChildren()->GetAttribute("name") == "my_dialog" );
+        CHECK( attr.GetValue() == "http://www.wxwidgets.org/wxxrc" );
+    }
+
+    SECTION("Detach")
+    {
+        // The detached nodes must remain valid even after the document is
+        // destroyed.
+        std::unique_ptr<wxXmlNode> root(doc.DetachRoot());
+        doc = wxXmlDocument();
+
+        CHECK( root->GetName() == "resource" );
+        CHECK( root->GetChildren()->GetChildren()->GetNodeContent()
+                == wxString::FromUTF8("Tom & \xc3\xa9t\xc3\xa9") );
+    }
+}
+
+TEST_CASE("XML::Reader", "[xml]")
+{
+    const char *xmlText =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"<!-- Prolog comment -->\n"
+"<root version=\"1\">\n"
+"  <item id=\"1\" name=\"first\">Tom &amp; \xc3\xa9t\xc3\xa9</item>\n"
+"  <item id=\"2\"><![CDATA[a < b]]></item>\n"
+"  <?target data?>\n"
+"  <skip><a><b/>text</a></skip>\n"
+"  <last/>\n"
+"</root>\n"
+    ;
+
+    // Use tiny buffer to check that items split between chunks are handled
+    // correctly too.
+    const size_t bufSize = GENERATE(3, 16384);
+    INFO("Buffer size " << bufSize);
+
+    wxMemoryInputStream mis(xmlText, strlen(xmlText));
+    wxXmlReader reader(mis, wxXMLDOC_NONE, bufSize);
+
+    REQUIRE( reader.Next() == wxXML_READER_COMMENT );
+    CHECK( reader.GetText() == " Prolog comment " );
+    CHECK( reader.GetDepth() == 0 );
+
+    REQUIRE( reader.Next() == wxXML_READER_START_ELEMENT );
+    CHECK( reader.GetName() == "root" );
+    CHECK( reader.GetDepth() == 1 );
+    CHECK( reader.GetLineNumber() == 3 );
+    CHECK( reader.GetAttribute("version") == "1" );
+
+    REQUIRE( reader.Next() == wxXML_READER_START_ELEMENT );
+    CHECK( reader.GetName() == "item" );
+    CHECK( reader.GetDepth() == 2 );
+    REQUIRE( reader.GetAttributeCount() == 2 );
+    CHECK( reader.GetAttributeName(1) == "name" );
+    CHECK( reader.GetAttributeValue(1) == "first" );
+    CHECK( reader.HasAttribute("id") );
+    CHECK( !reader.HasAttribute("value") );
+
+    REQUIRE( reader.Next() == wxXML_READER_TEXT );
+    CHECK( reader.GetText() == wxString::FromUTF8("Tom & \xc3\xa9t\xc3\xa9") );
+    CHECK( reader.GetDepth() == 2 );
+
+    REQUIRE( reader.Next() == wxXML_READER_END_ELEMENT );
+    CHECK( reader.GetDepth() == 2 );
+
+    REQUIRE( reader.Next() == wxXML_READER_START_ELEMENT );
+    std::unique_ptr<wxXmlNode> item(reader.ReadSubtree());
+    REQUIRE( item );
+    CHECK( item->GetAttribute("id") == "2" );
+    REQUIRE( item->GetChildren() );
+    CHECK( item->GetChildren()->GetType() == wxXML_CDATA_SECTION_NODE );
+    CHECK( item->GetNodeContent() == "a < b" );
+    CHECK( reader.GetItem() == wxXML_READER_END_ELEMENT );
+
+    REQUIRE( reader.Next() == wxXML_READER_PI );
+    CHECK( reader.GetName() == "target" );
+    CHECK( reader.GetText() == "data" );
+
+    REQUIRE( reader.Next() == wxXML_READER_START_ELEMENT );
+    CHECK( reader.GetName() == "skip" );
+    CHECK( reader.SkipSubtree() );
+    CHECK( reader.GetDepth() == 2 );
+
+    REQUIRE( reader.Next() == wxXML_READER_START_ELEMENT );
+    CHECK( reader.GetName() == "last" );
+    REQUIRE( reader.Next() == wxXML_READER_END_ELEMENT );
+
+    REQUIRE( reader.Next() == wxXML_READER_END_ELEMENT );
+    CHECK( reader.GetDepth() == 1 );
+
+    CHECK( reader.Next() == wxXML_READER_EOF );
+    CHECK( reader.Next() == wxXML_READER_EOF );
+}
+
+TEST_CASE("XML::Reader::Subtree", "[xml]")
+{
+    const char *xmlText =
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+"<root>\n"
+"  <a x=\"1\">one<b>two</b><!--c-->three</a>\n"
+"</root>\n"
+    ;
+
+    wxMemoryInputStream mis(xmlText, strlen(xmlText));
+    wxXmlReader reader(mis);
+
+    REQUIRE( reader.Next() == wxXML_READER_START_ELEMENT );
+    std::unique_ptr<wxXmlNode> root(reader.ReadSubtree());
+    REQUIRE( root );
+
+    // Compare with the tree created by wxXmlDocument.
+    wxMemoryInputStream mis2(xmlText, strlen(xmlText));
+    wxXmlDocument doc(mis2);
+    REQUIRE( doc.IsOk() );
+
+    wxXmlDocument docReader;
+    docReader.SetRoot(root.release());
+
+    wxStringOutputStream sos1, sos2;
+    REQUIRE( doc.Save(sos1) );
+    REQUIRE( docReader.Save(sos2) );
+    CHECK( sos1.GetString() == sos2.GetString() );
+
+    CHECK( reader.Next() == wxXML_READER_EOF );
+}
+
+TEST_CASE("XML::Reader::Error", "[xml]")
+{
+    const char *xmlText =
+"<root>\n"
+"  <a></b>\n"
+"</root>\n"
+    ;
+
+    wxMemoryInputStream mis(xmlText, strlen(xmlText));
+    wxXmlReader reader(mis);
+
+    REQUIRE( reader.Next() == wxXML_READER_START_ELEMENT );
+    REQUIRE( reader.Next() == wxXML_READER_START_ELEMENT );
+    CHECK( reader.SkipSubtree() == false );
+    CHECK( reader.GetItem() == wxXML_READER_ERROR );
+    CHECK( reader.GetError().line == 2 );
+    CHECK( !reader.GetError().message.empty() );
+
+    CHECK( reader.Next() == wxXML_READER_ERROR );
+}
+
 // This test is disabled by default as it requires the environment variable
 // below to be defined to point to a XML file to load.
 TEST_CASE("XML::Load", "[xml][.]")
@@ -27,6 +27,8 @@
 #include "wx/xrc/xmlres.h"
 #include "wx/xrc/xh_bmp.h"
 
+#include "wx/xrc/private/xmlresbin.h"
+
 #include <stdarg.h>
 
 #include <memory>
@@ -285,6 +287,110 @@ TEST_CASE("XRC::Features", "[xrc]")
     CHECK( xrc.LoadFrame(nullptr, "dodo") );
 }
 
+TEST_CASE("XRC::Compiled", "[xrc]")
+{
+    auto& xrc = *wxXmlResource::Get();
+    xrc.InitAllHandlers();
+
+    wxStringInputStream sis(R"(<?xml version="1.0" ?>
+<resource>
+  <object class="wxDialog" name="dialog">
+    <object class="wxBoxSizer">
+      <object class="sizeritem">
+        <object class="wxPanel" name="panel"/>
+      </object>
+      <object class="sizeritem">
+        <object class="wxButton" name="Buttons[0]">
+          <label>&amp;First</label>
+        </object>
+      </object>
+    </object>
+  </object>
+  <!-- This one should be filtered out when it's loaded. -->
+  <object class="wxFrame" name="frame" feature="NotEnabled"/>
+  <object class="wxPanel" name="parent">
+    <object class="wxPanel" name="nested"/>
+  </object>
+  <ids-range name="Buttons" size="2"/>
+  <!-- This one uses the IDs range, so it's created immediately, but must be
+       filtered out too. -->
+  <object class="wxDialog" name="inactive" feature="NotEnabled">
+    <object class="wxButton" name="Buttons[1]"/>
+  </object>
+</resource>
+    )");
+    wxXmlDocument doc(sis);
+    REQUIRE( doc.IsOk() );
+
+    wxXRCBinary::Writer writer;
+    writer.AddDocument(doc);
+
+    TempFile file("test.xrb");
+    REQUIRE( writer.Save(file.GetName()) );
+
+    REQUIRE( xrc.Load(file.GetName()) );
+
+    wxDialog dlg;
+    REQUIRE( xrc.LoadDialog(&dlg, nullptr, "dialog") );
+    CHECK( XRCCTRL(dlg, "panel", wxPanel) );
+
+    wxButton* const button = XRCCTRL(dlg, "Buttons[0]", wxButton);
+    REQUIRE( button );
+    CHECK( button->GetLabel() == "&First" );
+    CHECK( XRCID("Buttons[start]") < XRCID("Buttons[end]") );
+
+    CHECK( !xrc.LoadFrame(nullptr, "frame") );
+    CHECK( !xrc.LoadDialog(nullptr, "inactive") );
+
+    CHECK( xrc.LoadObjectRecursively(&dlg, "nested", "wxPanel") );
+
+    CHECK( xrc.Unload(file.GetName()) );
+}
+
+TEST_CASE("XRC::Deferred", "[xrc]")
+{
+    auto& xrc = *wxXmlResource::Get();
+    xrc.InitAllHandlers();
+
+    LoadXrcFrom(R"(<?xml version="1.0" ?>
+<resource>
+  <object class="wxDialog" name="deferred">
+    <object class="wxNotebook">
+      <deferred>1</deferred>
+      <object class="notebookpage">
+        <label>First</label>
+        <object class="wxPanel" name="page1">
+          <object class="wxPanel" name="child1"/>
+        </object>
+      </object>
+      <object class="notebookpage">
+        <label>Second</label>
+        <object class="wxPanel" name="page2">
+          <object class="wxPanel" name="child2"/>
+        </object>
+      </object>
+    </object>
+  </object>
+</resource>
+    )");
+
+    wxDialog dlg;
+    REQUIRE( xrc.LoadDialog(&dlg, nullptr, "deferred") );
+
+    // The pages themselves are always created, but only the contents of the
+    // first one is.
+    CHECK( XRCCTRL(dlg, "page1", wxPanel) );
+    CHECK( XRCCTRL(dlg, "page2", wxPanel) );
+    CHECK( XRCCTRL(dlg, "child1", wxPanel) );
+    CHECK( !XRCCTRL(dlg, "child2", wxPanel) );
+
+    CHECK( xrc.CreateDeferredContents(&dlg) );
+    CHECK( XRCCTRL(dlg, "child2", wxPanel) );
+
+    // Nothing is left to create now.
+    CHECK( !xrc.CreateDeferredContents(&dlg) );
+}
+
 TEST_CASE("XRC::EnvVarInPath", "[xrc]")
 {
     wxStringInputStream sis(
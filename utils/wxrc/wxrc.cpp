@@ -27,6 +27,8 @@
 #include "wx/mimetype.h"
 #include "wx/vector.h"
 
+#include "wx/xrc/private/xmlresbin.h"
+
 #include <memory>
 
 class XRCWidgetData
@@ -190,6 +192,8 @@ private:
     void MakePackageZIP(const wxArrayString& flist);
     void MakePackageCPP(const wxArrayString& flist);
     void MakePackagePython(const wxArrayString& flist);
+    void MakePackageBinary();
+    void AdjustFilePaths(wxXmlNode *node, const wxString& inputPath);
 
     void OutputGettext();
     ExtractedStrings FindStrings();
@@ -197,7 +201,7 @@ private:
 
     bool Validate();
 
-    bool flagVerbose, flagCPP, flagPython, flagGettext, flagValidate, flagValidateOnly;
+    bool flagVerbose, flagCPP, flagPython, flagBinary, flagGettext, flagValidate, flagValidateOnly;
     wxString parOutput, parFuncname, parOutputPath, parSchemaFile;
     wxArrayString parFiles;
     int retCode;
@@ -220,6 +224,7 @@ int XmlResApp::OnRun()
         { wxCMD_LINE_SWITCH, "e", "extra-cpp-code",  "output C++ header file with XRC derived classes" },
         { wxCMD_LINE_SWITCH, "c", "cpp-code",  "output C++ source rather than .rsc file" },
         { wxCMD_LINE_SWITCH, "p", "python-code",  "output wxPython source rather than .rsc file" },
+        { wxCMD_LINE_SWITCH, "b", "binary",  "output compiled binary resources rather than .rsc file" },
         { wxCMD_LINE_SWITCH, "g", "gettext",  "output list of translatable strings (to stdout or file if -o used)" },
         { wxCMD_LINE_OPTION, "n", "function",  "C++/Python function name (with -c or -p) [InitXmlResource]" },
         { wxCMD_LINE_OPTION, "o", "output",  "output file [resource.xrs/cpp]" },
@@ -275,6 +280,7 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
     flagVerbose = cmdline.Found("v");
     flagCPP = cmdline.Found("c");
     flagPython = cmdline.Found("p");
+    flagBinary = cmdline.Found("b");
     flagH = flagCPP && cmdline.Found("e");
     flagValidateOnly = cmdline.Found("validate-only");
     flagValidate = flagValidateOnly || cmdline.Found("validate");
@@ -291,6 +297,8 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
                 parOutput = wxT("resource.cpp");
             else if (flagPython)
                 parOutput = wxT("resource.py");
+            else if (flagBinary)
+                parOutput = wxT("resource.xrb");
             else
                 parOutput = wxT("resource.xrs");
         }
@@ -325,6 +333,16 @@ void XmlResApp::ParseParams(const wxCmdLineParser& cmdline)
 
 void XmlResApp::CompileRes()
 {
+    if (flagBinary)
+    {
+        // No temporary files are needed in this case.
+        if ( wxFileExists(parOutput) )
+            wxRemoveFile(parOutput);
+
+        MakePackageBinary();
+        return;
+    }
+
     wxArrayString files = PrepareTempFiles();
 
     if ( wxFileExists(parOutput) )
@@ -585,6 +603,78 @@ void XmlResApp::MakePackageZIP(const wxArrayString& flist)
 }
 
 
+// make the paths of all files mentioned in the structure relative to the
+// output file instead of the input one, as they're resolved relatively to the
+// location of the compiled file when it is loaded
+void XmlResApp::AdjustFilePaths(wxXmlNode *node, const wxString& inputPath)
+{
+    if (node->GetType() != wxXML_ELEMENT_NODE) return;
+
+    bool containsFilename = NodeContainsFilename(node);
+
+    for (wxXmlNode *n = node->GetChildren(); n; n = n->GetNext())
+    {
+        if (containsFilename &&
+            (n->GetType() == wxXML_TEXT_NODE ||
+             n->GetType() == wxXML_CDATA_SECTION_NODE))
+        {
+            wxArrayString paths = wxSplit(n->GetContent(), ';', '\0');
+            for (size_t i = 0; i < paths.size(); ++i)
+            {
+                // Leave absolute paths and URLs alone.
+                wxString& path = paths[i];
+                if (wxIsAbsolutePath(path) || path.find(':') != wxString::npos)
+                    continue;
+
+                wxFileName fn(path);
+                fn.MakeAbsolute(inputPath);
+                fn.MakeRelativeTo(parOutputPath);
+                path = fn.GetFullPath(wxPATH_UNIX);
+            }
+
+            n->SetContent(wxJoin(paths, ';', '\0'));
+        }
+
+        AdjustFilePaths(n, inputPath);
+    }
+}
+
+void XmlResApp::MakePackageBinary()
+{
+    wxXRCBinary::Writer writer;
+
+    for (size_t i = 0; i < parFiles.GetCount(); i++)
+    {
+        if (flagVerbose)
+            wxPrintf(wxT("processing %s...\n"), parFiles[i]);
+
+        wxXmlDocument doc;
+        if (!doc.Load(parFiles[i]))
+        {
+            wxLogError(wxT("Error parsing file ") + parFiles[i]);
+            retCode = 1;
+            continue;
+        }
+
+        AdjustFilePaths(doc.GetRoot(), wxPathOnly(parFiles[i]));
+
+        writer.AddDocument(doc);
+    }
+
+    if (retCode)
+        return;
+
+    if (flagVerbose)
+        wxPrintf(wxT("creating compiled resources file %s...\n"), parOutput);
+
+    if (!writer.Save(parOutput))
+    {
+        wxLogError(wxT("Failed to write compiled resources file ") + parOutput);
+        retCode = 1;
+    }
+}
+
+
 // This function returns empty string on any file IO error.
 static wxString FileToCppArray(wxString filename, int num)
 {